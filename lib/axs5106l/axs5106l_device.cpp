@@ -1,14 +1,37 @@
 #include "axs5106l_device.h"
 TwoWire *g_touch_i2c;         
+static SemaphoreHandle_t g_touch_bus_mutex = NULL; // Held for each whole transaction if set
+
+void touch_set_bus_mutex(SemaphoreHandle_t bus_mutex)
+{
+    g_touch_bus_mutex = bus_mutex;
+}
+
+static void touch_bus_take(void)
+{
+    if (g_touch_bus_mutex != NULL) {
+        xSemaphoreTake(g_touch_bus_mutex, portMAX_DELAY);
+    }
+}
+
+static void touch_bus_give(void)
+{
+    if (g_touch_bus_mutex != NULL) {
+        xSemaphoreGive(g_touch_bus_mutex);
+    }
+}
 
 static bool touch_i2c_write(uint8_t driver_addr, uint8_t reg_addr, const uint8_t *data, uint32_t length)
 {
+    touch_bus_take();
     g_touch_i2c->beginTransmission(driver_addr);
     g_touch_i2c->write(reg_addr);
     g_touch_i2c->write(data, length);
 
 
-    if (g_touch_i2c->endTransmission() != 0) {
+    bool ok = g_touch_i2c->endTransmission() == 0;
+    touch_bus_give();
+    if (!ok) {
         Serial.println("The I2C transmission fails. - I2C Read\r\n");
         return false;
     }
@@ -17,19 +40,23 @@ static bool touch_i2c_write(uint8_t driver_addr, uint8_t reg_addr, const uint8_t
 
 static bool touch_i2c_read(uint8_t driver_addr, uint8_t reg_addr, uint8_t *data, uint32_t length)
 {
+    touch_bus_take();
     g_touch_i2c->beginTransmission(driver_addr);
     g_touch_i2c->write(reg_addr);
     if (g_touch_i2c->endTransmission() != 0) {
+        touch_bus_give();
         Serial.println("The I2C write fails. - I2C Read\r\n");
         return false;
     }
 
     g_touch_i2c->requestFrom(driver_addr, length);
     if (g_touch_i2c->available() != length) {
+        touch_bus_give();
         Serial.println("The I2C read fails. - I2C Read\r\n");
         return false;
     }
     g_touch_i2c->readBytes(data, length);
+    touch_bus_give();
     return true;
 }
 
@@ -37,3 +37,6 @@ bool get_touch_data(touch_data_t *touch_data);
 
 bool touch_init(TwoWire *touch_i2c, int tp_rst, int tp_int);
 
+// Mutex taken around each I2C transaction, for a bus shared with other tasks
+void touch_set_bus_mutex(SemaphoreHandle_t bus_mutex);
+
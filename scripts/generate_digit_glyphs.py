@@ -0,0 +1,158 @@
+# PlatformIO pre-build script: rasterizes the large weight-readout numerals
+# into src/digit_glyphs.h as anti-aliased 4-bit palette bitmaps.
+#
+# The glyphs are defined as stroked vector paths below and rendered with 4x4
+# supersampling, so no font files or Python packages are needed. Coverage is
+# mapped onto the UI palette: 0 = UI_BLACK, full = UI_WHITE and the levels in
+# between onto the grey ramp starting at UI_AA_RAMP_FIRST (see ui_palette.h).
+#
+# Runs automatically before each build (extra_scripts = pre:...) and only
+# rewrites the header when this script is newer. Can also be run directly:
+#   python scripts/generate_digit_glyphs.py
+
+import math
+import os
+
+GLYPH_WIDTH = 18   # Must be even: two pixels per byte
+GLYPH_HEIGHT = 28
+DOT_WIDTH = 8
+STROKE = 3.2       # Stroke width in pixels
+SUPERSAMPLE = 4
+LEVELS = 8         # Coverage levels above black; level 8 = white
+
+UI_BLACK = 0
+UI_WHITE = 1
+UI_AA_RAMP_FIRST = 8  # Palette indices 8..14 hold coverage levels 1..7
+
+
+def arc(cx, cy, rx, ry, start, end, steps=24):
+    """Polyline along an ellipse, angles in degrees, y axis pointing down."""
+    points = []
+    for i in range(steps + 1):
+        a = math.radians(start + (end - start) * i / steps)
+        points.append((cx + rx * math.cos(a), cy + ry * math.sin(a)))
+    return points
+
+
+# Each glyph is a list of polylines in glyph pixel coordinates
+GLYPHS = {
+    "0": [arc(9, 14, 6, 10.5, 0, 360, 48)],
+    "1": [[(5, 7), (9.5, 3.5), (9.5, 24.5)], [(5, 24.5), (14, 24.5)]],
+    "2": [arc(9, 9, 5.5, 5.5, 190, 385) + [(3.5, 24.5), (14.5, 24.5)]],
+    "3": [arc(9, 8.75, 5.25, 5.25, 205, 450), arc(9, 19.25, 5.75, 5.25, 270, 515)],
+    "4": [[(12, 24.5), (12, 3.5), (3.5, 18), (15, 18)]],
+    "5": [[(14, 3.5), (5, 3.5), (4.5, 12.5)] + arc(9, 18, 5.75, 6.5, 225, 505)],
+    "6": [[(12.5, 3.5), (4.2, 16.5)], arc(9, 18.25, 5.75, 6.25, 0, 360, 40)],
+    "7": [[(3.5, 3.5), (14.5, 3.5), (7, 24.5)]],
+    "8": [arc(9, 8.75, 5, 5.25, 0, 360, 36), arc(9, 19.25, 5.75, 5.25, 0, 360, 40)],
+    "9": [arc(9, 9.75, 5.75, 6.25, 0, 360, 40), [(13.8, 11.5), (5.5, 24.5)]],
+    "-": [[(4, 14.5), (14, 14.5)]],
+}
+GLYPH_ORDER = "0123456789-"
+DOT = [[(4, 23), (4, 23)]]  # A single point stroked with a larger pen
+
+
+def distance_to_segment(px, py, a, b):
+    ax, ay = a
+    bx, by = b
+    dx, dy = bx - ax, by - ay
+    length2 = dx * dx + dy * dy
+    t = 0.0 if length2 == 0 else max(0.0, min(1.0, ((px - ax) * dx + (py - ay) * dy) / length2))
+    qx, qy = ax + t * dx, ay + t * dy
+    return math.hypot(px - qx, py - qy)
+
+
+def rasterize(paths, width, height, stroke):
+    segments = []
+    for path in paths:
+        for i in range(len(path) - 1):
+            segments.append((path[i], path[i + 1]))
+    radius = stroke / 2.0
+    pixels = []
+    for y in range(height):
+        for x in range(width):
+            hits = 0
+            for sy in range(SUPERSAMPLE):
+                for sx in range(SUPERSAMPLE):
+                    px = x + (sx + 0.5) / SUPERSAMPLE
+                    py = y + (sy + 0.5) / SUPERSAMPLE
+                    if any(distance_to_segment(px, py, a, b) <= radius for a, b in segments):
+                        hits += 1
+            level = (hits * LEVELS + SUPERSAMPLE * SUPERSAMPLE // 2) // (SUPERSAMPLE * SUPERSAMPLE)
+            if level == 0:
+                pixels.append(UI_BLACK)
+            elif level >= LEVELS:
+                pixels.append(UI_WHITE)
+            else:
+                pixels.append(UI_AA_RAMP_FIRST + level - 1)
+    return pixels
+
+
+def pack(pixels, width):
+    """Two pixels per byte, left pixel in the high nibble (LovyanGFX 4-bit layout)."""
+    data = []
+    for row in range(len(pixels) // width):
+        line = pixels[row * width:(row + 1) * width]
+        for i in range(0, width, 2):
+            data.append((line[i] << 4) | line[i + 1])
+    return data
+
+
+def format_bytes(data, indent="  "):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append(indent + ", ".join("0x%02X" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def generate(output_path):
+    out = []
+    out.append("// Generated by scripts/generate_digit_glyphs.py - do not edit.")
+    out.append("#ifndef DIGIT_GLYPHS_H")
+    out.append("#define DIGIT_GLYPHS_H")
+    out.append("")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append("// Anti-aliased numerals for the weight readout, 4-bit UI palette indices,")
+    out.append("// two pixels per byte with the left pixel in the high nibble.")
+    out.append("#define DIGIT_GLYPH_WIDTH %d" % GLYPH_WIDTH)
+    out.append("#define DIGIT_GLYPH_HEIGHT %d" % GLYPH_HEIGHT)
+    out.append("#define DIGIT_GLYPH_BYTES %d" % (GLYPH_WIDTH * GLYPH_HEIGHT // 2))
+    out.append("#define DIGIT_GLYPH_MINUS 10 // Index of '-' after the digits 0-9")
+    out.append("#define DIGIT_GLYPH_COUNT %d" % len(GLYPH_ORDER))
+    out.append("#define DOT_GLYPH_WIDTH %d" % DOT_WIDTH)
+    out.append("")
+    out.append("static const uint8_t DIGIT_GLYPHS[DIGIT_GLYPH_COUNT][DIGIT_GLYPH_BYTES] = {")
+    for ch in GLYPH_ORDER:
+        out.append("  { // '%s'" % ch)
+        out.append(format_bytes(pack(rasterize(GLYPHS[ch], GLYPH_WIDTH, GLYPH_HEIGHT, STROKE), GLYPH_WIDTH), "    "))
+        out.append("  },")
+    out.append("};")
+    out.append("")
+    out.append("static const uint8_t DOT_GLYPH[DOT_GLYPH_WIDTH * DIGIT_GLYPH_HEIGHT / 2] = {")
+    out.append(format_bytes(pack(rasterize(DOT, DOT_WIDTH, GLYPH_HEIGHT, 4.4), DOT_WIDTH)))
+    out.append("};")
+    out.append("")
+    out.append("#endif // DIGIT_GLYPHS_H")
+    out.append("")
+
+    with open(output_path, "w") as f:
+        f.write("\n".join(out))
+    print("Generated %s" % output_path)
+
+
+def run(project_dir, script_path):
+    output_path = os.path.join(project_dir, "src", "digit_glyphs.h")
+    if os.path.exists(output_path) and os.path.getmtime(output_path) >= os.path.getmtime(script_path):
+        return
+    generate(output_path)
+
+
+try:
+    Import("env")  # noqa: F821
+    _project_dir = env.subst("$PROJECT_DIR")  # noqa: F821
+    run(_project_dir, os.path.join(_project_dir, "scripts", "generate_digit_glyphs.py"))
+except NameError:
+    if __name__ == "__main__":
+        _script = os.path.abspath(__file__)
+        run(os.path.dirname(os.path.dirname(_script)), _script)
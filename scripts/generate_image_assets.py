@@ -0,0 +1,241 @@
+# PlatformIO pre-build script: converts the static artwork in assets/ into
+# run-length encoded RGB565 images in src/image_assets.h.
+#
+# Images are scaled to fit the panel (area averaging, aspect ratio kept),
+# composited onto black and stored in panel byte order, so the firmware only
+# expands runs into its DMA buffers. No PNG decoding, SPIFFS read or large
+# heap buffer is needed at boot.
+#
+# Encoding, in 16-bit words: a control word with the top bit set is followed
+# by one colour repeated (control & 0x7FFF) times; otherwise it is followed by
+# that many literal colours. Runs may cross row boundaries.
+#
+# Runs automatically before each build (extra_scripts = pre:...) and only
+# rewrites the header when this script or an image is newer. Can also be run
+# directly:
+#   python scripts/generate_image_assets.py
+
+import os
+import struct
+import zlib
+
+PANEL_WIDTH = 320   # Landscape panel resolution
+PANEL_HEIGHT = 172
+
+# (source image in assets/, C identifier, maximum width, maximum height)
+ASSETS = [
+    ("powdersense_2.png", "SPLASH_IMAGE", PANEL_WIDTH, PANEL_HEIGHT),
+]
+
+RLE_RUN = 0x8000
+RLE_MAX_COUNT = 0x7FFF
+MIN_RUN = 3  # Shorter repeats are cheaper as literals
+
+
+def read_png(path):
+    """Minimal PNG decoder: 8-bit greyscale/RGB/RGBA and palette images, not interlaced.
+    Returns (width, height, rows of (r, g, b, a) tuples)."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("%s is not a PNG file" % path)
+
+    pos = 8
+    idat = b""
+    palette = []
+    alpha = []
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color_type, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b"tRNS":
+            alpha = list(body)
+        elif kind == b"IDAT":
+            idat += body
+        elif kind == b"IEND":
+            break
+
+    if interlace != 0:
+        raise ValueError("%s: interlaced PNGs are not supported" % path)
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color_type]
+    if color_type != 3 and depth != 8:
+        raise ValueError("%s: only 8-bit channels are supported" % path)
+
+    bits_per_pixel = channels * depth
+    stride = (width * bits_per_pixel + 7) // 8
+    bpp = max(1, bits_per_pixel // 8)  # Filter distance in bytes
+    raw = zlib.decompress(idat)
+
+    rows = []
+    previous = bytearray(stride)
+    for y in range(height):
+        start = y * (stride + 1)
+        filter_type = raw[start]
+        line = bytearray(raw[start + 1:start + 1 + stride])
+        for i in range(stride):
+            left = line[i - bpp] if i >= bpp else 0
+            up = previous[i]
+            up_left = previous[i - bpp] if i >= bpp else 0
+            if filter_type == 1:
+                line[i] = (line[i] + left) & 0xFF
+            elif filter_type == 2:
+                line[i] = (line[i] + up) & 0xFF
+            elif filter_type == 3:
+                line[i] = (line[i] + ((left + up) >> 1)) & 0xFF
+            elif filter_type == 4:
+                p = left + up - up_left
+                pa, pb, pc = abs(p - left), abs(p - up), abs(p - up_left)
+                predictor = left if pa <= pb and pa <= pc else (up if pb <= pc else up_left)
+                line[i] = (line[i] + predictor) & 0xFF
+        previous = line
+
+        pixels = []
+        for x in range(width):
+            if color_type == 3:
+                bit = x * depth
+                index = (line[bit // 8] >> (8 - depth - bit % 8)) & ((1 << depth) - 1)
+                r, g, b = palette[index]
+                pixels.append((r, g, b, alpha[index] if index < len(alpha) else 255))
+            else:
+                px = line[x * channels:(x + 1) * channels]
+                if color_type == 0:
+                    pixels.append((px[0], px[0], px[0], 255))
+                elif color_type == 4:
+                    pixels.append((px[0], px[0], px[0], px[1]))
+                elif color_type == 2:
+                    pixels.append((px[0], px[1], px[2], 255))
+                else:
+                    pixels.append((px[0], px[1], px[2], px[3]))
+        rows.append(pixels)
+    return width, height, rows
+
+
+def fit(width, height, max_width, max_height):
+    scale = min(max_width / width, max_height / height, 1.0)
+    return max(1, int(round(width * scale))), max(1, int(round(height * scale)))
+
+
+def resample(rows, width, height, out_width, out_height):
+    """Area-average downscale, with alpha composited onto black."""
+    sx = width / out_width
+    sy = height / out_height
+    out = []
+    for oy in range(out_height):
+        y0, y1 = oy * sy, (oy + 1) * sy
+        line = []
+        for ox in range(out_width):
+            x0, x1 = ox * sx, (ox + 1) * sx
+            r = g = b = total = 0.0
+            y = int(y0)
+            while y < y1 and y < height:
+                wy = min(y + 1, y1) - max(y, y0)
+                x = int(x0)
+                while x < x1 and x < width:
+                    w = wy * (min(x + 1, x1) - max(x, x0))
+                    pr, pg, pb, pa = rows[y][x]
+                    a = pa / 255.0
+                    r += pr * a * w
+                    g += pg * a * w
+                    b += pb * a * w
+                    total += w
+                    x += 1
+                y += 1
+            line.append((r / total, g / total, b / total))
+        out.append(line)
+    return out
+
+
+def to_panel565(r, g, b):
+    value = (int(r + 0.5) >> 3 << 11) | (int(g + 0.5) >> 2 << 5) | (int(b + 0.5) >> 3)
+    return ((value & 0xFF) << 8) | (value >> 8)  # Byte-swapped, as the panel expects
+
+
+def rle_encode(pixels):
+    words = []
+    literals = []
+    i = 0
+    n = len(pixels)
+
+    def flush_literals():
+        while literals:
+            chunk = literals[:RLE_MAX_COUNT]
+            del literals[:RLE_MAX_COUNT]
+            words.append(len(chunk))
+            words.extend(chunk)
+
+    while i < n:
+        run = 1
+        while i + run < n and pixels[i + run] == pixels[i] and run < RLE_MAX_COUNT:
+            run += 1
+        if run >= MIN_RUN:
+            flush_literals()
+            words.append(RLE_RUN | run)
+            words.append(pixels[i])
+            i += run
+        else:
+            literals.append(pixels[i])
+            i += 1
+    flush_literals()
+    return words
+
+
+def format_words(data, indent="  "):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append(indent + ", ".join("0x%04X" % w for w in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def generate(assets_dir, output_path):
+    out = []
+    out.append("// Generated by scripts/generate_image_assets.py - do not edit.")
+    out.append("#ifndef IMAGE_ASSETS_H")
+    out.append("#define IMAGE_ASSETS_H")
+    out.append("")
+    out.append('#include "rle_image.h"')
+    out.append("")
+    for filename, name, max_width, max_height in ASSETS:
+        width, height, rows = read_png(os.path.join(assets_dir, filename))
+        out_width, out_height = fit(width, height, max_width, max_height)
+        scaled = resample(rows, width, height, out_width, out_height)
+        pixels = [to_panel565(*px) for line in scaled for px in line]
+        words = rle_encode(pixels)
+        out.append("// %s, %dx%d scaled to %dx%d: %d bytes RLE, %d bytes raw RGB565"
+                   % (filename, width, height, out_width, out_height, len(words) * 2, len(pixels) * 2))
+        out.append("static const uint16_t %s_DATA[] = {" % name)
+        out.append(format_words(words))
+        out.append("};")
+        out.append("static const RleImage %s = { %d, %d, %s_DATA, %d };" % (name, out_width, out_height, name, len(words)))
+        out.append("")
+        print("%s: %dx%d, %d bytes" % (name, out_width, out_height, len(words) * 2))
+    out.append("#endif // IMAGE_ASSETS_H")
+    out.append("")
+
+    with open(output_path, "w") as f:
+        f.write("\n".join(out))
+    print("Generated %s" % output_path)
+
+
+def run(project_dir, script_path):
+    assets_dir = os.path.join(project_dir, "assets")
+    output_path = os.path.join(project_dir, "src", "image_assets.h")
+    sources = [script_path] + [os.path.join(assets_dir, asset[0]) for asset in ASSETS]
+    if os.path.exists(output_path):
+        newest = max(os.path.getmtime(path) for path in sources)
+        if os.path.getmtime(output_path) >= newest:
+            return
+    generate(assets_dir, output_path)
+
+
+try:
+    Import("env")  # noqa: F821
+    _project_dir = env.subst("$PROJECT_DIR")  # noqa: F821
+    run(_project_dir, os.path.join(_project_dir, "scripts", "generate_image_assets.py"))
+except NameError:
+    if __name__ == "__main__":
+        _script = os.path.abspath(__file__)
+        run(os.path.dirname(os.path.dirname(_script)), _script)
@@ -30,6 +30,10 @@
     #define ADS1115_ADDRESS 0x48  // ADDR pin connected to ground
     #define ADS1115_CHANNEL 0     // A0 pin for VDS measurement
     
+    // Touch controller (AXS5106L), on the same I2C bus as the ADS1115
+    #define TOUCH_RST_PIN 20
+    #define TOUCH_INT_PIN 21
+    
     // RGB LED - NOT PRESENT on this board
     #undef HAS_RGB_LED
     
@@ -0,0 +1,192 @@
+#include <Arduino.h>
+#include "boot_sequence.h"
+#include "logger.h"
+
+BootSequence::BootSequence()
+  : _finished(nullptr) {
+  memset(_stages, 0, sizeof(_stages));
+  _mux = portMUX_INITIALIZER_UNLOCKED;
+}
+
+void BootSequence::begin() {
+  if (_finished == nullptr) {
+    _finished = xEventGroupCreate();
+  }
+}
+
+uint32_t BootSequence::dependencies(BootStage stage) {
+  switch (stage) {
+    case BOOT_STAGE_SETTINGS:
+      return bit(BOOT_STAGE_STORAGE);
+    case BOOT_STAGE_MEASURING:
+      return bit(BOOT_STAGE_SENSOR) | bit(BOOT_STAGE_SETTINGS);
+    case BOOT_STAGE_NETWORK:
+      // Pages come from SPIFFS and the state sent to clients includes the configs
+      return bit(BOOT_STAGE_WIFI) | bit(BOOT_STAGE_STORAGE) | bit(BOOT_STAGE_SETTINGS);
+    case BOOT_STAGE_TIME:
+      return bit(BOOT_STAGE_WIFI);
+    default:
+      return 0;
+  }
+}
+
+void BootSequence::start(BootStage stage) {
+  if (stage >= BOOT_STAGE_COUNT) {
+    return;
+  }
+  uint32_t now = millis();
+  uint32_t missing = dependencies(stage) & ~(_finished != nullptr ? xEventGroupGetBits(_finished) : 0);
+  portENTER_CRITICAL(&_mux);
+  _stages[stage].status = BOOT_STAGE_RUNNING;
+  _stages[stage].startMs = now;
+  portEXIT_CRITICAL(&_mux);
+  if (missing != 0) {
+    LOG_WARN("Boot: %s started before its dependencies (0x%02lx)", stageName(stage), (unsigned long)missing);
+  }
+}
+
+void BootSequence::finish(BootStage stage, const char* note) {
+  settle(stage, BOOT_STAGE_DONE, note);
+}
+
+void BootSequence::fail(BootStage stage, const char* note) {
+  settle(stage, BOOT_STAGE_FAILED, note);
+}
+
+void BootSequence::skip(BootStage stage, const char* note) {
+  settle(stage, BOOT_STAGE_SKIPPED, note);
+}
+
+void BootSequence::settle(BootStage stage, BootStageStatus status, const char* note) {
+  if (stage >= BOOT_STAGE_COUNT) {
+    return;
+  }
+  uint32_t now = millis();
+  portENTER_CRITICAL(&_mux);
+  BootStageRecord& record = _stages[stage];
+  if (record.status == BOOT_STAGE_PENDING) {
+    record.startMs = now; // Skipped, or finished without an explicit start
+  }
+  record.status = status;
+  record.endMs = now;
+  strlcpy(record.note, note != nullptr ? note : "", sizeof(record.note));
+  uint32_t startMs = record.startMs;
+  portEXIT_CRITICAL(&_mux);
+
+  if (_finished != nullptr) {
+    xEventGroupSetBits(_finished, bit(stage));
+  }
+  LOG_INFO("[boot %5lu ms] %s %s after %lu ms%s%s", (unsigned long)now, stageName(stage), statusName(status),
+                (unsigned long)(now - startMs), note != nullptr ? ": " : "", note != nullptr ? note : "");
+}
+
+BootStageStatus BootSequence::status(BootStage stage) const {
+  if (stage >= BOOT_STAGE_COUNT) {
+    return BOOT_STAGE_PENDING;
+  }
+  portENTER_CRITICAL(&_mux);
+  BootStageStatus status = _stages[stage].status;
+  portEXIT_CRITICAL(&_mux);
+  return status;
+}
+
+BootStageRecord BootSequence::record(BootStage stage) const {
+  BootStageRecord copy;
+  memset(&copy, 0, sizeof(copy));
+  if (stage >= BOOT_STAGE_COUNT) {
+    return copy;
+  }
+  portENTER_CRITICAL(&_mux);
+  copy = _stages[stage];
+  portEXIT_CRITICAL(&_mux);
+  return copy;
+}
+
+bool BootSequence::ready(BootStage stage) const {
+  if (status(stage) != BOOT_STAGE_PENDING || _finished == nullptr) {
+    return false;
+  }
+  uint32_t needed = dependencies(stage);
+  return (xEventGroupGetBits(_finished) & needed) == needed;
+}
+
+bool BootSequence::waitFor(uint32_t stages, TickType_t timeout) {
+  if (_finished == nullptr) {
+    return false;
+  }
+  EventBits_t bits = xEventGroupWaitBits(_finished, stages, pdFALSE, pdTRUE, timeout);
+  return (bits & stages) == stages;
+}
+
+bool BootSequence::complete() const {
+  uint32_t all = bit(BOOT_STAGE_COUNT) - 1;
+  return _finished != nullptr && (xEventGroupGetBits(_finished) & all) == all;
+}
+
+uint32_t BootSequence::totalMs() const {
+  if (!complete()) {
+    return millis();
+  }
+  uint32_t last = 0;
+  portENTER_CRITICAL(&_mux);
+  for (int i = 0; i < BOOT_STAGE_COUNT; i++) {
+    last = max(last, _stages[i].endMs);
+  }
+  portEXIT_CRITICAL(&_mux);
+  return last;
+}
+
+void BootSequence::logTimeline() const {
+  Serial.printf("Boot timeline, ms since power-on (%lu ms total):\n", (unsigned long)totalMs());
+  for (int i = 0; i < BOOT_STAGE_COUNT; i++) {
+    BootStageRecord stage = record((BootStage)i);
+    if (stage.status == BOOT_STAGE_PENDING) {
+      Serial.printf("  %-10s pending\n", stageName((BootStage)i));
+    } else if (stage.status == BOOT_STAGE_RUNNING) {
+      Serial.printf("  %-10s %6lu ->    ...  running\n", stageName((BootStage)i), (unsigned long)stage.startMs);
+    } else {
+      Serial.printf("  %-10s %6lu -> %6lu  %-7s %s\n", stageName((BootStage)i), (unsigned long)stage.startMs,
+                    (unsigned long)stage.endMs, statusName(stage.status), stage.note);
+    }
+  }
+}
+
+const char* BootSequence::stageName(BootStage stage) {
+  switch (stage) {
+    case BOOT_STAGE_DISPLAY:
+      return "display";
+    case BOOT_STAGE_SENSOR:
+      return "sensor";
+    case BOOT_STAGE_STORAGE:
+      return "storage";
+    case BOOT_STAGE_SETTINGS:
+      return "settings";
+    case BOOT_STAGE_MEASURING:
+      return "measuring";
+    case BOOT_STAGE_WIFI:
+      return "wifi";
+    case BOOT_STAGE_NETWORK:
+      return "network";
+    case BOOT_STAGE_TIME:
+      return "time";
+    default:
+      return "unknown";
+  }
+}
+
+const char* BootSequence::statusName(BootStageStatus status) {
+  switch (status) {
+    case BOOT_STAGE_PENDING:
+      return "pending";
+    case BOOT_STAGE_RUNNING:
+      return "running";
+    case BOOT_STAGE_DONE:
+      return "done";
+    case BOOT_STAGE_FAILED:
+      return "failed";
+    case BOOT_STAGE_SKIPPED:
+      return "skipped";
+    default:
+      return "unknown";
+  }
+}
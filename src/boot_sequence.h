@@ -0,0 +1,112 @@
+#ifndef BOOT_SEQUENCE_H
+#define BOOT_SEQUENCE_H
+
+#include <Arduino.h>
+#include <freertos/event_groups.h>
+
+// ========================================
+// BOOT STAGES AND TIMELINE
+// ========================================
+// Boot is split into stages that only wait for what they actually depend on.
+// The display comes up in its own task while setup() probes the sensor,
+// mounts SPIFFS and loads the settings, and Wi-Fi associates in the
+// background from the very start. Measuring begins as soon as the sensor
+// and the calibration are there; the network services follow from loop()
+// once Wi-Fi has an address or the access point is up.
+//
+// Every stage records when it started and finished (ms since power-on), so
+// the timeline can be logged and served to the web UI.
+
+enum BootStage : uint8_t {
+  BOOT_STAGE_DISPLAY,   // Panel, splash, canvas and DMA pipeline
+  BOOT_STAGE_SENSOR,    // ADS1115 probe, or the direct ADC fallback
+  BOOT_STAGE_STORAGE,   // SPIFFS mount
+  BOOT_STAGE_SETTINGS,  // Configs and calibration, measurement log, rollups
+  BOOT_STAGE_MEASURING, // First sample taken
+  BOOT_STAGE_WIFI,      // First connection attempt until an address, or AP fallback
+  BOOT_STAGE_NETWORK,   // HTTP and WebSocket servers
+  BOOT_STAGE_TIME,      // First SNTP sync
+  BOOT_STAGE_COUNT
+};
+
+enum BootStageStatus : uint8_t {
+  BOOT_STAGE_PENDING,
+  BOOT_STAGE_RUNNING,
+  BOOT_STAGE_DONE,
+  BOOT_STAGE_FAILED,  // Finished without its result, boot carries on without it
+  BOOT_STAGE_SKIPPED  // Not needed on this boot, e.g. Wi-Fi without credentials
+};
+
+struct BootStageRecord {
+  BootStageStatus status;
+  uint32_t startMs;  // millis() when the stage started
+  uint32_t endMs;    // millis() when it finished
+  char note[40];     // Short result, e.g. the IP address or why it failed
+};
+
+/**
+ * @brief Tracks the boot stages, their dependencies and their timing. Safe to use from several tasks.
+ */
+class BootSequence
+{
+public:
+  BootSequence();
+
+  /**
+   * @brief Creates the event group. Call first thing in setup().
+   */
+  void begin();
+
+  static uint32_t bit(BootStage stage) { return 1UL << stage; }
+
+  /**
+   * @brief Stages that must have finished (in any way) before this one may start.
+   */
+  static uint32_t dependencies(BootStage stage);
+
+  void start(BootStage stage);
+  void finish(BootStage stage, const char* note = nullptr);
+  void fail(BootStage stage, const char* note);
+  void skip(BootStage stage, const char* note);
+
+  BootStageStatus status(BootStage stage) const;
+  BootStageRecord record(BootStage stage) const;
+
+  /**
+   * @brief True if the stage has not started yet and everything it depends on has finished.
+   */
+  bool ready(BootStage stage) const;
+
+  /**
+   * @brief Blocks the calling task until every stage in the mask has finished.
+   * @return False on timeout.
+   */
+  bool waitFor(uint32_t stages, TickType_t timeout = portMAX_DELAY);
+
+  /**
+   * @brief True once every stage has finished, failed or been skipped.
+   */
+  bool complete() const;
+
+  /**
+   * @brief Time from power-on until the last stage finished (or until now while boot is still running).
+   */
+  uint32_t totalMs() const;
+
+  /**
+   * @brief Prints one line per stage with its start, duration and result.
+   */
+  void logTimeline() const;
+
+  static const char* stageName(BootStage stage);
+  static const char* statusName(BootStageStatus status);
+
+private:
+  void settle(BootStage stage, BootStageStatus status, const char* note);
+
+  BootStageRecord _stages[BOOT_STAGE_COUNT];
+  EventGroupHandle_t _finished;
+  mutable portMUX_TYPE _mux;
+};
+
+#endif // BOOT_SEQUENCE_H
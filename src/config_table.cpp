@@ -0,0 +1,146 @@
+#include <Arduino.h>
+#include <FS.h>
+#include <SPIFFS.h>
+#include "config_table.h"
+#include "logger.h"
+
+#define CONFIG_VERSIONS_FILE "/config_versions.bin"
+
+ConfigTable configTable;
+
+void ConfigTable::begin() {
+  _versions.clear();
+  _nextId = 1;
+  forgetFlashLookups();
+
+  if (!SPIFFS.exists(CONFIG_VERSIONS_FILE)) {
+    LOG_INFO("No config version log found, starting empty.");
+    return;
+  }
+
+  File file = SPIFFS.open(CONFIG_VERSIONS_FILE, "r");
+  if (!file) {
+    LOG_ERROR("Failed to open config version log.");
+    return;
+  }
+
+  // Replay the log; the ring buffer keeps the newest MAX_CONFIG_VERSIONS entries
+  ConfigVersion entry;
+  size_t records = 0;
+  while (file.read((uint8_t*)&entry, sizeof(entry)) == sizeof(entry)) {
+    _versions.push(entry);
+    if (entry.id >= _nextId) {
+      _nextId = entry.id + 1;
+    }
+    records++;
+  }
+  file.close();
+  LOG_INFO("Config version log loaded: %d records, %d in RAM.", (int)records, (int)_versions.size());
+}
+
+uint16_t ConfigTable::publish(PowderConfig& config) {
+  if (config.id == CONFIG_ID_NONE) {
+    config.id = _nextId++;
+    config.version = 0;
+  }
+  config.version++;
+
+  ConfigVersion entry;
+  entry.id = config.id;
+  entry.version = config.version;
+  entry.config = config;
+  append(entry);
+
+  LOG_INFO("Published config '%s' as id %u version %u.", config.name, config.id, config.version);
+  return config.version;
+}
+
+const PowderConfig* ConfigTable::find(uint16_t id, uint16_t version) {
+  if (id == CONFIG_ID_NONE) {
+    return nullptr;
+  }
+
+  // Newest first: recent measurements almost always reference recent versions
+  for (size_t i = _versions.size(); i > 0; i--) {
+    const ConfigVersion& entry = _versions[i - 1];
+    if (entry.id == id && entry.version == version) {
+      return &entry.config;
+    }
+  }
+
+  // Ids are handed out in order, a newer one cannot be in the log
+  if (id >= _nextId || (id == _missId && version == _missVersion)) {
+    return nullptr;
+  }
+  for (size_t i = 0; i < _flashHitCount; i++) {
+    if (_flashHits[i].id == id && _flashHits[i].version == version) {
+      return &_flashHits[i].config;
+    }
+  }
+
+  File file = SPIFFS.open(CONFIG_VERSIONS_FILE, "r");
+  if (!file) {
+    return nullptr;
+  }
+  ConfigVersion entry;
+  bool found = false;
+  while (file.read((uint8_t*)&entry, sizeof(entry)) == sizeof(entry)) {
+    if (entry.id == id && entry.version == version) {
+      found = true;
+      break;
+    }
+  }
+  file.close();
+  if (!found) {
+    _missId = id;
+    _missVersion = version;
+    return nullptr;
+  }
+  ConfigVersion& slot = _flashHits[_nextFlashHit];
+  slot = entry;
+  if (_flashHitCount < CONFIG_FLASH_CACHE_SIZE) {
+    _flashHitCount++;
+  }
+  _nextFlashHit = (_nextFlashHit + 1) % CONFIG_FLASH_CACHE_SIZE;
+  return &slot.config;
+}
+
+bool ConfigTable::adopt(PowderConfig& config) {
+  if (config.id != CONFIG_ID_NONE && config.id >= _nextId) {
+    _nextId = config.id + 1;
+  }
+  if (config.id == CONFIG_ID_NONE || find(config.id, config.version) == nullptr) {
+    publish(config);
+    return true;
+  }
+  return false;
+}
+
+void ConfigTable::clear() {
+  _versions.clear();
+  _nextId = 1;
+  forgetFlashLookups();
+  SPIFFS.remove(CONFIG_VERSIONS_FILE);
+}
+
+void ConfigTable::append(const ConfigVersion& entry) {
+  _versions.push(entry);
+  _missId = CONFIG_ID_NONE; // It may be the one that was missing
+
+  File file = SPIFFS.open(CONFIG_VERSIONS_FILE, "a");
+  if (!file) {
+    LOG_ERROR("Failed to open config version log for writing");
+    return;
+  }
+  if (file.write((const uint8_t*)&entry, sizeof(entry)) != sizeof(entry)) {
+    LOG_ERROR("Failed to append to config version log");
+  }
+  file.close();
+}
+
+void ConfigTable::forgetFlashLookups() {
+  _flashHitCount = 0;
+  _nextFlashHit = 0;
+  _missId = CONFIG_ID_NONE;
+  _missVersion = 0;
+}
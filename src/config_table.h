@@ -0,0 +1,111 @@
+#ifndef CONFIG_TABLE_H
+#define CONFIG_TABLE_H
+
+#include <stdint.h>
+#include "ring_buffer.h"
+
+// ========================================
+// POWDER CONFIGURATIONS
+// ========================================
+struct PowderConfig {
+  char name[32];
+  char caliber[24];
+  char bulletWeight[10];
+  char powderName[24];
+  float targetGrain;
+  // New fields for per-config calibration
+  float potMinAdc;
+  float grainsPerMmFactor;
+  bool isCalibrated;
+  // Identity of the published snapshot this config corresponds to (see ConfigTable)
+  uint16_t id;      // Stable across edits, 0 = never published
+  uint16_t version; // Incremented on every edit
+};
+
+// Immutable snapshot of a configuration as it was at one point in time.
+// Measurements reference these by {id, version} instead of embedding a full copy.
+struct ConfigVersion {
+  uint16_t id;
+  uint16_t version;
+  PowderConfig config;
+};
+
+// Number of snapshots kept in RAM. Older ones are still found in the on-flash log.
+#ifndef MAX_CONFIG_VERSIONS
+  #define MAX_CONFIG_VERSIONS 32
+#endif
+
+// Snapshots read back from flash that are kept for the next lookups. Exports and
+// rollup replays walk the history in order, so consecutive rows share a version.
+#ifndef CONFIG_FLASH_CACHE_SIZE
+  #define CONFIG_FLASH_CACHE_SIZE 2
+#endif
+
+#define CONFIG_ID_NONE 0 // Measurement taken without an active configuration
+
+/**
+ * @brief Append-only table of interned configuration versions.
+ *
+ * Every edit of a PowderConfig is published as a new {id, version} snapshot.
+ * Snapshots are never modified, so historical measurements keep pointing at the
+ * exact target and calibration they were taken with. The table is persisted to
+ * SPIFFS as a log of fixed-size records.
+ */
+class ConfigTable
+{
+public:
+  ConfigTable() : _nextId(1) { forgetFlashLookups(); }
+
+  /**
+   * @brief Loads the recent snapshots from SPIFFS. Call after SPIFFS is mounted.
+   */
+  void begin();
+
+  /**
+   * @brief Publishes the current contents of a config as a new immutable version.
+   *        Assigns an id on first publish and bumps config.version.
+   * @return The new version number.
+   */
+  uint16_t publish(PowderConfig& config);
+
+  /**
+   * @brief Looks up a snapshot. Falls back to scanning the on-flash log for
+   *        versions that no longer fit in RAM; the last CONFIG_FLASH_CACHE_SIZE
+   *        found there, and the last one that was not, are remembered so a run
+   *        of lookups for the same old version scans the log only once.
+   * @return Pointer to the snapshot, or nullptr if unknown. The pointer is only
+   *         valid until the next call to find(), publish() or clear(); copy
+   *         what is needed before looking up another version.
+   */
+  const PowderConfig* find(uint16_t id, uint16_t version);
+
+  /**
+   * @brief Makes sure a config loaded from settings has a matching snapshot.
+   *        Configs from older settings files without an id are published here.
+   * @return True if a new version had to be published (settings need saving).
+   */
+  bool adopt(PowderConfig& config);
+
+  /**
+   * @brief Removes all snapshots from RAM and flash.
+   */
+  void clear();
+
+  size_t size() const { return _versions.size(); }
+
+private:
+  void append(const ConfigVersion& entry);
+  void forgetFlashLookups();
+
+  RingBuffer<ConfigVersion, MAX_CONFIG_VERSIONS> _versions;
+  ConfigVersion _flashHits[CONFIG_FLASH_CACHE_SIZE]; // Results read back from flash
+  size_t _flashHitCount;
+  size_t _nextFlashHit;  // Slot replaced by the next flash hit
+  uint16_t _missId;      // Last {id, version} found neither in RAM nor on flash
+  uint16_t _missVersion;
+  uint16_t _nextId;
+};
+
+extern ConfigTable configTable;
+
+#endif // CONFIG_TABLE_H
@@ -0,0 +1,227 @@
+// Generated by scripts/generate_digit_glyphs.py - do not edit.
+#ifndef DIGIT_GLYPHS_H
+#define DIGIT_GLYPHS_H
+
+#include <stdint.h>
+
+// Anti-aliased numerals for the weight readout, 4-bit UI palette indices,
+// two pixels per byte with the left pixel in the high nibble.
+#define DIGIT_GLYPH_WIDTH 18
+#define DIGIT_GLYPH_HEIGHT 28
+#define DIGIT_GLYPH_BYTES 252
+#define DIGIT_GLYPH_MINUS 10 // Index of '-' after the digits 0-9
+#define DIGIT_GLYPH_COUNT 11
+#define DOT_GLYPH_WIDTH 8
+
+static const uint8_t DIGIT_GLYPHS[DIGIT_GLYPH_COUNT][DIGIT_GLYPH_BYTES] = {
+  { // '0'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xBE, 0x11, 0xEB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8E, 0x11, 0x11,
+    0x11, 0xE8, 0x00, 0x00, 0x00, 0x00, 0xD1, 0x11, 0x11, 0x11, 0x1D, 0x00, 0x00, 0x00, 0x0B, 0x11,
+    0x1D, 0x99, 0xD1, 0x11, 0xB0, 0x00, 0x00, 0x81, 0x11, 0xD0, 0x00, 0x0D, 0x11, 0x18, 0x00, 0x00,
+    0xB1, 0x11, 0x80, 0x00, 0x08, 0x11, 0x1B, 0x00, 0x00, 0xE1, 0x1C, 0x00, 0x00, 0x00, 0xC1, 0x1E,
+    0x00, 0x08, 0x11, 0x19, 0x00, 0x00, 0x00, 0x91, 0x11, 0x80, 0x09, 0x11, 0x10, 0x00, 0x00, 0x00,
+    0x01, 0x11, 0x90, 0x0B, 0x11, 0xD0, 0x00, 0x00, 0x00, 0x0D, 0x11, 0xB0, 0x0B, 0x11, 0xD0, 0x00,
+    0x00, 0x00, 0x0D, 0x11, 0xB0, 0x0B, 0x11, 0xC0, 0x00, 0x00, 0x00, 0x0C, 0x11, 0xB0, 0x0B, 0x11,
+    0xC0, 0x00, 0x00, 0x00, 0x0C, 0x11, 0xB0, 0x0B, 0x11, 0xD0, 0x00, 0x00, 0x00, 0x0D, 0x11, 0xB0,
+    0x0B, 0x11, 0xD0, 0x00, 0x00, 0x00, 0x0D, 0x11, 0xB0, 0x09, 0x11, 0x10, 0x00, 0x00, 0x00, 0x01,
+    0x11, 0x90, 0x08, 0x11, 0x19, 0x00, 0x00, 0x00, 0x91, 0x11, 0x80, 0x00, 0xE1, 0x1C, 0x00, 0x00,
+    0x00, 0xC1, 0x1E, 0x00, 0x00, 0xB1, 0x11, 0x80, 0x00, 0x08, 0x11, 0x1B, 0x00, 0x00, 0x81, 0x11,
+    0xD0, 0x00, 0x0D, 0x11, 0x18, 0x00, 0x00, 0x0B, 0x11, 0x1D, 0x99, 0xD1, 0x11, 0xB0, 0x00, 0x00,
+    0x00, 0xD1, 0x11, 0x11, 0x11, 0x1D, 0x00, 0x00, 0x00, 0x00, 0x8E, 0x11, 0x11, 0x11, 0xE8, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xBE, 0x11, 0xEB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  },
+  { // '1'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0xD1, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9E, 0x11,
+    0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0A, 0x11, 0x11, 0x10, 0x00, 0x00, 0x00, 0x00, 0x08, 0xC1,
+    0x11, 0x11, 0x10, 0x00, 0x00, 0x00, 0x00, 0x0B, 0x11, 0x11, 0x11, 0x10, 0x00, 0x00, 0x00, 0x00,
+    0x0B, 0x11, 0xE8, 0x11, 0x10, 0x00, 0x00, 0x00, 0x00, 0x08, 0xBB, 0x80, 0x11, 0x10, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x10,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x11, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x11, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x10, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x11, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x10, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11,
+    0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x11, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x10, 0x00, 0x00, 0x00, 0x00,
+    0x09, 0x11, 0x11, 0x11, 0x11, 0x11, 0x19, 0x00, 0x00, 0x0B, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1B,
+    0x00, 0x00, 0x09, 0x11, 0x11, 0x11, 0x11, 0x11, 0x19, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  },
+  { // '2'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x08, 0xC1, 0x11, 0x1C, 0x80, 0x00, 0x00, 0x00, 0x00, 0xB1, 0x11, 0x11,
+    0x11, 0x1B, 0x00, 0x00, 0x00, 0x0B, 0x11, 0x11, 0x11, 0x11, 0x11, 0xB0, 0x00, 0x00, 0x91, 0x11,
+    0x1A, 0x99, 0xA1, 0x11, 0x18, 0x00, 0x00, 0xC1, 0x11, 0x80, 0x00, 0x08, 0x11, 0x1C, 0x00, 0x00,
+    0x11, 0x1A, 0x00, 0x00, 0x00, 0xA1, 0x11, 0x00, 0x00, 0x11, 0x18, 0x00, 0x00, 0x00, 0x91, 0x11,
+    0x00, 0x00, 0x9C, 0xA0, 0x00, 0x00, 0x00, 0x91, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xB1, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0x11, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x81, 0x11, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE1, 0x11, 0xA0, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x0C, 0x11, 0x1B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xA1, 0x11, 0xD0, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x09, 0x11, 0x1E, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8E, 0x11, 0x19, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xD1, 0x11, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x11, 0x1B,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xA1, 0x11, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0x11,
+    0x1E, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8E, 0x11, 0x19, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xD1, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1D, 0x00, 0x00, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+    0x00, 0x00, 0xD1, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  },
+  { // '3'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x08, 0xC1, 0x11, 0x1C, 0x80, 0x00, 0x00, 0x00, 0x00, 0xA1, 0x11, 0x11,
+    0x11, 0x1A, 0x00, 0x00, 0x00, 0x0A, 0x11, 0x11, 0x11, 0x11, 0x11, 0xA0, 0x00, 0x00, 0x81, 0x11,
+    0x1B, 0x99, 0xB1, 0x11, 0x18, 0x00, 0x00, 0x91, 0x11, 0x90, 0x00, 0x09, 0x11, 0x1B, 0x00, 0x00,
+    0x81, 0x1B, 0x00, 0x00, 0x00, 0xC1, 0x1D, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0xA1, 0x1D,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xB1, 0x1D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xE1, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8C, 0x11, 0x19, 0x00, 0x00, 0x00, 0x00, 0x08,
+    0xBD, 0x11, 0x11, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x0B, 0x11, 0x11, 0x1E, 0x80, 0x00, 0x00, 0x00,
+    0x00, 0x0B, 0x11, 0x11, 0x11, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x08, 0xBD, 0xE1, 0x11, 0x19, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0B, 0x11, 0x1D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xB1,
+    0x11, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x11, 0x90, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x00, 0x0E, 0x11, 0x90, 0x00, 0xB1, 0x18, 0x00, 0x00, 0x00, 0x81, 0x11, 0x90, 0x00, 0xD1, 0x1E,
+    0x80, 0x00, 0x08, 0xD1, 0x11, 0x00, 0x00, 0xB1, 0x11, 0xEA, 0x99, 0xAE, 0x11, 0x1B, 0x00, 0x00,
+    0x0D, 0x11, 0x11, 0x11, 0x11, 0x11, 0xD0, 0x00, 0x00, 0x08, 0xC1, 0x11, 0x11, 0x11, 0x1C, 0x80,
+    0x00, 0x00, 0x00, 0x09, 0xD1, 0x11, 0x1D, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  },
+  { // '4'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x91, 0x19, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xE1, 0x1B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0B, 0x11, 0x1B, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x81, 0x11, 0x1B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC1, 0x11, 0x1B, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x09, 0x11, 0x11, 0x1B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0D, 0x11, 0x11, 0x1B, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xA1, 0x11, 0xE1, 0x1B, 0x00, 0x00, 0x00, 0x00, 0x08, 0x11, 0x1D, 0xB1,
+    0x1B, 0x00, 0x00, 0x00, 0x00, 0x0B, 0x11, 0x19, 0xB1, 0x1B, 0x00, 0x00, 0x00, 0x00, 0x81, 0x11,
+    0xC0, 0xB1, 0x1B, 0x00, 0x00, 0x00, 0x00, 0xD1, 0x11, 0x80, 0xB1, 0x1B, 0x00, 0x00, 0x00, 0x0A,
+    0x11, 0x1B, 0x00, 0xB1, 0x1B, 0x00, 0x00, 0x00, 0x0E, 0x11, 0xE0, 0x00, 0xB1, 0x1B, 0x00, 0x00,
+    0x00, 0xB1, 0x11, 0xDB, 0xBB, 0xD1, 0x1D, 0xBB, 0x80, 0x00, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+    0x11, 0xB0, 0x00, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0xB0, 0x00, 0x9B, 0xBB, 0xBB, 0xBB,
+    0xD1, 0x1D, 0xBB, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0xB1, 0x1B, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xB1, 0x1B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xB1, 0x1B, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xB1, 0x1B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xB1, 0x1B, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x91, 0x19, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  },
+  { // '5'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x09, 0x11, 0x11, 0x11, 0x11, 0x11, 0x19, 0x00, 0x00, 0x0B, 0x11, 0x11, 0x11,
+    0x11, 0x11, 0x1B, 0x00, 0x00, 0x0D, 0x11, 0x11, 0x11, 0x11, 0x11, 0x19, 0x00, 0x00, 0x0D, 0x11,
+    0xB0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0D, 0x11, 0xB0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x0D, 0x11, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x11, 0x90, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x01, 0x11, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x11, 0xD1, 0x11, 0x1C,
+    0x80, 0x00, 0x00, 0x00, 0x01, 0x11, 0x11, 0x11, 0x11, 0x1A, 0x00, 0x00, 0x00, 0x01, 0x11, 0x11,
+    0x11, 0x11, 0x11, 0xA0, 0x00, 0x00, 0x0D, 0x11, 0x1B, 0x99, 0xB1, 0x11, 0x18, 0x00, 0x00, 0x09,
+    0x1E, 0x90, 0x00, 0x09, 0x11, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xB1, 0x11, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x81, 0x11, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+    0x11, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x11, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x81, 0x11, 0x90, 0x00, 0x0C, 0xDA, 0x00, 0x00, 0x00, 0xB1, 0x11, 0x00, 0x00, 0x91, 0x11,
+    0x90, 0x00, 0x09, 0x11, 0x1C, 0x00, 0x00, 0x81, 0x11, 0x1B, 0x99, 0xB1, 0x11, 0x18, 0x00, 0x00,
+    0x0A, 0x11, 0x11, 0x11, 0x11, 0x11, 0xA0, 0x00, 0x00, 0x00, 0xA1, 0x11, 0x11, 0x11, 0x1A, 0x00,
+    0x00, 0x00, 0x00, 0x08, 0xCE, 0x11, 0x1C, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  },
+  { // '6'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0D, 0x1D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xB1, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x11, 0x1D, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x0D, 0x11, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xA1, 0x11, 0xB0, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x08, 0xE1, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x11, 0x19, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x91, 0x11, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE1, 0x11, 0xB8,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x8D, 0x11, 0x11, 0x11, 0xC8, 0x00, 0x00, 0x00, 0x08, 0xE1, 0x11,
+    0x11, 0x11, 0x1E, 0x80, 0x00, 0x00, 0x0E, 0x11, 0x11, 0xDD, 0x11, 0x11, 0xE0, 0x00, 0x00, 0xB1,
+    0x11, 0x1A, 0x00, 0x0C, 0x11, 0x1B, 0x00, 0x00, 0xE1, 0x11, 0xD0, 0x00, 0x00, 0xD1, 0x1E, 0x00,
+    0x08, 0x11, 0x11, 0x80, 0x00, 0x00, 0x91, 0x11, 0x80, 0x09, 0x11, 0x1A, 0x00, 0x00, 0x00, 0x01,
+    0x11, 0x90, 0x09, 0x11, 0xE0, 0x00, 0x00, 0x00, 0x0E, 0x11, 0x90, 0x09, 0x11, 0x18, 0x00, 0x00,
+    0x00, 0x81, 0x11, 0x90, 0x00, 0x11, 0x1A, 0x00, 0x00, 0x00, 0xA1, 0x11, 0x00, 0x00, 0xD1, 0x11,
+    0x90, 0x00, 0x09, 0x11, 0x1D, 0x00, 0x00, 0x91, 0x11, 0x1B, 0x99, 0xB1, 0x11, 0x19, 0x00, 0x00,
+    0x0A, 0x11, 0x11, 0x11, 0x11, 0x11, 0xA0, 0x00, 0x00, 0x00, 0xA1, 0x11, 0x11, 0x11, 0x1A, 0x00,
+    0x00, 0x00, 0x00, 0x08, 0xC1, 0x11, 0x1C, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  },
+  { // '7'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xD1, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1D, 0x00, 0x00, 0x11, 0x11, 0x11, 0x11,
+    0x11, 0x11, 0x11, 0x00, 0x00, 0xD1, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1E, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xE1, 0x1B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0A, 0x11, 0x18, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x0C, 0x11, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x11, 0xA0,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xA1, 0x11, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xD1,
+    0x1D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x11, 0x1A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x0A, 0x11, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x11, 0xC0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x81, 0x11, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xB1, 0x1E, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xE1, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0x11, 0x19, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x11, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x11,
+    0xB0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xA1, 0x11, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xC1, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x1A, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x0A, 0x11, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0B, 0x11, 0xD0, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x09, 0x11, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  },
+  { // '8'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x08, 0xCE, 0x11, 0xEC, 0x80, 0x00, 0x00, 0x00, 0x00, 0x91, 0x11, 0x11,
+    0x11, 0x19, 0x00, 0x00, 0x00, 0x09, 0x11, 0x11, 0x11, 0x11, 0x11, 0x90, 0x00, 0x00, 0x0D, 0x11,
+    0x1B, 0x99, 0xB1, 0x11, 0xD0, 0x00, 0x00, 0x91, 0x11, 0xA0, 0x00, 0x0A, 0x11, 0x19, 0x00, 0x00,
+    0xB1, 0x1E, 0x00, 0x00, 0x00, 0xE1, 0x1B, 0x00, 0x00, 0xB1, 0x1C, 0x00, 0x00, 0x00, 0xC1, 0x1B,
+    0x00, 0x00, 0xB1, 0x1D, 0x00, 0x00, 0x00, 0xD1, 0x1B, 0x00, 0x00, 0xA1, 0x11, 0x80, 0x00, 0x08,
+    0x11, 0x1A, 0x00, 0x00, 0x81, 0x11, 0xE8, 0x00, 0x8E, 0x11, 0x18, 0x00, 0x00, 0x0B, 0x11, 0x11,
+    0xDD, 0x11, 0x11, 0xB0, 0x00, 0x00, 0x00, 0xD1, 0x11, 0x11, 0x11, 0x1D, 0x00, 0x00, 0x00, 0x0A,
+    0x11, 0x11, 0x11, 0x11, 0x11, 0xA0, 0x00, 0x00, 0x91, 0x11, 0x1E, 0xDD, 0xE1, 0x11, 0x19, 0x00,
+    0x00, 0xD1, 0x11, 0xB0, 0x00, 0x0B, 0x11, 0x1D, 0x00, 0x08, 0x11, 0x1B, 0x00, 0x00, 0x00, 0xB1,
+    0x11, 0x80, 0x09, 0x11, 0x10, 0x00, 0x00, 0x00, 0x01, 0x11, 0x90, 0x09, 0x11, 0xE0, 0x00, 0x00,
+    0x00, 0x0E, 0x11, 0x90, 0x09, 0x11, 0x18, 0x00, 0x00, 0x00, 0x81, 0x11, 0x90, 0x00, 0x11, 0x1D,
+    0x80, 0x00, 0x08, 0xD1, 0x11, 0x00, 0x00, 0xB1, 0x11, 0xEA, 0x99, 0xAE, 0x11, 0x1B, 0x00, 0x00,
+    0x0D, 0x11, 0x11, 0x11, 0x11, 0x11, 0xD0, 0x00, 0x00, 0x08, 0xC1, 0x11, 0x11, 0x11, 0x1C, 0x80,
+    0x00, 0x00, 0x00, 0x09, 0xD1, 0x11, 0x1D, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  },
+  { // '9'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x08, 0xC1, 0x11, 0x1C, 0x80, 0x00, 0x00, 0x00, 0x00, 0xA1, 0x11, 0x11,
+    0x11, 0x1A, 0x00, 0x00, 0x00, 0x0A, 0x11, 0x11, 0x11, 0x11, 0x11, 0xA0, 0x00, 0x00, 0x91, 0x11,
+    0x1B, 0x99, 0xB1, 0x11, 0x19, 0x00, 0x00, 0xD1, 0x11, 0x90, 0x00, 0x09, 0x11, 0x1D, 0x00, 0x00,
+    0x11, 0x1A, 0x00, 0x00, 0x00, 0xA1, 0x11, 0x00, 0x09, 0x11, 0x18, 0x00, 0x00, 0x00, 0x81, 0x11,
+    0x90, 0x09, 0x11, 0xE0, 0x00, 0x00, 0x00, 0x0E, 0x11, 0x90, 0x09, 0x11, 0x10, 0x00, 0x00, 0x00,
+    0xA1, 0x11, 0x90, 0x08, 0x11, 0x19, 0x00, 0x00, 0x08, 0x11, 0x11, 0x80, 0x00, 0xE1, 0x1D, 0x00,
+    0x00, 0x0D, 0x11, 0x1E, 0x00, 0x00, 0xB1, 0x11, 0xC0, 0x00, 0xA1, 0x11, 0x1B, 0x00, 0x00, 0x0E,
+    0x11, 0x11, 0xDD, 0x11, 0x11, 0xE0, 0x00, 0x00, 0x08, 0xE1, 0x11, 0x11, 0x11, 0x1E, 0x80, 0x00,
+    0x00, 0x00, 0x8C, 0x11, 0x11, 0x11, 0xD8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8B, 0x11, 0x1E, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x11, 0x19, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x91, 0x11,
+    0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE1, 0x1E, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0B,
+    0x11, 0x1A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x81, 0x11, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xD1, 0x11, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x1B, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xD1, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  },
+  { // '-'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x91, 0x11, 0x11, 0x11, 0x11, 0x11, 0x19, 0x00, 0x00, 0xB1,
+    0x11, 0x11, 0x11, 0x11, 0x11, 0x1B, 0x00, 0x00, 0x91, 0x11, 0x11, 0x11, 0x11, 0x11, 0x19, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  },
+};
+
+static const uint8_t DOT_GLYPH[DOT_GLYPH_WIDTH * DIGIT_GLYPH_HEIGHT / 2] = {
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x08, 0x80, 0x00, 0x00, 0xC1, 0x1C, 0x00, 0x08, 0x11, 0x11, 0x80, 0x08, 0x11, 0x11, 0x80,
+  0x00, 0xC1, 0x1C, 0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+#endif // DIGIT_GLYPHS_H
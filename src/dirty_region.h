@@ -0,0 +1,129 @@
+#ifndef DIRTY_REGION_H
+#define DIRTY_REGION_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ========================================
+// DIRTY RECTANGLE TRACKING
+// ========================================
+// Collects the screen areas that changed during one frame so only those are
+// redrawn in the sprite and pushed over SPI. Overlapping or touching
+// rectangles are merged, so the result is a small set of disjoint areas.
+
+struct DirtyRect {
+  int16_t x, y, w, h;
+
+  int32_t right() const { return x + w; }
+  int32_t bottom() const { return y + h; }
+  uint32_t area() const { return (uint32_t)w * (uint32_t)h; }
+
+  // True if the rectangles overlap or share an edge
+  bool touches(const DirtyRect& other) const {
+    return x <= other.right() && other.x <= right() && y <= other.bottom() && other.y <= bottom();
+  }
+
+  bool intersects(const DirtyRect& other) const {
+    return x < other.right() && other.x < right() && y < other.bottom() && other.y < bottom();
+  }
+
+  DirtyRect united(const DirtyRect& other) const {
+    int32_t l = x < other.x ? x : other.x;
+    int32_t t = y < other.y ? y : other.y;
+    int32_t r = right() > other.right() ? right() : other.right();
+    int32_t b = bottom() > other.bottom() ? bottom() : other.bottom();
+    return { (int16_t)l, (int16_t)t, (int16_t)(r - l), (int16_t)(b - t) };
+  }
+
+  DirtyRect intersected(const DirtyRect& other) const {
+    int32_t l = x > other.x ? x : other.x;
+    int32_t t = y > other.y ? y : other.y;
+    int32_t r = right() < other.right() ? right() : other.right();
+    int32_t b = bottom() < other.bottom() ? bottom() : other.bottom();
+    if (r <= l || b <= t) {
+      return { 0, 0, 0, 0 };
+    }
+    return { (int16_t)l, (int16_t)t, (int16_t)(r - l), (int16_t)(b - t) };
+  }
+};
+
+// Maximum number of separate rectangles per frame. When exceeded, the new
+// rectangle is merged into whichever existing one grows the least.
+#ifndef DIRTY_REGION_MAX_RECTS
+  #define DIRTY_REGION_MAX_RECTS 8
+#endif
+
+class DirtyRegion
+{
+public:
+  DirtyRegion() : _count(0) {}
+
+  void clear() { _count = 0; }
+
+  /**
+   * @brief Adds an area to the region. Empty rectangles are ignored.
+   */
+  void add(const DirtyRect& rect) {
+    if (rect.w <= 0 || rect.h <= 0) {
+      return;
+    }
+
+    DirtyRect merged = rect;
+    // Absorb every rectangle the new one touches; repeat because the grown
+    // rectangle may now touch others that were disjoint before
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (size_t i = 0; i < _count; i++) {
+        if (merged.touches(_rects[i])) {
+          merged = merged.united(_rects[i]);
+          _rects[i] = _rects[--_count];
+          changed = true;
+          break;
+        }
+      }
+    }
+
+    if (_count < DIRTY_REGION_MAX_RECTS) {
+      _rects[_count++] = merged;
+      return;
+    }
+
+    // Full: fold into the rectangle whose bounding box grows the least
+    size_t best = 0;
+    uint32_t bestGrowth = UINT32_MAX;
+    for (size_t i = 0; i < _count; i++) {
+      uint32_t growth = _rects[i].united(merged).area() - _rects[i].area();
+      if (growth < bestGrowth) {
+        bestGrowth = growth;
+        best = i;
+      }
+    }
+    merged = _rects[best].united(merged);
+    _rects[best] = _rects[--_count];
+    add(merged);
+  }
+
+  void add(int32_t x, int32_t y, int32_t w, int32_t h) {
+    add(DirtyRect{ (int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h });
+  }
+
+  size_t size() const { return _count; }
+  bool empty() const { return _count == 0; }
+  const DirtyRect& operator[](size_t index) const { return _rects[index]; }
+
+  // Total number of pixels covered (rectangles are disjoint)
+  uint32_t pixelCount() const {
+    uint32_t total = 0;
+    for (size_t i = 0; i < _count; i++) {
+      total += _rects[i].area();
+    }
+    return total;
+  }
+
+private:
+  DirtyRect _rects[DIRTY_REGION_MAX_RECTS];
+  size_t _count;
+};
+
+#endif // DIRTY_REGION_H
@@ -0,0 +1,184 @@
+#include <Arduino.h>
+#include <Preferences.h>
+#include "display_clock.h"
+#include "ui_palette.h"
+#include "logger.h"
+
+#define DISPLAY_CLOCK_NVS_NAMESPACE "display"
+
+// SPI clocks the C6 can generate exactly (80 MHz APB / n), slowest first
+static const uint32_t CANDIDATE_CLOCKS[] = { 10000000, 16000000, 20000000, 26666667, 40000000, 80000000 };
+
+// Text line for the throughput test, one screen width of size 1 characters
+static const char TEXT_LINE[] = "The quick brown fox jumps over the lazy dog 012345678";
+
+DisplayClockTuner::DisplayClockTuner()
+  : _boardName(""), _frequency(0), _tuned(false) {
+  memset(&_lastSweep, 0, sizeof(_lastSweep));
+}
+
+uint32_t DisplayClockTuner::begin(const char* boardName, uint32_t fallback) {
+  _boardName = boardName;
+  _frequency = fallback;
+  _tuned = false;
+
+  Preferences prefs;
+  if (prefs.begin(DISPLAY_CLOCK_NVS_NAMESPACE, true)) {
+    String board = prefs.getString("board", "");
+    uint32_t frequency = prefs.getUInt("spiHz", 0);
+    prefs.end();
+    if (board == boardName && frequency > 0) {
+      _frequency = frequency;
+      _tuned = true;
+    }
+  }
+
+  if (_tuned) {
+    LOG_INFO("Display SPI clock: %.1f MHz (saved)", _frequency / 1e6f);
+  } else {
+    LOG_WARN("Display SPI clock: %.1f MHz, not tuned for this board yet", _frequency / 1e6f);
+  }
+  return _frequency;
+}
+
+const DisplayClockSweepResult& DisplayClockTuner::sweep(lgfx::LGFX_Device& panel, LGFX_Sprite& canvas,
+                                                        DisplayPipeline& pipeline, DisplayClockSetter setter) {
+  uint32_t start = millis();
+  memset(&_lastSweep, 0, sizeof(_lastSweep));
+  pipeline.flush();
+
+  const DisplayClockMeasurement* best = nullptr;
+  const DisplayClockMeasurement* margin = nullptr; // The stable clock before best
+  for (size_t i = 0; i < sizeof(CANDIDATE_CLOCKS) / sizeof(CANDIDATE_CLOCKS[0]); i++) {
+    if (CANDIDATE_CLOCKS[i] > DISPLAY_SPI_FREQ_MAX || _lastSweep.count >= DISPLAY_CLOCK_MAX_CANDIDATES) {
+      break;
+    }
+    DisplayClockMeasurement& m = _lastSweep.clocks[_lastSweep.count++];
+    m.frequency = CANDIDATE_CLOCKS[i];
+    setter(m.frequency);
+    measure(panel, canvas, pipeline, m);
+
+    bool faster = best == nullptr || m.frameMs < best->frameMs * (1.0f - DISPLAY_CLOCK_MIN_SPEEDUP);
+    m.stable = m.jitter <= DISPLAY_CLOCK_MAX_JITTER && faster;
+    Serial.printf("Display clock %.1f MHz: fill %.1f Mpx/s, frame %.1f ms (jitter %.0f%%), text %.0f chars/s, "
+                  "wire efficiency %.0f%% -> %s\n",
+                  m.frequency / 1e6f, m.fillMpixelsPerS, m.frameMs, m.jitter * 100.0f, m.textCharsPerS,
+                  m.wireEfficiency * 100.0f, m.stable ? "ok" : (faster ? "unstable" : "no gain"));
+    if (!m.stable) {
+      break; // Faster clocks will not do better
+    }
+    margin = best;
+    best = &m;
+  }
+
+  // Back off one step from the fastest clock that passed; if only the slowest
+  // candidate passed there is nothing below it to fall back to
+  _lastSweep.fastestStable = best != nullptr ? best->frequency : 0;
+  if (margin != nullptr) {
+    _lastSweep.selected = margin->frequency;
+  } else {
+    _lastSweep.selected = best != nullptr ? best->frequency : _frequency;
+  }
+  _frequency = _lastSweep.selected;
+  _tuned = true;
+  setter(_frequency);
+  save();
+
+  panel.fillScreen(TFT_BLACK);
+  canvas.fillScreen(UI_BLACK);
+  _lastSweep.durationMs = millis() - start;
+  LOG_INFO("Display clock sweep: %.1f MHz selected (fastest stable %.1f MHz) in %lu ms", _frequency / 1e6f,
+           _lastSweep.fastestStable / 1e6f, (unsigned long)_lastSweep.durationMs);
+  return _lastSweep;
+}
+
+void DisplayClockTuner::setFixed(uint32_t frequency, DisplayClockSetter setter) {
+  _frequency = frequency;
+  _tuned = true;
+  setter(frequency);
+  save();
+  LOG_INFO("Display SPI clock fixed at %.1f MHz", frequency / 1e6f);
+}
+
+void DisplayClockTuner::measure(lgfx::LGFX_Device& panel, LGFX_Sprite& canvas, DisplayPipeline& pipeline,
+                                DisplayClockMeasurement& out) {
+  uint32_t pixels = (uint32_t)panel.width() * panel.height();
+
+  // Fill rate; 0x5555 / 0xAAAA toggle the data line on every bit
+  panel.startWrite();
+  uint32_t start = micros();
+  for (int i = 0; i < DISPLAY_CLOCK_REPEATS; i++) {
+    panel.fillScreen((i & 1) ? 0xAAAA : 0x5555);
+  }
+  uint32_t fillUs = micros() - start;
+  panel.endWrite();
+  out.fillMpixelsPerS = fillUs > 0 ? (float)pixels * DISPLAY_CLOCK_REPEATS / fillUs : 0.0f;
+
+  // Text throughput, a screenful of size 1 lines
+  uint32_t chars = 0;
+  panel.setTextSize(1);
+  panel.setTextColor(TFT_WHITE, TFT_BLACK);
+  panel.startWrite();
+  start = micros();
+  for (int32_t y = 0; y + 8 <= panel.height(); y += 8) {
+    panel.setCursor(0, y);
+    chars += panel.print(TEXT_LINE);
+  }
+  uint32_t textUs = micros() - start;
+  panel.endWrite();
+  out.textCharsPerS = textUs > 0 ? chars * 1e6f / textUs : 0.0f;
+
+  // Full frames through the DMA pipeline, the way the display task sends them.
+  // Drawn last so the pattern stays up while the next clock is set.
+  drawPattern(canvas, out.frequency);
+  DirtyRegion screen;
+  screen.add(0, 0, canvas.width(), canvas.height());
+  uint32_t fastest = UINT32_MAX;
+  uint32_t slowest = 0;
+  uint64_t totalUs = 0;
+  for (int i = 0; i < DISPLAY_CLOCK_REPEATS; i++) {
+    pipeline.submit(screen);
+    pipeline.flush();
+    uint32_t frameUs = pipeline.stats().frameUs;
+    fastest = min(fastest, frameUs);
+    slowest = max(slowest, frameUs);
+    totalUs += frameUs;
+  }
+  float meanUs = (float)totalUs / DISPLAY_CLOCK_REPEATS;
+  out.frameMs = meanUs / 1000.0f;
+  out.jitter = meanUs > 0 ? (slowest - fastest) / meanUs : 0.0f;
+  float wireUs = screen.pixelCount() * 16.0f * 1e6f / out.frequency;
+  out.wireEfficiency = meanUs > 0 ? wireUs / meanUs : 0.0f;
+}
+
+void DisplayClockTuner::drawPattern(LGFX_Sprite& canvas, uint32_t frequency) {
+  static const uint8_t bars[] = { UI_WHITE, UI_RED, UI_GREEN, UI_BLUE, UI_CYAN, UI_ORANGE, UI_DARKGREY, UI_BLACK };
+  int32_t width = canvas.width();
+  int32_t height = canvas.height();
+  int32_t barHeight = height * 2 / 3;
+  int32_t barWidth = width / (int32_t)sizeof(bars);
+
+  canvas.fillScreen(UI_BLACK);
+  for (size_t i = 0; i < sizeof(bars); i++) {
+    canvas.fillRect(i * barWidth, 0, barWidth, barHeight, bars[i]);
+  }
+  // One-pixel columns: every pixel differs from its neighbour
+  for (int32_t x = 0; x < width; x += 2) {
+    canvas.drawFastVLine(x, barHeight, height - barHeight - 20, UI_WHITE);
+  }
+  canvas.setTextSize(2);
+  canvas.setTextColor(UI_WHITE);
+  canvas.setCursor(4, height - 18);
+  canvas.printf("SPI %.1f MHz", frequency / 1e6f);
+}
+
+void DisplayClockTuner::save() {
+  Preferences prefs;
+  if (!prefs.begin(DISPLAY_CLOCK_NVS_NAMESPACE, false)) {
+    LOG_ERROR("Display clock: failed to open NVS, clock not saved.");
+    return;
+  }
+  prefs.putString("board", _boardName);
+  prefs.putUInt("spiHz", _frequency);
+  prefs.end();
+}
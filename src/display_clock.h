@@ -0,0 +1,111 @@
+#ifndef DISPLAY_CLOCK_H
+#define DISPLAY_CLOCK_H
+
+#define LGFX_USE_V1
+#include <LovyanGFX.hpp>
+#include "display_pipeline.h"
+
+// ========================================
+// SPI CLOCK SWEEP AND AUTO-TUNING
+// ========================================
+// The panel is wired without MISO, so nothing can be read back to check a
+// clock. Instead each candidate clock is judged by what the bus delivers:
+// a full-frame push is timed several times, and a clock counts as stable if
+// those times agree and the push is clearly faster than at the previous
+// clock. Above the fastest useful clock the wiring or the band copy is the
+// limit, so the sweep stops there. Every clock also shows a test pattern
+// with its frequency (colour bars and alternating-bit stripes), so glitches
+// can be spotted on screen while the sweep runs.
+//
+// Timing cannot see bit errors on the wire, so the fastest clock that passes
+// is not trusted as is: the sweep keeps one step below it. The sweep only
+// runs on request, with someone watching the patterns; an untuned board
+// stays at DISPLAY_SPI_FREQ_WRITE. The chosen clock is kept in NVS together
+// with the board name and applied at boot.
+
+// Fastest clock tried. The ST7789 write cycle is 16 ns (62.5 MHz), so the
+// next step the C6 can generate from its 80 MHz APB clock is out of spec.
+#ifndef DISPLAY_SPI_FREQ_MAX
+  #define DISPLAY_SPI_FREQ_MAX 40000000
+#endif
+
+// Full-frame pushes timed per clock
+#ifndef DISPLAY_CLOCK_REPEATS
+  #define DISPLAY_CLOCK_REPEATS 3
+#endif
+
+#define DISPLAY_CLOCK_MAX_CANDIDATES 8
+#define DISPLAY_CLOCK_MAX_JITTER 0.15f     // Spread of the repeated frame times, relative to their mean
+#define DISPLAY_CLOCK_MIN_SPEEDUP 0.05f    // Required frame time gain over the previous clock
+
+struct DisplayClockMeasurement {
+  uint32_t frequency;
+  float fillMpixelsPerS;  // fillScreen straight to the panel
+  float frameMs;          // Full canvas through the DMA pipeline, mean of the repeats
+  float jitter;           // (slowest - fastest) / mean frame time
+  float textCharsPerS;    // Size 1 text straight to the panel
+  float wireEfficiency;   // Theoretical wire time / measured frame time
+  bool stable;
+};
+
+struct DisplayClockSweepResult {
+  uint8_t count;
+  DisplayClockMeasurement clocks[DISPLAY_CLOCK_MAX_CANDIDATES];
+  uint32_t fastestStable; // Fastest clock that passed, 0 if none did
+  uint32_t selected;      // One step below fastestStable, now applied and saved
+  uint32_t durationMs;
+};
+
+typedef void (*DisplayClockSetter)(uint32_t frequency);
+
+/**
+ * @brief Finds, stores and restores an SPI write clock for the panel, one step below the fastest stable one.
+ */
+class DisplayClockTuner
+{
+public:
+  DisplayClockTuner();
+
+  /**
+   * @brief Loads the saved clock for this board from NVS.
+   * @param boardName Identifies the wiring; a clock saved by another board is ignored.
+   * @param fallback Clock to use if none is saved.
+   * @return The clock to apply.
+   */
+  uint32_t begin(const char* boardName, uint32_t fallback);
+
+  /**
+   * @brief True if a clock has been saved for this board by a sweep or setFixed().
+   */
+  bool tuned() const { return _tuned; }
+
+  uint32_t frequency() const { return _frequency; }
+
+  /**
+   * @brief Measures every candidate clock, applies and saves the one below the fastest stable one.
+   *        Blocks for a second or two and leaves the panel and canvas black;
+   *        the caller must redraw. Only call from the task that owns the display.
+   */
+  const DisplayClockSweepResult& sweep(lgfx::LGFX_Device& panel, LGFX_Sprite& canvas, DisplayPipeline& pipeline,
+                                       DisplayClockSetter setter);
+
+  /**
+   * @brief Saves a fixed clock instead of the tuned one, e.g. if the sweep's choice shows glitches.
+   */
+  void setFixed(uint32_t frequency, DisplayClockSetter setter);
+
+  const DisplayClockSweepResult& lastSweep() const { return _lastSweep; }
+
+private:
+  void measure(lgfx::LGFX_Device& panel, LGFX_Sprite& canvas, DisplayPipeline& pipeline,
+               DisplayClockMeasurement& out);
+  void drawPattern(LGFX_Sprite& canvas, uint32_t frequency);
+  void save();
+
+  const char* _boardName;
+  uint32_t _frequency;
+  bool _tuned;
+  DisplayClockSweepResult _lastSweep;
+};
+
+#endif // DISPLAY_CLOCK_H
@@ -0,0 +1,249 @@
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include "display_pipeline.h"
+#include "logger.h"
+
+DisplayPipeline displayPipeline;
+
+DisplayPipeline::DisplayPipeline()
+  : _panel(nullptr), _canvas(nullptr), _spiFrequency(0), _canvasBits(16), _nextBand(0), _pendingReady(false),
+    _rectIndex(0), _rectRow(0), _active(false), _frameStartUs(0), _cpuUs(0), _bytes(0),
+    _bandCount(0), _callback(nullptr) {
+  memset(_bands, 0, sizeof(_bands));
+  memset(&_stats, 0, sizeof(_stats));
+}
+
+bool DisplayPipeline::begin(lgfx::LGFX_Device& panel, LGFX_Sprite& canvas, uint32_t spiFrequency) {
+  _panel = &panel;
+  _canvas = &canvas;
+  _spiFrequency = spiFrequency;
+
+  // Indexed canvases are expanded through a lookup table of panel-order RGB565 values
+  _canvasBits = canvas.getColorDepth() & lgfx::bit_mask;
+  memset(_palette, 0, sizeof(_palette));
+  if (canvas.getColorDepth() & lgfx::has_palette) {
+    const lgfx::bgr888_t* palette = canvas.getPalette();
+    size_t entries = canvas.getPaletteCount();
+    for (size_t i = 0; i < entries && i < 16; i++) {
+      _palette[i] = lgfx::swap565(palette[i].r, palette[i].g, palette[i].b);
+    }
+  }
+  if (_canvasBits != 16 && _canvasBits != 4) {
+    LOG_WARN("Display pipeline: unsupported canvas depth %d, falling back to blocking pushes.", _canvasBits);
+    return false;
+  }
+
+  for (int i = 0; i < 2; i++) {
+    if (_bands[i].pixels == nullptr) {
+      _bands[i].pixels = (uint16_t*)heap_caps_malloc(DISPLAY_BAND_PIXELS * sizeof(uint16_t), MALLOC_CAP_DMA);
+    }
+    if (_bands[i].pixels == nullptr) {
+      LOG_ERROR("Failed to allocate display DMA band buffers, falling back to blocking pushes.");
+      return false;
+    }
+  }
+  LOG_INFO("Display pipeline ready: 2 x %d byte DMA bands", (int)(DISPLAY_BAND_PIXELS * sizeof(uint16_t)));
+  return true;
+}
+
+bool DisplayPipeline::submit(const DirtyRegion& region) {
+  if (_active) {
+    return false;
+  }
+  if (region.empty()) {
+    return true;
+  }
+  if (_bands[0].pixels == nullptr || _bands[1].pixels == nullptr) {
+    pushBlocking(region);
+    return true;
+  }
+
+  _region = region;
+  _rectIndex = 0;
+  _rectRow = _region[0].y;
+  _nextBand = 0;
+  _frameStartUs = micros();
+  _cpuUs = 0;
+  _bytes = 0;
+  _bandCount = 0;
+  _active = true;
+
+  uint32_t start = micros();
+  _panel->startWrite();
+  _pendingReady = prepareBand();
+  _cpuUs += micros() - start;
+
+  service(); // Kick off the first transfer right away
+  return true;
+}
+
+void DisplayPipeline::service() {
+  if (!_active || _panel->dmaBusy()) {
+    return;
+  }
+
+  uint32_t start = micros();
+  if (_pendingReady) {
+    startBand();
+    // Fill the other band while this one is on the wire
+    _pendingReady = prepareBand();
+    _cpuUs += micros() - start;
+  } else {
+    _cpuUs += micros() - start;
+    finishFrame();
+  }
+}
+
+void DisplayPipeline::flush() {
+  while (_active) {
+    service();
+  }
+}
+
+bool DisplayPipeline::prepareBand() {
+  // Skip to the next rectangle once the current one has been copied completely
+  while (_rectIndex < _region.size() && _rectRow >= _region[_rectIndex].bottom()) {
+    _rectIndex++;
+    if (_rectIndex < _region.size()) {
+      _rectRow = _region[_rectIndex].y;
+    }
+  }
+  if (_rectIndex >= _region.size()) {
+    return false;
+  }
+
+  const DirtyRect& rect = _region[_rectIndex];
+  int rows = DISPLAY_BAND_PIXELS / rect.w;
+  if (rows < 1) {
+    rows = 1; // Cannot happen for widths up to DISPLAY_BAND_PIXELS
+  }
+  if (rows > rect.bottom() - _rectRow) {
+    rows = rect.bottom() - _rectRow;
+  }
+
+  Band& band = _bands[_nextBand];
+  band.x = rect.x;
+  band.y = _rectRow;
+  band.w = rect.w;
+  band.h = rows;
+
+  if (_canvasBits == 16) {
+    // Canvas pixels are already stored in panel byte order, so rows are copied as-is
+    const uint16_t* source = (const uint16_t*)_canvas->getBuffer();
+    int32_t stride = _canvas->width();
+    for (int row = 0; row < rows; row++) {
+      memcpy(band.pixels + row * rect.w, source + (band.y + row) * stride + rect.x, rect.w * sizeof(uint16_t));
+    }
+  } else {
+    // 4-bit palette: two pixels per byte, left pixel in the high nibble, rows padded to even widths
+    const uint8_t* source = (const uint8_t*)_canvas->getBuffer();
+    int32_t strideBytes = (_canvas->width() + 1) >> 1;
+    for (int row = 0; row < rows; row++) {
+      const uint8_t* in = source + (band.y + row) * strideBytes + (rect.x >> 1);
+      uint16_t* out = band.pixels + row * rect.w;
+      int remaining = rect.w;
+      if (rect.x & 1) {
+        *out++ = _palette[*in++ & 0x0F];
+        remaining--;
+      }
+      for (; remaining >= 2; remaining -= 2) {
+        uint8_t pair = *in++;
+        *out++ = _palette[pair >> 4];
+        *out++ = _palette[pair & 0x0F];
+      }
+      if (remaining) {
+        *out = _palette[*in >> 4];
+      }
+    }
+  }
+
+  _rectRow += rows;
+  return true;
+}
+
+void DisplayPipeline::startBand() {
+  Band& band = _bands[_nextBand];
+  _panel->pushImageDMA(band.x, band.y, band.w, band.h, (const lgfx::swap565_t*)band.pixels);
+  _bytes += (uint32_t)band.w * band.h * sizeof(uint16_t);
+  _bandCount++;
+  _nextBand ^= 1;
+}
+
+void DisplayPipeline::finishFrame() {
+  _panel->endWrite();
+  _active = false;
+
+  _stats.frames++;
+  _stats.frameUs = micros() - _frameStartUs;
+  _stats.cpuUs = _cpuUs;
+  _stats.bytes = _bytes;
+  _stats.bands = _bandCount;
+
+  if (_callback != nullptr) {
+    _callback(_stats);
+  }
+}
+
+void DisplayPipeline::pushBlocking(const DirtyRegion& region) {
+  uint32_t start = micros();
+  for (size_t i = 0; i < region.size(); i++) {
+    const DirtyRect& rect = region[i];
+    _panel->setClipRect(rect.x, rect.y, rect.w, rect.h);
+    _canvas->pushSprite(_panel, 0, 0);
+  }
+  _panel->clearClipRect();
+
+  _stats.frames++;
+  _stats.frameUs = micros() - start;
+  _stats.cpuUs = _stats.frameUs;
+  _stats.bytes = region.pixelCount() * sizeof(uint16_t);
+  _stats.bands = region.size();
+  if (_callback != nullptr) {
+    _callback(_stats);
+  }
+}
+
+DisplayBenchmarkResult DisplayPipeline::runBenchmark(uint16_t frames) {
+  DisplayBenchmarkResult result;
+  memset(&result, 0, sizeof(result));
+  if (_panel == nullptr || frames == 0) {
+    return result;
+  }
+  flush();
+
+  DirtyRegion screen;
+  screen.add(0, 0, _canvas->width(), _canvas->height());
+  result.frames = frames;
+  result.pixelsPerFrame = screen.pixelCount();
+
+  // Blocking push, the way every frame used to be sent
+  uint32_t start = micros();
+  for (uint16_t i = 0; i < frames; i++) {
+    _canvas->pushSprite(_panel, 0, 0);
+  }
+  result.blockingFrameMs = (micros() - start) / 1000.0f / frames;
+
+  // DMA pipeline; the time not spent inside the pipeline is free for the loop
+  uint64_t totalUs = 0;
+  uint64_t cpuUs = 0;
+  for (uint16_t i = 0; i < frames; i++) {
+    submit(screen);
+    flush();
+    totalUs += _stats.frameUs;
+    cpuUs += _stats.cpuUs;
+  }
+  result.asyncFrameMs = totalUs / 1000.0f / frames;
+  if (totalUs > 0) {
+    result.cpuIdlePercent = 100.0f * (1.0f - (float)cpuUs / totalUs);
+  }
+  if (_spiFrequency > 0 && result.asyncFrameMs > 0) {
+    float wireMs = result.pixelsPerFrame * 16.0f * 1000.0f / _spiFrequency;
+    result.busUtilization = wireMs / result.asyncFrameMs;
+  }
+
+  Serial.printf("Display benchmark (%u frames, %u px): blocking %.1f ms/frame, DMA %.1f ms/frame, "
+                "CPU idle %.0f%%, bus utilization %.0f%%\n",
+                result.frames, result.pixelsPerFrame, result.blockingFrameMs, result.asyncFrameMs,
+                result.cpuIdlePercent, result.busUtilization * 100.0f);
+  return result;
+}
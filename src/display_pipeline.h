@@ -0,0 +1,135 @@
+#ifndef DISPLAY_PIPELINE_H
+#define DISPLAY_PIPELINE_H
+
+#define LGFX_USE_V1
+#include <LovyanGFX.hpp>
+#include "dirty_region.h"
+
+// ========================================
+// ASYNCHRONOUS DISPLAY PUSH
+// ========================================
+// Streams areas of the canvas sprite to the panel with SPI DMA instead of a
+// blocking pushSprite. Pixels are copied out of the canvas into one of two
+// small band buffers; while the DMA engine sends one band the CPU fills the
+// other. service() is called from loop() and only does work when the DMA
+// engine is idle, so the measurement loop keeps running during a push.
+//
+// Two full-screen RGB565 sprites would need 2 x 110 KB, which the C6 cannot
+// spare next to Wi-Fi, so the second buffer is a pair of bands instead.
+// The canvas may be 16-bit RGB565 or a 4-bit palette sprite; palette indices
+// are expanded to RGB565 while a band is filled.
+
+// Pixels per band buffer (each band is twice this in bytes)
+#ifndef DISPLAY_BAND_PIXELS
+  #define DISPLAY_BAND_PIXELS (320 * 20)
+#endif
+
+struct DisplayFrameStats {
+  uint32_t frames;       // Frames completed since boot
+  uint32_t frameUs;      // Last frame, submit() to last band sent
+  uint32_t cpuUs;        // Last frame, CPU time spent copying bands and starting DMA
+  uint32_t bytes;        // Last frame, bytes sent over SPI
+  uint32_t bands;        // Last frame, DMA transfers issued
+};
+
+struct DisplayBenchmarkResult {
+  uint16_t frames;
+  uint32_t pixelsPerFrame;
+  float blockingFrameMs;  // pushSprite, CPU blocked for the whole transfer
+  float asyncFrameMs;     // DMA pipeline, submit() to completion
+  float cpuIdlePercent;   // Share of the async frame the CPU was free for other work
+  float busUtilization;   // Theoretical wire time at the configured clock / async frame time
+};
+
+typedef void (*DisplayFrameCallback)(const DisplayFrameStats& stats);
+
+/**
+ * @brief Double-buffered DMA push of dirty canvas areas.
+ */
+class DisplayPipeline
+{
+public:
+  DisplayPipeline();
+
+  /**
+   * @brief Allocates the DMA band buffers and captures the canvas palette.
+   *        Call after the canvas sprite has been created.
+   * @param spiFrequency Configured SPI write clock, used for bus utilization figures.
+   * @return False if the buffers could not be allocated; submit() then pushes blocking.
+   */
+  bool begin(lgfx::LGFX_Device& panel, LGFX_Sprite& canvas, uint32_t spiFrequency);
+
+  /**
+   * @brief Starts pushing the given canvas areas. Returns immediately.
+   *        The canvas must not be drawn into until busy() returns false.
+   * @return False if a frame is still in flight.
+   */
+  bool submit(const DirtyRegion& region);
+
+  /**
+   * @brief Advances the transfer: starts the next band once the DMA engine is idle
+   *        and prepares the one after it. Call as often as possible.
+   */
+  void service();
+
+  /**
+   * @brief Blocks until the frame in flight has been sent.
+   */
+  void flush();
+
+  bool busy() const { return _active; }
+
+  /**
+   * @brief Called from service() whenever a frame has been completely sent.
+   */
+  void onFrameComplete(DisplayFrameCallback callback) { _callback = callback; }
+
+  const DisplayFrameStats& stats() const { return _stats; }
+
+  /**
+   * @brief Updates the SPI clock used for bus utilization figures after the clock was changed.
+   */
+  void setSpiFrequency(uint32_t spiFrequency) { _spiFrequency = spiFrequency; }
+
+  /**
+   * @brief Pushes the full canvas a number of times, first blocking then through
+   *        the DMA pipeline, and measures both. Blocks for the duration.
+   */
+  DisplayBenchmarkResult runBenchmark(uint16_t frames);
+
+private:
+  bool prepareBand();
+  void startBand();
+  void finishFrame();
+  void pushBlocking(const DirtyRegion& region);
+
+  struct Band {
+    uint16_t* pixels; // Byte-swapped RGB565, as the panel expects
+    int16_t x, y, w, h;
+  };
+
+  lgfx::LGFX_Device* _panel;
+  LGFX_Sprite* _canvas;
+  uint32_t _spiFrequency;
+  uint8_t _canvasBits;    // 16 (RGB565) or 4 (palette)
+  uint16_t _palette[16];  // Palette index -> panel-order RGB565
+  Band _bands[2];
+  uint8_t _nextBand;     // Band that is filled next
+  bool _pendingReady;    // The other band is filled and waiting for the DMA engine
+
+  DirtyRegion _region;   // Copy of the frame in flight
+  size_t _rectIndex;     // Rectangle being copied into bands
+  int16_t _rectRow;      // Next row of that rectangle
+  bool _active;
+
+  uint32_t _frameStartUs;
+  uint32_t _cpuUs;
+  uint32_t _bytes;
+  uint32_t _bandCount;
+  DisplayFrameStats _stats;
+  DisplayFrameCallback _callback;
+};
+
+extern DisplayPipeline displayPipeline;
+
+#endif // DISPLAY_PIPELINE_H
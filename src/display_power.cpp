@@ -0,0 +1,97 @@
+#include <Arduino.h>
+#include "display_power.h"
+#include "logger.h"
+
+DisplayPowerPolicy::DisplayPowerPolicy()
+  : _mode(DISPLAY_POWER_ACTIVE), _modeSinceMs(0), _lastActivityMs(0), _reference(0), _hasReference(false) {
+  _settings.activeIntervalMs = 100;
+  _settings.settledIntervalMs = 1000;
+  _settings.dimAfterMs = 120000;
+  _settings.blankAfterMs = 600000;
+  _settings.fullBrightness = 255;
+  _settings.dimBrightness = 32;
+  memset(_modeMs, 0, sizeof(_modeMs));
+}
+
+void DisplayPowerPolicy::configure(const DisplayPowerSettings& settings) {
+  _settings = settings;
+}
+
+bool DisplayPowerPolicy::update(uint32_t nowMs, float weight, bool stable) {
+  if (!_hasReference || fabsf(weight - _reference) > DISPLAY_POWER_MOVE_THRESHOLD) {
+    _reference = weight;
+    _hasReference = true;
+    _lastActivityMs = nowMs;
+  }
+
+  uint32_t idleMs = nowMs - _lastActivityMs;
+  DisplayPowerMode next;
+  if (_settings.blankAfterMs > 0 && idleMs >= _settings.blankAfterMs) {
+    next = DISPLAY_POWER_BLANK;
+  } else if (_settings.dimAfterMs > 0 && idleMs >= _settings.dimAfterMs) {
+    next = DISPLAY_POWER_DIMMED;
+  } else if (stable || idleMs >= DISPLAY_POWER_SETTLE_MS) {
+    next = DISPLAY_POWER_SETTLED;
+  } else {
+    next = DISPLAY_POWER_ACTIVE;
+  }
+
+  if (next == _mode) {
+    return false;
+  }
+  bool woke = next < _mode;
+  enter(next, nowMs);
+  return woke;
+}
+
+void DisplayPowerPolicy::wake(uint32_t nowMs) {
+  _lastActivityMs = nowMs;
+}
+
+uint32_t DisplayPowerPolicy::frameIntervalMs() const {
+  return _mode == DISPLAY_POWER_ACTIVE ? _settings.activeIntervalMs : _settings.settledIntervalMs;
+}
+
+uint8_t DisplayPowerPolicy::brightness() const {
+  switch (_mode) {
+    case DISPLAY_POWER_DIMMED:
+      return _settings.dimBrightness;
+    case DISPLAY_POWER_BLANK:
+      return 0;
+    default:
+      return _settings.fullBrightness;
+  }
+}
+
+uint64_t DisplayPowerPolicy::timeInModeMs(DisplayPowerMode mode, uint32_t nowMs) const {
+  if (mode >= DISPLAY_POWER_MODE_COUNT) {
+    return 0;
+  }
+  uint64_t total = _modeMs[mode];
+  if (mode == _mode) {
+    total += nowMs - _modeSinceMs;
+  }
+  return total;
+}
+
+const char* DisplayPowerPolicy::modeName(DisplayPowerMode mode) {
+  switch (mode) {
+    case DISPLAY_POWER_ACTIVE:
+      return "active";
+    case DISPLAY_POWER_SETTLED:
+      return "settled";
+    case DISPLAY_POWER_DIMMED:
+      return "dimmed";
+    case DISPLAY_POWER_BLANK:
+      return "blank";
+    default:
+      return "unknown";
+  }
+}
+
+void DisplayPowerPolicy::enter(DisplayPowerMode mode, uint32_t nowMs) {
+  _modeMs[_mode] += nowMs - _modeSinceMs;
+  LOG_DEBUG("Display power: %s -> %s", modeName(_mode), modeName(mode));
+  _mode = mode;
+  _modeSinceMs = nowMs;
+}
@@ -0,0 +1,92 @@
+#ifndef DISPLAY_POWER_H
+#define DISPLAY_POWER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ========================================
+// ADAPTIVE REFRESH AND BACKLIGHT POLICY
+// ========================================
+// Decides how often the display task renders and how bright the backlight
+// is. While the weight moves the screen refreshes at full rate. Once it has
+// settled the rate drops to about 1 Hz. After a configurable idle time the
+// backlight dims, and later blanks and rendering stops. Any weight change,
+// touch or screen change wakes it back up to full rate at once.
+//
+// Fed from loop() with every sample; the display task only reads the result
+// through the display snapshot.
+
+enum DisplayPowerMode : uint8_t {
+  DISPLAY_POWER_ACTIVE,  // Signal moving: full frame rate, full brightness
+  DISPLAY_POWER_SETTLED, // Signal steady: slow frame rate, full brightness
+  DISPLAY_POWER_DIMMED,  // Idle: slow frame rate, dimmed backlight
+  DISPLAY_POWER_BLANK,   // Idle for longer: backlight off, nothing rendered
+  DISPLAY_POWER_MODE_COUNT
+};
+
+// Weight change that counts as movement (grains)
+#ifndef DISPLAY_POWER_MOVE_THRESHOLD
+  #define DISPLAY_POWER_MOVE_THRESHOLD 0.1f
+#endif
+
+// Time without movement before the signal counts as settled
+#ifndef DISPLAY_POWER_SETTLE_MS
+  #define DISPLAY_POWER_SETTLE_MS 2000
+#endif
+
+struct DisplayPowerSettings {
+  uint32_t activeIntervalMs;  // Frame interval while the signal moves
+  uint32_t settledIntervalMs; // Frame interval once settled or dimmed
+  uint32_t dimAfterMs;        // Idle time before dimming, 0 = never
+  uint32_t blankAfterMs;      // Idle time before blanking, 0 = never
+  uint8_t fullBrightness;
+  uint8_t dimBrightness;
+};
+
+/**
+ * @brief Display refresh rate and backlight state machine, with time spent per mode.
+ */
+class DisplayPowerPolicy
+{
+public:
+  DisplayPowerPolicy();
+
+  void configure(const DisplayPowerSettings& settings);
+  const DisplayPowerSettings& settings() const { return _settings; }
+
+  /**
+   * @brief Feeds one weight sample and re-evaluates the mode.
+   * @param stable True if the stability detector reports a settled reading.
+   * @return True if the mode became more awake, i.e. the display should render now.
+   */
+  bool update(uint32_t nowMs, float weight, bool stable);
+
+  /**
+   * @brief Records user activity (touch, screen change); the next update() returns to full rate.
+   */
+  void wake(uint32_t nowMs);
+
+  DisplayPowerMode mode() const { return _mode; }
+  uint32_t frameIntervalMs() const;
+  uint8_t brightness() const;
+
+  /**
+   * @brief Total time spent in a mode since boot, including the current stay.
+   */
+  uint64_t timeInModeMs(DisplayPowerMode mode, uint32_t nowMs) const;
+
+  static const char* modeName(DisplayPowerMode mode);
+
+private:
+  void enter(DisplayPowerMode mode, uint32_t nowMs);
+
+  DisplayPowerSettings _settings;
+  DisplayPowerMode _mode;
+  uint32_t _modeSinceMs;
+  uint32_t _lastActivityMs;  // Last movement or wake()
+  float _reference;          // Weight at the last movement
+  bool _hasReference;
+  uint64_t _modeMs[DISPLAY_POWER_MODE_COUNT];
+};
+
+#endif // DISPLAY_POWER_H
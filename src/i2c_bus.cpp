@@ -0,0 +1,10 @@
+#include <Arduino.h>
+#include "i2c_bus.h"
+
+SemaphoreHandle_t i2cBusMutex = nullptr;
+
+void i2cBusBegin() {
+  if (i2cBusMutex == nullptr) {
+    i2cBusMutex = xSemaphoreCreateMutex();
+  }
+}
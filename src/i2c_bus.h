@@ -0,0 +1,36 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <Arduino.h>
+
+// ========================================
+// SHARED I2C BUS
+// ========================================
+// The ADS1115 and the touch controller hang off the same Wire bus but are read
+// from different tasks (acquisition and touch). Wire only protects a single
+// call, while a register read is several: write the register address, then
+// requestFrom(), available() and readBytes() on the shared receive buffer. A
+// read from the other task in between corrupts it. Every transaction holds
+// i2cBusMutex from start to finish; it is a FreeRTOS mutex, so the
+// acquisition task lends its priority to the touch task while it waits.
+
+extern SemaphoreHandle_t i2cBusMutex;
+
+/**
+ * @brief Creates the bus mutex. Call once, before any task uses the bus.
+ */
+void i2cBusBegin();
+
+/**
+ * @brief Holds the I2C bus for the lifetime of the object.
+ */
+class I2cBusLock
+{
+public:
+  I2cBusLock() { xSemaphoreTake(i2cBusMutex, portMAX_DELAY); }
+  ~I2cBusLock() { xSemaphoreGive(i2cBusMutex); }
+  I2cBusLock(const I2cBusLock&) = delete;
+  I2cBusLock& operator=(const I2cBusLock&) = delete;
+};
+
+#endif // I2C_BUS_H
@@ -0,0 +1,178 @@
+// Generated by scripts/generate_image_assets.py - do not edit.
+#ifndef IMAGE_ASSETS_H
+#define IMAGE_ASSETS_H
+
+#include "rle_image.h"
+
+// powdersense_2.png, 568x315 scaled to 310x172: 5294 bytes RLE, 106640 bytes raw RGB565
+static const uint16_t SPLASH_IMAGE_DATA[] = {
+  0xA160, 0x0000, 0x0004, 0x2000, 0x4108, 0x8210, 0x8210, 0x8130, 0x0000, 0x0007, 0x2000, 0xC318, 0x2421, 0xA631, 0x0742, 0x2842,
+  0x2421, 0x812D, 0x0000, 0x0002, 0x2000, 0xC218, 0x8003, 0x6529, 0x0005, 0xA631, 0x0742, 0x284A, 0xC639, 0xC318, 0x812A, 0x0000,
+  0x000D, 0x4108, 0xE318, 0x6529, 0xC639, 0xE739, 0xC739, 0x4429, 0x6531, 0xC639, 0x0742, 0xE739, 0x0B5B, 0x8108, 0x8127, 0x0000,
+  0x0010, 0x4108, 0xE318, 0x8531, 0xC639, 0xE739, 0xE739, 0xC739, 0xC739, 0x6529, 0x4429, 0x8531, 0xC639, 0xE739, 0xEB5A, 0x2C63,
+  0x2000, 0x8124, 0x0000, 0x0012, 0x6108, 0xE318, 0x6529, 0xC739, 0xE739, 0xE739, 0xC739, 0xC639, 0xC639, 0xA631, 0xA631, 0x2421,
+  0x4429, 0x8631, 0xC639, 0xC739, 0x13A5, 0xE739, 0x8122, 0x0000, 0x0004, 0x6108, 0xE318, 0x6529, 0xC639, 0x8003, 0xE739, 0x000E,
+  0xC739, 0xC639, 0xA631, 0x4529, 0x0421, 0x8531, 0x4429, 0x0421, 0x4529, 0xA631, 0xA631, 0xEF7B, 0x139D, 0xA210, 0x8120, 0x0000,
+  0x0004, 0x2421, 0x6529, 0x4529, 0x8631, 0x8003, 0xC739, 0x000F, 0xC639, 0xA631, 0x4529, 0xA210, 0x2000, 0x0000, 0xE318, 0x6529,
+  0x0421, 0x0321, 0x8531, 0x0742, 0x694A, 0xD6BD, 0x694A, 0x8003, 0x0000, 0x0002, 0x8210, 0x4108, 0x8119, 0x0000, 0x0006, 0x2000,
+  0xC639, 0x8531, 0xE318, 0x2421, 0x6529, 0x8003, 0xA631, 0x0002, 0x4429, 0x8210, 0x8003, 0x0000, 0x0010, 0x8210, 0x2421, 0x6529,
+  0x8631, 0x0321, 0x6529, 0x4C6B, 0xAA52, 0xB294, 0xF29C, 0x2000, 0x8210, 0x6D6B, 0x57CE, 0x13A5, 0x0421, 0x8118, 0x0000, 0x001F,
+  0x4429, 0xCA5A, 0x0321, 0xC318, 0xE318, 0x2421, 0x4529, 0xA631, 0x2421, 0x2000, 0x0000, 0x2000, 0xA210, 0x2421, 0x6529, 0x2842,
+  0x0B63, 0xAA52, 0xE741, 0x0B63, 0x6C6B, 0x0B63, 0x4C6B, 0xF6BD, 0x6D6B, 0x57CE, 0xB9DE, 0x74B5, 0x33AD, 0xF39C, 0x6529, 0x8117,
+  0x0000, 0x000F, 0x0742, 0xEB62, 0x6531, 0xC318, 0xC318, 0xE320, 0x2421, 0x6529, 0x2421, 0x6108, 0x8210, 0x0421, 0x8529, 0x2842,
+  0x0B63, 0x8003, 0x4C6B, 0x8003, 0x6C6B, 0x000B, 0x4C6B, 0xAA52, 0x54A5, 0xB5B5, 0xFAE6, 0xDADE, 0x53AD, 0x73B5, 0xD19C, 0xD6B5,
+  0xC318, 0x8116, 0x0000, 0x000E, 0x0421, 0x8D73, 0xA631, 0xE320, 0xC218, 0xC318, 0x0421, 0x2421, 0x6529, 0x2421, 0x6529, 0x484A,
+  0xEB5A, 0x4C6B, 0x8005, 0x6C6B, 0x000E, 0x6D6B, 0x6C6B, 0x6C6B, 0xEB5A, 0xCE7B, 0x75AD, 0x58CE, 0x78D6, 0xD5BD, 0x33AD, 0xD1A4,
+  0x17BE, 0xD294, 0x4008, 0x8115, 0x0000, 0x0021, 0x4108, 0x0B63, 0x484A, 0x4429, 0xC218, 0xA218, 0xE318, 0x0421, 0x8531, 0x484A,
+  0xEB62, 0x4C6B, 0x4C6B, 0x6C6B, 0x6C6B, 0x6D73, 0x6D73, 0x6D6B, 0x6C6B, 0x6C6B, 0x4C6B, 0xEB62, 0xCA5A, 0xAA52, 0xB6B5, 0x33AD,
+  0x57CE, 0x57CE, 0x13A5, 0x33AD, 0x9194, 0x3BE7, 0xEB5A, 0x8116, 0x0000, 0x0021, 0xA639, 0x4C6B, 0xC639, 0xE318, 0xA210, 0xA210,
+  0x8531, 0x0B63, 0x2C6B, 0x4C6B, 0x6C6B, 0x6C6B, 0x6D6B, 0x6D6B, 0x6D73, 0x6D6B, 0x6C6B, 0x4C6B, 0xEB5A, 0xE739, 0x0421, 0x4429,
+  0xA639, 0xAE73, 0x33A5, 0x16C6, 0x37CE, 0xD5BD, 0x12A5, 0xD2A4, 0xB5B5, 0xDAD6, 0x6529, 0x8115, 0x0000, 0x000B, 0x6108, 0x8D73,
+  0x694A, 0x4429, 0x8210, 0xA210, 0x8631, 0x2C6B, 0x4C6B, 0x4C6B, 0x6C6B, 0x8004, 0x6D6B, 0x0013, 0x6C6B, 0xEA5A, 0xC639, 0x2421,
+  0x4529, 0x2842, 0x8952, 0xA631, 0xE739, 0xF29C, 0xD29C, 0x16C6, 0x37CE, 0x33AD, 0x33AD, 0x2F8C, 0x1BDF, 0x74AD, 0x8210, 0x8115,
+  0x0000, 0x0006, 0x694A, 0x4C6B, 0x0742, 0x484A, 0x6952, 0x2C63, 0x8003, 0x4C6B, 0x0018, 0x6C6B, 0x6D6B, 0x6D6B, 0x6C6B, 0x4C6B,
+  0x0742, 0x2421, 0x0421, 0x8631, 0x8952, 0x0742, 0x4429, 0x0321, 0x2429, 0x684A, 0x718C, 0xB5BD, 0x16C6, 0xF6C5, 0xF29C, 0x12A5,
+  0xF29C, 0x5CE7, 0x6D6B, 0x8115, 0x0000, 0x0006, 0x0421, 0x6C6B, 0x0B63, 0xEB62, 0x4C6B, 0x6C6B, 0x8005, 0x4C6B, 0x0017, 0xCA5A,
+  0x0742, 0x284A, 0xE739, 0x2421, 0x2842, 0x484A, 0x6529, 0x6529, 0x2421, 0x0321, 0x0321, 0x6529, 0xAA52, 0xF2A4, 0xF6C5, 0x37C6,
+  0xB5BD, 0xF29C, 0x4F8C, 0x37C6, 0xB9D6, 0xA631, 0x8114, 0x0000, 0x0007, 0x2000, 0x0B63, 0x2C63, 0x0B63, 0x4C6B, 0x6C6B, 0x6C6B,
+  0x8003, 0x4C6B, 0x0019, 0x8952, 0x2421, 0xE318, 0x4429, 0x2421, 0x8531, 0x2842, 0xC639, 0xE739, 0xC639, 0x6529, 0x0421, 0x0321,
+  0x0321, 0xC639, 0x6C6B, 0xF6C5, 0x58CE, 0x58CE, 0xF2A4, 0xF2A4, 0x9094, 0xFADE, 0x13A5, 0x6108, 0x8114, 0x0000, 0x0005, 0xC639,
+  0x6D6B, 0x0B63, 0x2C63, 0x6C6B, 0x8003, 0x4C6B, 0x001A, 0x2C63, 0x484A, 0xE318, 0x8210, 0xE318, 0x2421, 0xA631, 0x0842, 0x484A,
+  0x484A, 0xC739, 0xA631, 0x4429, 0x0321, 0x0321, 0x2421, 0x284A, 0x74B5, 0x37CE, 0x58CE, 0x58CE, 0xB19C, 0x9094, 0x33A5, 0x1BDF,
+  0xCA5A, 0x8114, 0x0000, 0x0004, 0xA210, 0x2C6B, 0x2B63, 0xEB5A, 0x8003, 0x4C6B, 0x0007, 0x2C6B, 0x6952, 0x8531, 0x0319, 0x2421,
+  0xA631, 0x0842, 0x8004, 0x484A, 0x0011, 0x2842, 0xC639, 0xA631, 0x2429, 0x0321, 0x0321, 0x2421, 0xF29C, 0x58CE, 0x99D6, 0x98D6,
+  0x74B5, 0x9194, 0x4F8C, 0x17C6, 0x78C6, 0xA210, 0x8114, 0x0000, 0x0003, 0x484A, 0x4C6B, 0xEB5A, 0x8003, 0x4C6B, 0x0005, 0x0B63,
+  0x6531, 0x4429, 0xC639, 0x2842, 0x8007, 0x484A, 0x0010, 0x0842, 0xA631, 0x8531, 0x2421, 0x0321, 0x0421, 0x34AD, 0x78CE, 0x57CE,
+  0x36CE, 0xF5C5, 0x9094, 0x7094, 0x4F8C, 0xDAD6, 0xCE7B, 0x8114, 0x0000, 0x0009, 0x0421, 0x6C6B, 0xCA5A, 0xAA52, 0xCA5A, 0x8952,
+  0xE739, 0xE739, 0x2842, 0x800A, 0x484A, 0x0010, 0xE739, 0xC639, 0x6529, 0x0321, 0xCA5A, 0xF6C5, 0x36C6, 0xF5C5, 0xD5BD, 0xB5BD,
+  0xB5BD, 0x9094, 0x6F94, 0xB194, 0xDAD6, 0xE318, 0x8112, 0x0000, 0x0009, 0x4108, 0x694A, 0x6C6B, 0xEB62, 0xAA52, 0x2842, 0x8531,
+  0xA631, 0x4842, 0x800B, 0x484A, 0x0011, 0x4842, 0xC639, 0xA631, 0xAA5A, 0x94B5, 0xF5C5, 0xD4BD, 0xB4BD, 0xB5BD, 0x37C6, 0x98D6,
+  0xD5BD, 0x7094, 0x7094, 0x54AD, 0xEF7B, 0x2000, 0x8110, 0x0000, 0x000A, 0x2421, 0x9194, 0x78D6, 0x74B5, 0x0B63, 0xE741, 0xC639,
+  0xC639, 0xA631, 0xE739, 0x800B, 0x484A, 0x0011, 0x4842, 0x484A, 0x8D73, 0x94B5, 0xB4BD, 0xB4BD, 0x94B5, 0xF5BD, 0x57CE, 0x98D6,
+  0x78CE, 0x78CE, 0x95B5, 0xB19C, 0x7094, 0xF29C, 0xA210, 0x810E, 0x0000, 0x000D, 0x6108, 0xCA5A, 0x17C6, 0xDADE, 0xB9DE, 0x58CE,
+  0xB19C, 0xA952, 0xE741, 0xE739, 0xA639, 0xA631, 0x0842, 0x8009, 0x484A, 0x0012, 0x4842, 0xCA5A, 0xB19C, 0xB4BD, 0xB4BD, 0x94B5,
+  0xB4B5, 0x16C6, 0x78CE, 0x78CE, 0x57CE, 0x99D6, 0xFADE, 0xDADE, 0x53AD, 0x33AD, 0x12A5, 0x484A, 0x810D, 0x0000, 0x000E, 0x2421,
+  0xD29C, 0xD9DE, 0xDADE, 0xB9DE, 0x58D6, 0x37CE, 0xF6C5, 0xEE83, 0x484A, 0xE741, 0xC639, 0xA631, 0xA631, 0x8009, 0x484A, 0x000B,
+  0xAE7B, 0x74B5, 0xB4BD, 0x94B5, 0x94B5, 0xD5BD, 0x57CE, 0x78CE, 0x37CE, 0x58CE, 0xD9DE, 0x8003, 0xFADE, 0x0004, 0xD9DE, 0x33A5,
+  0x37C6, 0x694A, 0x810B, 0x0000, 0x0011, 0x4108, 0x4C6B, 0x98D6, 0xFAE6, 0xDADE, 0x98D6, 0x58CE, 0x37CE, 0x37CE, 0x16C6, 0x95B5,
+  0x2B6B, 0x2742, 0xE739, 0xC639, 0xA631, 0xC639, 0x8005, 0x484A, 0x000C, 0x2842, 0xCA5A, 0xF2A4, 0xB4BD, 0x94B5, 0x74B5, 0x94B5,
+  0x36C6, 0x78CE, 0x58CE, 0x37CE, 0x99D6, 0x8005, 0xFADE, 0x0004, 0x1ADF, 0xDADE, 0xCA5A, 0x4108, 0x810A, 0x0000, 0x0022, 0xA631,
+  0x54AD, 0xFAE6, 0xFAE6, 0xD9DE, 0x98D6, 0x78D6, 0x57CE, 0x37CE, 0x17CE, 0x16C6, 0xF6C5, 0xF2A4, 0xCA5A, 0x0742, 0xE739, 0xA639,
+  0x8631, 0x0742, 0x484A, 0x484A, 0x2842, 0x484A, 0xEE83, 0x94B5, 0x94B5, 0x73B5, 0x94B5, 0xD5BD, 0x57CE, 0x78CE, 0x37CE, 0x78CE,
+  0xD9DE, 0x8004, 0xFADE, 0x0004, 0x1ADF, 0x1AE7, 0xB5B5, 0xC639, 0x810A, 0x0000, 0x0022, 0xA210, 0xAD73, 0xB9DE, 0x1BE7, 0xFAE6,
+  0xB9DE, 0x98D6, 0x78D6, 0x57CE, 0x37CE, 0x37CE, 0x16C6, 0x17C6, 0x16C6, 0xD6BD, 0x2F8C, 0x6952, 0xE741, 0xE739, 0xA631, 0xA631,
+  0x2842, 0x2842, 0x0B63, 0xF2A4, 0x94BD, 0x94B5, 0x74B5, 0xB4B5, 0x16C6, 0x78CE, 0x57CE, 0x37CE, 0xB9D6, 0x8005, 0xFADE, 0x0004,
+  0x1ADF, 0x98CE, 0xAE73, 0xA210, 0x8109, 0x0000, 0x0023, 0x2000, 0xE739, 0x54AD, 0x1AE7, 0x1BE7, 0xFAE6, 0xB9DE, 0x98D6, 0x98D6,
+  0x78D6, 0x78D6, 0x57CE, 0x37CE, 0x17C6, 0x16C6, 0x16C6, 0xF6C5, 0x95B5, 0x6C6B, 0x284A, 0xE741, 0xC639, 0xA531, 0x2842, 0x2F8C,
+  0x94B5, 0x94B5, 0x74B5, 0x94B5, 0xD5BD, 0x57CE, 0x58CE, 0x37CE, 0x78CE, 0xD9DE, 0x8004, 0xFADE, 0x0005, 0x1ADF, 0xFADE, 0x74AD,
+  0xC639, 0x2000, 0x8109, 0x0000, 0x0022, 0xA210, 0xEF83, 0xB9DE, 0x3BEF, 0x1BE7, 0xDADE, 0xB9DE, 0xB9DE, 0x98D6, 0x98D6, 0x78D6,
+  0x78D6, 0x58CE, 0x37CE, 0x37C6, 0x17C6, 0x37C6, 0x37CE, 0x37CE, 0x33AD, 0xEB62, 0x284A, 0x284A, 0x6C73, 0x33AD, 0xB4BD, 0x94B5,
+  0x94B5, 0xB4B5, 0x36C6, 0x78CE, 0x57CE, 0x37CE, 0xB9D6, 0x8005, 0xFADE, 0x0004, 0x1ADF, 0x99D6, 0x4C6B, 0x8210, 0x810A, 0x0000,
+  0x0005, 0x0742, 0xD6BD, 0x3BEF, 0x3BEF, 0xFAE6, 0x8003, 0xD9DE, 0x001A, 0xB9DE, 0xB9DE, 0x98D6, 0x98D6, 0x78D6, 0x78CE, 0x58CE,
+  0x57CE, 0x58CE, 0x78CE, 0x78CE, 0x37CE, 0x37CE, 0x17C6, 0x54AD, 0xD5BD, 0xF5C5, 0xB4BD, 0x94B5, 0x94B5, 0xF5BD, 0x57CE, 0x78CE,
+  0x37CE, 0x78CE, 0xDADE, 0x8004, 0xFADE, 0x0004, 0x1ADF, 0xFADE, 0x74AD, 0x6529, 0x810A, 0x0000, 0x0007, 0xA210, 0x508C, 0x1AEF,
+  0x3BEF, 0x1BE7, 0xFAE6, 0xDADE, 0x8004, 0xD9DE, 0x0017, 0xB9DE, 0xB9DE, 0x99D6, 0x98D6, 0x78D6, 0x78D6, 0x99D6, 0x99D6, 0x78CE,
+  0x57CE, 0x78D6, 0x79D6, 0x58CE, 0x36CE, 0xD5C5, 0xB4BD, 0x94B5, 0xB5BD, 0x37CE, 0x78CE, 0x37CE, 0x37CE, 0xB9D6, 0x8005, 0xFADE,
+  0x0004, 0x1AE7, 0x78CE, 0x0B5B, 0x2000, 0x8109, 0x0000, 0x0009, 0x2000, 0xAA52, 0x37CE, 0x3BEF, 0x3BEF, 0x1AE7, 0xFAE6, 0xFAE6,
+  0xDADE, 0x8005, 0xD9DE, 0x0015, 0xB9DE, 0xB9D6, 0x99D6, 0x99D6, 0xB9D6, 0x99D6, 0x78D6, 0x78D6, 0x99D6, 0x78D6, 0x57CE, 0x15C6,
+  0xD5BD, 0xB4BD, 0xB4BD, 0x16C6, 0x77CE, 0x58CE, 0x37CE, 0x78D6, 0xDADE, 0x8004, 0xFADE, 0x0004, 0x1ADF, 0xFADE, 0xB294, 0x2421,
+  0x810A, 0x0000, 0x0005, 0x2421, 0xB194, 0xFAE6, 0x3BEF, 0x1BE7, 0x8003, 0xFAE6, 0x0003, 0xD9E6, 0xFAE6, 0xDADE, 0x8004, 0xD9DE,
+  0x0013, 0xB9DE, 0xB9DE, 0xDADE, 0xDADE, 0xB9DE, 0x99D6, 0xB9DE, 0xB9DE, 0x78D6, 0x36CE, 0xF5C5, 0xD4BD, 0xB4BD, 0xD5BD, 0x57CE,
+  0x78CE, 0x37CE, 0x57CE, 0xB9D6, 0x8005, 0xFADE, 0x0004, 0x1ADF, 0x37C6, 0x8952, 0x4108, 0x8109, 0x0000, 0x0006, 0x4108, 0xEB5A,
+  0x37CE, 0x3BEF, 0x3BEF, 0x1BE7, 0x8007, 0xFAE6, 0x0016, 0xDADE, 0xD9DE, 0xD9DE, 0xB9DE, 0xDADE, 0xFADE, 0xDADE, 0xB9DE, 0xB9DE,
+  0xDADE, 0xB9DE, 0x77D6, 0x16CE, 0xD5C5, 0xB4BD, 0xD5BD, 0x16C6, 0x78CE, 0x58CE, 0x37CE, 0x78D6, 0xDADE, 0x8005, 0xFADE, 0x0003,
+  0xB9D6, 0x9194, 0x0421, 0x810A, 0x0000, 0x0005, 0x2421, 0xB19C, 0x1BEF, 0x5BEF, 0x3BEF, 0x8008, 0xFAE6, 0x0015, 0xDADE, 0xDADE,
+  0xD9DE, 0xDADE, 0xDADE, 0xFAE6, 0xDADE, 0xB9DE, 0xDADE, 0xDADE, 0x98D6, 0x57D6, 0x15C6, 0xD5BD, 0xB4BD, 0xF5C5, 0x57CE, 0x98D6,
+  0x57CE, 0x58CE, 0xB9D6, 0x8006, 0xFADE, 0x0003, 0x16BE, 0x8952, 0x2000, 0x8109, 0x0000, 0x0009, 0x4108, 0x0B63, 0x78D6, 0x3BEF,
+  0x3BEF, 0x1BE7, 0xFAE6, 0x1AE7, 0x1AE7, 0x8005, 0xFAE6, 0x8003, 0xDADE, 0x0012, 0xFADE, 0xFAE6, 0xFAE6, 0xD9DE, 0xDADE, 0xFAE6,
+  0xD9DE, 0x98D6, 0x36CE, 0xF5C5, 0xD5BD, 0xD5BD, 0x37CE, 0x98D6, 0x78CE, 0x37CE, 0x98D6, 0xDADE, 0x8004, 0xFADE, 0x0004, 0x1ADF,
+  0xFADE, 0x3084, 0xC318, 0x810A, 0x0000, 0x000B, 0x6531, 0x53AD, 0x3BEF, 0x5BEF, 0x3BEF, 0xFAE6, 0x1AE7, 0x1AE7, 0xFAE6, 0x1AE7,
+  0x1AE7, 0x8004, 0xFAE6, 0x0013, 0xDADE, 0xFADE, 0xFAE6, 0x1BE7, 0xDADE, 0xD9DE, 0xFAE6, 0xFAE6, 0xB9DE, 0x77D6, 0x15CE, 0xD5C5,
+  0xD5BD, 0xF6C5, 0x78D6, 0x98D6, 0x57CE, 0x58CE, 0xD9D6, 0x8005, 0xFADE, 0x0003, 0x1ADF, 0x16BE, 0xE739, 0x810A, 0x0000, 0x0007,
+  0x6108, 0xAD73, 0xB9DE, 0x3BEF, 0x3BEF, 0x1BE7, 0xFAE6, 0x8004, 0x1AE7, 0x0002, 0xFAE6, 0x1BE7, 0x8005, 0xFAE6, 0x0011, 0x1BE7,
+  0xFAE6, 0xDADE, 0xFAE6, 0xFAE6, 0xD9DE, 0x98D6, 0x36CE, 0xF5C5, 0xD5BD, 0xF5BD, 0x57CE, 0x98D6, 0x58CE, 0x37CE, 0x99D6, 0xDADE,
+  0x8004, 0xFADE, 0x0004, 0x1ADF, 0xB9D6, 0xCE7B, 0x8110, 0x8109, 0x0000, 0x0006, 0x2000, 0xE739, 0x74B5, 0x1BEF, 0x5BEF, 0x3BE7,
+  0x800A, 0x1AE7, 0x0013, 0xFAE6, 0xFAE6, 0x1BE7, 0x1BE7, 0xFAE6, 0xFADE, 0xFAE6, 0xFAE6, 0xB9DE, 0x77D6, 0x16CE, 0xF5C5, 0xD5BD,
+  0x16C6, 0x78D6, 0x98D6, 0x57CE, 0x78D6, 0xD9DE, 0x8006, 0xFADE, 0x0003, 0x54AD, 0xE739, 0x2000, 0x8109, 0x0000, 0x0006, 0xA210,
+  0xAE7B, 0xB9DE, 0x3BEF, 0x3BEF, 0x1BE7, 0x8006, 0x1AE7, 0x0001, 0x1BE7, 0x8003, 0x1AE7, 0x0001, 0xFAE6, 0x8003, 0x1BE7, 0x000E,
+  0xFAE6, 0xFAE6, 0x1BE7, 0xD9DE, 0x98D6, 0x56CE, 0x15C6, 0xD5C5, 0xF5C5, 0x57CE, 0x98D6, 0x78CE, 0x57CE, 0xB9D6, 0x8005, 0xFADE,
+  0x0004, 0x1ADF, 0x98CE, 0x6D6B, 0x8210, 0x8109, 0x0000, 0x0003, 0x2000, 0x0742, 0x95B5, 0x8003, 0x3BEF, 0x8004, 0x1AE7, 0x0007,
+  0x1BE7, 0x1AE7, 0x1AE7, 0x1BE7, 0x1AE7, 0x1AE7, 0xFAE6, 0x8003, 0x1BE7, 0x000F, 0xFAE6, 0xFAE6, 0x1BE7, 0xFAE6, 0xB9DE, 0x77D6,
+  0x36CE, 0xF5C5, 0xD5BD, 0x16C6, 0x98D6, 0x98D6, 0x57CE, 0x78D6, 0xDADE, 0x8006, 0xFADE, 0x0002, 0x74AD, 0x8531, 0x810A, 0x0000,
+  0x0008, 0x6108, 0x0F84, 0xFAE6, 0x3BEF, 0x3BEF, 0x1AE7, 0x1AE7, 0x1BE7, 0x8004, 0x1AE7, 0x0016, 0x1BE7, 0x1AE7, 0x1BE7, 0x1AE7,
+  0x1AE7, 0x1BE7, 0x3BE7, 0x1BE7, 0xFAE6, 0x1BE7, 0x1BE7, 0xFAE6, 0x98DE, 0x56CE, 0x15C6, 0xF5C5, 0xF6C5, 0x77CE, 0x99D6, 0x58CE,
+  0x57CE, 0xB9D6, 0x8005, 0xFADE, 0x0004, 0x1ADF, 0xB9D6, 0x4C6B, 0x4108, 0x810B, 0x0000, 0x0020, 0x284A, 0x3BEF, 0x3BEF, 0x1BE7,
+  0x1AE7, 0x1BE7, 0x1AE7, 0x1AE7, 0x1BE7, 0x1AE7, 0x1BE7, 0x1BE7, 0x1AE7, 0x1BE7, 0x1AE7, 0x1BE7, 0x3BE7, 0x3BE7, 0xFAE6, 0xFAE6,
+  0x1BE7, 0xFAE6, 0xB9DE, 0x77D6, 0x36CE, 0xF5C5, 0xF5C5, 0x57CE, 0xB8D6, 0x98D6, 0x37CE, 0x78D6, 0x8007, 0xFADE, 0x0002, 0xF29C,
+  0x2421, 0x810D, 0x0000, 0x0002, 0x8210, 0x78D6, 0x8003, 0x1BE7, 0x0004, 0x1AE7, 0x1BE7, 0x1BE7, 0x1AE7, 0x8006, 0x1BE7, 0x0010,
+  0x3BE7, 0x1BE7, 0xFAE6, 0x1BE7, 0x1BE7, 0xD9DE, 0x98D6, 0x56CE, 0x15C6, 0xF5C5, 0x16C6, 0x98D6, 0x98D6, 0x57CE, 0x57CE, 0xB9D6,
+  0x8005, 0xFADE, 0x0004, 0x1ADF, 0x37C6, 0xCA5A, 0x4108, 0x810E, 0x0000, 0x0007, 0x2000, 0x8D73, 0xFAE6, 0x1BE7, 0x1AE7, 0x1BE7,
+  0x1AE7, 0x8006, 0x1BE7, 0x0011, 0x3BE7, 0x1BE7, 0xFAE6, 0xFAE6, 0x1BE7, 0xFAE6, 0xB8DE, 0x77D6, 0x36CE, 0xF5C5, 0xF5C5, 0x57CE,
+  0x98D6, 0x78D6, 0x57CE, 0x98D6, 0xDADE, 0x8005, 0xFADE, 0x0003, 0xDADE, 0xB194, 0x0321, 0x810E, 0x0000, 0x0005, 0x2000, 0x8210,
+  0xE739, 0x8531, 0x37CE, 0x8008, 0x1BE7, 0x0011, 0x3BE7, 0x3BE7, 0x1BE7, 0xFAE6, 0x1BE7, 0x1AE7, 0xD9DE, 0x97D6, 0x36CE, 0x15C6,
+  0xF5C5, 0x16C6, 0x78D6, 0x98D6, 0x57CE, 0x57CE, 0xB9D6, 0x8006, 0xFADE, 0x0003, 0xF6BD, 0xAA52, 0x4108, 0x810A, 0x0000, 0x000B,
+  0x6108, 0x2421, 0x2421, 0x0000, 0x6108, 0x0321, 0x484A, 0x2742, 0x284A, 0x8D73, 0xFAE6, 0x8006, 0x1BE7, 0x0011, 0x3BE7, 0x1BE7,
+  0xFAE6, 0x1AE7, 0x1BE7, 0xFAE6, 0xB8DE, 0x57D6, 0x16CE, 0xF5C5, 0xF5C5, 0x57CE, 0x98D6, 0x78CE, 0x37CE, 0x98D6, 0xDADE, 0x8005,
+  0xFADE, 0x0003, 0xD9DE, 0x708C, 0xE318, 0x810A, 0x0000, 0x000D, 0x2000, 0xE318, 0xA631, 0x0421, 0xEB5A, 0x8631, 0x8631, 0x8952,
+  0x284A, 0x484A, 0x8952, 0xC639, 0x95B5, 0x8004, 0x1BE7, 0x0011, 0x3BE7, 0x3BEF, 0x1BE7, 0xFAE6, 0x1BE7, 0x1AE7, 0xD9DE, 0x77D6,
+  0x36CE, 0x15C6, 0xD5C5, 0x16C6, 0x98D6, 0x98D6, 0x37CE, 0x57CE, 0xB9D6, 0x8005, 0xFADE, 0x0004, 0x1ADF, 0x17BE, 0x2842, 0x2000,
+  0x8109, 0x0000, 0x0022, 0x2000, 0x6108, 0xC639, 0x8631, 0x6D6B, 0xA631, 0x2842, 0x8631, 0x8952, 0x484A, 0x6952, 0x6952, 0x284A,
+  0x6952, 0xAA52, 0xB9DE, 0x1BE7, 0x3BE7, 0x3BEF, 0x1BE7, 0xFAE6, 0x1AE7, 0x1BE7, 0xFAE6, 0x98DE, 0x56D6, 0x15CE, 0xF5C5, 0xF5C5,
+  0x57CE, 0xB9D6, 0x78CE, 0x37CE, 0x98D6, 0x8006, 0xFADE, 0x0003, 0xDADE, 0x2F84, 0x4108, 0x810A, 0x0000, 0x0022, 0x4108, 0x4429,
+  0x4529, 0x6952, 0x2842, 0x694A, 0x8E73, 0xA631, 0xA631, 0x484A, 0x484A, 0x6952, 0x284A, 0x8952, 0x484A, 0x0742, 0x7194, 0x3BE7,
+  0x3BEF, 0x1AE7, 0xFAE6, 0x1BE7, 0xFAE6, 0xB9DE, 0x77D6, 0x36CE, 0xF5C5, 0xF5C5, 0x36C6, 0x98D6, 0x98D6, 0x37CE, 0x58CE, 0xD9D6,
+  0x8006, 0xFADE, 0x0003, 0x74AD, 0xE739, 0x2000, 0x810A, 0x0000, 0x0021, 0x8210, 0xC639, 0xA631, 0x0B63, 0x694A, 0xCA5A, 0xCA5A,
+  0x694A, 0x694A, 0x4429, 0xE639, 0x8952, 0x284A, 0x8952, 0x694A, 0x484A, 0x8952, 0x484A, 0x17C6, 0xFAE6, 0x1AE7, 0x1BE7, 0xD9DE,
+  0x98DE, 0x56CE, 0x15CE, 0xF5C5, 0xF5C5, 0x57CE, 0x98D6, 0x58CE, 0x37CE, 0x99D6, 0x8006, 0xFADE, 0x0003, 0x98CE, 0xAE73, 0xA210,
+  0x810C, 0x0000, 0x0020, 0xC218, 0xAA5A, 0xE739, 0xCB5A, 0xCB5A, 0x4D6B, 0x2C63, 0xAE7B, 0x6D6B, 0x484A, 0xC639, 0x284A, 0x8952,
+  0x6952, 0x484A, 0xAA52, 0x484A, 0x694A, 0x4C6B, 0xFAE6, 0xFAE6, 0xB8DE, 0x77D6, 0x36CE, 0xF5C5, 0xF5C5, 0x36C6, 0x98D6, 0x78D6,
+  0x37CE, 0x58CE, 0xD9D6, 0x8006, 0xFADE, 0x0003, 0x54A5, 0xA631, 0x2000, 0x810D, 0x0000, 0x001E, 0xC318, 0xAA52, 0x8952, 0x2C63,
+  0x484A, 0xCA5A, 0x484A, 0x0C63, 0x6952, 0x0B63, 0x8531, 0x0742, 0x8952, 0x484A, 0xAA5A, 0x694A, 0x6952, 0x8952, 0x484A, 0xD29C,
+  0x97D6, 0x56CE, 0x15C6, 0xF5C5, 0xF5C5, 0x77CE, 0x98D6, 0x57CE, 0x37CE, 0x99D6, 0x8006, 0xFADE, 0x0003, 0x78CE, 0x8D73, 0x6108,
+  0x810E, 0x0000, 0x001E, 0x2000, 0x6529, 0x8531, 0xEF83, 0xAA52, 0xD29C, 0x6D6B, 0xD29C, 0x2C63, 0x0F84, 0x0C63, 0x494A, 0xA631,
+  0x0742, 0xA952, 0x684A, 0x6952, 0x6952, 0x484A, 0x8952, 0x2742, 0xB4BD, 0xF5C5, 0xD5BD, 0x36CE, 0x98D6, 0x78D6, 0x17CE, 0x58CE,
+  0xD9D6, 0x8005, 0xFADE, 0x0003, 0x1ADF, 0x54AD, 0x6529, 0x810F, 0x0000, 0x001D, 0x6108, 0xC739, 0x694A, 0xA631, 0x6952, 0x484A,
+  0x6952, 0xAA52, 0xCA5A, 0xCA5A, 0x6D6B, 0xEB5A, 0xEF7B, 0xE739, 0xA631, 0x484A, 0x6952, 0x6952, 0x484A, 0x8952, 0x0742, 0x8952,
+  0xEA5A, 0xD5BD, 0x78CE, 0x98D6, 0x37CE, 0x37CE, 0xB9D6, 0x8006, 0xFADE, 0x0003, 0x58CE, 0xEB5A, 0x2000, 0x810E, 0x0000, 0x001E,
+  0x6108, 0x0421, 0x494A, 0x8952, 0x484A, 0xA952, 0x0742, 0xB294, 0xCB5A, 0x718C, 0xEB5A, 0x3084, 0x0B63, 0xEF7B, 0x6D6B, 0x2842,
+  0xC639, 0xC639, 0x6952, 0x2842, 0x6952, 0x2742, 0x6952, 0x284A, 0x484A, 0x9194, 0x58CE, 0x37CE, 0x78CE, 0xD9D6, 0x8006, 0xFADE,
+  0x0002, 0xD294, 0x0421, 0x810F, 0x0000, 0x001D, 0xE318, 0x6529, 0x8952, 0xA952, 0x684A, 0xA952, 0x6952, 0x0742, 0x694A, 0x2C63,
+  0xEB5A, 0x0B63, 0x6D6B, 0xCB5A, 0x0F84, 0xCA5A, 0x7194, 0x484A, 0x8531, 0xE741, 0x8952, 0x2842, 0x694A, 0x484A, 0x2842, 0x684A,
+  0x684A, 0x33AD, 0xB9D6, 0x8006, 0xFADE, 0x0003, 0x16BE, 0xAA52, 0x4108, 0x810F, 0x0000, 0x001E, 0xA210, 0xEB5A, 0x694A, 0xA952,
+  0x684A, 0x8952, 0x6952, 0x694A, 0xAA5A, 0x0742, 0x718C, 0x0B63, 0x718C, 0x2C63, 0xCE7B, 0x2C63, 0x2C63, 0x8D73, 0x0742, 0xC639,
+  0x2421, 0x284A, 0x484A, 0x284A, 0x484A, 0x684A, 0x0742, 0x6952, 0x0B63, 0x58CE, 0x8004, 0xFADE, 0x0003, 0xB9D6, 0x9194, 0x2421,
+  0x8111, 0x0000, 0x0024, 0xAA52, 0x78D6, 0xCA5A, 0x684A, 0x8952, 0x6952, 0x6952, 0xA952, 0x484A, 0x8952, 0x0742, 0x0B63, 0x6D6B,
+  0xAA52, 0x308C, 0xAA52, 0xEE7B, 0x8952, 0x4C6B, 0x284A, 0x8531, 0xA631, 0x284A, 0x484A, 0x684A, 0xE739, 0x8952, 0xA631, 0x6952,
+  0x8D73, 0xB9D6, 0xFADE, 0xFADE, 0xF6BD, 0x694A, 0x2000, 0x8112, 0x0000, 0x0022, 0xE318, 0x99D6, 0xEF83, 0xCA5A, 0x8952, 0x8952,
+  0xAA5A, 0x694A, 0xCA5A, 0x8952, 0x284A, 0xAE73, 0xEB5A, 0xAE73, 0x4C6B, 0xEA5A, 0xEA5A, 0x0742, 0xA952, 0xE639, 0xC639, 0x0421,
+  0xC639, 0x684A, 0xE741, 0xA952, 0xA631, 0x484A, 0x6108, 0x4108, 0xAD73, 0xFADE, 0x508C, 0xA210, 0x8115, 0x0000, 0x001F, 0x8D73,
+  0xDADE, 0xCA5A, 0x8952, 0xAA5A, 0x6952, 0xCA5A, 0x8952, 0x694A, 0x484A, 0xAA5A, 0xAA52, 0xAE7B, 0x2742, 0x4B6B, 0x484A, 0x4C6B,
+  0xAA5A, 0x3084, 0x4C6B, 0xC639, 0x6529, 0xC639, 0x6952, 0xC639, 0x8631, 0x2000, 0x0000, 0x0000, 0x2000, 0xC318, 0x8117, 0x0000,
+  0x0019, 0x8210, 0x99D6, 0xB294, 0xCA5A, 0x694A, 0xAA5A, 0x8952, 0x484A, 0xCA5A, 0x684A, 0xE741, 0xA952, 0xCA5A, 0x6952, 0x8952,
+  0x2842, 0x8952, 0x2842, 0x694A, 0x2842, 0x8952, 0x8531, 0x2742, 0xA631, 0xA210, 0x811E, 0x0000, 0x0018, 0xEB5A, 0xFBE6, 0x0B63,
+  0xAA52, 0xA952, 0x8952, 0xAA5A, 0x6952, 0x8952, 0x284A, 0x8952, 0xE739, 0x6C73, 0x694A, 0x0F84, 0xAA52, 0x2C63, 0x484A, 0x4C6B,
+  0x8952, 0xE739, 0x8631, 0xAA52, 0x4108, 0x811E, 0x0000, 0x0018, 0x4108, 0x95B5, 0xB6B5, 0xCA5A, 0x8952, 0xAA5A, 0x684A, 0x8952,
+  0x6952, 0x684A, 0x484A, 0xE741, 0x684A, 0x484A, 0x484A, 0x694A, 0x694A, 0x0B63, 0xCA5A, 0xEB5A, 0xAA52, 0x4429, 0xA631, 0xA210,
+  0x811F, 0x0000, 0x0017, 0xA631, 0xB9D6, 0xEE7B, 0xA952, 0x484A, 0xA952, 0x6952, 0x484A, 0x8952, 0x2742, 0xA95A, 0xE639, 0x8D73,
+  0x694A, 0xAE73, 0x484A, 0x894A, 0x694A, 0xE739, 0x694A, 0xC631, 0x6108, 0x2000, 0x8120, 0x0000, 0x0014, 0xAE73, 0x98D6, 0x8952,
+  0xAA5A, 0x8952, 0x484A, 0x8952, 0x0742, 0x8952, 0xE741, 0x484A, 0xA631, 0x0B5B, 0x694A, 0xAD73, 0x2842, 0x484A, 0x4842, 0xA210,
+  0xA210, 0x8116, 0x0000, 0x0003, 0xC218, 0xEB5A, 0xE318, 0x8009, 0x0000, 0x0013, 0x8210, 0x33A5, 0x94B5, 0x2742, 0x484A, 0x8952,
+  0x284A, 0x8952, 0x0742, 0xA952, 0xA631, 0xA631, 0x694A, 0x694A, 0x8631, 0xEB5A, 0x8631, 0x8210, 0x4108, 0x8117, 0x0000, 0x0004,
+  0x8531, 0x13A5, 0xCE7B, 0xA210, 0x8009, 0x0000, 0x0010, 0x8531, 0x57CE, 0x3084, 0x6952, 0x0742, 0xA952, 0x0742, 0xAA52, 0xC739,
+  0x8952, 0xC318, 0x4429, 0x484A, 0xC639, 0xE318, 0x8210, 0x8119, 0x0000, 0x0004, 0x8531, 0x308C, 0x13A5, 0xAA52, 0x8009, 0x0000,
+  0x000F, 0x2000, 0xEB5A, 0xFADE, 0x0B63, 0xAA52, 0x2842, 0xA952, 0xE739, 0x694A, 0xA210, 0x0000, 0x4108, 0x8210, 0xE318, 0x2000,
+  0x8118, 0x0000, 0x0007, 0x6108, 0xCA5A, 0x74AD, 0x9194, 0x34AD, 0xEB5A, 0xE318, 0x8009, 0x0000, 0x0008, 0x4108, 0x508C, 0xB9D6,
+  0xAA52, 0xCA5A, 0xE739, 0x8631, 0x4108, 0x811D, 0x0000, 0x0009, 0x2421, 0xB194, 0x38CE, 0x78CE, 0xD6BD, 0x308C, 0xD29C, 0xC639,
+  0x6108, 0x8009, 0x0000, 0x0005, 0x6108, 0x34A5, 0x9194, 0x4529, 0xE318, 0x811D, 0x0000, 0x000B, 0x4108, 0x0B63, 0xD6BD, 0x58CE,
+  0x79D6, 0x79CE, 0x37C6, 0xD19C, 0x508C, 0x6D73, 0x8952, 0x800A, 0x0000, 0x0002, 0x4108, 0x2000, 0x811E, 0x0000, 0x000D, 0xA631,
+  0x13A5, 0x58CE, 0x79CE, 0x99D6, 0x58CE, 0xF6C5, 0x95B5, 0x54AD, 0xEE7B, 0xD29C, 0x3084, 0x2421, 0x8127, 0x0000, 0x000F, 0x8210,
+  0x8D73, 0xF6BD, 0x78CE, 0x99D6, 0x79D6, 0x38CE, 0xD6BD, 0x94B5, 0x95B5, 0xD6BD, 0x74AD, 0x0B63, 0x139D, 0xAA52, 0x8126, 0x0000,
+  0x0010, 0x6108, 0x2F84, 0x58CE, 0x79D6, 0x99D6, 0x58CE, 0x17C6, 0xB5B5, 0x94B5, 0xB5B5, 0xD6BD, 0xD294, 0xC639, 0x8210, 0xCA5A,
+  0x4529, 0x8126, 0x0000, 0x000C, 0x8210, 0x2F8C, 0x58CE, 0x79D6, 0x37C6, 0xD6BD, 0x94B5, 0x95B5, 0xD6BD, 0x95B5, 0x2C63, 0x8210,
+  0x812B, 0x0000, 0x0009, 0xCA5A, 0xF29C, 0xF6C5, 0xB5B5, 0x74B5, 0xB5B5, 0xF6BD, 0xB294, 0x8631, 0x812D, 0x0000, 0x0008, 0x6108,
+  0x0E84, 0x12A5, 0x95B5, 0xD6BD, 0xD6BD, 0xEB5A, 0x2000, 0x812F, 0x0000, 0x0005, 0x6531, 0xCE7B, 0xB5B5, 0x718C, 0x0421, 0x8132,
+  0x0000, 0x0003, 0x8531, 0xA631, 0x4108, 0xCD1C, 0x0000,
+};
+static const RleImage SPLASH_IMAGE = { 310, 172, SPLASH_IMAGE_DATA, 2647 };
+
+#endif // IMAGE_ASSETS_H
@@ -0,0 +1,161 @@
+#include <Arduino.h>
+#include "job_scheduler.h"
+
+static JobClock* jobRegistry[JOB_CLOCK_MAX];
+static size_t jobRegistryCount = 0;
+
+// Sleeps until the esp_timer clock reaches releaseUs, rounded up to the next tick
+static void sleepUntil(int64_t releaseUs) {
+  int64_t waitUs = releaseUs - esp_timer_get_time();
+  if (waitUs > 0) {
+    const int64_t TICK_US = portTICK_PERIOD_MS * 1000LL;
+    vTaskDelay((TickType_t)((waitUs + TICK_US - 1) / TICK_US));
+  }
+}
+
+// --- JobClock ---
+
+JobClock::JobClock(const char* name, uint32_t periodMs)
+  : _periodUs(periodMs * 1000UL), _releaseUs(0), _startUs(0) {
+  memset(&_stats, 0, sizeof(_stats));
+  _stats.name = name;
+  _stats.periodUs = _periodUs;
+  _mux = portMUX_INITIALIZER_UNLOCKED;
+  if (jobRegistryCount < JOB_CLOCK_MAX) {
+    jobRegistry[jobRegistryCount++] = this;
+  }
+}
+
+void JobClock::start() {
+  _releaseUs = esp_timer_get_time();
+}
+
+void JobClock::setPeriodMs(uint32_t periodMs) {
+  portENTER_CRITICAL(&_mux);
+  _periodUs = periodMs * 1000UL;
+  _stats.periodUs = _periodUs;
+  portEXIT_CRITICAL(&_mux);
+}
+
+void JobClock::sleepUntilRelease() const {
+  sleepUntil(_releaseUs);
+}
+
+void JobClock::started(int64_t nowUs) {
+  _startUs = nowUs;
+}
+
+void JobClock::finished(int64_t nowUs) {
+  uint32_t jitterUs = _startUs > _releaseUs ? (uint32_t)(_startUs - _releaseUs) : 0;
+  uint32_t misses = 0;
+  if (nowUs - _releaseUs >= (int64_t)_periodUs) {
+    // Overran into the next period: count it and restart the grid from now
+    misses = (uint32_t)((nowUs - _releaseUs) / _periodUs);
+    _releaseUs = nowUs;
+  }
+  _releaseUs += _periodUs;
+  record(jitterUs, (uint32_t)(nowUs - _startUs), misses);
+}
+
+void JobClock::account(int64_t releaseUs, int64_t startUs, int64_t endUs) {
+  uint32_t jitterUs = startUs > releaseUs ? (uint32_t)(startUs - releaseUs) : 0;
+  uint32_t misses = endUs > releaseUs ? (uint32_t)((endUs - releaseUs) / _periodUs) : 0;
+  record(jitterUs, (uint32_t)(endUs - startUs), misses);
+}
+
+void JobClock::record(uint32_t jitterUs, uint32_t runUs, uint32_t misses) {
+  portENTER_CRITICAL(&_mux);
+  _stats.runs++;
+  _stats.misses += misses;
+  _stats.lastJitterUs = jitterUs;
+  _stats.totalJitterUs += jitterUs;
+  if (jitterUs > _stats.maxJitterUs) {
+    _stats.maxJitterUs = jitterUs;
+  }
+  _stats.lastRunUs = runUs;
+  if (runUs > _stats.maxRunUs) {
+    _stats.maxRunUs = runUs;
+  }
+  portEXIT_CRITICAL(&_mux);
+}
+
+JobStats JobClock::stats() const {
+  portENTER_CRITICAL(&_mux);
+  JobStats result = _stats;
+  portEXIT_CRITICAL(&_mux);
+  return result;
+}
+
+void JobClock::resetStats() {
+  portENTER_CRITICAL(&_mux);
+  const char* name = _stats.name;
+  memset(&_stats, 0, sizeof(_stats));
+  _stats.name = name;
+  _stats.periodUs = _periodUs;
+  portEXIT_CRITICAL(&_mux);
+}
+
+size_t JobClock::count() {
+  return jobRegistryCount;
+}
+
+JobClock* JobClock::at(size_t index) {
+  return index < jobRegistryCount ? jobRegistry[index] : nullptr;
+}
+
+void JobClock::logAll() {
+  Serial.println("Jobs:");
+  for (size_t i = 0; i < jobRegistryCount; i++) {
+    JobStats job = jobRegistry[i]->stats();
+    uint32_t averageJitterUs = job.runs > 0 ? (uint32_t)(job.totalJitterUs / job.runs) : 0;
+    Serial.printf("  %-12s every %5lu us  %8lu runs  %5lu misses  jitter avg %5lu / max %6lu us  run max %6lu us\n",
+                  job.name, (unsigned long)job.periodUs, (unsigned long)job.runs, (unsigned long)job.misses,
+                  (unsigned long)averageJitterUs, (unsigned long)job.maxJitterUs, (unsigned long)job.maxRunUs);
+  }
+}
+
+// --- JobScheduler ---
+
+JobScheduler::JobScheduler() : _jobCount(0) {
+}
+
+bool JobScheduler::add(JobClock& clock, JobFunction function) {
+  if (_jobCount == JOB_SCHEDULER_MAX_JOBS || function == nullptr) {
+    return false;
+  }
+  _clocks[_jobCount] = &clock;
+  _functions[_jobCount] = function;
+  _jobCount++;
+  return true;
+}
+
+void JobScheduler::start() {
+  for (size_t i = 0; i < _jobCount; i++) {
+    _clocks[i]->start();
+  }
+}
+
+uint32_t JobScheduler::runNext() {
+  if (_jobCount == 0) {
+    vTaskDelay(1);
+    return 0;
+  }
+  int64_t earliest = _clocks[0]->releaseUs();
+  for (size_t i = 1; i < _jobCount; i++) {
+    earliest = min(earliest, _clocks[i]->releaseUs());
+  }
+  sleepUntil(earliest);
+
+  int64_t now = esp_timer_get_time();
+  int64_t begin = now;
+  for (size_t i = 0; i < _jobCount; i++) {
+    if (!_clocks[i]->due(now)) {
+      continue;
+    }
+    _clocks[i]->started(now);
+    _functions[i]();
+    now = esp_timer_get_time();
+    _clocks[i]->finished(now);
+  }
+  return (uint32_t)(now - begin);
+}
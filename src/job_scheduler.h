@@ -0,0 +1,139 @@
+#ifndef JOB_SCHEDULER_H
+#define JOB_SCHEDULER_H
+
+#include <Arduino.h>
+#include <esp_timer.h>
+
+// ========================================
+// FIXED-RATE JOBS WITH DEADLINE ACCOUNTING
+// ========================================
+// Every periodic piece of work is a job with an absolute release time on the
+// esp_timer clock. A job runs at its release time; the next release is one
+// period later, however long this run took, so the rate does not drift with
+// the work. For every run the job records:
+//
+//   jitter  how late it started after its release
+//   miss    it was still running when its next release came, or it started
+//           so late that whole periods went by; those periods are skipped
+//           and the grid restarts from now instead of running back to back
+//
+// A task that does one job sleeps with JobClock::sleepUntilRelease(). A task
+// that does several runs them through a JobScheduler, which sleeps until the
+// earliest release and then runs every job that is due, in the order they
+// were added. Jobs that are triggered by something else (the engine runs per
+// sample) report each run through JobClock::account().
+//
+// All jobs register themselves, so they can be listed together.
+
+// Jobs that can exist at once, over all tasks
+#define JOB_CLOCK_MAX 8
+
+// Jobs one scheduler runs
+#define JOB_SCHEDULER_MAX_JOBS 6
+
+struct JobStats {
+  const char* name;
+  uint32_t periodUs;
+  uint32_t runs;
+  uint32_t misses;        // Runs that overran into the next period, plus skipped periods
+  uint32_t lastJitterUs;
+  uint32_t maxJitterUs;
+  uint64_t totalJitterUs;
+  uint32_t lastRunUs;
+  uint32_t maxRunUs;
+};
+
+/**
+ * @brief Release times and timing statistics of one fixed-period job. Stats can be read from any task.
+ */
+class JobClock
+{
+public:
+  JobClock(const char* name, uint32_t periodMs);
+
+  /**
+   * @brief Makes the first release now. Call in the task that runs the job, before its first run.
+   */
+  void start();
+
+  void setPeriodMs(uint32_t periodMs);
+  uint32_t periodUs() const { return _periodUs; }
+  int64_t releaseUs() const { return _releaseUs; }
+  bool due(int64_t nowUs) const { return nowUs >= _releaseUs; }
+
+  /**
+   * @brief Blocks the calling task until the next release.
+   */
+  void sleepUntilRelease() const;
+
+  /**
+   * @brief Start of a run: records how late it is.
+   */
+  void started(int64_t nowUs);
+
+  /**
+   * @brief End of a run: records its duration and any miss, then moves to the next release.
+   */
+  void finished(int64_t nowUs);
+
+  /**
+   * @brief Records a run of a job that is released by something else, e.g. a queued sample.
+   * @param releaseUs When the run was released; it has to end within one period after that.
+   */
+  void account(int64_t releaseUs, int64_t startUs, int64_t endUs);
+
+  JobStats stats() const;
+  void resetStats();
+
+  static size_t count();
+  static JobClock* at(size_t index);
+
+  /**
+   * @brief Prints one line per job: period, runs, misses, average and worst jitter, worst run time.
+   */
+  static void logAll();
+
+private:
+  void record(uint32_t jitterUs, uint32_t runUs, uint32_t misses);
+
+  JobStats _stats;
+  uint32_t _periodUs;
+  int64_t _releaseUs;
+  int64_t _startUs;
+  mutable portMUX_TYPE _mux;
+};
+
+typedef void (*JobFunction)();
+
+/**
+ * @brief Cooperative scheduler that runs several fixed-period jobs in the calling task.
+ */
+class JobScheduler
+{
+public:
+  JobScheduler();
+
+  /**
+   * @brief Adds a job. Jobs that are due at the same time run in the order they were added.
+   * @return False if the scheduler is full.
+   */
+  bool add(JobClock& clock, JobFunction function);
+
+  /**
+   * @brief Makes every job due now. Call once before the first runNext().
+   */
+  void start();
+
+  /**
+   * @brief Sleeps until the earliest release, then runs every job that is due.
+   * @return Time spent running jobs (us), without the sleep.
+   */
+  uint32_t runNext();
+
+private:
+  JobClock* _clocks[JOB_SCHEDULER_MAX_JOBS];
+  JobFunction _functions[JOB_SCHEDULER_MAX_JOBS];
+  size_t _jobCount;
+};
+
+#endif // JOB_SCHEDULER_H
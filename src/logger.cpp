@@ -0,0 +1,228 @@
+#include <Arduino.h>
+#include <SPIFFS.h>
+#include <stdarg.h>
+#include "logger.h"
+
+Logger logger;
+
+static_assert((LOG_BUFFER_BYTES & (LOG_BUFFER_BYTES - 1)) == 0, "LOG_BUFFER_BYTES must be a power of two, the ring indices wrap at 2^32");
+static_assert(LOG_LINE_MAX <= 256, "Line lengths are stored in one byte");
+
+// Each line in the ring: millis(), level, text length, then the text without a terminator
+struct LogHeader {
+  uint32_t ms;
+  uint8_t level;
+  uint8_t length;
+};
+
+// The one ring behind the logger, shared by every writer and the drain task
+static uint8_t ringBuffer[LOG_BUFFER_BYTES];
+static size_t ringHead = 0; // Write position, free running; index with % LOG_BUFFER_BYTES
+static size_t ringTail = 0; // Read position, free running
+static LogStats ringStats = {0, 0, 0, LOG_BUFFER_BYTES, 0, 0};
+static portMUX_TYPE ringMux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t drainTaskHandle = nullptr;
+static uint32_t reportedDropped = 0; // Drain task only
+
+static size_t ringUsed() {
+  return ringHead - ringTail;
+}
+
+// Both helpers run inside the critical section and wrap around the end of the buffer
+
+static void ringPut(const uint8_t* data, size_t length) {
+  size_t offset = ringHead % LOG_BUFFER_BYTES;
+  size_t first = min(length, (size_t)LOG_BUFFER_BYTES - offset);
+  memcpy(ringBuffer + offset, data, first);
+  memcpy(ringBuffer, data + first, length - first);
+  ringHead += length;
+}
+
+static void ringTake(uint8_t* data, size_t length) {
+  size_t offset = ringTail % LOG_BUFFER_BYTES;
+  size_t first = min(length, (size_t)LOG_BUFFER_BYTES - offset);
+  memcpy(data, ringBuffer + offset, first);
+  memcpy(data + first, ringBuffer, length - first);
+  ringTail += length;
+}
+
+static bool ringPop(uint32_t& ms, uint8_t& level, char* text, size_t& length) {
+  portENTER_CRITICAL(&ringMux);
+  if (ringUsed() == 0) {
+    portEXIT_CRITICAL(&ringMux);
+    return false;
+  }
+  LogHeader header;
+  ringTake((uint8_t*)&header, sizeof(header));
+  ringTake((uint8_t*)text, header.length);
+  portEXIT_CRITICAL(&ringMux);
+  ms = header.ms;
+  level = header.level;
+  length = header.length;
+  return true;
+}
+
+/**
+ * @brief Writes out everything in the ring. Only the drain task (or flush() without it) calls this.
+ */
+static void drainRing(bool toFile) {
+  static const char LEVEL_LETTERS[] = "-EWIDT";
+  char line[LOG_LINE_MAX + 24];
+  char text[LOG_LINE_MAX];
+  File file;
+  bool fileOpen = false;
+
+  uint32_t ms;
+  uint8_t level;
+  size_t length;
+  while (ringPop(ms, level, text, length)) {
+    int prefix = snprintf(line, sizeof(line), "%6lu.%03lu %c ", (unsigned long)(ms / 1000), (unsigned long)(ms % 1000),
+                          LEVEL_LETTERS[level <= LOG_LEVEL_TRACE ? level : 0]);
+    memcpy(line + prefix, text, length);
+    size_t total = prefix + length;
+    line[total++] = '\n';
+    Serial.write((const uint8_t*)line, total);
+
+    if (toFile && !fileOpen) {
+      file = SPIFFS.open(LOG_FILE_PATH, "a");
+      fileOpen = true;
+    }
+    if (fileOpen && file) {
+      file.write((const uint8_t*)line, total);
+    }
+  }
+
+  portENTER_CRITICAL(&ringMux);
+  uint32_t dropped = ringStats.dropped;
+  portEXIT_CRITICAL(&ringMux);
+  if (dropped != reportedDropped) {
+    Serial.printf("[log] %lu lines dropped, the buffer was full\n", (unsigned long)(dropped - reportedDropped));
+    reportedDropped = dropped;
+  }
+
+  if (fileOpen && file) {
+    bool rotate = file.size() >= LOG_FILE_MAX_BYTES;
+    file.close();
+    if (rotate) {
+      SPIFFS.remove(LOG_FILE_OLD_PATH);
+      SPIFFS.rename(LOG_FILE_PATH, LOG_FILE_OLD_PATH);
+    }
+  }
+}
+
+static void drainTask(void* parameter) {
+  Logger* owner = static_cast<Logger*>(parameter);
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LOG_DRAIN_PERIOD_MS));
+    drainRing(owner->fileOutput());
+  }
+}
+
+Logger::Logger() : _level(LOG_LEVEL), _fileOutput(false) {
+}
+
+void Logger::begin() {
+  if (drainTaskHandle != nullptr) {
+    return;
+  }
+  if (xTaskCreate(drainTask, "log", LOG_TASK_STACK_SIZE, this, LOG_TASK_PRIORITY, &drainTaskHandle) != pdPASS) {
+    drainTaskHandle = nullptr;
+    Serial.println("Failed to start the log task, log lines are written by flush() only.");
+  }
+}
+
+void Logger::setLevel(uint8_t level) {
+  _level = level > LOG_LEVEL ? LOG_LEVEL : level;
+}
+
+void Logger::write(uint8_t level, const char* format, ...) {
+  char text[LOG_LINE_MAX];
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(text, sizeof(text), format, args);
+  va_end(args);
+  if (length < 0) {
+    return;
+  }
+  bool cut = (size_t)length >= sizeof(text);
+  if (cut) {
+    length = sizeof(text) - 1;
+  }
+  LogHeader header = {(uint32_t)millis(), level, (uint8_t)length};
+  size_t needed = sizeof(header) + length;
+
+  bool wake = false;
+  portENTER_CRITICAL(&ringMux);
+  if (LOG_BUFFER_BYTES - ringUsed() < needed) {
+    ringStats.dropped++;
+  } else {
+    ringPut((const uint8_t*)&header, sizeof(header));
+    ringPut((const uint8_t*)text, length);
+    ringStats.lines++;
+    if (cut) {
+      ringStats.cut++;
+    }
+    if (ringUsed() > ringStats.peakBytes) {
+      ringStats.peakBytes = ringUsed();
+    }
+    wake = level <= LOG_LEVEL_WARN || ringUsed() >= LOG_BUFFER_BYTES / 2;
+  }
+  portEXIT_CRITICAL(&ringMux);
+
+  if (wake && drainTaskHandle != nullptr) {
+    xTaskNotifyGive(drainTaskHandle);
+  }
+}
+
+void Logger::setFileOutput(bool enabled) {
+  _fileOutput = enabled;
+  Serial.printf("Log file %s (%s)\n", enabled ? "on" : "off", LOG_FILE_PATH);
+}
+
+void Logger::flush(uint32_t timeoutMs) {
+  if (drainTaskHandle == nullptr || xTaskGetCurrentTaskHandle() == drainTaskHandle) {
+    drainRing(_fileOutput);
+    return;
+  }
+  uint32_t start = millis();
+  for (;;) {
+    portENTER_CRITICAL(&ringMux);
+    bool empty = ringUsed() == 0;
+    portEXIT_CRITICAL(&ringMux);
+    if (empty || millis() - start >= timeoutMs) {
+      return;
+    }
+    xTaskNotifyGive(drainTaskHandle);
+    vTaskDelay(1);
+  }
+}
+
+LogStats Logger::stats() const {
+  portENTER_CRITICAL(&ringMux);
+  LogStats result = ringStats;
+  result.usedBytes = ringUsed();
+  portEXIT_CRITICAL(&ringMux);
+  return result;
+}
+
+const char* Logger::levelName(uint8_t level) {
+  switch (level) {
+    case LOG_LEVEL_NONE: return "none";
+    case LOG_LEVEL_ERROR: return "error";
+    case LOG_LEVEL_WARN: return "warn";
+    case LOG_LEVEL_INFO: return "info";
+    case LOG_LEVEL_DEBUG: return "debug";
+    case LOG_LEVEL_TRACE: return "trace";
+    default: return "?";
+  }
+}
+
+bool Logger::parseLevel(const char* name, uint8_t& level) {
+  for (uint8_t i = LOG_LEVEL_NONE; i <= LOG_LEVEL_TRACE; i++) {
+    if (strcmp(name, levelName(i)) == 0) {
+      level = i;
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,128 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <Arduino.h>
+
+// ========================================
+// BUFFERED LOGGING WITH COMPILE-TIME LEVELS
+// ========================================
+// LOG_ERROR() .. LOG_TRACE() take printf arguments. A call above LOG_LEVEL is
+// compiled out completely: the arguments are still type-checked but never
+// evaluated, and the format string does not end up in flash.
+//
+// An enabled call formats the line into a stack buffer and copies it into a
+// RAM ring buffer; it never waits for the serial port. A low-priority drain
+// task writes the buffered lines to Serial and, when switched on, appends them
+// to LOG_FILE_PATH on SPIFFS. When the ring is full (no host reading the
+// USB-CDC port, a burst of lines) new lines are dropped and counted, and the
+// drain task reports how many once it catches up.
+//
+// The drain task wakes every LOG_DRAIN_PERIOD_MS, or at once for warnings,
+// errors and a ring that is half full, so hot paths do not cause a context
+// switch per line.
+//
+// Interactive reports (the serial console, boot timeline) still print to
+// Serial directly, as they are requested and expected at once.
+
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+#define LOG_LEVEL_TRACE 5
+
+// Highest level compiled in; set with -D LOG_LEVEL=... in platformio.ini
+#ifndef LOG_LEVEL
+  #define LOG_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+#ifndef LOG_BUFFER_BYTES
+  #define LOG_BUFFER_BYTES 4096
+#endif
+#define LOG_LINE_MAX 160              // Longer lines are cut
+#define LOG_DRAIN_PERIOD_MS 50
+#define LOG_TASK_STACK_SIZE 3072
+#define LOG_TASK_PRIORITY 1           // With the persistence task, below everything that measures
+#define LOG_FILE_PATH "/log.txt"
+#define LOG_FILE_OLD_PATH "/log.old.txt"
+#define LOG_FILE_MAX_BYTES 32768      // The file is rotated to LOG_FILE_OLD_PATH at this size
+
+#define LOG_AT(level, ...) \
+  do { \
+    if ((level) <= LOG_LEVEL && logger.enabled(level)) { \
+      logger.write((level), __VA_ARGS__); \
+    } \
+  } while (0)
+
+#define LOG_ERROR(...) LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+#define LOG_WARN(...)  LOG_AT(LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_INFO(...)  LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_DEBUG(...) LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_TRACE(...) LOG_AT(LOG_LEVEL_TRACE, __VA_ARGS__)
+
+struct LogStats {
+  uint32_t lines;       // Lines accepted into the ring
+  uint32_t dropped;     // Lines lost because the ring was full
+  uint32_t cut;         // Lines longer than LOG_LINE_MAX
+  uint32_t bufferBytes;
+  uint32_t usedBytes;
+  uint32_t peakBytes;   // Most bytes waiting at once
+};
+
+/**
+ * @brief Ring-buffered log with a drain task that writes to Serial and optionally a SPIFFS file.
+ */
+class Logger
+{
+public:
+  Logger();
+
+  /**
+   * @brief Starts the drain task. Lines logged before this are kept and written once it runs.
+   */
+  void begin();
+
+  bool enabled(uint8_t level) const { return level <= _level; }
+
+  /**
+   * @brief Lowers the level at run time; it cannot go above the compiled-in LOG_LEVEL.
+   */
+  void setLevel(uint8_t level);
+  uint8_t level() const { return _level; }
+
+  /**
+   * @brief Formats one line (no trailing newline) into the ring. Never blocks on the output.
+   */
+  void write(uint8_t level, const char* format, ...) __attribute__((format(printf, 3, 4)));
+
+  /**
+   * @brief Also appends every line to LOG_FILE_PATH. SPIFFS must be mounted.
+   */
+  void setFileOutput(bool enabled);
+  bool fileOutput() const { return _fileOutput; }
+
+  /**
+   * @brief Waits until the ring is written out, e.g. before a restart.
+   */
+  void flush(uint32_t timeoutMs = 500);
+
+  LogStats stats() const;
+
+  static const char* levelName(uint8_t level);
+
+  /**
+   * @brief Level from its name ("error" .. "trace", "none").
+   * @return False if the name is unknown.
+   */
+  static bool parseLevel(const char* name, uint8_t& level);
+
+private:
+  // The ring, the drain task and their lock live in logger.cpp, so this header
+  // needs no FreeRTOS types and the host display emulator can include it
+  uint8_t _level;
+  volatile bool _fileOutput;
+};
+
+extern Logger logger;
+
+#endif // LOGGER_H
@@ -3,7 +3,27 @@
 #define LGFX_USE_V1
 #include <LovyanGFX.hpp>
 #include "board_config.h"     // ✅ Board-specific pin definitions
-// #include "axs5106l_device.h"   // Temporarily disabled. Board has an AXS5106L.
+#include "ring_buffer.h"      // Fixed-capacity history buffers
+#include "config_table.h"     // PowderConfig and interned config versions
+#include "measurement_store.h" // Persistent per-shot log on SPIFFS
+#include "rollups.h"          // Incremental session/config/day statistics
+#include "measurement_screen.h" // Retained-mode measurement screen with dirty rectangles
+#include "display_pipeline.h"  // Asynchronous DMA push of dirty areas
+#include "ui_palette.h"       // Palette indices for the 4-bit canvas
+#include "trace_view.h"       // Live weight trace using panel hardware scroll
+#include "display_power.h"    // Adaptive refresh rate and backlight policy
+#include "image_assets.h"     // Splash artwork, RLE RGB565 in flash (generated)
+#include "status_screens.h"   // Calibration and AP mode screens
+#include "display_clock.h"    // SPI clock sweep, fastest stable clock kept in NVS
+#include "boot_sequence.h"    // Boot stages, their dependencies and timeline
+#include "wifi_link.h"        // Event-driven Wi-Fi station with backoff and AP fallback
+#include "time_sync.h"        // Background SNTP, monotonic shot stamps, configurable time zone
+#include "task_monitor.h"     // Task priorities, stack budgets and worst-case execution times
+#include "stage_profiler.h"   // Cycle-counter timing and latency histograms per stage
+#include "job_scheduler.h"    // Fixed-rate jobs with jitter and deadline-miss accounting
+#include "logger.h"           // LOG_INFO() etc.: compile-time levels, ring buffer drained by a low-priority task
+#include "touch_input.h"      // AXS5106L read on its INT line, taps and long presses queued for the UI
+#include "i2c_bus.h"          // One mutex for the I2C bus the ADS1115 and the touch controller share
 #include <Wire.h>              // For I2C communication with touch controller and ADS1115
 #include <WiFi.h>
 #include <WebServer.h>
@@ -21,6 +41,16 @@
 #include <Adafruit_ADS1X15.h> // For ADS1115 ADC
 
 // --- LovyanGFX Configuration ---
+// SPI write clock until a sweep has tuned it for this board (see display_clock.h)
+#ifndef DISPLAY_SPI_FREQ_WRITE
+  #define DISPLAY_SPI_FREQ_WRITE 10000000
+#endif
+
+// Extra time the splash stays up before boot continues; 0 = no hold
+#ifndef SPLASH_HOLD_MS
+  #define SPLASH_HOLD_MS 0
+#endif
+
 // ✅ Uses board-specific pins from board_config.h
 class LGFX : public lgfx::LGFX_Device
 {
@@ -35,12 +65,13 @@ public:
       auto cfg = _bus_instance.config();
       cfg.spi_host = SPI2_HOST;
       cfg.spi_mode = 0;
-      cfg.freq_write = 10000000;
+      cfg.freq_write = DISPLAY_SPI_FREQ_WRITE;
       cfg.freq_read  = 8000000;
       cfg.pin_sclk = TFT_SCLK;  // ✅ From board_config.h
       cfg.pin_mosi = TFT_MOSI;  // ✅ From board_config.h
       cfg.pin_miso = -1;
       cfg.pin_dc   = TFT_DC;    // ✅ From board_config.h
+      cfg.dma_channel = SPI_DMA_CH_AUTO; // Frames are pushed asynchronously by displayPipeline
       _bus_instance.config(cfg);
       _panel_instance.setBus(&_bus_instance);
     }
@@ -77,6 +108,19 @@ public:
 
     setPanel(&_panel_instance);
   }
+
+  /**
+   * @brief Changes the SPI write clock. The bus is re-initialised so the new divider takes effect.
+   */
+  void setWriteClock(uint32_t frequency)
+  {
+    waitDMA();
+    auto cfg = _bus_instance.config();
+    cfg.freq_write = frequency;
+    _bus_instance.release();
+    _bus_instance.config(cfg);
+    _bus_instance.init();
+  }
 };
 
 // --- Pin Definitions ---
@@ -102,8 +146,42 @@ LGFX_Sprite canvas(&gfx);  // Create sprite buffer for smooth rendering
 // Use 'display' for all drawing in draw functions
 LGFX_Sprite& display = canvas;
 
-// Touch data struct
-// touch_data_t touch_data; // Temporarily disabled
+// Measurement screen keeps its last drawn state and only repaints/pushes what changed
+MeasurementScreen measurementScreen(canvas);
+
+// Scrolling weight trace, drawn straight to the panel
+TraceView traceView(gfx);
+
+// Fastest stable SPI clock for this board's display wiring
+DisplayClockTuner displayClock;
+
+// Station link with reconnect backoff and access point fallback
+WifiLink wifiLink;
+bool captiveDnsRunning = false; // dnsServer follows wifiLink.apActive(), see updateCaptiveDns()
+uint32_t firstWebSocketClientMs = 0; // millis() of the first WebSocket client since power-on, 0 = none yet
+
+// --- Store and forward ---
+// Measuring never waits for the network. Every shot is in measurementStore
+// under its sequence number, so a client that was cut off asks for the shots
+// after the last sequence it saw (see handleReplayCommand()).
+bool networkOnline = false;
+uint32_t offlineFromSequence = 0; // First shot recorded since the network went down
+#define REPLAY_BATCH_SIZE 32 // Shots per replay message; the client asks for the next batch
+
+// Wall clock; shots stamped before the first SNTP sync are back-dated by onFirstTimeSync()
+TimeSync timeSync;
+uint32_t bootFirstSequence = 0; // First measurementStore sequence recorded on this boot
+uint32_t provisionalEndSequence = 0; // End of this boot's shots stamped before the first sync (exclusive)
+uint32_t backfillFirstSequence = 0;  // Back-dated shots whose days are still to be added, see backfillPendingDays()
+uint32_t backfillEndSequence = 0;
+size_t sessionLogsThisBoot = 0; // Session logs ended on this boot, the newest ones in sessionLogs
+
+// --- Boot ---
+// Stages run concurrently where they can; loop() finishes the network ones
+BootSequence bootSequence;
+bool bootTimelineLogged = false;
+#define BOOT_DISPLAY_TASK_STACK_SIZE 4096
+const unsigned long BOOT_TIME_TIMEOUT_MS = 10000; // Boot stops waiting for SNTP; the sync itself keeps going
 
 // --- Button Pin Definitions ---
 // Removed: No longer using physical buttons
@@ -118,12 +196,7 @@ LGFX_Sprite& display = canvas;
 // potMaxAdc is no longer used in 2-step calibration.
 const float MEASUREMENT_RANGE_MM = 60.0; // 60mm travel for Bourns PTA6043-2015DPB103
 
-// Calibration state machine
-enum CalibrationState {
-  CALIBRATE_NONE,
-  CALIBRATE_ZERO_STEP,      // Step 1: Set probe at 0mm
-  CALIBRATE_KNOWN_GRAINS_STEP // Step 2: Set probe at known grains
-};
+// Calibration state machine (CalibrationState is in status_screens.h)
 CalibrationState currentCalibrationState = CALIBRATE_NONE;
 float tempZeroAdc = 0.0; // Temporary storage for zero calibration ADC value
 float tempKnownGrainsDepth = 0.0; // Temporary storage for depth during known grains calibration
@@ -161,18 +234,8 @@ size_t updateReceived = 0;
 
 // --- Configuration Management ---
 #define MAX_CONFIGS 20 // Max number of custom configurations
-struct PowderConfig {
-  char name[32];
-  char caliber[24];
-  char bulletWeight[10];
-  char powderName[24];
-  float targetGrain;
-  // New fields for per-config calibration
-  float potMinAdc;
-  float grainsPerMmFactor;
-  bool isCalibrated;
-};
-
+// PowderConfig is defined in config_table.h. Every edit publishes a new version
+// to configTable so measurements can reference it without copying it.
 PowderConfig powderConfigs[MAX_CONFIGS];
 int configCount = 0;
 int currentConfigIndex = -1; // -1 means no config selected
@@ -184,16 +247,18 @@ unsigned long systemUptimeMillis = 0;
 struct Measurement {
   time_t timestamp; // Epoch time (seconds since 1970-01-01)
   float weight;
-  PowderConfig config; // Store a copy of the config at time of measurement
-  bool configWasSet;   // Flag to know if a config was active
+  uint16_t configId;      // Interned config (CONFIG_ID_NONE if no config was active)
+  uint16_t configVersion; // Version of the config at time of measurement
 };
-#define MAX_MEASUREMENTS_HISTORY 100 // Store up to 100 measurements
-Measurement measurementHistory[MAX_MEASUREMENTS_HISTORY];
+// Override at build time with -D MAX_MEASUREMENTS_HISTORY=<n> in platformio.ini
+#ifndef MAX_MEASUREMENTS_HISTORY
+  #define MAX_MEASUREMENTS_HISTORY 1000 // Store up to 1000 measurements (16 bytes each)
+#endif
+RingBuffer<Measurement, MAX_MEASUREMENTS_HISTORY> measurementHistory; // Oldest first, overwrites oldest when full
+#define STATE_RECENT_MEASUREMENTS 50 // Newest shots in each state message; older ones come from the replay or the exports
 int measurementCount = 0; // Total measurements taken
-int sessionMeasurementCount = 0; // Measurements in current session
-float minWeight = 0.0; // Initialize with 0.0, will be set on first measurement
-float maxWeight = 0.0;    // Initialize with 0.0, will be set on first measurement
-float sumWeight = 0.0;
+int sessionMeasurementCount = 0; // Measurements in current session (may exceed history capacity)
+// Session min/max/sum/SD live in rollupStore.session()
 
 // Session log for tracking completed sessions
 struct SessionLog {
@@ -201,15 +266,19 @@ struct SessionLog {
   time_t endTime;   // Epoch time when session ended
   int bulletCount;         // Number of bullets created in session
   float totalWeight;       // Total weight measured in session
-  // Store measurement indices for this session
-  int measurementStartIndex; // Index of first measurement in this session
-  int measurementCount;      // Number of measurements in this session
+  // Range of this session's shots in measurementStore
+  uint32_t measurementStartIndex; // Sequence number of first measurement in this session
+  int measurementCount;           // Number of measurements in this session
+  Rollup stats;                   // Count/sum/SD/ES/in-band/histogram at session end
 };
 #define MAX_SESSION_LOGS 50 // Store up to 50 session logs
-SessionLog sessionLogs[MAX_SESSION_LOGS];
-int sessionLogCount = 0;
+RingBuffer<SessionLog, MAX_SESSION_LOGS> sessionLogs; // Oldest first, overwrites oldest when full
+
+// JSON pool for /depth and the state broadcast: configs plus display and Wi-Fi stats,
+// then one object per recent shot (with its config) and per session log
+#define STATE_JSON_SIZE (3584 + STATE_RECENT_MEASUREMENTS * 192 + MAX_SESSION_LOGS * 160)
 unsigned long currentSessionStartTime = 0; // Track start time of current session
-int sessionStartMeasurementIndex = 0; // Track where current session measurements start
+uint32_t sessionStartMeasurementIndex = 0; // Sequence number of the current session's first measurement
 
 // Alarm settings
 // Changed default lowThreshold to 0.0 and highThreshold to 100.0
@@ -230,39 +299,197 @@ bool lastMeasurementTaken = false; // Flag to prevent continuous counting at per
 const float RESET_MEASUREMENT_THRESHOLD = 0.1; // Weight must drop below this to allow next measurement
 
 // --- Display Update Variables ---
-unsigned long lastDisplayUpdateTime = 0;
 const unsigned long DISPLAY_UPDATE_INTERVAL_MS = 100; // ✅ FASTER - Update display every 100ms (10 times per second)
+const unsigned long DISPLAY_SETTLED_INTERVAL_MS = 1000; // Once the weight has settled, 1 frame per second is enough
+
+// Frame rate and backlight follow signal activity; the engine feeds it, the display task applies it
+DisplayPowerPolicy displayPower;
 // Keep track of the current screen to know when to clear fully
 enum ScreenState {
   SCREEN_MEASUREMENT,
   SCREEN_CALIBRATION,
-  SCREEN_AP_MODE
+  SCREEN_AP_MODE,
+  SCREEN_TRACE
 };
 ScreenState currentScreenState = SCREEN_MEASUREMENT; // Default to measurement screen
 
+// What the device shows while measuring; set with setSetting "displayView" and saved with the settings
+enum DisplayView {
+  DISPLAY_VIEW_READOUT, // Measurement screen
+  DISPLAY_VIEW_TRACE    // Scrolling weight trace
+};
+DisplayView displayView = DISPLAY_VIEW_READOUT;
+
+// --- Display Task ---
+// Rendering runs in its own FreeRTOS task, paced to the interval displayPower picks.
+// The engine publishes everything a frame needs as one snapshot after each
+// sample; the task copies it under a lock, so a frame never mixes values from
+// two samples and never reads globals that the other tasks are changing.
+struct DisplaySnapshot {
+  ScreenState screen;
+  float weight;
+  float adc;
+  bool alarmActive;
+  bool alarmEnabled;
+  float lowThreshold;
+  float highThreshold;
+  bool hasConfig;
+  char configName[32];
+  float targetGrain;
+  CalibrationState calibrationState;
+  uint32_t ip;
+  bool offline;         // Station link down; shots are still recorded
+  uint32_t queuedShots; // Shots recorded since it went down
+  // Weight envelope since the display task last took a snapshot, for the trace
+  float traceMin;
+  float traceMax;
+  uint16_t traceSamples;
+  uint32_t shotCount;
+  // Refresh policy for this frame
+  DisplayPowerMode powerMode;
+  uint32_t frameIntervalMs;
+  uint8_t brightness;
+};
+DisplaySnapshot displaySnapshot;
+portMUX_TYPE displaySnapshotMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Written by the display task only
+struct DisplayTaskStats {
+  uint32_t frames;
+  uint32_t missedFrames; // Frame slots skipped because a frame overran its interval
+  uint32_t lastFrameUs;  // Snapshot to last pixel sent
+  uint32_t maxFrameUs;
+};
+DisplayTaskStats displayTaskStats = {0, 0, 0, 0};
+
+#define DISPLAY_TASK_STACK_SIZE 6144
+#define DISPLAY_TASK_PRIORITY 3
+TaskHandle_t displayTaskHandle = nullptr;
+
+// Benchmarks run inside the display task, which owns the panel; loop() reports the result
+volatile int pendingDisplayBenchmarkFrames = 0;
+volatile bool displayBenchmarkReady = false;
+DisplayBenchmarkResult displayBenchmarkResult;
+volatile bool pendingDisplayClockSweep = false; // Set by command, run by the display task
+volatile uint32_t pendingDisplayClock = 0;      // Fixed clock requested by command, applied by the display task
+volatile bool displayClockSweepReady = false;
+
+// --- Tasks ---
+// Sampling, measuring, rendering, networking and flash writes each run in a
+// task of their own, in that order of priority (see task_monitor.h). The
+// acquisition task hands raw samples to the engine through sampleQueue, the
+// engine hands recorded shots to the persistence task through persistQueue,
+// and the display task reads the display snapshot. The measurement state in
+// the globals above is shared by the engine, loop() and the persistence task,
+// which only touch it while holding a StateLock.
+#define ACQUISITION_TASK_STACK_SIZE 3072
+#define ACQUISITION_TASK_PRIORITY 5
+#define ACQUISITION_PERIOD_MS 10 // The ADS1115 converts continuously at 128 SPS, a new result every ~8 ms
+#define ENGINE_TASK_STACK_SIZE 6144
+#define ENGINE_TASK_PRIORITY 4
+#define NETWORK_TASK_STACK_SIZE 8192 // Arduino loop task, size set by the core
+#define NETWORK_TASK_PRIORITY 2
+#define NETWORK_POLL_MS 5
+#define HOUSEKEEPING_PERIOD_MS 50 // Boot stages, time sync, offline tracking, captive DNS
+#define PERSISTENCE_TASK_STACK_SIZE 6144
+#define PERSISTENCE_TASK_PRIORITY 1
+#define SAMPLE_QUEUE_LENGTH 64 // 640 ms of samples while the engine waits for the state lock
+#define PERSIST_QUEUE_LENGTH 16
+#define PERSIST_OVERFLOW_LENGTH 32 // Shots held back while persistQueue is full, dropped beyond that
+#define PERSISTENCE_IDLE_MS 250 // How often an idle persistence task checks for rollups and session logs to save
+
+// Worst case each task is expected to stay within per cycle
+#define ACQUISITION_BUDGET_US (ACQUISITION_PERIOD_MS * 1000UL)
+#define ENGINE_BUDGET_US (ACQUISITION_PERIOD_MS * 1000UL) // Must keep up with the samples
+#define DISPLAY_BUDGET_US (DISPLAY_UPDATE_INTERVAL_MS * 1000UL)
+#define NETWORK_BUDGET_US 50000UL
+#define PERSISTENCE_BUDGET_US 200000UL // Sealing a history block writes 1 KB to flash
+
+struct AdcSample {
+  int64_t us;   // esp_timer time when it was read
+  int32_t raw;  // ADS1115 or direct ADC count
+};
+
+// A recorded shot on its way to measurementStore
+struct ShotRecord {
+  uint32_t sequence;
+  uint32_t timestamp;
+  float weight;
+  uint16_t configId;
+  uint16_t configVersion;
+};
+
+QueueHandle_t sampleQueue = nullptr;
+QueueHandle_t persistQueue = nullptr;
+TaskHandle_t acquisitionTaskHandle = nullptr;
+TaskHandle_t engineTaskHandle = nullptr;
+TaskHandle_t persistenceTaskHandle = nullptr;
+volatile uint32_t sampleOverruns = 0;    // Samples dropped because the engine fell behind
+RingBuffer<ShotRecord, PERSIST_OVERFLOW_LENGTH> persistOverflow; // Newer than anything in persistQueue, guarded by persistOverflowMux
+portMUX_TYPE persistOverflowMux = portMUX_INITIALIZER_UNLOCKED;
+uint32_t persistOverflows = 0;           // Shots that went to persistOverflow because persistQueue was full
+uint32_t persistDropped = 0;             // Shots never written because persistOverflow was full too
+uint32_t persistQueuePeak = 0;           // Most shots waiting at once
+uint32_t nextShotSequence = 0;           // Sequence of the next shot; measurementStore catches up in the persistence task
+volatile bool sessionLogsSavePending = false; // Set with the state lock held; the persistence task writes them without it
+volatile bool stateBroadcastPending = false; // Set by whoever holds the state lock, which must not touch the sockets; sent once it is released
+float currentDepthAdc = 0.0;             // Averaged ADC value of the latest sample
+
+SemaphoreHandle_t stateMutex = nullptr;
+
+/**
+ * @brief Holds the shared measurement state for the lifetime of the object.
+ *        Recursive, so handlers that call each other can each take it.
+ *        Take it before any measurementStore call that needs it, never after.
+ */
+class StateLock
+{
+public:
+  StateLock() { xSemaphoreTakeRecursive(stateMutex, portMAX_DELAY); }
+  ~StateLock() { xSemaphoreGiveRecursive(stateMutex); }
+
+  /**
+   * @brief True if the calling task holds the lock, i.e. must not do network I/O now.
+   */
+  static bool held() { return xSemaphoreGetMutexHolder(stateMutex) == xTaskGetCurrentTaskHandle(); }
+  StateLock(const StateLock&) = delete;
+  StateLock& operator=(const StateLock&) = delete;
+};
+
 // --- Touch Button Definitions ---
 struct TouchButton {
   int x, y, width, height;
   String label;
-  uint16_t color;
+  uint16_t color; // UiColor, buttons are drawn into the canvas
   bool enabled;
 };
 
 // Touch buttons for main screen
-TouchButton calibrateBtn = {10, 280, 80, 30, "CAL", TFT_BLUE, true};
-TouchButton profileBtn = {100, 280, 80, 30, "PROF", TFT_GREEN, true};
-TouchButton settingsBtn = {190, 280, 80, 30, "SET", TFT_ORANGE, true};
+TouchButton calibrateBtn = {10, 280, 80, 30, "CAL", UI_BLUE, true};
+TouchButton profileBtn = {100, 280, 80, 30, "PROF", UI_GREEN, true};
+TouchButton settingsBtn = {190, 280, 80, 30, "SET", UI_ORANGE, true};
 
 // Touch buttons for calibration screen
 // NOTE: These buttons are currently unused as calibration is driven by the Web UI.
-// TouchButton zeroBtn = {20, 250, 100, 40, "ZERO", TFT_RED, true};
-// TouchButton spanBtn = {140, 250, 100, 40, "SPAN", TFT_YELLOW, true};
-// TouchButton backBtn = {260, 250, 50, 40, "BACK", TFT_DARKGREY, true};
+// TouchButton zeroBtn = {20, 250, 100, 40, "ZERO", UI_RED, true};
+// TouchButton spanBtn = {140, 250, 100, 40, "SPAN", UI_ORANGE, true}; // No yellow in the UI palette
+// TouchButton backBtn = {260, 250, 50, 40, "BACK", UI_DARKGREY, true};
 
 // --- WebSocket Update Variables ---
-unsigned long lastWebSocketUpdateTime = 0;
 const unsigned long WEBSOCKET_UPDATE_INTERVAL_MS = 500; // Update WebSocket every 500ms for faster web UI response
 
+// --- Jobs ---
+// Fixed-period work with absolute release times (see job_scheduler.h). Sample
+// and render pace their own tasks, the engine runs per sample and has to be
+// done before the next one, and loop() runs the rest through networkScheduler.
+JobClock sampleJob("sample", ACQUISITION_PERIOD_MS);
+JobClock engineJob("engine", ACQUISITION_PERIOD_MS);
+JobClock renderJob("render", DISPLAY_UPDATE_INTERVAL_MS); // Period follows displayPower
+JobClock ioJob("io", NETWORK_POLL_MS);
+JobClock housekeepingJob("housekeeping", HOUSEKEEPING_PERIOD_MS);
+JobClock broadcastJob("broadcast", WEBSOCKET_UPDATE_INTERVAL_MS);
+JobScheduler networkScheduler;
+
 // --- Stable Measurement Variables ---
 unsigned long lastGreenLEDTime = 0;
 bool wasGreenLED = false;
@@ -271,22 +498,54 @@ bool isStable = false; // Declare isStable globally
 
 // --- Function Prototypes ---
 void setupDisplay(); // Renamed from setupOLED
-float readDepthADC(); // Changed to return ADC value
+void bootDisplayTask(void* parameter);
+void setupSensor();
+void serviceBoot();
+void startNetworkServices();
+int32_t readRawDepthADC();
+float averageDepthADC(float rawAdc);
 float calculatePowderWeight(float adcValue); // Changed to accept ADC value
 void updateLEDs(float currentWeight); // ✅ Function prototype for RGB LED support
+void startMeasurementTasks();
+void acquisitionTask(void* parameter);
+void engineTask(void* parameter);
+void persistenceTask(void* parameter);
+bool savePendingFiles();
+void processSample(const AdcSample& sample);
+void updateAutoMeasure();
+void queueShot(const ShotRecord& shot);
+bool takeOverflowShot(ShotRecord& shot);
+bool waitForPersistence(uint32_t endSequence, uint32_t timeoutMs);
 void setupWiFi();
-void startAPMode(); // New function for AP mode
+void updateCaptiveDns();
+void onFirstTimeSync(uint32_t bootEpoch);
+bool backfillPendingDays(uint32_t timeoutMs);
+void handleSetTimeZoneCommand(const String& timeZone);
+void updateNetworkOnline();
+void handleReplayCommand(uint8_t client, uint32_t fromSequence);
+void handleStateCommand(const String& command, JsonDocument& doc);
+void handleProfileCommand(uint8_t client, const String& action);
+void handleSerialConsole();
+void serviceNetworkIo();
+void serviceHousekeeping();
+void broadcastState();
+void wifiStatsToJson(JsonObject out);
 void handleRoot();
 void handleGetDepth(); // Will be updated to send full state
 void handleApiMeasurement(); // New handler for /api/measurement fallback
 void handleNotFound();
 void sendCurrentStateToClients();
+void sendPendingState(); // Sends the state once the state lock is released
 void handleAutoMeasure(); // New function for auto-measurement
 // void displayExampleScreen(); // Removed as it's no longer used
 void saveSettings(); // Save settings to SPIFFS
 float calculateStandardDeviation(); // New function for standard deviation
 void loadSettings(); // Load settings from SPIFFS
+void saveSessionLogs(); // Save session logs to SPIFFS (binary)
+void writeSessionLogs(const SessionLog* logs, size_t count);
+void loadSessionLogs(); // Load session logs from SPIFFS (binary)
 void saveWiFiCredentials(const String& ssid, const String& password); // Modified to use NVS
+void saveWiFiStaticIp(const String& ip, const String& gateway, const String& subnet, const String& dns);
 void loadWiFiCredentials(); // Modified to use NVS
 void handleWiFiConfigSave(); // New function for AP mode config save
 void handleWiFiConfigPage(); // New function to serve AP mode config page
@@ -306,6 +565,10 @@ void handleStartSessionCommand(); // New command
 void handleEndSessionCommand(); // New command
 void handleExportDataCommand(); // HTTP endpoint for CSV export
 void handleExportSessionCommand(); // HTTP endpoint for session CSV export
+void handleHistoryStatsCommand(); // HTTP endpoint for long-range history aggregates
+void handleRollupsCommand(); // HTTP endpoint for per-config and per-day rollups
+void handleBootTimelineCommand(); // HTTP endpoint for the boot stage timeline
+void handleTasksCommand(); // HTTP endpoint for task execution times and queues
 void handleFactoryResetCommand(); // New command for factory reset
 void handleUpdateFirmwareCommand(String type, String filename, size_t size); // New command for OTA updates
 void handleUpdateFirmwareCommand(String type, String filename, size_t size); // New command for OTA updates
@@ -320,9 +583,26 @@ void setCalibrationKnownGrains(float knownWeight);
 void cancelCalibration();
 
 // New display functions
-void drawMeasurementScreen(float weight, bool alarmActive, float lowThreshold, float highThreshold);
-void drawCalibrationScreen(CalibrationState state, float currentAdc, float currentWeight); // Changed to currentWeight
-void drawAPModeScreen();
+const DirtyRegion& drawMeasurementScreen(const DisplaySnapshot& snapshot);
+void pushDirtyRegion(const DirtyRegion& region);
+void onDisplayFrameComplete(const DisplayFrameStats& stats);
+void handleDisplayBenchmarkCommand(int frames);
+void handleDisplayClockSweepCommand();
+void handleSetDisplayClockCommand(long frequency);
+void applyDisplayClock(uint32_t frequency);
+void sendDisplayClockSweepResult();
+void handleSetDisplayViewCommand(const String& view);
+void handleSetDisplayPowerCommand(const String& key, long value);
+const char* displayViewName(DisplayView view);
+void drawTraceScreen(const DisplaySnapshot& snapshot);
+void sendDisplayBenchmarkResult();
+void publishDisplaySnapshot(float currentAdc);
+void startDisplayTask();
+void displayTask(void* parameter);
+void renderDisplayFrame(const DisplaySnapshot& snapshot, ScreenState& shownScreen);
+void displayStatsToJson(JsonObject out);
+void recentMeasurementsToJson(JsonArray out);
+void sessionLogsToJson(JsonArray out);
 
 // Touch handling functions
 void handleTouch();
@@ -354,307 +634,428 @@ String getContentType(String filename){
 
 void setup() {
   Serial.begin(115200);
-  Serial.println("Starting Powder Depth Measurement System...");
-  Serial.printf("Board: %s\n", BOARD_NAME);  // ✅ Print board name
+  logger.begin(); // Before anything logs, so no task waits on the serial port
+  bootSequence.begin();
+  stateMutex = xSemaphoreCreateRecursiveMutex();
+  // setup() and loop() run in the Arduino loop task, which does the network I/O
+  vTaskPrioritySet(nullptr, NETWORK_TASK_PRIORITY);
+  taskMonitor.attach(TASK_NETWORK, "network", nullptr, NETWORK_TASK_STACK_SIZE, NETWORK_BUDGET_US);
+  LOG_INFO("Starting Powder Depth Measurement System...");
+  LOG_INFO("Board: %s", BOARD_NAME);
 
   #ifdef HAS_RGB_LED
-    Serial.println("Initializing RGB LED...");
+    LOG_INFO("Initializing RGB LED...");
     FastLED.addLeds<WS2812B, RGB_LED_PIN, RGB>(leds, NUM_LEDS);  // ✅ RGB color order (not GRB)
     leds[0] = CRGB::Black;
     FastLED.show();
   #else
-    Serial.println("No RGB LED on this board");
+    LOG_INFO("No RGB LED on this board");
   #endif
 
-  // Removed: Button Pin Initialization
-
-  // Initialize SPI for the display with non-default pins
-  // SPI.begin(TFT_SCLK, -1, TFT_MOSI, -1); // Not needed for software SPI (Arduino_ESP32SPI)
-
-  Serial.println("Initializing Display...");
-  setupDisplay(); // Initialize the new display and touch controller
-  Serial.println("Display Initialized.");
-
-  // Initialize sprite buffer for double buffering (eliminates flicker!)
-  canvas.createSprite(gfx.width(), gfx.height());
-  canvas.fillSprite(TFT_BLACK); // ✅ Ensure sprite starts with black background
-  Serial.printf("Sprite buffer created: %dx%d pixels\n", gfx.width(), gfx.height());
-
-  // Initialize direct ADC pin as fallback (in case ADS1115 initialization fails)
-  pinMode(LEVEL_SENSOR_PIN, INPUT);
+  // Wi-Fi first: it associates in the background while everything else starts.
+  // The credentials are in NVS, so this does not have to wait for SPIFFS.
+  loadWiFiCredentials();
+  setupWiFi();
+  // SNTP polls in the background from here on; nothing waits for it
+  timeSync.onFirstSync(onFirstTimeSync);
+  timeSync.begin(TIME_ZONE_DEFAULT); // Needs the network stack, so after setupWiFi()
+
+  // Panel reset and init are mostly fixed waits, so the display gets its own task
+  // and comes up while the sensor, SPIFFS and the settings are loaded here.
+  if (xTaskCreate(bootDisplayTask, "bootDisplay", BOOT_DISPLAY_TASK_STACK_SIZE, nullptr, DISPLAY_TASK_PRIORITY, nullptr) != pdPASS) {
+    LOG_ERROR("Failed to start display init task, initializing the display inline.");
+    setupDisplay();
+  }
+
+  setupSensor();
+#ifdef TOUCH_INT_PIN
+  touchInput.setOrientation(DISPLAY_ROTATION, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  touchInput.begin(&Wire, i2cBusMutex, TOUCH_RST_PIN, TOUCH_INT_PIN); // Resets the controller in its own task
+#endif
 
-  // Initial message on Display - with multiple explicit display calls
-  gfx.fillScreen(TFT_BLACK);
-  gfx.display();
-  gfx.flush();
-  delay(100);
-  
-  gfx.setTextColor(TFT_WHITE, TFT_BLACK);
-  gfx.setTextSize(2); // Increased font size
-  String initMsg = "... System Initializing ...";
-  uint16_t msgWidth = gfx.textWidth(initMsg);
-  int initX = (gfx.width() - msgWidth) / 2; // Center horizontally
-  gfx.setCursor(initX, 10);
-  gfx.println(initMsg);
-  gfx.display();
-  gfx.flush();
-  delay(500);
-
-  Serial.println("Initializing SPIFFS...");
+  bootSequence.start(BOOT_STAGE_STORAGE);
   // First, try to mount. If it fails, format and then then try again.
   if(!SPIFFS.begin(false)){ // Use 'false' here to not format on first attempt
-    Serial.println("SPIFFS Mount Failed! Attempting to format...");
+    LOG_ERROR("SPIFFS Mount Failed! Attempting to format...");
     if(SPIFFS.format()){
-      Serial.println("SPIFFS formatted successfully. Retrying mount...");
+      LOG_WARN("SPIFFS formatted successfully. Retrying mount...");
       if(!SPIFFS.begin(false)){ // Try mounting again after format
-        Serial.println("SPIFFS Mount Failed even after format! Halting.");
+        LOG_ERROR("SPIFFS Mount Failed even after format! Halting.");
+        logger.flush(); // The halt loop below starves the log task
         for(;;); // Don't proceed
       }
     } else {
-      Serial.println("SPIFFS Format Failed! Halting.");
+      LOG_ERROR("SPIFFS Format Failed! Halting.");
+      logger.flush();
       for(;;); // Don't proceed
     }
   }
-  Serial.println("SPIFFS mounted successfully");
-  Serial.printf("SPIFFS Total: %d bytes, Used: %d bytes\n", SPIFFS.totalBytes(), SPIFFS.usedBytes());
+  LOG_INFO("SPIFFS Total: %d bytes, Used: %d bytes", (int)SPIFFS.totalBytes(), (int)SPIFFS.usedBytes());
+  bootSequence.finish(BOOT_STAGE_STORAGE);
 
-  loadWiFiCredentials(); // Load saved Wi-Fi credentials (now from NVS) - MUST be before loadSettings
+  bootSequence.start(BOOT_STAGE_SETTINGS);
+  configTable.begin(); // Load interned config versions - MUST be before loadSettings
+  measurementStore.begin(); // Recover the persistent measurement log
+  bootFirstSequence = measurementStore.nextSequence();
+  nextShotSequence = bootFirstSequence;
+  provisionalEndSequence = bootFirstSequence;
+  offlineFromSequence = bootFirstSequence;
   loadSettings(); // Load settings, which now include calibration data
+  loadSessionLogs(); // Binary session logs (falls back to logs found in settings.json)
+  rollupStore.begin(); // Config/day rollups, catches up from measurementStore - needs configTable
+
+  DisplayPowerSettings power = displayPower.settings();
+  power.activeIntervalMs = DISPLAY_UPDATE_INTERVAL_MS;
+  power.settledIntervalMs = DISPLAY_SETTLED_INTERVAL_MS;
+  displayPower.configure(power);
+  displayPower.wake(millis());
+  char settingsNote[40];
+  snprintf(settingsNote, sizeof(settingsNote), "%d configs, %d shots", configCount, measurementCount);
+  bootSequence.finish(BOOT_STAGE_SETTINGS, settingsNote);
+
+  // Sensor and calibration are ready: measure from now on. The display task
+  // picks the sample up once the panel is ready (see serviceBoot()).
+  bootSequence.start(BOOT_STAGE_MEASURING);
+  currentSessionStartTime = timeSync.now(); // Provisional until the first sync, then back-dated
+  AdcSample firstSample = {esp_timer_get_time(), readRawDepthADC()};
+  processSample(firstSample); // No other task shares the state yet
+  startMeasurementTasks();
+  bootSequence.finish(BOOT_STAGE_MEASURING, adsInitialized ? "ADS1115" : "direct ADC");
+  serviceBoot();
+
+  // Everything loop() does from here on, by priority when several are due at once
+  networkScheduler.add(ioJob, serviceNetworkIo);
+  networkScheduler.add(housekeepingJob, serviceHousekeeping);
+  networkScheduler.add(broadcastJob, broadcastState);
+  networkScheduler.start();
+} // <-- Closing brace for setup()
 
-  if (wifiSsid == "" || wifiPassword == "") {
-    Serial.println("No WiFi credentials found. Starting AP mode...");
-    gfx.fillScreen(TFT_BLACK);
-    gfx.setTextColor(TFT_WHITE, TFT_BLACK); // Add background color
-    gfx.setTextSize(2); // Increased font size
-    String noWifiMsg = "No WiFi Config!";
-    uint16_t noWifiWidth = gfx.textWidth(noWifiMsg);
-    int noWifiX = (gfx.width() - noWifiWidth) / 2;
-    gfx.setCursor(noWifiX, 10);
-    gfx.println(noWifiMsg);
-    
-    String apMsg = "Starting AP Mode...";
-    uint16_t apWidth = gfx.textWidth(apMsg);
-    int apX = (gfx.width() - apWidth) / 2;
-    gfx.setCursor(apX, 40);
-    gfx.println(apMsg);
-    
-    gfx.setTextSize(1); // Smaller font for details
-    String connectMsg = "Connect to:";
-    uint16_t connectWidth = gfx.textWidth(connectMsg);
-    int connectX = (gfx.width() - connectWidth) / 2;
-    gfx.setCursor(connectX, 70);
-    gfx.println(connectMsg);
-    
-    gfx.setTextSize(3); // Larger font for AP name
-    String apName = "PowderSense";
-    uint16_t apNameWidth = gfx.textWidth(apName);
-    int apNameX = (gfx.width() - apNameWidth) / 2;
-    gfx.setCursor(apNameX, 100);
-    gfx.println(apName);
-    
-    gfx.setTextSize(3); // Larger font for IP
-    String apIP = "192.168.4.1";
-    uint16_t apIPWidth = gfx.textWidth(apIP);
-    int apIPX = (gfx.width() - apIPWidth) / 2;
-    gfx.setCursor(apIPX, 150);
-    gfx.println(apIP);
-    
-    gfx.display(); // Explicitly flush buffer
-    delay(500); // Longer delay to ensure text is drawn
-    startAPMode();
+
+void loop() {
+  uint32_t busyUs = networkScheduler.runNext(); // Sleeps until the next job is due
+  taskMonitor.record(TASK_NETWORK, busyUs);
+}
+
+/**
+ * @brief I/O job: serves HTTP, DNS, WebSocket and the serial console, reads touch
+ *        and sends the state right after a shot. Every NETWORK_POLL_MS.
+ */
+void serviceNetworkIo() {
+  // Handlers and WebSocket commands take the state lock themselves
+  uint32_t stageStart = stageProfiler.start();
+  server.handleClient(); // Handle incoming web requests
+  stageProfiler.stop(PROFILE_HTTP, stageStart);
+  stageStart = stageProfiler.start();
+  dnsServer.processNextRequest(); // For Captive Portal
+  stageProfiler.stop(PROFILE_DNS, stageStart);
+  stageStart = stageProfiler.start();
+  webSocket.loop(); // Handle WebSocket events
+  stageProfiler.stop(PROFILE_WEBSOCKET, stageStart);
+  handleSerialConsole();
+
+  {
+    StateLock lock;
+    // Handle touch input
+    stageStart = stageProfiler.start();
+    handleTouch();
+    stageProfiler.stop(PROFILE_TOUCH, stageStart);
+  }
+
+  sendPendingState();
+}
+
+/**
+ * @brief Sends the state if a change made under the state lock asked for it.
+ *        Call without the lock held.
+ */
+void sendPendingState() {
+  if (stateBroadcastPending) {
+    stateBroadcastPending = false;
+    sendCurrentStateToClients();
+  }
+}
+
+/**
+ * @brief Housekeeping job: boot stages, time sync, offline tracking, captive DNS
+ *        and results from the display task. Every HOUSEKEEPING_PERIOD_MS.
+ */
+void serviceHousekeeping() {
+  {
+    StateLock lock;
+    serviceBoot(); // Wi-Fi result, network services and time sync finish here after setup()
+    timeSync.service(); // Back-dates this boot's shots once the first sync is in
+    backfillPendingDays(0); // Their days, if the shots were still queued for flash then
+    updateNetworkOnline();
+    updateCaptiveDns();
+
+    systemUptimeMillis = millis(); // Update uptime
+  }
+  sendPendingState();
+
+  // Results of the display task; they do not touch the measurement state
+  if (displayBenchmarkReady) {
+    displayBenchmarkReady = false;
+    sendDisplayBenchmarkResult();
+  }
+  if (displayClockSweepReady) {
+    displayClockSweepReady = false;
+    sendDisplayClockSweepResult();
+  }
+}
+
+/**
+ * @brief Broadcast job: live state for the web UI. Every WEBSOCKET_UPDATE_INTERVAL_MS.
+ */
+void broadcastState() {
+  if (wifiLink.connected()) {
+    sendCurrentStateToClients();
+  }
+}
+
+/**
+ * @brief Starts the acquisition, engine and persistence tasks and their queues.
+ *        Called from setup() once the sensor and the settings are ready.
+ */
+void startMeasurementTasks() {
+  sampleQueue = xQueueCreate(SAMPLE_QUEUE_LENGTH, sizeof(AdcSample));
+  persistQueue = xQueueCreate(PERSIST_QUEUE_LENGTH, sizeof(ShotRecord));
+  if (sampleQueue == nullptr || persistQueue == nullptr) {
+    LOG_ERROR("Failed to create the task queues! Halting.");
+    logger.flush();
+    for(;;); // Don't proceed
+  }
+
+  // Lowest first, so each consumer is there before its producer starts
+  if (xTaskCreate(persistenceTask, "persistence", PERSISTENCE_TASK_STACK_SIZE, nullptr, PERSISTENCE_TASK_PRIORITY, &persistenceTaskHandle) != pdPASS) {
+    persistenceTaskHandle = nullptr;
+    LOG_ERROR("Failed to start persistence task, shots are written inline.");
   } else {
-    Serial.println("Connecting to WiFi...");
-    setupWiFi();
-    Serial.println("WiFi setup complete.");
-
-    // Web Server Routes for STA mode
-    server.on("/", HTTP_GET, handleRoot);
-    server.on("/depth", HTTP_GET, handleGetDepth); // This will now send full state
-    server.on("/api/measurement", HTTP_GET, handleApiMeasurement); // New fallback API endpoint
-    server.on("/api/export", HTTP_GET, handleExportDataCommand); // New export endpoint
-    server.on("/api/export_session", HTTP_GET, handleExportSessionCommand); // New session export endpoint
-    server.onNotFound(handleNotFound); // This will now handle static files too
-
-    server.begin();
-    Serial.println("HTTP server started");
-
-    // WebSocket server setup
-    webSocket.begin();
-    webSocket.onEvent([](uint8_t num, WStype_t type, uint8_t * payload, size_t length){
-      switch (type) {
-        case WStype_DISCONNECTED:
-          Serial.printf("[%u] Disconnected!\n", num);
-          break;
-        case WStype_CONNECTED: {
-          IPAddress ip = webSocket.remoteIP(num);
-          Serial.printf("[%u] Connected from %d.%d.%d.%d url: %s\n", num, ip[0], ip[1], ip[2], ip[3], payload);
-          // Send current state immediately upon connection
-          sendCurrentStateToClients();
-        }
-          break;
-        case WStype_TEXT: { // Added curly braces to create a new scope
-          Serial.printf("[%u] get Text: %s\n", num, payload);
-          // Parse JSON command from client
-          // Use JsonDocument for modern ArduinoJson API
-          // Increased size to handle large configuration imports
-          DynamicJsonDocument doc(4096); 
-          DeserializationError error = deserializeJson(doc, payload);
-
-          if (error) {
-            Serial.print(F("deserializeJson() failed: "));
-            Serial.println(error.f_str());
-            return;
-          }
+    taskMonitor.attach(TASK_PERSISTENCE, "persistence", persistenceTaskHandle, PERSISTENCE_TASK_STACK_SIZE, PERSISTENCE_BUDGET_US);
+  }
+  if (xTaskCreate(engineTask, "engine", ENGINE_TASK_STACK_SIZE, nullptr, ENGINE_TASK_PRIORITY, &engineTaskHandle) != pdPASS) {
+    LOG_ERROR("Failed to start measurement engine task! Halting.");
+    logger.flush();
+    for(;;); // Don't proceed
+  }
+  taskMonitor.attach(TASK_ENGINE, "engine", engineTaskHandle, ENGINE_TASK_STACK_SIZE, ENGINE_BUDGET_US);
+  if (xTaskCreate(acquisitionTask, "acquisition", ACQUISITION_TASK_STACK_SIZE, nullptr, ACQUISITION_TASK_PRIORITY, &acquisitionTaskHandle) != pdPASS) {
+    LOG_ERROR("Failed to start acquisition task! Halting.");
+    logger.flush();
+    for(;;); // Don't proceed
+  }
+  taskMonitor.attach(TASK_ACQUISITION, "acquisition", acquisitionTaskHandle, ACQUISITION_TASK_STACK_SIZE, ACQUISITION_BUDGET_US);
+  LOG_INFO("Measurement tasks started (sampling every %d ms)", ACQUISITION_PERIOD_MS);
+}
 
-          String command = doc["command"];
-          if (command == "zero") {
-            handleZeroCommand();
-          } else if (command == "measure") {
-            handleMeasureCommand();
-          } else if (command == "calibrate") {
-            // Calibration command now takes a step parameter
-            String step = doc["step"];
-            if (step == "startWizard") { // New command to start the wizard
-              startCalibrationWizard();
-            } else if (step == "setZeroPoint") { // New command for zero point
-              setCalibrationZeroPoint();
-            } else if (step == "setKnownGrains") { // New command for known grains
-              float knownWeight = doc["knownWeight"];
-              setCalibrationKnownGrains(knownWeight);
-            } else if (step == "cancel") {
-              cancelCalibration();
-            }
-            handleCalibrateCommand(); // Call to update UI with new state
-          } else if (command == "selectConfig") {
-            int index = doc["index"];
-            handleSelectConfigCommand(index);
-          } else if (command == "saveConfig") {
-            JsonObject data = doc["data"];
-            handleSaveConfigCommand(data);
-          } else if (command == "deleteConfig") {
-            int index = doc["index"];
-            handleDeleteConfigCommand(index);
-          } else if (command == "setAlarms") {
-            bool enabled = doc["enabled"];
-            float low = doc["lowThreshold"];
-            float high = doc["highThreshold"];
-            handleSetAlarmsCommand(enabled, low, high);
-          } else if (command == "acknowledgeAlarm") {
-            handleAcknowledgeAlarmCommand();
-          } else if (command == "resetSession") {
-            handleResetSessionCommand();
-          } else if (command == "startSession") {
-            handleStartSessionCommand();
-          } else if (command == "endSession") {
-            handleEndSessionCommand();
-          } else if (command == "factoryReset") { // New command
-            handleFactoryResetCommand();
-          } else if (command == "importConfigs") { // New command for importing configurations
-            JsonArray configs = doc["configs"];
-            handleImportConfigsCommand(configs);
-          } else if (command == "updateFirmware") { // New command for OTA updates
-            String type = doc["type"];
-            String filename = doc["filename"];
-            size_t size = doc["size"];
-            handleUpdateFirmwareCommand(type, filename, size);
-          } else if (command == "setSetting") { // New command to set a generic setting
-            // This command is currently unused after removing autoMeasureInsertionWeight.
-            // Kept as a placeholder for future settings.
-            String key = doc["key"];
-            Serial.printf("Received setSetting for key: %s (no action)\n", key.c_str());
-            sendCurrentStateToClients(); // Send updated state back to client
-          }
-          // Add more command handlers as needed
-          break;
-        } // End of WStype_TEXT scope
-        case WStype_BIN: {
-          if (isUpdating) {
-            size_t len = length;
-            if (updateReceived + len > updateSize) {
-              len = updateSize - updateReceived; // Prevent overflow
-            }
-            Update.write((uint8_t*)payload, len);
-            updateReceived += len;
-            Serial.printf("Received %d bytes, total %d/%d\n", len, updateReceived, updateSize);
-            if (updateReceived >= updateSize) {
-              if (Update.end(true)) {
-                Serial.println("Update successful. Sending status and rebooting...");
-                // Send success status to client
-                DynamicJsonDocument statusDoc(128);
-                statusDoc["updateStatus"] = "success";
-                String statusJson;
-                serializeJson(statusDoc, statusJson);
-                webSocket.broadcastTXT(statusJson);
-                delay(2000); // Give time for the message to be sent
-                ESP.restart();
-              } else {
-                Serial.println("Update failed.");
-                // Send error status to client
-                DynamicJsonDocument statusDoc(128);
-                statusDoc["updateStatus"] = "error";
-                statusDoc["message"] = "Update failed";
-                String statusJson;
-                serializeJson(statusDoc, statusJson);
-                webSocket.broadcastTXT(statusJson);
-                isUpdating = false;
-                Update.abort();
-              }
-            }
-          }
-          break;
+/**
+ * @brief Acquisition task: reads the sensor on a fixed period and queues the raw value.
+ *        Never waits for anything else; if the engine falls behind, the sample is dropped and counted.
+ */
+void acquisitionTask(void* parameter) {
+  sampleJob.start();
+  for (;;) {
+    sampleJob.sleepUntilRelease();
+    int64_t start = esp_timer_get_time();
+    sampleJob.started(start);
+    uint32_t stageStart = stageProfiler.start();
+    AdcSample sample = {start, readRawDepthADC()};
+    stageProfiler.stop(PROFILE_ADC_READ, stageStart);
+    if (xQueueSend(sampleQueue, &sample, 0) != pdTRUE) {
+      sampleOverruns++;
+    }
+    int64_t end = esp_timer_get_time();
+    sampleJob.finished(end);
+    taskMonitor.record(TASK_ACQUISITION, (uint32_t)(end - start));
+  }
+}
+
+/**
+ * @brief Measurement engine task: turns every queued sample into a weight and
+ *        runs auto-measure, the LEDs and the display snapshot on it.
+ */
+void engineTask(void* parameter) {
+  AdcSample sample;
+  for (;;) {
+    if (xQueueReceive(sampleQueue, &sample, portMAX_DELAY) != pdTRUE) {
+      continue;
+    }
+    int64_t start = esp_timer_get_time();
+    {
+      StateLock lock;
+      processSample(sample);
+    }
+    int64_t end = esp_timer_get_time();
+    engineJob.account(sample.us, start, end); // Late if the next sample was due before it was done
+    taskMonitor.record(TASK_ENGINE, (uint32_t)(end - start));
+  }
+}
+
+/**
+ * @brief Writes the rollups and session logs that are due. Copies them with the
+ *        state lock held and writes them to SPIFFS after releasing it, so the
+ *        engine task never waits for flash.
+ * @return True if anything was written.
+ */
+bool savePendingFiles() {
+  RollupSnapshot rollups;
+  SessionLog* logs = nullptr;
+  size_t logCount = 0;
+  {
+    StateLock lock;
+    if (rollupStore.saveDue()) {
+      rollupStore.snapshot(rollups);
+    }
+    if (sessionLogsSavePending) {
+      logCount = sessionLogs.size();
+      logs = (SessionLog*)malloc(max(logCount, (size_t)1) * sizeof(SessionLog));
+      if (logs != nullptr) {
+        for (size_t i = 0; i < logCount; i++) {
+          logs[i] = sessionLogs[i];
         }
-        case WStype_ERROR:
-        case WStype_FRAGMENT_TEXT_START:
-        case WStype_FRAGMENT_BIN_START:
-        case WStype_FRAGMENT:
-        case WStype_FRAGMENT_FIN:
-          break;
+        sessionLogsSavePending = false;
+      } else {
+        LOG_ERROR("Out of memory for session logs, saving them later");
       }
-    });
-    Serial.println("WebSocket server started on port 81");
-
-    // Display IP on Display
-    gfx.fillScreen(TFT_BLACK);
-    gfx.setCursor(0,0);
-    gfx.setTextColor(TFT_WHITE, TFT_BLACK); // Add background color
-    gfx.setTextSize(1);
-    gfx.printf("IP: %s\n", WiFi.localIP().toString().c_str());
-    gfx.println("Ready!");
-    gfx.display(); // Explicitly flush buffer
-    delay(1000); // Add delay to ensure display updates
-
-    // Initialize session start time
-    currentSessionStartTime = time(nullptr);
-
-    // Force initial draw of measurement screen after setup is complete
-    // This ensures the screen updates immediately after the "IP and Ready" message.
-    currentScreenState = SCREEN_MEASUREMENT; // Ensure state is set
-    gfx.fillScreen(TFT_BLACK); // Clear screen completely
-    drawMeasurementScreen(currentPowderWeight, alarmActive, alarmSettings.lowThreshold, alarmSettings.highThreshold);
-    lastDisplayUpdateTime = millis(); // Reset timer after initial draw
-    gfx.display(); // Explicitly push to display after initial draw
-    Serial.println("Initial measurement screen drawn and displayed.");
+    }
   }
-} // <-- Closing brace for setup()
+  rollups.write();
+  if (logs != nullptr) {
+    writeSessionLogs(logs, logCount);
+    free(logs);
+  }
+  return !rollups.empty() || logs != nullptr;
+}
+
+/**
+ * @brief Persistence task: appends queued shots to measurementStore, then saves
+ *        the rollups and session logs once no more shots are waiting.
+ */
+void persistenceTask(void* parameter) {
+  ShotRecord shot;
+  for (;;) {
+    // Queued shots are older than those held back in persistOverflow
+    bool received = xQueueReceive(persistQueue, &shot, 0) == pdTRUE || takeOverflowShot(shot) ||
+                    xQueueReceive(persistQueue, &shot, pdMS_TO_TICKS(PERSISTENCE_IDLE_MS)) == pdTRUE;
+    uint32_t start = micros();
+    if (received) {
+      uint32_t sequence = measurementStore.append(shot.timestamp, shot.weight, shot.configId, shot.configVersion);
+      if (sequence != shot.sequence) {
+        LOG_DEBUG("Persistence: shot %lu stored as sequence %lu", (unsigned long)shot.sequence, (unsigned long)sequence);
+      }
+    }
+    bool idle = (uxQueueMessagesWaiting(persistQueue) == 0);
+    portENTER_CRITICAL(&persistOverflowMux);
+    idle = idle && persistOverflow.empty();
+    portEXIT_CRITICAL(&persistOverflowMux);
+    bool saved = idle && savePendingFiles();
+    if (received || saved) {
+      taskMonitor.record(TASK_PERSISTENCE, micros() - start);
+    }
+  }
+}
 
+/**
+ * @brief Hands a recorded shot to the persistence task. While its queue is full
+ *        the shot is held back in persistOverflow, and dropped with an error if
+ *        that is full too; this never waits. Call with the state lock held.
+ */
+void queueShot(const ShotRecord& shot) {
+  if (persistenceTaskHandle == nullptr) {
+    // Failed to start, nothing else would write the shot
+    measurementStore.append(shot.timestamp, shot.weight, shot.configId, shot.configVersion);
+    savePendingFiles();
+    return;
+  }
 
-void loop() {
-  server.handleClient(); // Handle incoming web requests
-  dnsServer.processNextRequest(); // For Captive Portal
-  webSocket.loop(); // Handle WebSocket events
+  portENTER_CRITICAL(&persistOverflowMux);
+  bool holdBack = !persistOverflow.empty(); // Keep the store in sequence order
+  portEXIT_CRITICAL(&persistOverflowMux);
+  if (!holdBack && xQueueSend(persistQueue, &shot, 0) == pdTRUE) {
+    uint32_t waiting = uxQueueMessagesWaiting(persistQueue);
+    if (waiting > persistQueuePeak) {
+      persistQueuePeak = waiting;
+    }
+    return;
+  }
+
+  portENTER_CRITICAL(&persistOverflowMux);
+  bool dropped = persistOverflow.full();
+  if (!dropped) {
+    persistOverflow.push(shot);
+  }
+  portEXIT_CRITICAL(&persistOverflowMux);
+  if (dropped) {
+    persistDropped++;
+    LOG_ERROR("Persistence backlog full, shot %lu not stored", (unsigned long)shot.sequence);
+  } else {
+    persistOverflows++;
+  }
+}
+
+/**
+ * @brief Takes the oldest shot held back by queueShot(). Persistence task only,
+ *        once persistQueue is empty.
+ * @return False if there is none.
+ */
+bool takeOverflowShot(ShotRecord& shot) {
+  portENTER_CRITICAL(&persistOverflowMux);
+  bool taken = !persistOverflow.empty();
+  if (taken) {
+    shot = persistOverflow.front();
+    persistOverflow.pop();
+  }
+  portEXIT_CRITICAL(&persistOverflowMux);
+  return taken;
+}
+
+/**
+ * @brief Waits until the queued shots before endSequence are in measurementStore.
+ *        Safe with the state lock held: appending does not take it.
+ * @return False on timeout.
+ */
+bool waitForPersistence(uint32_t endSequence, uint32_t timeoutMs) {
+  uint32_t start = millis();
+  while (measurementStore.nextSequence() < endSequence) {
+    if (millis() - start >= timeoutMs) {
+      return false;
+    }
+    vTaskDelay(1);
+  }
+  return true;
+}
+
+/**
+ * @brief Runs one sample through the engine: averaging, weight, auto-measure,
+ *        LEDs and the display snapshot. Call with the state lock held.
+ */
+void processSample(const AdcSample& sample) {
+  currentDepthAdc = averageDepthADC((float)sample.raw);
+  currentPowderWeight = calculatePowderWeight(currentDepthAdc); // Calculate weight from ADC
 
-  // Handle touch input
-  handleTouch();
+  uint32_t stageStart = stageProfiler.start();
+  updateAutoMeasure();
+  stageProfiler.stop(PROFILE_AUTO_MEASURE, stageStart);
 
-  systemUptimeMillis = millis(); // Update uptime
+  // Hand the new sample to the display task; it renders on its own schedule
+  publishDisplaySnapshot(currentDepthAdc);
 
-  float currentAdc = readDepthADC(); // Get ADC value
-  currentPowderWeight = calculatePowderWeight(currentAdc); // Calculate weight from ADC
+  // Update RGB LED based on weight (this can be more frequent as it's not a full screen redraw)
+  #ifdef HAS_RGB_LED
+    stageStart = stageProfiler.start();
+    updateLEDs(currentPowderWeight); // ✅ Only call if board has RGB LED
+    stageProfiler.stop(PROFILE_LEDS, stageStart);
+  #endif
+}
 
+/**
+ * @brief Auto-measurement: triggers when the weight is stable within a tolerance of the target.
+ */
+void updateAutoMeasure() {
   // New Auto-measurement logic: triggers when weight is stable within a tolerance of the target
   // Only allows next measurement after weight has dropped below threshold
   // Skip auto-measure during calibration
-  if (WiFi.getMode() == WIFI_STA && WiFi.status() == WL_CONNECTED && currentConfigIndex != -1 && currentCalibrationState == CALIBRATE_NONE) {
+  // Runs whether or not there is a network; offline shots are replayed to clients later
+  if (currentConfigIndex != -1 && currentCalibrationState == CALIBRATE_NONE) {
     float target = powderConfigs[currentConfigIndex].targetGrain;
     float lowerBound = target - AUTO_MEASURE_TOLERANCE_GRAINS;
     float upperBound = target + AUTO_MEASURE_TOLERANCE_GRAINS;
@@ -662,7 +1063,7 @@ void loop() {
     // Check if we need to reset the measurement flag (weight has dropped to near zero)
     if (lastMeasurementTaken && currentPowderWeight < RESET_MEASUREMENT_THRESHOLD) {
       lastMeasurementTaken = false;
-      Serial.println("Measurement flag reset: weight dropped below threshold.");
+      LOG_DEBUG("Measurement flag reset: weight dropped below threshold.");
     }
 
     // Only proceed with auto-measure if last measurement has been reset
@@ -673,19 +1074,19 @@ void loop() {
           if (autoMeasureTimerStart == 0) {
               // We just entered the range, start the timer.
               autoMeasureTimerStart = millis();
-              Serial.printf("Entered auto-measure range [%.2f, %.2f]. Starting timer.\n", lowerBound, upperBound);
+              LOG_DEBUG("Entered auto-measure range [%.2f, %.2f]. Starting timer.", lowerBound, upperBound);
           } else {
               // Timer is already running, check if it has been stable for long enough.
               unsigned long elapsedTime = millis() - autoMeasureTimerStart;
               
               // Check for timeout: if weight has been stable for too long, reset timer to prevent stale measurements
               if (elapsedTime >= AUTO_MEASURE_MAX_STABLE_TIME_MS) {
-                  Serial.printf("Auto-measure timeout: weight stable for %lu ms. Resetting timer.\n", elapsedTime);
+                  LOG_DEBUG("Auto-measure timeout: weight stable for %lu ms. Resetting timer.", elapsedTime);
                   autoMeasureTimerStart = 0; // Reset timer to wait for weight to drop and re-enter range
               } else if (elapsedTime >= AUTO_MEASURE_STABLE_DURATION_MS) {
                   // Stable for required duration. Check cooldown before measuring.
                   if (millis() - lastAutoMeasureTime > AUTO_MEASURE_COOLDOWN_MS) {
-                      Serial.println("Auto-measure triggered! Calling handleAutoMeasure().");
+                      LOG_DEBUG("Auto-measure triggered! Calling handleAutoMeasure().");
                       handleAutoMeasure(); // Trigger a measurement
                       lastAutoMeasureTime = millis(); // Reset cooldown timer
                       autoMeasureTimerStart = 0; // Reset timer to prevent immediate re-triggering
@@ -701,187 +1102,140 @@ void loop() {
       }
     }
   } else {
-    // No config selected, not connected, or calibration active, ensure timer is reset.
+    // No config selected or calibration active, ensure timer is reset.
     if (autoMeasureTimerStart != 0) {
         autoMeasureTimerStart = 0;
     }
   }
+}
 
-
-  // Determine the desired screen state
-  ScreenState newScreenState;
-  if (WiFi.getMode() == WIFI_AP) {
-    newScreenState = SCREEN_AP_MODE;
-  } else if (currentCalibrationState != CALIBRATE_NONE) {
-    newScreenState = SCREEN_CALIBRATION;
-  } else {
-    newScreenState = SCREEN_MEASUREMENT;
-  }
-
-  // If screen state changes, force a full redraw and update currentScreenState
-  if (newScreenState != currentScreenState) {
-    Serial.printf("ScreenState changed from %d to %d. Clearing screen.\n", currentScreenState, newScreenState); // Debug print
-    gfx.fillScreen(TFT_BLACK); // Clear screen completely for new layout
-    currentScreenState = newScreenState;
-    lastDisplayUpdateTime = 0; // Force immediate update of new screen
-  }
-
-  // Handle TFT display updates with DOUBLE BUFFERING (no more flicker!)
-  if (millis() - lastDisplayUpdateTime >= DISPLAY_UPDATE_INTERVAL_MS) {
-    // Draw to off-screen sprite buffer (no flicker!)
-    canvas.fillScreen(TFT_BLACK);
-
-    if (currentScreenState == SCREEN_MEASUREMENT) {
-      drawMeasurementScreen(currentPowderWeight, alarmActive, alarmSettings.lowThreshold, alarmSettings.highThreshold);
-    } else if (currentScreenState == SCREEN_CALIBRATION) {
-      drawCalibrationScreen(currentCalibrationState, currentAdc, currentPowderWeight);
-    } else if (currentScreenState == SCREEN_AP_MODE) {
-      drawAPModeScreen();
-    }
-
-    // Push complete frame to display in one smooth operation (eliminates flicker!)
-    canvas.pushSprite(0, 0);
-
-    lastDisplayUpdateTime = millis();
-  }
-  
-
-  // Update RGB LED based on weight (this can be more frequent as it's not a full screen redraw)
-  #ifdef HAS_RGB_LED
-    updateLEDs(currentPowderWeight); // ✅ Only call if board has RGB LED
-  #endif
-
-  // Periodically send state to WebSocket clients for live updates
-  // Re-added this block to ensure web UI updates
-  if (WiFi.getMode() == WIFI_STA && WiFi.status() == WL_CONNECTED && millis() - lastWebSocketUpdateTime >= WEBSOCKET_UPDATE_INTERVAL_MS) {
-    sendCurrentStateToClients();
-    lastWebSocketUpdateTime = millis();
-  }
-
-  delay(5); // Reduced delay for faster loop iteration and more responsive ADC readings
+/**
+ * @brief Display init task: brings up the panel while setup() carries on, then ends.
+ */
+void bootDisplayTask(void* parameter) {
+  setupDisplay();
+  vTaskDelete(nullptr);
 }
 
 /**
- * @brief Initializes the display and touch controller.
+ * @brief Initializes the display, the canvas and the DMA pipeline. Runs in bootDisplayTask.
  */
 void setupDisplay() {
-  Serial.println("setupDisplay() called."); // Debug print
+  bootSequence.start(BOOT_STAGE_DISPLAY);
+  LOG_DEBUG("setupDisplay() called.");
   // Init Display
   if (!gfx.begin()) {
-    Serial.println("gfx.begin() failed!");
+    LOG_ERROR("gfx.begin() failed!");
     // If display initialization fails, turn LED red to indicate error
     // leds[0] = CRGB::Red; // RGB LED not present
     // FastLED.show();
     while(true) { // Halt execution if display fails
-      Serial.println("Display initialization failed. Halting.");
+      LOG_ERROR("Display initialization failed. Halting.");
       delay(1000);
     }
     return; 
   }
-  Serial.println("gfx.begin() succeeded."); // Debug print
+  LOG_DEBUG("gfx.begin() succeeded.");
   gfx.setRotation(DISPLAY_ROTATION); // ✅ Board-specific rotation from board_config.h
-  Serial.printf("gfx.setRotation(%d) called\n", DISPLAY_ROTATION); // Debug print
+  LOG_DEBUG("gfx.setRotation(%d) called", DISPLAY_ROTATION);
   gfx.fillScreen(TFT_BLACK);
-  Serial.println("gfx.fillScreen(TFT_BLACK) called."); // Debug print
+  LOG_DEBUG("gfx.fillScreen(TFT_BLACK) called.");
 
   // Backlight is handled by the LGFX config's Light_PWM instance.
   // We can set brightness here if needed.
   gfx.setBrightness(255); // Set to full brightness
-  Serial.println("gfx.setBrightness(255) called."); // Debug print
+  LOG_DEBUG("gfx.setBrightness(255) called.");
+
+  // Run at the clock tuned for this board, if a sweep has already found one
+  uint32_t spiClock = displayClock.begin(BOARD_NAME, DISPLAY_SPI_FREQ_WRITE);
+  if (spiClock != DISPLAY_SPI_FREQ_WRITE) {
+    gfx.setWriteClock(spiClock);
+  }
+
+  gfx.setTextWrap(true);
+  gfx.setTextSize(1);
+  gfx.setTextColor(TFT_WHITE);
+  
+  // Startup image, streamed from flash (see scripts/generate_image_assets.py).
+  // It stays up until the display task draws the first frame.
+  uint32_t splashStart = millis();
+  if (drawRleImage(gfx, SPLASH_IMAGE, (gfx.width() - SPLASH_IMAGE.width) / 2, (gfx.height() - SPLASH_IMAGE.height) / 2)) {
+    LOG_INFO("Splash drawn in %lu ms", millis() - splashStart);
+    if (SPLASH_HOLD_MS > 0) {
+      delay(SPLASH_HOLD_MS);
+    }
+  }
+
+  // Initialize sprite buffer for double buffering (eliminates flicker!)
+  // 4-bit palette sprite: ~27 KB instead of ~110 KB for 16-bit RGB565
+  canvas.setColorDepth(UI_CANVAS_COLOR_DEPTH);
+  if (!canvas.createSprite(gfx.width(), gfx.height())) {
+    LOG_ERROR("Failed to allocate sprite buffer!");
+  }
+  applyUiPalette(canvas);
+  canvas.fillSprite(UI_BLACK); // ✅ Ensure sprite starts with black background
+  LOG_INFO("Sprite buffer created: %dx%d pixels, %d bytes", gfx.width(), gfx.height(), (gfx.width() * gfx.height() + 1) / 2);
+  displayPipeline.begin(gfx, canvas, displayClock.frequency());
+  displayPipeline.onFrameComplete(onDisplayFrameComplete);
+
+  LOG_DEBUG("setupDisplay() finished.");
+  bootSequence.finish(BOOT_STAGE_DISPLAY);
+}
 
+/**
+ * @brief Probes the ADS1115 and falls back to the direct ADC pin if it does not answer.
+ */
+void setupSensor() {
+  bootSequence.start(BOOT_STAGE_SENSOR);
   // Initialize I2C for ADS1115 ADC
-  Serial.println("Initializing I2C for ADS1115...");
+  LOG_INFO("Initializing I2C for ADS1115...");
+  i2cBusBegin(); // Shared with the touch controller, see i2c_bus.h
   Wire.begin(ADS1115_SDA_PIN, ADS1115_SCL_PIN);
   
   // Initialize ADS1115
   if (!ads.begin(ADS1115_ADDRESS, &Wire)) {
-    Serial.println("Failed to initialize ADS1115! Check I2C connections.");
-    Serial.println("Falling back to direct ADC on GPIO5...");
+    LOG_ERROR("Failed to initialize ADS1115! Check I2C connections.");
+    LOG_WARN("Falling back to direct ADC on GPIO5...");
     adsInitialized = false;
     // Initialize direct ADC pin as fallback
     pinMode(LEVEL_SENSOR_PIN, INPUT);
-    Serial.printf("Direct ADC initialized on GPIO%d\n", LEVEL_SENSOR_PIN);
+    LOG_INFO("Direct ADC initialized on GPIO%d", LEVEL_SENSOR_PIN);
+    bootSequence.fail(BOOT_STAGE_SENSOR, "no ADS1115, direct ADC");
   } else {
-    Serial.println("ADS1115 initialized successfully.");
+    LOG_INFO("ADS1115 initialized successfully.");
     // Set gain to ±4.096V for better precision with 3.3V signals
     ads.setGain(GAIN_TWOTHIRDS);  // ±6.144V range
+    // Convert continuously, so a read only fetches the latest result instead of
+    // starting a conversion and polling the bus until it is done
+    ads.setDataRate(RATE_ADS1115_128SPS);
+    ads.startADCReading(MUX_BY_CHANNEL[ADS1115_CHANNEL], /*continuous=*/true);
+    delay(10); // First conversion
     adsInitialized = true;
+    bootSequence.finish(BOOT_STAGE_SENSOR, "ADS1115");
   }
-
-  gfx.setTextWrap(true);
-  gfx.setTextSize(1);
-  gfx.setTextColor(TFT_WHITE);
-  
-  // Load and display startup image (only if SPIFFS is mounted)
-  if (SPIFFS.exists("/powdersense_2.png")) {
-    File file = SPIFFS.open("/powdersense_2.png", "r");
-    if (file) {
-      // Read file into buffer
-      size_t fileSize = file.size();
-      Serial.printf("Image file size: %d bytes\n", fileSize);
-      uint8_t *buffer = (uint8_t *)malloc(fileSize);
-      if (buffer) {
-        size_t bytesRead = file.read(buffer, fileSize);
-        file.close();
-        Serial.printf("Bytes read: %d\n", bytesRead);
-        if (bytesRead == fileSize) {
-          // Draw PNG image centered on screen
-          int16_t x = (gfx.width() - 172) / 2; // Assuming image width 172, center it
-          int16_t y = (gfx.height() - 320) / 2; // Assuming image height 320, center it
-          Serial.printf("Drawing PNG at x=%d, y=%d\n", x, y);
-          if (gfx.drawPng(buffer, fileSize, x, y)) {
-            Serial.println("PNG drawn successfully");
-            gfx.display(); // Ensure the image is displayed
-            delay(3000); // Show for 3 seconds
-          } else {
-            Serial.println("Failed to draw PNG");
-          }
-        } else {
-          Serial.println("Failed to read entire image file");
-        }
-        free(buffer);
-      } else {
-        Serial.println("Failed to allocate buffer for image");
-        file.close();
-      }
-    } else {
-      Serial.println("Failed to open image file");
-    }
-  } else {
-    Serial.println("Image file not found - skipping startup image");
-  }
-  
-  // Display initialization message
-  gfx.setTextColor(TFT_WHITE);
-  gfx.setTextSize(2);
-  gfx.setCursor(10, 10);
-  gfx.print("Display OK");
-  gfx.display();
-  
-  delay(500);
-  
-  Serial.println("setupDisplay() finished."); // Debug print
 }
 
 /**
- * @brief Reads the analog value from the ADS1115 ADC or direct GPIO5 ADC and returns the averaged ADC value.
- * @return The averaged ADC value (0-32767 for 16-bit ADS1115 or 0-4095 for 12-bit direct ADC).
+ * @brief Reads the analog value from the ADS1115 ADC or direct GPIO5 ADC. Runs in the acquisition task.
+ * @return The raw ADC value (0-32767 for 16-bit ADS1115 or 0-4095 for 12-bit direct ADC).
  */
-float readDepthADC() { // Changed function name and return type
-  float currentAdcValue = 0.0;
-  
+int32_t readRawDepthADC() {
   if (adsInitialized) {
-    // Read from ADS1115 channel A0
-    int16_t rawAdc = ads.readADC_SingleEnded(ADS1115_CHANNEL);
-    currentAdcValue = (float)rawAdc;
-  } else {
-    // Fallback to direct ADC on GPIO5 if ADS1115 is not available
-    int rawAdc = analogRead(LEVEL_SENSOR_PIN);
-    currentAdcValue = (float)rawAdc;
+    // Latest continuous conversion of channel A0: one register read, no waiting
+    I2cBusLock bus;
+    return ads.getLastConversionResults();
   }
+  // Fallback to direct ADC on GPIO5 if ADS1115 is not available
+  return analogRead(LEVEL_SENSOR_PIN);
+}
 
+/**
+ * @brief Adds a raw reading to the moving average. Runs in the engine task.
+ * @return The averaged ADC value.
+ */
+float averageDepthADC(float rawAdc) {
   // Store the reading in the circular buffer
-  adcReadings[adcReadingsIndex] = currentAdcValue;
+  adcReadings[adcReadingsIndex] = rawAdc;
   adcReadingsIndex = (adcReadingsIndex + 1) % ADC_READINGS_COUNT;
 
   // If the buffer hasn't been filled yet, only average the readings taken so far
@@ -925,20 +1279,8 @@ float calculatePowderWeight(float adcValue) { // Changed to accept ADC value
  * @return The standard deviation in grains.
  */
 float calculateStandardDeviation() {
-  if (sessionMeasurementCount <= 1) {
-    return 0.0;
-  }
-
-  float average = sumWeight / sessionMeasurementCount;
-  float sumOfSquares = 0.0;
-
-  for (int i = 0; i < sessionMeasurementCount; i++) {
-    float difference = measurementHistory[i].weight - average;
-    sumOfSquares += difference * difference;
-  }
-
-  // Use N-1 for sample standard deviation
-  return sqrt(sumOfSquares / (sessionMeasurementCount - 1));
+  // Maintained incrementally from count, sum and sum of squares
+  return rollupStore.session().standardDeviation();
 }
 
 /**
@@ -977,240 +1319,563 @@ void updateLEDs(float currentWeight) {
 }
 
 /**
- * @brief Connects to Wi-Fi.
+ * @brief Starts the Wi-Fi link and returns at once; wifiLink keeps it up from here on.
+ *        Without credentials only the access point comes up.
  */
 void setupWiFi() {
-  delay(10);
-  Serial.println();
-  Serial.print("Connecting to ");
-  Serial.println(wifiSsid);
-
-  WiFi.mode(WIFI_STA);
-  WiFi.begin(wifiSsid.c_str(), wifiPassword.c_str());
-
-  int attempts = 0;
-  while (WiFi.status() != WL_CONNECTED && attempts < 30) { // Try for 30 seconds
-    delay(500);
-    gfx.fillScreen(TFT_BLACK); // Clear display before updating
-    gfx.setTextSize(2); // Increased font size
-    String wifiMsg = "... Connecting to WiFi ...";
-    uint16_t wifiMsgWidth = gfx.textWidth(wifiMsg);
-    int wifiX = (gfx.width() - wifiMsgWidth) / 2; // Center horizontally
-    gfx.setCursor(wifiX, 10);
-    gfx.println(wifiMsg);
-    gfx.setTextSize(1);
-    uint16_t ssidWidth = gfx.textWidth(wifiSsid);
-    int ssidX = (gfx.width() - ssidWidth) / 2; // Center horizontally
-    gfx.setCursor(ssidX, 40);
-    gfx.println(wifiSsid);
-    attempts++;
-  }
-
-  if (WiFi.status() == WL_CONNECTED) {
-    Serial.println("");
-    Serial.println("WiFi connected");
-    Serial.println("IP address: ");
-    Serial.println(WiFi.localIP());
-
-    // Sync time with NTP
-    Serial.println("Syncing time with NTP...");
-    configTzTime("CET-1CEST,M3.5.0,M10.5.0/3", "pool.ntp.org", "time.nist.gov");
-    delay(2000); // Wait for NTP sync
-    struct tm timeinfo;
-    if (getLocalTime(&timeinfo)) {
-      Serial.println("Time synced successfully");
-      char timeStr[30];
-      strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", &timeinfo);
-      Serial.printf("Current time: %s\n", timeStr);
-    } else {
-      Serial.println("Failed to sync time with NTP");
-    }
-
-    gfx.fillScreen(TFT_BLACK); // Clear display before showing IP
-    gfx.setTextSize(4); // Extra large font size for IP display
-    String ipMsg = WiFi.localIP().toString();
-    uint16_t ipWidth = gfx.textWidth(ipMsg);
-    int ipX = (gfx.width() - ipWidth) / 2; // Center horizontally
-    gfx.setCursor(ipX, 10);
-    gfx.println(ipMsg);
-    
-    gfx.setTextSize(3); // Large font size for WiFi SSID
-    String ssidMsg = WiFi.SSID();
-    uint16_t ssidWidth = gfx.textWidth(ssidMsg);
-    int ssidX = (gfx.width() - ssidWidth) / 2; // Center horizontally
-    gfx.setCursor(ssidX, 70);
-    gfx.println(ssidMsg);
-    
-    gfx.setTextSize(2); // Medium font size for Ready message
-    String readyMsg = "Ready!";
-    uint16_t readyWidth = gfx.textWidth(readyMsg);
-    int readyX = (gfx.width() - readyWidth) / 2; // Center horizontally
-    gfx.setCursor(readyX, 130);
-    gfx.println(readyMsg);
-  } else {
-    Serial.println("");
-    Serial.println("Failed to connect to WiFi. Starting AP mode.");
-    gfx.fillScreen(TFT_BLACK); // Clear display before updating
-    gfx.setCursor(0,0);
-    gfx.setTextSize(2); // Increased font size
-    gfx.println("WiFi Failed!");
-    gfx.println("Starting AP Mode...");
-    startAPMode(); // Fallback to AP mode if STA connection fails
+  if (wifiSsid == "" || wifiPassword == "") {
+    LOG_INFO("No WiFi credentials found. Starting AP mode...");
+    wifiLink.begin("", "");
+    bootSequence.skip(BOOT_STAGE_WIFI, "no credentials, AP mode");
+    bootSequence.skip(BOOT_STAGE_TIME, "AP mode");
+    return;
   }
+  LOG_INFO("Connecting to %s", wifiSsid.c_str());
+  bootSequence.start(BOOT_STAGE_WIFI);
+  wifiLink.begin(wifiSsid.c_str(), wifiPassword.c_str());
 }
 
 /**
- * @brief Starts Access Point (AP) mode for Wi-Fi configuration.
+ * @brief Advances the boot stages that finish after setup(): the display task,
+ *        the Wi-Fi result, the network services and the first time sync.
+ *        Called from loop(); returns at once when there is nothing to do.
  */
-void startAPMode() {
-  WiFi.mode(WIFI_AP);
-  WiFi.softAP("PowderSense", ""); // SSID, no password for easy setup
-  IPAddress apIP(192, 168, 4, 1);
-  WiFi.softAPConfig(apIP, apIP, IPAddress(255, 255, 255, 0));
+void serviceBoot() {
+  if (displayTaskHandle == nullptr && bootSequence.waitFor(BootSequence::bit(BOOT_STAGE_DISPLAY) | BootSequence::bit(BOOT_STAGE_SETTINGS), 0)) {
+    startDisplayTask(); // From here on the display task owns the panel and the canvas
+  }
+  if (bootTimelineLogged) {
+    return;
+  }
+  uint32_t now = millis();
 
-  Serial.print("AP IP address: ");
-  Serial.println(apIP);
+  if (bootSequence.status(BOOT_STAGE_WIFI) == BOOT_STAGE_RUNNING) {
+    if (wifiLink.connected()) {
+      bootSequence.finish(BOOT_STAGE_WIFI, WiFi.localIP().toString().c_str());
+      bootSequence.start(BOOT_STAGE_TIME); // Time syncs in the background; checked below on every call
+    } else if (wifiLink.apActive()) {
+      // wifiLink keeps retrying behind the access point; boot does not wait for it
+      bootSequence.fail(BOOT_STAGE_WIFI, "no connection, AP mode");
+      bootSequence.skip(BOOT_STAGE_TIME, "no connection yet");
+    }
+  }
 
-  // DNS server for captive portal
-  dnsServer.start(53, "*", apIP);
+  if (bootSequence.ready(BOOT_STAGE_NETWORK)) {
+    startNetworkServices();
+  }
 
-  // Web server routes for AP mode
-  server.on("/", HTTP_GET, handleWiFiConfigPage);
-  server.on("/wifi_config.html", HTTP_GET, handleWiFiConfigPage); // Explicitly serve the config page
+  if (bootSequence.status(BOOT_STAGE_TIME) == BOOT_STAGE_RUNNING) {
+    if (timeSync.synced()) {
+      time_t wallTime = time(nullptr);
+      struct tm timeinfo;
+      localtime_r(&wallTime, &timeinfo);
+      char timeStr[30];
+      strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", &timeinfo);
+      bootSequence.finish(BOOT_STAGE_TIME, timeStr);
+    } else if (now - bootSequence.record(BOOT_STAGE_TIME).startMs >= BOOT_TIME_TIMEOUT_MS) {
+      bootSequence.fail(BOOT_STAGE_TIME, "no reply yet, still trying");
+    }
+  }
+
+  if (bootSequence.complete()) {
+    bootSequence.logTimeline();
+    taskMonitor.logSummary();
+    JobClock::logAll();
+    // Worst cases and misses from here on are the steady-state ones
+    taskMonitor.resetPeaks();
+    for (size_t i = 0; i < JobClock::count(); i++) {
+      JobClock::at(i)->resetStats();
+    }
+    bootTimelineLogged = true;
+  }
+}
+
+/**
+ * @brief Back-dates everything this boot stamped before the clock was synced: the
+ *        session history, the stored shots (as a read-time fixup), their day
+ *        rollups, this boot's session logs and the current session start.
+ *        Called once from loop() by timeSync.service().
+ * @param bootEpoch Wall time at boot; provisional stamps are seconds since then.
+ */
+void onFirstTimeSync(uint32_t bootEpoch) {
+  size_t fixedEntries = 0;
+  for (Measurement& entry : measurementHistory) {
+    if (TimeSync::provisional(entry.timestamp)) {
+      entry.timestamp += bootEpoch;
+      fixedEntries++;
+    }
+  }
+
+  // Only the shots stamped before the sync: the SNTP callback sets the offset in
+  // the lwIP task, so shots taken before this runs already have wall time and
+  // their days in the rollups
+  uint32_t endSequence = provisionalEndSequence;
+  if (bootFirstSequence < endSequence) {
+    // The fixup is by sequence, so it also covers shots still queued for flash
+    measurementStore.fixTimestamps(bootFirstSequence, endSequence, bootEpoch);
+    backfillFirstSequence = bootFirstSequence;
+    backfillEndSequence = endSequence;
+    backfillPendingDays(1000);
+  }
+
+  bool logsFixed = false;
+  size_t logsThisBoot = min(sessionLogsThisBoot, sessionLogs.size());
+  for (size_t i = sessionLogs.size() - logsThisBoot; i < sessionLogs.size(); i++) {
+    SessionLog& log = sessionLogs[i];
+    if (TimeSync::provisional(log.startTime)) {
+      log.startTime += bootEpoch;
+      logsFixed = true;
+    }
+    if (TimeSync::provisional(log.endTime)) {
+      log.endTime += bootEpoch;
+      logsFixed = true;
+    }
+  }
+  if (logsFixed) {
+    saveSessionLogs();
+  }
+
+  if (TimeSync::provisional(currentSessionStartTime)) {
+    currentSessionStartTime += bootEpoch;
+  }
+
+  LOG_INFO("Time: back-dated %d history entries, %lu stored shots, %d session logs",
+                (int)fixedEntries, (unsigned long)(endSequence - bootFirstSequence), (int)logsThisBoot);
+  sendCurrentStateToClients();
+}
+
+/**
+ * @brief Adds the shots back-dated by onFirstTimeSync() to their day rollups. The
+ *        rollups read them from measurementStore, so this waits until all of them
+ *        are written; if that takes too long it is left to the next call from
+ *        serviceHousekeeping(). Call with the state lock held.
+ * @return True once nothing is left to backfill.
+ */
+bool backfillPendingDays(uint32_t timeoutMs) {
+  if (backfillFirstSequence >= backfillEndSequence) {
+    return true;
+  }
+  if (!waitForPersistence(backfillEndSequence, timeoutMs)) {
+    if (timeoutMs > 0) { // Not on every retry
+      LOG_INFO("Time: day rollups of %lu back-dated shots wait until they are written",
+               (unsigned long)(backfillEndSequence - measurementStore.nextSequence()));
+    }
+    return false;
+  }
+  size_t backfilledShots = rollupStore.backfillDays(backfillFirstSequence, backfillEndSequence);
+  LOG_INFO("Time: %d back-dated shots added to day rollups", (int)backfilledShots);
+  backfillFirstSequence = backfillEndSequence;
+  return true;
+}
+
+/**
+ * @brief Starts the HTTP and WebSocket servers, once Wi-Fi is up or in AP mode.
+ */
+void startNetworkServices() {
+  bootSequence.start(BOOT_STAGE_NETWORK);
+
+  // Same routes in station and AP mode; the handlers check wifiLink.inApMode().
+  // Handlers copy what they need under the state lock and send without it, so a
+  // slow client never holds up the engine task.
+  server.on("/", HTTP_GET, handleRoot);
+  server.on("/depth", HTTP_GET, handleGetDepth); // This will now send full state
+  server.on("/api/measurement", HTTP_GET, handleApiMeasurement); // New fallback API endpoint
+  server.on("/api/export", HTTP_GET, handleExportDataCommand); // New export endpoint
+  server.on("/api/export_session", HTTP_GET, handleExportSessionCommand); // New session export endpoint
+  server.on("/api/history", HTTP_GET, handleHistoryStatsCommand); // Aggregates over the on-flash history
+  server.on("/api/rollups", HTTP_GET, handleRollupsCommand); // Per-config and per-day rollups
+  server.on("/api/boot", HTTP_GET, handleBootTimelineCommand); // Boot stage timeline
+  server.on("/api/tasks", HTTP_GET, handleTasksCommand); // Task execution times, stacks and queues
+  // Wi-Fi setup, reached through the access point; "/" serves it too while in AP mode
+  server.on("/wifi_config.html", HTTP_GET, handleWiFiConfigPage);
   server.on("/save_wifi", HTTP_POST, handleWiFiConfigSave);
-  server.onNotFound([]() { // Redirect all other requests to config page
-    server.sendHeader("Location", "/wifi_config.html");
-    server.send(302, "text/plain", "");
-  });
+  server.onNotFound(handleNotFound); // This will now handle static files too
 
   server.begin();
-  Serial.println("AP Mode HTTP server started.");
+  LOG_INFO("HTTP server started");
+
+  // WebSocket server setup
+  webSocket.begin();
+  webSocket.onEvent([](uint8_t num, WStype_t type, uint8_t * payload, size_t length){
+    switch (type) {
+      case WStype_DISCONNECTED:
+        LOG_DEBUG("[%u] Disconnected!", num);
+        break;
+      case WStype_CONNECTED: {
+        IPAddress ip = webSocket.remoteIP(num);
+        LOG_DEBUG("[%u] Connected from %d.%d.%d.%d url: %s", num, ip[0], ip[1], ip[2], ip[3], payload);
+        if (firstWebSocketClientMs == 0) {
+          // The figure that matters to the user: power-on until the UI is live
+          firstWebSocketClientMs = millis();
+          WifiLinkStats stats = wifiLink.stats();
+          LOG_INFO("First WebSocket client %lu ms after power-on (Wi-Fi up at %lu ms, %s%s)",
+                        (unsigned long)firstWebSocketClientMs, (unsigned long)stats.firstConnectMs,
+                        stats.fastConnects > 0 ? "cached access point" : "full scan",
+                        wifiLink.staticIp() ? ", static IP" : ", DHCP");
+        }
+        // Send current state immediately upon connection
+        sendCurrentStateToClients();
+      }
+        break;
+      case WStype_TEXT: { // Added curly braces to create a new scope
+        LOG_DEBUG("[%u] get Text: %s", num, payload);
+        // Parse JSON command from client
+        // Use JsonDocument for modern ArduinoJson API
+        // Increased size to handle large configuration imports
+        DynamicJsonDocument doc(4096); 
+        DeserializationError error = deserializeJson(doc, payload);
+
+        if (error) {
+          LOG_WARN("deserializeJson() failed: %s", error.c_str());
+          return;
+        }
+
+        // Commands that only read the store, the profiler or start an update run
+        // without the state lock; the rest change the state the engine works on
+        String command = doc["command"];
+        if (command == "replay") {
+          uint32_t fromSequence = doc["fromSequence"] | 0UL;
+          handleReplayCommand(num, fromSequence);
+        } else if (command == "profile") {
+          String action = doc["action"] | "get";
+          handleProfileCommand(num, action);
+        } else if (command == "updateFirmware") { // New command for OTA updates
+          String type = doc["type"];
+          String filename = doc["filename"];
+          size_t size = doc["size"];
+          handleUpdateFirmwareCommand(type, filename, size);
+        } else {
+          StateLock lock;
+          handleStateCommand(command, doc);
+        }
+        sendPendingState(); // The new state goes out once the lock is released
+        break;
+      } // End of WStype_TEXT scope
+      case WStype_BIN: {
+        if (isUpdating) {
+          size_t len = length;
+          if (updateReceived + len > updateSize) {
+            len = updateSize - updateReceived; // Prevent overflow
+          }
+          Update.write((uint8_t*)payload, len);
+          updateReceived += len;
+          LOG_TRACE("Received %d bytes, total %d/%d", (int)len, (int)updateReceived, (int)updateSize);
+          if (updateReceived >= updateSize) {
+            if (Update.end(true)) {
+              LOG_INFO("Update successful. Sending status and rebooting...");
+              // Send success status to client
+              DynamicJsonDocument statusDoc(128);
+              statusDoc["updateStatus"] = "success";
+              String statusJson;
+              serializeJson(statusDoc, statusJson);
+              webSocket.broadcastTXT(statusJson);
+              delay(2000); // Give time for the message to be sent
+              logger.flush();
+              ESP.restart();
+            } else {
+              LOG_ERROR("Update failed.");
+              // Send error status to client
+              DynamicJsonDocument statusDoc(128);
+              statusDoc["updateStatus"] = "error";
+              statusDoc["message"] = "Update failed";
+              String statusJson;
+              serializeJson(statusDoc, statusJson);
+              webSocket.broadcastTXT(statusJson);
+              isUpdating = false;
+              Update.abort();
+            }
+          }
+        }
+        break;
+      }
+      case WStype_ERROR:
+      case WStype_FRAGMENT_TEXT_START:
+      case WStype_FRAGMENT_BIN_START:
+      case WStype_FRAGMENT:
+      case WStype_FRAGMENT_FIN:
+        break;
+    }
+  });
+  LOG_INFO("WebSocket server started on port 81");
+
+  bootSequence.finish(BOOT_STAGE_NETWORK);
+}
+
+/**
+ * @brief Runs a WebSocket command that changes the measurement state. Call with
+ *        the state lock held; the new state is sent once the caller releases it.
+ */
+void handleStateCommand(const String& command, JsonDocument& doc) {
+  if (command == "zero") {
+    handleZeroCommand();
+  } else if (command == "measure") {
+    handleMeasureCommand();
+  } else if (command == "calibrate") {
+    // Calibration command now takes a step parameter
+    String step = doc["step"];
+    if (step == "startWizard") { // New command to start the wizard
+      startCalibrationWizard();
+    } else if (step == "setZeroPoint") { // New command for zero point
+      setCalibrationZeroPoint();
+    } else if (step == "setKnownGrains") { // New command for known grains
+      float knownWeight = doc["knownWeight"];
+      setCalibrationKnownGrains(knownWeight);
+    } else if (step == "cancel") {
+      cancelCalibration();
+    }
+    handleCalibrateCommand(); // Call to update UI with new state
+  } else if (command == "selectConfig") {
+    int index = doc["index"];
+    handleSelectConfigCommand(index);
+  } else if (command == "saveConfig") {
+    JsonObject data = doc["data"];
+    handleSaveConfigCommand(data);
+  } else if (command == "deleteConfig") {
+    int index = doc["index"];
+    handleDeleteConfigCommand(index);
+  } else if (command == "setAlarms") {
+    bool enabled = doc["enabled"];
+    float low = doc["lowThreshold"];
+    float high = doc["highThreshold"];
+    handleSetAlarmsCommand(enabled, low, high);
+  } else if (command == "acknowledgeAlarm") {
+    handleAcknowledgeAlarmCommand();
+  } else if (command == "resetSession") {
+    handleResetSessionCommand();
+  } else if (command == "startSession") {
+    handleStartSessionCommand();
+  } else if (command == "endSession") {
+    handleEndSessionCommand();
+  } else if (command == "factoryReset") { // New command
+    handleFactoryResetCommand();
+  } else if (command == "importConfigs") { // New command for importing configurations
+    JsonArray configs = doc["configs"];
+    handleImportConfigsCommand(configs);
+  } else if (command == "displayBenchmark") {
+    int frames = doc["frames"] | 20;
+    handleDisplayBenchmarkCommand(frames);
+  } else if (command == "displayClockSweep") {
+    handleDisplayClockSweepCommand();
+  } else if (command == "setSetting") { // New command to set a generic setting
+    String key = doc["key"];
+    if (key == "displayView") {
+      String value = doc["value"];
+      handleSetDisplayViewCommand(value);
+    } else if (key == "displayDimAfterS" || key == "displayBlankAfterS" || key == "displayDimBrightness") {
+      long value = doc["value"] | -1L;
+      handleSetDisplayPowerCommand(key, value);
+    } else if (key == "displaySpiClock") {
+      long value = doc["value"] | -1L;
+      handleSetDisplayClockCommand(value);
+    } else if (key == "timeZone") {
+      String value = doc["value"];
+      handleSetTimeZoneCommand(value);
+    } else {
+      LOG_DEBUG("Received setSetting for key: %s (no action)", key.c_str());
+    }
+    sendCurrentStateToClients(); // Send updated state back to client
+  }
+  // Add more command handlers as needed
+}
+
+/**
+ * @brief Follows the station link for the offline indicator and logs what was
+ *        recorded while it was down. Called from loop().
+ */
+void updateNetworkOnline() {
+  bool online = wifiLink.connected();
+  if (online == networkOnline) {
+    return;
+  }
+  networkOnline = online;
+  uint32_t nextSequence = nextShotSequence;
+  if (online) {
+    LOG_INFO("Network back: %lu shots recorded offline (sequence %lu onwards), clients replay them",
+                  (unsigned long)(nextSequence - offlineFromSequence), (unsigned long)offlineFromSequence);
+  } else {
+    offlineFromSequence = nextSequence;
+    LOG_INFO("Network down: measuring carries on, shots are kept for replay");
+  }
+}
+
+/**
+ * @brief Sends one batch of stored shots starting at fromSequence to a client.
+ *        The reply says where the next batch starts and whether there is more,
+ *        so a client catches up batch by batch without a large buffer here.
+ * @param client WebSocket client number.
+ * @param fromSequence First sequence the client has not seen; older shots that
+ *        have been overwritten are skipped and reported as missed.
+ */
+void handleReplayCommand(uint8_t client, uint32_t fromSequence) {
+  StoredMeasurement batch[REPLAY_BATCH_SIZE];
+  uint32_t oldest = measurementStore.oldestSequence();
+  uint32_t first = max(fromSequence, oldest);
+  size_t count = measurementStore.read(first, batch, REPLAY_BATCH_SIZE);
+
+  DynamicJsonDocument doc(512 + REPLAY_BATCH_SIZE * 96);
+  JsonObject replay = doc.createNestedObject("replay");
+  replay["fromSequence"] = fromSequence;
+  replay["missed"] = fromSequence < oldest ? oldest - fromSequence : 0;
+  uint32_t next = count > 0 ? batch[count - 1].sequence + 1 : measurementStore.nextSequence();
+  replay["nextSequence"] = next;
+  replay["more"] = next < measurementStore.nextSequence();
+  JsonArray measurements = replay.createNestedArray("measurements");
+  String json;
+  {
+    StateLock lock; // For the config table; the store has its own lock
+    for (size_t i = 0; i < count; i++) {
+      JsonObject m = measurements.createNestedObject();
+      m["sequence"] = batch[i].sequence;
+      m["timestamp"] = batch[i].timestamp;
+      m["weight"] = batch[i].weight;
+      const PowderConfig* config = configTable.find(batch[i].configId, batch[i].configVersion);
+      if (config) {
+        m["config"] = config->name;
+        m["targetGrain"] = config->targetGrain;
+      }
+    }
+    serializeJson(doc, json);
+  }
+  webSocket.sendTXT(client, json);
+  LOG_INFO("[%u] Replayed %d shots from sequence %lu", client, (int)count, (unsigned long)first);
+}
+
+/**
+ * @brief Runs the captive portal DNS server while the access point is up. Called from loop().
+ */
+void updateCaptiveDns() {
+  bool apActive = wifiLink.apActive();
+  if (apActive == captiveDnsRunning) {
+    return;
+  }
+  if (apActive) {
+    dnsServer.start(53, "*", IPAddress(192, 168, 4, 1));
+  } else {
+    dnsServer.stop();
+  }
+  captiveDnsRunning = apActive;
 }
 
 /**
  * @brief Handles requests to the root URL ("/"). Serves index.html from SPIFFS.
  */
 void handleRoot() {
-  Serial.println("Request for / (root)");
+  LOG_DEBUG("Request for / (root)");
+  if (wifiLink.inApMode()) {
+    handleWiFiConfigPage();
+    return;
+  }
   File file = SPIFFS.open("/index.html", "r");
   if(!file){
-    Serial.println("Failed to open /index.html from SPIFFS");
+    LOG_ERROR("Failed to open /index.html from SPIFFS");
     server.send(404, "text/plain", "File Not Found");
     return;
   }
   server.streamFile(file, "text/html");
   file.close();
-  Serial.println("Served /index.html");
+  LOG_DEBUG("Served /index.html");
 }
 
 /**
  * @brief Handles requests to "/depth". Returns current state as JSON.
  */
 void handleGetDepth() {
-  Serial.println("HTTP Request for /depth (full state)");
-  DynamicJsonDocument doc(3072); // Increased size for configs
-
-  doc["currentWeight"] = currentPowderWeight;
-  doc["currentAdc"] = readDepthADC(); // Add current ADC value
-  doc["alarmActive"] = alarmActive;
-  doc["alarmEnabled"] = alarmSettings.enabled;
-  doc["lowThreshold"] = alarmSettings.lowThreshold;
-  doc["highThreshold"] = alarmSettings.highThreshold;
-  doc["wifiConnected"] = (WiFi.status() == WL_CONNECTED);
-  doc["freeHeap"] = ESP.getFreeHeap();
-  doc["rssi"] = WiFi.RSSI();
-  doc["ipAddress"] = WiFi.localIP().toString();
-  doc["uptime"] = systemUptimeMillis;
-  time_t now = time(nullptr);
-  doc["currentTime"] = now;
-  doc["calibrationState"] = currentCalibrationState;
-  doc["isCalibrated"] = (currentConfigIndex != -1) ? powderConfigs[currentConfigIndex].isCalibrated : false;
-  doc["tempKnownGrainsDepth"] = tempKnownGrainsDepth;
-  doc["isStable"] = isStable;
+  LOG_DEBUG("HTTP Request for /depth (full state)");
+  String jsonResponse;
+  {
+    StateLock lock; // Copied under the lock, sent without it
+    DynamicJsonDocument doc(STATE_JSON_SIZE);
+
+    doc["currentWeight"] = currentPowderWeight;
+    doc["currentAdc"] = currentDepthAdc; // Add current ADC value
+    doc["alarmActive"] = alarmActive;
+    doc["alarmEnabled"] = alarmSettings.enabled;
+    doc["lowThreshold"] = alarmSettings.lowThreshold;
+    doc["highThreshold"] = alarmSettings.highThreshold;
+    doc["wifiConnected"] = wifiLink.connected();
+    doc["nextSequence"] = measurementStore.nextSequence(); // Clients replay from their last one after a dropout
+    doc["historyFirstSequence"] = nextShotSequence - measurementHistory.size(); // Clients drop shots outside the history
+    doc["historyEndSequence"] = nextShotSequence;
+    doc["freeHeap"] = ESP.getFreeHeap();
+    doc["rssi"] = WiFi.RSSI();
+    doc["ipAddress"] = WiFi.localIP().toString();
+    doc["uptime"] = systemUptimeMillis;
+    doc["currentTime"] = timeSync.now();
+    doc["timeSynced"] = timeSync.synced();
+    doc["timeZone"] = timeSync.timeZone();
+    doc["calibrationState"] = currentCalibrationState;
+    doc["isCalibrated"] = (currentConfigIndex != -1) ? powderConfigs[currentConfigIndex].isCalibrated : false;
+    doc["tempKnownGrainsDepth"] = tempKnownGrainsDepth;
+    doc["isStable"] = isStable;
+    doc["displayView"] = displayViewName(displayView);
   
-  doc["currentConfigIndex"] = currentConfigIndex;
-
-  // Add current config details if one is selected
-  if (currentConfigIndex != -1 && currentConfigIndex < configCount) {
-    JsonObject currentConfig = doc.createNestedObject("currentConfig");
-    currentConfig["name"] = powderConfigs[currentConfigIndex].name;
-    currentConfig["caliber"] = powderConfigs[currentConfigIndex].caliber;
-    currentConfig["bulletWeight"] = powderConfigs[currentConfigIndex].bulletWeight;
-    currentConfig["powderName"] = powderConfigs[currentConfigIndex].powderName;
-    currentConfig["targetGrain"] = powderConfigs[currentConfigIndex].targetGrain;
-    currentConfig["potMinAdc"] = powderConfigs[currentConfigIndex].potMinAdc; // Added
-    currentConfig["grainsPerMmFactor"] = powderConfigs[currentConfigIndex].grainsPerMmFactor; // Added
-    currentConfig["isCalibrated"] = powderConfigs[currentConfigIndex].isCalibrated; // Added
-  }
+    doc["currentConfigIndex"] = currentConfigIndex;
+
+    // Add current config details if one is selected
+    if (currentConfigIndex != -1 && currentConfigIndex < configCount) {
+      JsonObject currentConfig = doc.createNestedObject("currentConfig");
+      currentConfig["name"] = powderConfigs[currentConfigIndex].name;
+      currentConfig["caliber"] = powderConfigs[currentConfigIndex].caliber;
+      currentConfig["bulletWeight"] = powderConfigs[currentConfigIndex].bulletWeight;
+      currentConfig["powderName"] = powderConfigs[currentConfigIndex].powderName;
+      currentConfig["targetGrain"] = powderConfigs[currentConfigIndex].targetGrain;
+      currentConfig["potMinAdc"] = powderConfigs[currentConfigIndex].potMinAdc; // Added
+      currentConfig["grainsPerMmFactor"] = powderConfigs[currentConfigIndex].grainsPerMmFactor; // Added
+      currentConfig["isCalibrated"] = powderConfigs[currentConfigIndex].isCalibrated; // Added
+    }
 
-  // Add the list of all configurations
-  JsonArray configs = doc.createNestedArray("powderConfigs");
-  for (int i = 0; i < configCount; i++) {
-    JsonObject config_out = configs.createNestedObject();
-    config_out["name"] = powderConfigs[i].name;
-    config_out["caliber"] = powderConfigs[i].caliber;
-    config_out["bulletWeight"] = powderConfigs[i].bulletWeight;
-    config_out["powderName"] = powderConfigs[i].powderName;
-    config_out["targetGrain"] = powderConfigs[i].targetGrain;
-    config_out["potMinAdc"] = powderConfigs[i].potMinAdc;
-    config_out["grainsPerMmFactor"] = powderConfigs[i].grainsPerMmFactor;
-    config_out["isCalibrated"] = powderConfigs[i].isCalibrated;
-  }
-
-  JsonObject stats = doc["stats"].to<JsonObject>();
-  stats["averageWeight"] = (sessionMeasurementCount > 0) ? (sumWeight / sessionMeasurementCount) : 0.0; // Handle division by zero
-  stats["standardDeviation"] = calculateStandardDeviation();
-  stats["minWeight"] = minWeight;
-  stats["maxWeight"] = maxWeight;
-  stats["totalMeasurements"] = measurementCount;
-  stats["sessionMeasurements"] = sessionMeasurementCount;
-
-  JsonArray recentMeasurements = doc["recentMeasurements"].to<JsonArray>();
-  // Send all measurements in the current session
-  // The JS will reverse it to show newest first.
-  for (int i = 0; i < sessionMeasurementCount; i++) {
-    JsonObject m = recentMeasurements.createNestedObject();
-    m["timestamp"] = measurementHistory[i].timestamp;
-    m["weight"] = measurementHistory[i].weight;
-    if (measurementHistory[i].configWasSet) {
-      JsonObject config = m.createNestedObject("config");
-      config["name"] = measurementHistory[i].config.name;
-      config["caliber"] = measurementHistory[i].config.caliber;
-      config["bulletWeight"] = measurementHistory[i].config.bulletWeight;
-      config["powderName"] = measurementHistory[i].config.powderName;
-      config["targetGrain"] = measurementHistory[i].config.targetGrain;
+    // Add the list of all configurations
+    JsonArray configs = doc.createNestedArray("powderConfigs");
+    for (int i = 0; i < configCount; i++) {
+      JsonObject config_out = configs.createNestedObject();
+      config_out["name"] = powderConfigs[i].name;
+      config_out["caliber"] = powderConfigs[i].caliber;
+      config_out["bulletWeight"] = powderConfigs[i].bulletWeight;
+      config_out["powderName"] = powderConfigs[i].powderName;
+      config_out["targetGrain"] = powderConfigs[i].targetGrain;
+      config_out["potMinAdc"] = powderConfigs[i].potMinAdc;
+      config_out["grainsPerMmFactor"] = powderConfigs[i].grainsPerMmFactor;
+      config_out["isCalibrated"] = powderConfigs[i].isCalibrated;
     }
-  }
 
-  // Add session logs
-  JsonArray sessionLogsArray = doc.createNestedArray("sessionLogs");
-  Serial.printf("Sending %d session logs to client\n", sessionLogCount);
-  for (int i = 0; i < sessionLogCount; i++) {
-    JsonObject log = sessionLogsArray.createNestedObject();
-    log["startTime"] = sessionLogs[i].startTime;
-    log["endTime"] = sessionLogs[i].endTime;
-    log["bulletCount"] = sessionLogs[i].bulletCount;
-    log["totalWeight"] = sessionLogs[i].totalWeight;
-    Serial.printf("  Log %d: bullets=%d, weight=%.2f\n", i, sessionLogs[i].bulletCount, sessionLogs[i].totalWeight);
-  }
+    JsonObject stats = doc["stats"].to<JsonObject>();
+    const Rollup& sessionStats = rollupStore.session();
+    stats["averageWeight"] = sessionStats.mean(); // 0 when no measurements yet
+    stats["standardDeviation"] = calculateStandardDeviation();
+    stats["minWeight"] = sessionStats.min / 1000.0;
+    stats["maxWeight"] = sessionStats.max / 1000.0;
+    stats["extremeSpread"] = sessionStats.extremeSpread();
+    stats["inBandPercent"] = sessionStats.inBandPercent();
+    stats["totalMeasurements"] = measurementCount;
+    stats["sessionMeasurements"] = sessionMeasurementCount;
 
-  String jsonResponse;
-  serializeJson(doc, jsonResponse);
+    displayStatsToJson(doc.createNestedObject("display"));
+    wifiStatsToJson(doc.createNestedObject("wifi"));
+
+    recentMeasurementsToJson(doc.createNestedArray("recentMeasurements"));
+
+    sessionLogsToJson(doc.createNestedArray("sessionLogs"));
+
+    if (doc.overflowed()) {
+      LOG_WARN("/depth state did not fit in %d bytes, parts are missing", STATE_JSON_SIZE);
+    }
+    serializeJson(doc, jsonResponse);
+  }
   server.send(200, "application/json", jsonResponse);
-  Serial.println("Served /depth JSON state.");
+  LOG_DEBUG("Served /depth JSON state.");
 }
 
 /**
  * @brief Handles requests for /api/measurement (fallback for JS).
  */
 void handleApiMeasurement() {
-  Serial.println("HTTP Request for /api/measurement (fallback)");
+  LOG_DEBUG("HTTP Request for /api/measurement (fallback)");
   DynamicJsonDocument doc(128);
-  doc["powderWeight"] = currentPowderWeight; // Use currentPowderWeight for API
+  doc["powderWeight"] = currentPowderWeight; // Use currentPowderWeight for API; a float, read without the lock
   String jsonResponse;
   serializeJson(doc, jsonResponse);
   server.send(200, "application/json", jsonResponse);
-  Serial.println("Served /api/measurement JSON.");
+  LOG_DEBUG("Served /api/measurement JSON.");
 }
 
 /**
@@ -1218,11 +1883,10 @@ void handleApiMeasurement() {
  */
 void handleNotFound() {
   String path = server.uri();
-  Serial.print("Handling not found: Requested path: ");
-  Serial.println(path);
+  LOG_DEBUG("Handling not found: Requested path: %s", path.c_str());
 
   if (path == "/ws") {
-    Serial.println("Ignoring /ws request, handled by WebSocketsServer.");
+    LOG_DEBUG("Ignoring /ws request, handled by WebSocketsServer.");
     return;
   }
 
@@ -1232,7 +1896,7 @@ void handleNotFound() {
     return;
   }
 
-  if (WiFi.getMode() == WIFI_AP) {
+  if (wifiLink.inApMode()) {
     server.sendHeader("Location", "/wifi_config.html");
     server.send(302, "text/plain", "");
     return;
@@ -1245,21 +1909,17 @@ void handleNotFound() {
 
   String contentType = getContentType(path);
   if(SPIFFS.exists(path)){
-    Serial.print("File found in SPIFFS: ");
-    Serial.println(path);
+    LOG_DEBUG("File found in SPIFFS: %s", path.c_str());
     File file = SPIFFS.open(path, "r");
     if(file){
       server.streamFile(file, contentType);
       file.close();
-      Serial.print("Served file: ");
-      Serial.println(path);
+      LOG_DEBUG("Served file: %s", path.c_str());
     } else {
-      Serial.print("Failed to open file from SPIFFS: ");
-      Serial.println(path);
+      LOG_ERROR("Failed to open file from SPIFFS: %s", path.c_str());
     }
   } else {
-    Serial.print("File not found in SPIFFS: ");
-    Serial.println(path);
+    LOG_DEBUG("File not found in SPIFFS: %s", path.c_str());
   }
 
   String message = "File Not Found\n\n";
@@ -1274,100 +1934,155 @@ void handleNotFound() {
     message += " " + server.argName(i) + ": " + server.arg(i) + "\n";
   }
   server.send(404, "text/plain", message);
-  Serial.println("Sent 404 Not Found.");
+  LOG_DEBUG("Sent 404 Not Found.");
 }
 
 /**
  * @brief Sends the current state of the device to all connected WebSocket clients.
+ *        The document is built under the state lock and sent after it is released.
+ *        If the caller holds the lock, the state is only marked pending.
  */
 void sendCurrentStateToClients() {
-  DynamicJsonDocument doc(3072); // Increased size for configs
-
-  doc["currentWeight"] = currentPowderWeight;
-  doc["currentAdc"] = readDepthADC(); // Add current ADC value
-  doc["alarmActive"] = alarmActive;
-  doc["alarmEnabled"] = alarmSettings.enabled;
-  doc["lowThreshold"] = alarmSettings.lowThreshold;
-  doc["highThreshold"] = alarmSettings.highThreshold;
-  doc["wifiConnected"] = (WiFi.status() == WL_CONNECTED);
-  doc["freeHeap"] = ESP.getFreeHeap();
-  doc["rssi"] = WiFi.RSSI();
-  doc["ipAddress"] = WiFi.localIP().toString();
-  doc["uptime"] = systemUptimeMillis;
-  doc["calibrationState"] = currentCalibrationState;
-  doc["isCalibrated"] = (currentConfigIndex != -1) ? powderConfigs[currentConfigIndex].isCalibrated : false;
-  doc["tempKnownGrainsDepth"] = tempKnownGrainsDepth;
-  doc["isStable"] = isStable;
+  if (StateLock::held()) {
+    stateBroadcastPending = true; // Sent by sendPendingState() once the caller lets go
+    return;
+  }
+  ProfileScope profile(PROFILE_STATE_BROADCAST);
+  if (webSocket.connectedClients() == 0) {
+    return; // Nobody to tell; building the document would only slow measuring down
+  }
+  String jsonString;
+  {
+    StateLock lock; // Copied under the lock, sent without it
+    DynamicJsonDocument doc(STATE_JSON_SIZE);
+
+    doc["currentWeight"] = currentPowderWeight;
+    doc["currentAdc"] = currentDepthAdc; // Add current ADC value
+    doc["alarmActive"] = alarmActive;
+    doc["alarmEnabled"] = alarmSettings.enabled;
+    doc["lowThreshold"] = alarmSettings.lowThreshold;
+    doc["highThreshold"] = alarmSettings.highThreshold;
+    doc["wifiConnected"] = wifiLink.connected();
+    doc["nextSequence"] = measurementStore.nextSequence(); // Clients replay from their last one after a dropout
+    doc["historyFirstSequence"] = nextShotSequence - measurementHistory.size(); // Clients drop shots outside the history
+    doc["historyEndSequence"] = nextShotSequence;
+    doc["freeHeap"] = ESP.getFreeHeap();
+    doc["rssi"] = WiFi.RSSI();
+    doc["ipAddress"] = WiFi.localIP().toString();
+    doc["uptime"] = systemUptimeMillis;
+    doc["timeSynced"] = timeSync.synced();
+    doc["timeZone"] = timeSync.timeZone();
+    doc["calibrationState"] = currentCalibrationState;
+    doc["isCalibrated"] = (currentConfigIndex != -1) ? powderConfigs[currentConfigIndex].isCalibrated : false;
+    doc["tempKnownGrainsDepth"] = tempKnownGrainsDepth;
+    doc["isStable"] = isStable;
+    doc["displayView"] = displayViewName(displayView);
   
-  doc["currentConfigIndex"] = currentConfigIndex;
+    doc["currentConfigIndex"] = currentConfigIndex;
+
+    // Add current config details if one is selected
+    if (currentConfigIndex != -1 && currentConfigIndex < configCount) {
+      JsonObject currentConfig = doc.createNestedObject("currentConfig");
+      currentConfig["name"] = powderConfigs[currentConfigIndex].name;
+      currentConfig["caliber"] = powderConfigs[currentConfigIndex].caliber;
+      currentConfig["bulletWeight"] = powderConfigs[currentConfigIndex].bulletWeight;
+      currentConfig["powderName"] = powderConfigs[currentConfigIndex].powderName;
+      currentConfig["targetGrain"] = powderConfigs[currentConfigIndex].targetGrain;
+      currentConfig["potMinAdc"] = powderConfigs[currentConfigIndex].potMinAdc; // Added
+      currentConfig["grainsPerMmFactor"] = powderConfigs[currentConfigIndex].grainsPerMmFactor; // Added
+      currentConfig["isCalibrated"] = powderConfigs[currentConfigIndex].isCalibrated; // Added
+    }
+
+    // Add the list of all configurations
+    JsonArray configs = doc.createNestedArray("powderConfigs");
+    for (int i = 0; i < configCount; i++) {
+      JsonObject config_out = configs.createNestedObject();
+      config_out["name"] = powderConfigs[i].name;
+      config_out["caliber"] = powderConfigs[i].caliber;
+      config_out["bulletWeight"] = powderConfigs[i].bulletWeight;
+      config_out["powderName"] = powderConfigs[i].powderName;
+      config_out["targetGrain"] = powderConfigs[i].targetGrain;
+      config_out["potMinAdc"] = powderConfigs[i].potMinAdc;
+      config_out["grainsPerMmFactor"] = powderConfigs[i].grainsPerMmFactor;
+      config_out["isCalibrated"] = powderConfigs[i].isCalibrated;
+    }
+
+    JsonObject stats = doc["stats"].to<JsonObject>();
+    const Rollup& sessionStats = rollupStore.session();
+    stats["averageWeight"] = sessionStats.mean(); // 0 when no measurements yet
+    stats["standardDeviation"] = calculateStandardDeviation();
+    stats["minWeight"] = sessionStats.min / 1000.0;
+    stats["maxWeight"] = sessionStats.max / 1000.0;
+    stats["extremeSpread"] = sessionStats.extremeSpread();
+    stats["inBandPercent"] = sessionStats.inBandPercent();
+    stats["totalMeasurements"] = measurementCount;
+    stats["sessionMeasurements"] = sessionMeasurementCount;
+
+    displayStatsToJson(doc.createNestedObject("display"));
+    wifiStatsToJson(doc.createNestedObject("wifi"));
+
+    recentMeasurementsToJson(doc.createNestedArray("recentMeasurements"));
 
-  // Add current config details if one is selected
-  if (currentConfigIndex != -1 && currentConfigIndex < configCount) {
-    JsonObject currentConfig = doc.createNestedObject("currentConfig");
-    currentConfig["name"] = powderConfigs[currentConfigIndex].name;
-    currentConfig["caliber"] = powderConfigs[currentConfigIndex].caliber;
-    currentConfig["bulletWeight"] = powderConfigs[currentConfigIndex].bulletWeight;
-    currentConfig["powderName"] = powderConfigs[currentConfigIndex].powderName;
-    currentConfig["targetGrain"] = powderConfigs[currentConfigIndex].targetGrain;
-    currentConfig["potMinAdc"] = powderConfigs[currentConfigIndex].potMinAdc; // Added
-    currentConfig["grainsPerMmFactor"] = powderConfigs[currentConfigIndex].grainsPerMmFactor; // Added
-    currentConfig["isCalibrated"] = powderConfigs[currentConfigIndex].isCalibrated; // Added
+    sessionLogsToJson(doc.createNestedArray("sessionLogs"));
+
+    if (doc.overflowed()) {
+      LOG_WARN("State broadcast did not fit in %d bytes, parts are missing", STATE_JSON_SIZE);
+    }
+    serializeJson(doc, jsonString);
   }
+  webSocket.broadcastTXT(jsonString);
+}
 
-  // Add the list of all configurations
-  JsonArray configs = doc.createNestedArray("powderConfigs");
-  for (int i = 0; i < configCount; i++) {
-    JsonObject config_out = configs.createNestedObject();
-    config_out["name"] = powderConfigs[i].name;
-    config_out["caliber"] = powderConfigs[i].caliber;
-    config_out["bulletWeight"] = powderConfigs[i].bulletWeight;
-    config_out["powderName"] = powderConfigs[i].powderName;
-    config_out["targetGrain"] = powderConfigs[i].targetGrain;
-    config_out["potMinAdc"] = powderConfigs[i].potMinAdc;
-    config_out["grainsPerMmFactor"] = powderConfigs[i].grainsPerMmFactor;
-    config_out["isCalibrated"] = powderConfigs[i].isCalibrated;
-  }
-
-  JsonObject stats = doc["stats"].to<JsonObject>();
-  stats["averageWeight"] = (sessionMeasurementCount > 0) ? (sumWeight / sessionMeasurementCount) : 0.0; // Handle division by zero
-  stats["standardDeviation"] = calculateStandardDeviation();
-  stats["minWeight"] = minWeight;
-  stats["maxWeight"] = maxWeight;
-  stats["totalMeasurements"] = measurementCount;
-  stats["sessionMeasurements"] = sessionMeasurementCount;
-
-  JsonArray recentMeasurements = doc["recentMeasurements"].to<JsonArray>();
-  // Send all measurements in the current session
-  // The JS will reverse it to show newest first.
-  for (int i = 0; i < sessionMeasurementCount; i++) {
-    JsonObject m = recentMeasurements.createNestedObject();
-    m["timestamp"] = measurementHistory[i].timestamp;
-    m["weight"] = measurementHistory[i].weight;
-    if (measurementHistory[i].configWasSet) {
+/**
+ * @brief Writes the newest STATE_RECENT_MEASUREMENTS shots, newest first, with their sequence numbers.
+ *        Only handleMeasureCommand() adds to the history, and it numbers every shot, so the
+ *        newest entry is nextShotSequence - 1 and the rest count down from it.
+ */
+void recentMeasurementsToJson(JsonArray out) {
+  size_t count = min(measurementHistory.size(), (size_t)STATE_RECENT_MEASUREMENTS);
+  uint16_t lastId = CONFIG_ID_NONE;
+  uint16_t lastVersion = 0;
+  const PowderConfig* entryConfig = nullptr;
+  for (size_t i = 0; i < count; i++) {
+    const Measurement& entry = measurementHistory[measurementHistory.size() - 1 - i];
+    JsonObject m = out.createNestedObject();
+    m["sequence"] = nextShotSequence - 1 - i;
+    m["timestamp"] = entry.timestamp;
+    m["weight"] = entry.weight;
+    // Shots come in runs with the same config, so look it up once per run
+    if (entry.configId != lastId || entry.configVersion != lastVersion) {
+      lastId = entry.configId;
+      lastVersion = entry.configVersion;
+      entryConfig = configTable.find(entry.configId, entry.configVersion);
+    }
+    if (entryConfig) {
       JsonObject config = m.createNestedObject("config");
-      config["name"] = measurementHistory[i].config.name;
-      config["caliber"] = measurementHistory[i].config.caliber;
-      config["bulletWeight"] = measurementHistory[i].config.bulletWeight;
-      config["powderName"] = measurementHistory[i].config.powderName;
-      config["targetGrain"] = measurementHistory[i].config.targetGrain;
+      config["name"] = entryConfig->name;
+      config["caliber"] = entryConfig->caliber;
+      config["bulletWeight"] = entryConfig->bulletWeight;
+      config["powderName"] = entryConfig->powderName;
+      config["targetGrain"] = entryConfig->targetGrain;
+      config["version"] = entry.configVersion;
     }
   }
+}
 
-  // Add session logs
-  JsonArray sessionLogsArray = doc.createNestedArray("sessionLogs");
-  Serial.printf("Sending %d session logs to client via WebSocket\n", sessionLogCount);
-  for (int i = 0; i < sessionLogCount; i++) {
-    JsonObject log = sessionLogsArray.createNestedObject();
-    log["startTime"] = sessionLogs[i].startTime;
-    log["endTime"] = sessionLogs[i].endTime;
-    log["bulletCount"] = sessionLogs[i].bulletCount;
-    log["totalWeight"] = sessionLogs[i].totalWeight;
-    Serial.printf("  Log %d: bullets=%d, weight=%.2f\n", i, sessionLogs[i].bulletCount, sessionLogs[i].totalWeight);
+/**
+ * @brief Writes all session logs, oldest first; the index is what exportSessionDetails takes.
+ */
+void sessionLogsToJson(JsonArray out) {
+  for (const SessionLog& sessionLog : sessionLogs) {
+    JsonObject log = out.createNestedObject();
+    log["startTime"] = sessionLog.startTime;
+    log["endTime"] = sessionLog.endTime;
+    log["bulletCount"] = sessionLog.bulletCount;
+    log["totalWeight"] = sessionLog.totalWeight;
+    log["measurementCount"] = sessionLog.measurementCount; // Shots available for detailed export
+    log["averageWeight"] = sessionLog.stats.mean();
+    log["standardDeviation"] = sessionLog.stats.standardDeviation();
+    log["extremeSpread"] = sessionLog.stats.extremeSpread();
+    log["inBandPercent"] = sessionLog.stats.inBandPercent();
   }
-
-  String jsonString;
-  serializeJson(doc, jsonString);
-  webSocket.broadcastTXT(jsonString);
 }
 
 
@@ -1383,6 +2098,11 @@ void saveSettings() {
   doc["lowThreshold"] = alarmSettings.lowThreshold;
   doc["highThreshold"] = alarmSettings.highThreshold;
   doc["currentConfigIndex"] = currentConfigIndex;
+  doc["displayView"] = displayViewName(displayView);
+  doc["displayDimAfterS"] = displayPower.settings().dimAfterMs / 1000;
+  doc["displayBlankAfterS"] = displayPower.settings().blankAfterMs / 1000;
+  doc["displayDimBrightness"] = displayPower.settings().dimBrightness;
+  doc["timeZone"] = timeSync.timeZone();
 
   // Save powder configurations
   JsonArray configs = doc.createNestedArray("powderConfigs");
@@ -1396,27 +2116,21 @@ void saveSettings() {
     config_out["potMinAdc"] = powderConfigs[i].potMinAdc; // Added
     config_out["grainsPerMmFactor"] = powderConfigs[i].grainsPerMmFactor; // Added
     config_out["isCalibrated"] = powderConfigs[i].isCalibrated; // Added
+    config_out["id"] = powderConfigs[i].id;
+    config_out["version"] = powderConfigs[i].version;
   }
 
-  // Save session logs
-  JsonArray logs = doc.createNestedArray("sessionLogs");
-  for (int i = 0; i < sessionLogCount; i++) {
-    JsonObject log_out = logs.createNestedObject();
-    log_out["startTime"] = sessionLogs[i].startTime;
-    log_out["endTime"] = sessionLogs[i].endTime;
-    log_out["bulletCount"] = sessionLogs[i].bulletCount;
-    log_out["totalWeight"] = sessionLogs[i].totalWeight;
-  }
+  // Session logs are saved separately in binary form, see saveSessionLogs()
 
   File file = SPIFFS.open("/settings.json", "w");
   if (!file) {
-    Serial.println("Failed to open settings file for writing");
+    LOG_ERROR("Failed to open settings file for writing");
     return;
   }
   if (serializeJson(doc, file) == 0) {
-    Serial.println("Failed to write settings to file");
+    LOG_ERROR("Failed to write settings to file");
   } else {
-    Serial.println("Settings data saved.");
+    LOG_INFO("Settings data saved.");
   }
   file.close();
 }
@@ -1426,19 +2140,19 @@ void saveSettings() {
  */
 void loadSettings() {
   if (!SPIFFS.exists("/settings.json")) {
-    Serial.println("Settings file not found, using initial defaults.");
+    LOG_WARN("Settings file not found, using initial defaults.");
     return;
   }
 
   File file = SPIFFS.open("/settings.json", "r");
   if (!file) {
-    Serial.println("Failed to open settings file, using initial defaults.");
+    LOG_ERROR("Failed to open settings file, using initial defaults.");
     return;
   }
 
   // Check if file is empty
   if (file.size() == 0) {
-    Serial.println("Settings file is empty, using initial defaults.");
+    LOG_INFO("Settings file is empty, using initial defaults.");
     file.close();
     return;
   }
@@ -1447,8 +2161,7 @@ void loadSettings() {
   DynamicJsonDocument doc(2048); 
   DeserializationError error = deserializeJson(doc, file);
   if (error) {
-    Serial.println("Failed to read settings file, using initial defaults.");
-    Serial.println(error.f_str());
+    LOG_ERROR("Failed to read settings file, using initial defaults: %s", error.c_str());
     file.close();
     return;
   }
@@ -1458,10 +2171,21 @@ void loadSettings() {
   alarmSettings.lowThreshold = doc["lowThreshold"] | 0.0;
   alarmSettings.highThreshold = doc["highThreshold"] | 100.0;
   currentConfigIndex = doc["currentConfigIndex"] | -1;
+  String view = doc["displayView"] | "readout";
+  displayView = (view == "trace") ? DISPLAY_VIEW_TRACE : DISPLAY_VIEW_READOUT;
+  DisplayPowerSettings power = displayPower.settings();
+  power.dimAfterMs = (doc["displayDimAfterS"] | power.dimAfterMs / 1000) * 1000UL;
+  power.blankAfterMs = (doc["displayBlankAfterS"] | power.blankAfterMs / 1000) * 1000UL;
+  power.dimBrightness = doc["displayDimBrightness"] | power.dimBrightness;
+  displayPower.configure(power);
+  if (!timeSync.setTimeZone(doc["timeZone"] | TIME_ZONE_DEFAULT)) {
+    timeSync.setTimeZone(TIME_ZONE_DEFAULT);
+  }
 
   // Load powder configurations
   JsonArray configs = doc["powderConfigs"].as<JsonArray>();
   configCount = 0;
+  bool configsAdopted = false; // Set when configs had to be (re)published to the version table
   for (JsonObject config_in : configs) {
     if (configCount >= MAX_CONFIGS) break;
 
@@ -1473,20 +2197,28 @@ void loadSettings() {
     powderConfigs[configCount].potMinAdc = config_in["potMinAdc"] | 0.0;
     powderConfigs[configCount].grainsPerMmFactor = config_in["grainsPerMmFactor"] | 0.0;
     powderConfigs[configCount].isCalibrated = config_in["isCalibrated"] | false;
+    powderConfigs[configCount].id = config_in["id"] | CONFIG_ID_NONE;
+    powderConfigs[configCount].version = config_in["version"] | 0;
+    if (configTable.adopt(powderConfigs[configCount])) {
+      configsAdopted = true;
+    }
 
     configCount++;
   }
 
-  // Load session logs
+  // Load session logs from older settings files; loadSessionLogs() replaces them
+  // with /sessions.bin when that exists
   JsonArray logs = doc["sessionLogs"].as<JsonArray>();
-  sessionLogCount = 0;
+  sessionLogs.clear();
   for (JsonObject log_in : logs) {
-    if (sessionLogCount >= MAX_SESSION_LOGS) break;
-    sessionLogs[sessionLogCount].startTime = log_in["startTime"] | 0;
-    sessionLogs[sessionLogCount].endTime = log_in["endTime"] | 0;
-    sessionLogs[sessionLogCount].bulletCount = log_in["bulletCount"] | 0;
-    sessionLogs[sessionLogCount].totalWeight = log_in["totalWeight"] | 0.0;
-    sessionLogCount++;
+    SessionLog log = {};
+    log.startTime = log_in["startTime"] | 0;
+    log.endTime = log_in["endTime"] | 0;
+    log.bulletCount = log_in["bulletCount"] | 0;
+    log.totalWeight = log_in["totalWeight"] | 0.0;
+    log.measurementStartIndex = log_in["firstSequence"] | 0;
+    log.measurementCount = log_in["measurementCount"] | 0; // 0 for logs saved before per-shot storage
+    sessionLogs.push(log); // Keeps the newest MAX_SESSION_LOGS entries
   }
 
   // Ensure currentConfigIndex is valid after loading configs
@@ -1494,8 +2226,65 @@ void loadSettings() {
     currentConfigIndex = -1;
   }
 
-  Serial.printf("Settings loaded. %d configurations and %d session logs found.\n", configCount, sessionLogCount);
+  LOG_INFO("Settings loaded. %d configurations and %d session logs found.", configCount, (int)sessionLogs.size());
   file.close();
+
+  if (configsAdopted) {
+    saveSettings(); // Persist newly assigned config ids and versions
+  }
+}
+
+/**
+ * @brief Saves session logs, including their rollups, to SPIFFS. Once the persistence
+ *        task runs it writes them after the state lock is released; before that,
+ *        and if it failed to start, they are written right away.
+ */
+void saveSessionLogs() {
+  sessionLogsSavePending = true;
+  if (persistenceTaskHandle == nullptr) {
+    savePendingFiles();
+  }
+}
+
+/**
+ * @brief Writes a copy of the session logs to SPIFFS as fixed-size records.
+ */
+void writeSessionLogs(const SessionLog* logs, size_t count) {
+  File file = SPIFFS.open("/sessions.bin", "w");
+  if (!file) {
+    LOG_ERROR("Failed to open session log file for writing");
+    return;
+  }
+  file.write((const uint8_t*)logs, count * sizeof(SessionLog));
+  file.close();
+  LOG_INFO("Saved %d session logs.", (int)count);
+}
+
+/**
+ * @brief Loads session logs from SPIFFS. Migrates logs read from settings.json
+ *        by loadSettings() when no binary file exists yet.
+ */
+void loadSessionLogs() {
+  if (!SPIFFS.exists("/sessions.bin")) {
+    if (!sessionLogs.empty()) {
+      LOG_INFO("Migrating session logs from settings.json.");
+      saveSessionLogs();
+    }
+    return;
+  }
+
+  File file = SPIFFS.open("/sessions.bin", "r");
+  if (!file) {
+    LOG_ERROR("Failed to open session log file.");
+    return;
+  }
+  sessionLogs.clear();
+  SessionLog log;
+  while (file.read((uint8_t*)&log, sizeof(SessionLog)) == sizeof(SessionLog)) {
+    sessionLogs.push(log);
+  }
+  file.close();
+  LOG_INFO("Loaded %d session logs.", (int)sessionLogs.size());
 }
 
 /**
@@ -1506,7 +2295,32 @@ void saveWiFiCredentials(const String& ssid, const String& password) {
   preferences.putString("ssid", ssid);
   preferences.putString("password", password);
   preferences.end(); // Close NVS namespace
-  Serial.println("WiFi credentials saved to NVS.");
+  WifiLink::forgetAccessPoint(); // May be a different network now
+  LOG_INFO("WiFi credentials saved to NVS.");
+}
+
+/**
+ * @brief Saves an optional static IP configuration next to the credentials.
+ *        An empty or invalid ip removes it, so DHCP is used again.
+ */
+void saveWiFiStaticIp(const String& ip, const String& gateway, const String& subnet, const String& dns) {
+  IPAddress address, gatewayAddress, subnetAddress, dnsAddress;
+  bool valid = address.fromString(ip) && gatewayAddress.fromString(gateway) && subnetAddress.fromString(subnet);
+  if (valid && !dnsAddress.fromString(dns)) {
+    dnsAddress = gatewayAddress; // Most home routers also answer DNS
+  }
+  preferences.begin("wifi-creds", false);
+  if (valid) {
+    preferences.putUInt("staticIp", (uint32_t)address);
+    preferences.putUInt("gateway", (uint32_t)gatewayAddress);
+    preferences.putUInt("subnet", (uint32_t)subnetAddress);
+    preferences.putUInt("dns", (uint32_t)dnsAddress);
+    LOG_INFO("WiFi static IP %s saved to NVS.", ip.c_str());
+  } else if (preferences.isKey("staticIp")) {
+    preferences.remove("staticIp");
+    LOG_INFO("WiFi static IP removed, using DHCP.");
+  }
+  preferences.end();
 }
 
 /**
@@ -1516,12 +2330,17 @@ void loadWiFiCredentials() {
   preferences.begin("wifi-creds", false); // Open NVS namespace
   wifiSsid = preferences.getString("ssid", "");
   wifiPassword = preferences.getString("password", "");
+  uint32_t staticIp = preferences.getUInt("staticIp", 0);
+  if (staticIp != 0) {
+    wifiLink.setStaticIp(IPAddress(staticIp), IPAddress(preferences.getUInt("gateway", 0)),
+                         IPAddress(preferences.getUInt("subnet", 0)), IPAddress(preferences.getUInt("dns", 0)));
+  }
   preferences.end(); // Close NVS namespace
 
   if (wifiSsid == "") {
-    Serial.println("WiFi credentials not found in NVS.");
+    LOG_WARN("WiFi credentials not found in NVS.");
   } else {
-    Serial.printf("WiFi credentials loaded from NVS: SSID=%s\n", wifiSsid.c_str());
+    LOG_INFO("WiFi credentials loaded from NVS: SSID=%s", wifiSsid.c_str());
   }
 }
 
@@ -1533,10 +2352,12 @@ void handleWiFiConfigSave() {
     String newSsid = server.arg("ssid");
     String newPassword = server.arg("password");
     saveWiFiCredentials(newSsid, newPassword);
+    saveWiFiStaticIp(server.arg("staticIp"), server.arg("gateway"), server.arg("subnet"), server.arg("dns"));
     
     server.send(200, "text/html", "<h1>WiFi Config Saved!</h1><p>Attempting to connect to your network. Please restart your device or wait for it to reconnect.</p><p>You can now disconnect from 'PowderSense' AP and connect to your home network.</p>");
-    Serial.println("WiFi credentials received and saved. Restarting...");
+    LOG_INFO("WiFi credentials received and saved. Restarting...");
     delay(1000);
+    logger.flush();
     ESP.restart(); // Restart to connect to the new network
   } else {
     server.send(400, "text/plain", "Missing SSID or Password");
@@ -1549,20 +2370,20 @@ void handleWiFiConfigSave() {
 void handleWiFiConfigPage() {
   File file = SPIFFS.open("/wifi_config.html", "r");
   if(!file){
-    Serial.println("Failed to open /wifi_config.html from SPIFFS");
+    LOG_ERROR("Failed to open /wifi_config.html from SPIFFS");
     server.send(404, "text/plain", "WiFi Config Page Not Found");
     return;
   }
   server.streamFile(file, "text/html");
   file.close();
-  Serial.println("Served /wifi_config.html");
+  LOG_DEBUG("Served /wifi_config.html");
 }
 
 
 // --- Command Handler Implementations (Placeholders) ---
 
 void handleZeroCommand() {
-  Serial.println("Command: Zero Sensor");
+  LOG_INFO("Command: Zero Sensor");
   // Implement zeroing logic here
   // For now, let's simulate a measurement after zeroing
   currentPowderWeight = 0.0; // Set to zero after zeroing
@@ -1571,12 +2392,12 @@ void handleZeroCommand() {
 }
 
 void handleMeasureCommand() {
-  Serial.println("handleMeasureCommand() called."); // Debug print
+  LOG_DEBUG("handleMeasureCommand() called.");
 
   // Prevent measurements during calibration to avoid messing with statistics
   if (currentCalibrationState != CALIBRATE_NONE) {
-    Serial.println("Measurement blocked: Calibration in progress.");
-    sendCurrentStateToClients(); // Still send state update to UI
+    LOG_WARN("Measurement blocked: Calibration in progress.");
+    stateBroadcastPending = true; // Still send state update to UI
     return;
   }
 
@@ -1584,70 +2405,62 @@ void handleMeasureCommand() {
   // Use the currentPowderWeight for recording, as it's already averaged
   float newWeight = currentPowderWeight;
 
-  // Add to history
-  int historyIndex;
-  if (sessionMeasurementCount < MAX_MEASUREMENTS_HISTORY) {
-    historyIndex = sessionMeasurementCount;
-    sessionMeasurementCount++;
-  } else {
-    // Shift history if full
-    for (int i = 0; i < MAX_MEASUREMENTS_HISTORY - 1; i++) {
-      measurementHistory[i] = measurementHistory[i+1];
-    }
-    historyIndex = MAX_MEASUREMENTS_HISTORY - 1;
-  }
-
-  measurementHistory[historyIndex].timestamp = time(nullptr);
-  measurementHistory[historyIndex].weight = newWeight;
+  // Add to history (O(1), the ring buffer overwrites the oldest entry when full)
+  sessionMeasurementCount++;
+  Measurement& entry = measurementHistory.push(Measurement());
+  entry.timestamp = timeSync.now(); // Seconds since boot until the first sync, see onFirstTimeSync()
+  entry.weight = newWeight;
 
-  // Record the configuration used for this measurement
+  // Record a reference to the configuration version used for this measurement
   if (currentConfigIndex != -1) {
-    measurementHistory[historyIndex].config = powderConfigs[currentConfigIndex];
-    measurementHistory[historyIndex].configWasSet = true;
-    Serial.printf("Measurement recorded: %.3f grains with config '%s'. Session count: %d\n", newWeight, powderConfigs[currentConfigIndex].name, sessionMeasurementCount);
+    entry.configId = powderConfigs[currentConfigIndex].id;
+    entry.configVersion = powderConfigs[currentConfigIndex].version;
+    LOG_INFO("Measurement recorded: %.3f grains with config '%s' v%u. Session count: %d", newWeight, powderConfigs[currentConfigIndex].name, entry.configVersion, sessionMeasurementCount);
   } else {
-    measurementHistory[historyIndex].configWasSet = false;
-    memset(&measurementHistory[historyIndex].config, 0, sizeof(PowderConfig)); // Clear out old data
-    Serial.printf("Measurement recorded: %.3f grains without config. Session count: %d\n", newWeight, sessionMeasurementCount);
+    entry.configId = CONFIG_ID_NONE;
+    entry.configVersion = 0;
+    LOG_INFO("Measurement recorded: %.3f grains without config. Session count: %d", newWeight, sessionMeasurementCount);
   }
 
-  // Update min/max/sum only if this is the first measurement or if it's truly min/max
-  if (sessionMeasurementCount == 1) { // First measurement in session
-    minWeight = newWeight;
-    maxWeight = newWeight;
-    sumWeight = newWeight;
-  } else {
-    if (newWeight < minWeight) minWeight = newWeight;
-    if (newWeight > maxWeight) maxWeight = newWeight;
-    sumWeight += newWeight;
+  // Persist the shot in the background; the first shot of a session marks where its range starts
+  uint32_t sequence = nextShotSequence++;
+  ShotRecord shot = {sequence, (uint32_t)entry.timestamp, entry.weight, entry.configId, entry.configVersion};
+  queueShot(shot);
+  if (TimeSync::provisional(shot.timestamp)) {
+    provisionalEndSequence = sequence + 1;
+  }
+  if (sessionMeasurementCount == 1) {
+    sessionStartMeasurementIndex = sequence;
   }
 
-  measurementCount++; // Total count (across all sessions since boot)
+  // Update session, config and day rollups
+  const PowderConfig* activeConfig = (currentConfigIndex != -1) ? &powderConfigs[currentConfigIndex] : nullptr;
+  rollupStore.record(sequence, entry.timestamp, newWeight, activeConfig);
 
-  // Auto-save settings after each measurement to persist session data
-  saveSettings();
+  measurementCount++; // Total count (across all sessions since boot)
 
-  sendCurrentStateToClients();
+  // Runs in the engine task for auto-measure, so loop() sends the new state
+  stateBroadcastPending = true;
 }
 
 void handleCalibrateCommand() {
-  Serial.println("Command: Calibrate (UI update)");
+  LOG_INFO("Command: Calibrate (UI update)");
   // This function is now primarily for sending the current calibration state to the UI
   sendCurrentStateToClients();
 }
 
 void handleSelectConfigCommand(int index) {
-  Serial.printf("Command: Select Config index %d\n", index);
+  LOG_INFO("Command: Select Config index %d", index);
   if (index >= 0 && index < configCount) {
     currentConfigIndex = index;
     // When a config is selected, auto-set the alarm thresholds based on its target grain
     float target = powderConfigs[index].targetGrain;
     alarmSettings.lowThreshold = target - 0.10; // Default to +/- 0.10 grain tolerance (difference 0.20)
     alarmSettings.highThreshold = target + 0.10;
-    Serial.printf("Selected config '%s'. Alarms set to %.2f/%.2f\n", powderConfigs[index].name, alarmSettings.lowThreshold, alarmSettings.highThreshold);
+    LOG_INFO("Selected config '%s'. Alarms set to %.2f/%.2f", powderConfigs[index].name, alarmSettings.lowThreshold, alarmSettings.highThreshold);
   } else {
     currentConfigIndex = -1; // Deselect
-    Serial.println("No configuration selected.");
+    LOG_INFO("No configuration selected.");
   }
   saveSettings(); // Save the new current index and thresholds
   sendCurrentStateToClients();
@@ -1657,7 +2470,7 @@ void handleSaveConfigCommand(JsonObject data) {
   int index = data["index"];
   
   if (index < 0 || index >= MAX_CONFIGS) {
-    Serial.println("Error: Invalid index for saveConfig");
+    LOG_ERROR("Error: Invalid index for saveConfig");
     return;
   }
 
@@ -1667,12 +2480,14 @@ void handleSaveConfigCommand(JsonObject data) {
     powderConfigs[index].potMinAdc = 0.0;
     powderConfigs[index].grainsPerMmFactor = 0.0;
     powderConfigs[index].isCalibrated = false;
+    powderConfigs[index].id = CONFIG_ID_NONE; // Assigned on publish below
+    powderConfigs[index].version = 0;
     configCount++; // It's a new config, increment count
-    Serial.printf("Command: Add new config at index %d\n", index);
+    LOG_INFO("Command: Add new config at index %d", index);
   } else if (index < configCount) {
-    Serial.printf("Command: Update config at index %d\n", index);
+    LOG_INFO("Command: Update config at index %d", index);
   } else {
-    Serial.println("Error: Cannot add new config, max reached or invalid index.");
+    LOG_ERROR("Error: Cannot add new config, max reached or invalid index.");
     return;
   }
 
@@ -1690,15 +2505,17 @@ void handleSaveConfigCommand(JsonObject data) {
            powderConfigs[index].targetGrain);
   strlcpy(powderConfigs[index].name, nameBuffer, sizeof(powderConfigs[index].name));
 
+  // Publish as a new version; measurements taken with the old one keep referencing it
+  configTable.publish(powderConfigs[index]);
 
   saveSettings();
   sendCurrentStateToClients();
 }
 
 void handleDeleteConfigCommand(int index) {
-  Serial.printf("Command: Delete config at index %d\n", index);
+  LOG_INFO("Command: Delete config at index %d", index);
   if (index < 0 || index >= configCount) {
-    Serial.println("Error: Invalid index for deleteConfig");
+    LOG_ERROR("Error: Invalid index for deleteConfig");
     return;
   }
 
@@ -1721,7 +2538,7 @@ void handleDeleteConfigCommand(int index) {
 }
 
 void handleSetAlarmsCommand(bool enabled, float low, float high) {
-  Serial.printf("Command: Set Alarms Enabled: %s, Low: %.1f, High: %.1f\n", enabled ? "true" : "false", low, high);
+  LOG_INFO("Command: Set Alarms Enabled: %s, Low: %.1f, High: %.1f", enabled ? "true" : "false", low, high);
   alarmSettings.enabled = enabled;
   alarmSettings.lowThreshold = low;
   alarmSettings.highThreshold = high;
@@ -1730,7 +2547,7 @@ void handleSetAlarmsCommand(bool enabled, float low, float high) {
 }
 
 void handleAcknowledgeAlarmCommand() {
-  Serial.println("Command: Acknowledge Alarm");
+  LOG_INFO("Command: Acknowledge Alarm");
   alarmActive = false;
   #ifdef HAS_RGB_LED
     leds[0] = CRGB::Green;
@@ -1740,7 +2557,7 @@ void handleAcknowledgeAlarmCommand() {
 }
 
 void handleResetSessionCommand() {
-  Serial.println("Command: Reset Session");
+  LOG_INFO("Command: Reset Session");
 
   // Save current session to log before resetting (if active)
   if (sessionMeasurementCount > 0) {
@@ -1749,23 +2566,16 @@ void handleResetSessionCommand() {
 
   // Reset session variables
   sessionMeasurementCount = 0;
-  minWeight = 0.0; // Reset to 0.0
-  maxWeight = 0.0;    // Reset to 0.0
-  sumWeight = 0.0;
-  currentSessionStartTime = time(nullptr); // Start new session (effectively a reset)
-
-  // Clear history array (optional, as count handles it)
-  for (int i = 0; i < MAX_MEASUREMENTS_HISTORY; i++) {
-    measurementHistory[i].timestamp = 0;
-    measurementHistory[i].weight = 0.0;
-    measurementHistory[i].configWasSet = false;
-    memset(&measurementHistory[i].config, 0, sizeof(PowderConfig));
-  }
+  rollupStore.resetSession();
+  currentSessionStartTime = timeSync.now(); // Start new session (effectively a reset)
+
+  // Clear history buffer
+  measurementHistory.clear();
   sendCurrentStateToClients();
 }
 
 void handleStartSessionCommand() {
-  Serial.println("Command: Start Session");
+  LOG_INFO("Command: Start Session");
   // A session is implicitly started when the device boots or after a reset.
   // This command primarily ensures the session is fresh and ready to log.
   // We treat this as a soft reset of the current session stats.
@@ -1775,103 +2585,87 @@ void handleStartSessionCommand() {
   
   // Reset session variables
   sessionMeasurementCount = 0;
-  minWeight = 0.0;
-  maxWeight = 0.0;
-  sumWeight = 0.0;
-  currentSessionStartTime = time(nullptr);
-  sessionStartMeasurementIndex = measurementCount; // Mark where this session's measurements start
+  rollupStore.resetSession();
+  currentSessionStartTime = timeSync.now();
   
-  // Clear history array for the new session
-  for (int i = 0; i < MAX_MEASUREMENTS_HISTORY; i++) {
-    measurementHistory[i].timestamp = 0;
-    measurementHistory[i].weight = 0.0;
-    measurementHistory[i].configWasSet = false;
-    memset(&measurementHistory[i].config, 0, sizeof(PowderConfig));
-  }
+  // Clear history buffer for the new session
+  measurementHistory.clear();
   
   saveSettings(); // Save the reset state
   sendCurrentStateToClients();
 }
 
 void handleEndSessionCommand() {
-  Serial.println("Command: End Session");
+  LOG_INFO("Command: End Session");
   
   // Save current session to log
   if (sessionMeasurementCount > 0) {
     SessionLog currentLog;
     currentLog.startTime = currentSessionStartTime;
-    currentLog.endTime = time(nullptr);
+    currentLog.endTime = timeSync.now();
     currentLog.bulletCount = sessionMeasurementCount;
-    currentLog.totalWeight = sumWeight;
+    currentLog.totalWeight = rollupStore.session().sum / 1000.0;
     currentLog.measurementStartIndex = sessionStartMeasurementIndex;
     currentLog.measurementCount = sessionMeasurementCount;
+    currentLog.stats = rollupStore.session();
 
-    Serial.printf("Creating session log: bullets=%d, weight=%.3f, start=%ld, end=%ld\n", 
+    LOG_INFO("Creating session log: bullets=%d, weight=%.3f, start=%ld, end=%ld", 
                   currentLog.bulletCount, currentLog.totalWeight, currentLog.startTime, currentLog.endTime);
 
-    // Log to SPIFFS (for web UI display)
-    if (sessionLogCount < MAX_SESSION_LOGS) {
-      sessionLogs[sessionLogCount] = currentLog;
-      sessionLogCount++;
-      Serial.printf("Added session log. Total logs: %d\n", sessionLogCount);
-    } else {
-      // Shift logs if full
-      for (int i = 0; i < MAX_SESSION_LOGS - 1; i++) {
-        sessionLogs[i] = sessionLogs[i+1];
-      }
-      sessionLogs[MAX_SESSION_LOGS - 1] = currentLog;
-      Serial.printf("Session logs full. Shifted and added new log.\n");
+    // Log to SPIFFS (for web UI display). When full the oldest log is dropped.
+    if (sessionLogs.full()) {
+      LOG_WARN("Session logs full. Dropping oldest log.");
     }
-    saveSettings(); // Save session logs (SPIFFS)
-    Serial.printf("Session saved to SPIFFS. Total session logs: %d\n", sessionLogCount);
+    sessionLogs.push(currentLog);
+    sessionLogsThisBoot++;
+    LOG_INFO("Added session log. Total logs: %d", (int)sessionLogs.size());
+    rollupStore.requestSave(); // Checkpoint config/day rollups at session boundaries
+    saveSessionLogs(); // Both written by the persistence task once the lock is released
+    LOG_INFO("Session ended. Total session logs: %d", (int)sessionLogs.size());
     
     // After logging, reset the current session stats to zero, but keep the history buffer intact
     // The next measurement will start a new implicit session.
     sessionMeasurementCount = 0;
-    minWeight = 0.0;
-    maxWeight = 0.0;
-    sumWeight = 0.0;
+    rollupStore.resetSession();
     
-    // Clear history array after session ends
-    for (int i = 0; i < MAX_MEASUREMENTS_HISTORY; i++) {
-      measurementHistory[i].timestamp = 0;
-      measurementHistory[i].weight = 0.0;
-      measurementHistory[i].configWasSet = false;
-      memset(&measurementHistory[i].config, 0, sizeof(PowderConfig));
-    }
+    // Clear history buffer after session ends
+    measurementHistory.clear();
     
-    currentSessionStartTime = time(nullptr);
-    sessionStartMeasurementIndex = measurementCount; // Next session starts after current measurements
+    currentSessionStartTime = timeSync.now();
   } else {
-    Serial.println("No measurements in current session to log.");
+    LOG_INFO("No measurements in current session to log.");
   }
   
   sendCurrentStateToClients();
 }
 
 void handleExportDataCommand() {
-  Serial.println("HTTP Request: Export Data (CSV)");
+  LOG_DEBUG("HTTP Request: Export Data (CSV)");
   // This will be a simple CSV export of the current session history
   String csv = "Timestamp,Weight(grains),Config Name,Caliber,Bullet Weight,Powder Name,Target Grain\n";
-  for (int i = 0; i < sessionMeasurementCount; i++) {
-    csv += String(measurementHistory[i].timestamp) + "," + String(measurementHistory[i].weight, 3);
-    if (measurementHistory[i].configWasSet) {
-      csv += "," + String(measurementHistory[i].config.name);
-      csv += "," + String(measurementHistory[i].config.caliber);
-      csv += "," + String(measurementHistory[i].config.bulletWeight);
-      csv += "," + String(measurementHistory[i].config.powderName);
-      csv += "," + String(measurementHistory[i].config.targetGrain, 3);
-    } else {
-      csv += ",,,,,,"; // Add empty columns if no config was set
+  {
+    StateLock lock; // Built under the lock, sent without it
+    for (const Measurement& entry : measurementHistory) {
+      csv += String(entry.timestamp) + "," + String(entry.weight, 3);
+      const PowderConfig* entryConfig = configTable.find(entry.configId, entry.configVersion);
+      if (entryConfig) {
+        csv += "," + String(entryConfig->name);
+        csv += "," + String(entryConfig->caliber);
+        csv += "," + String(entryConfig->bulletWeight);
+        csv += "," + String(entryConfig->powderName);
+        csv += "," + String(entryConfig->targetGrain, 3);
+      } else {
+        csv += ",,,,,,"; // Add empty columns if no config was set
+      }
+      csv += "\n";
     }
-    csv += "\n";
   }
   server.send(200, "text/csv", csv);
-  Serial.println("Served CSV data.");
+  LOG_DEBUG("Served CSV data.");
 }
 
 void handleExportSessionCommand() {
-  Serial.println("HTTP Request: Export Session Details (CSV)");
+  LOG_DEBUG("HTTP Request: Export Session Details (CSV)");
   
   if (!server.hasArg("index")) {
     server.send(400, "text/plain", "Missing session index parameter");
@@ -1879,63 +2673,337 @@ void handleExportSessionCommand() {
   }
   
   int sessionIndex = server.arg("index").toInt();
-  
-  if (sessionIndex < 0 || sessionIndex >= sessionLogCount) {
-    server.send(404, "text/plain", "Session not found");
-    return;
+  handleExportSessionDetailsCommand(sessionIndex);
+}
+
+/**
+ * @brief Returns aggregate statistics over the persistent history as JSON.
+ *        Optional "from" and "to" arguments (epoch seconds) limit the time range.
+ *        Whole blocks are answered from their headers, so this stays fast over 100k shots.
+ */
+void handleHistoryStatsCommand() {
+  uint32_t fromTime = server.hasArg("from") ? strtoul(server.arg("from").c_str(), nullptr, 10) : 0;
+  uint32_t toTime = server.hasArg("to") ? strtoul(server.arg("to").c_str(), nullptr, 10) : UINT32_MAX;
+
+  waitForPersistence(nextShotSequence, 1000); // Include shots still queued for flash; the store has its own lock
+  unsigned long queryStart = micros();
+  HistoryAggregate aggregate;
+  measurementStore.aggregate(fromTime, toTime, aggregate);
+  unsigned long queryMicros = micros() - queryStart;
+
+  DynamicJsonDocument doc(512);
+  doc["count"] = aggregate.count;
+  doc["averageWeight"] = (aggregate.count > 0) ? (aggregate.sumWeight / 1000.0) / aggregate.count : 0.0;
+  doc["minWeight"] = aggregate.minWeight / 1000.0;
+  doc["maxWeight"] = aggregate.maxWeight / 1000.0;
+  doc["blocksFromHeader"] = aggregate.blocksFromHeader;
+  doc["blocksDecoded"] = aggregate.blocksDecoded;
+  doc["blocksSkipped"] = aggregate.blocksSkipped;
+  doc["queryMicros"] = queryMicros;
+  doc["storedShots"] = measurementStore.size();
+  doc["storedBlocks"] = measurementStore.blockCount();
+  doc["storedBytes"] = measurementStore.bytesUsed();
+
+  String jsonResponse;
+  serializeJson(doc, jsonResponse);
+  server.send(200, "application/json", jsonResponse);
+}
+
+/**
+ * @brief Adds count/mean/SD/ES/in-band/histogram of a rollup to a JSON object.
+ */
+void rollupToJson(const Rollup& rollup, JsonObject out) {
+  out["count"] = rollup.count;
+  out["averageWeight"] = rollup.mean();
+  out["standardDeviation"] = rollup.standardDeviation();
+  out["minWeight"] = rollup.min / 1000.0;
+  out["maxWeight"] = rollup.max / 1000.0;
+  out["extremeSpread"] = rollup.extremeSpread();
+  out["inBandPercent"] = rollup.inBandPercent();
+  JsonArray histogram = out.createNestedArray("histogram");
+  for (int i = 0; i < ROLLUP_HISTOGRAM_BUCKETS; i++) {
+    histogram.add(rollup.histogram[i]);
   }
+}
 
-  SessionLog& log = sessionLogs[sessionIndex];
-  
-  // Create a detailed CSV export for this session with all measurements
-  String csv = "Timestamp,Weight(grains),Config Name,Caliber,Bullet Weight,Powder Name,Target Grain\n";
-  
-  // Export all measurements from this session
-  // Note: We're exporting from the stored session indices
-  for (int i = 0; i < log.measurementCount; i++) {
-    // Calculate the actual index in the global measurement history
-    // Since measurements wrap around, we need to be careful here
-    // For now, we'll iterate through recent measurements that match the session timeframe
-    for (int j = 0; j < sessionMeasurementCount; j++) {
-      if (measurementHistory[j].timestamp >= log.startTime && 
-          measurementHistory[j].timestamp <= log.endTime) {
-        csv += String(measurementHistory[j].timestamp) + "," + String(measurementHistory[j].weight, 3);
-        if (measurementHistory[j].configWasSet) {
-          csv += "," + String(measurementHistory[j].config.name);
-          csv += "," + String(measurementHistory[j].config.caliber);
-          csv += "," + String(measurementHistory[j].config.bulletWeight);
-          csv += "," + String(measurementHistory[j].config.powderName);
-          csv += "," + String(measurementHistory[j].config.targetGrain, 3);
-        } else {
-          csv += ",,,,,";
+/**
+ * @brief Returns the per-config and per-day rollups as JSON for long-range reports.
+ *        Nothing is rescanned; the data is maintained as shots are recorded.
+ *        Entries are serialized one at a time and streamed to keep heap use small.
+ */
+void handleRollupsCommand() {
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "application/json", "");
+  server.sendContent("{\"bucketWidth\":" + String(ROLLUP_BUCKET_WIDTH_MG / 1000.0, 3) +
+                     ",\"inBandTolerance\":" + String(ROLLUP_IN_BAND_TOLERANCE_MG / 1000.0, 3) +
+                     ",\"configs\":[");
+
+  // Each entry is serialized under the state lock and sent without it
+  DynamicJsonDocument entryDoc(1024);
+  String entryJson;
+  for (size_t i = 0; ; i++) {
+    {
+      StateLock lock;
+      if (i >= rollupStore.configCount()) {
+        break;
+      }
+      const ConfigRollup& entry = rollupStore.configAt(i);
+      entryDoc.clear();
+      JsonObject config_out = entryDoc.to<JsonObject>();
+      config_out["id"] = entry.configId;
+      // Name of the live config if it still exists
+      for (int c = 0; c < configCount; c++) {
+        if (powderConfigs[c].id == entry.configId) {
+          config_out["name"] = powderConfigs[c].name;
+          break;
         }
-        csv += "\n";
       }
+      rollupToJson(entry.stats, config_out);
+      entryJson = (i > 0) ? "," : "";
+      serializeJson(entryDoc, entryJson);
     }
+    server.sendContent(entryJson);
   }
-  
-  server.send(200, "text/csv", csv);
-  Serial.println("Served session export CSV data.");
+
+  server.sendContent("],\"days\":[");
+  for (size_t i = 0; ; i++) {
+    {
+      StateLock lock;
+      if (i >= rollupStore.dayCount()) {
+        break;
+      }
+      const DayRollup& entry = rollupStore.dayAt(i);
+      entryDoc.clear();
+      JsonObject day_out = entryDoc.to<JsonObject>();
+      day_out["date"] = (uint32_t)entry.day * 86400UL; // Epoch seconds at 00:00 UTC
+      rollupToJson(entry.stats, day_out);
+      entryJson = (i > 0) ? "," : "";
+      serializeJson(entryDoc, entryJson);
+    }
+    server.sendContent(entryJson);
+  }
+  server.sendContent("]}");
+  server.sendContent(""); // Terminate chunked response
+}
+
+/**
+ * @brief Returns the boot timeline as JSON: per stage its status, start and end (ms since power-on) and result.
+ */
+void handleBootTimelineCommand() {
+  DynamicJsonDocument doc(1536);
+  doc["complete"] = bootSequence.complete();
+  doc["totalMs"] = bootSequence.totalMs();
+  JsonArray stages = doc.createNestedArray("stages");
+  for (int i = 0; i < BOOT_STAGE_COUNT; i++) {
+    BootStageRecord record = bootSequence.record((BootStage)i);
+    JsonObject stage = stages.createNestedObject();
+    stage["name"] = BootSequence::stageName((BootStage)i);
+    stage["status"] = BootSequence::statusName(record.status);
+    if (record.status != BOOT_STAGE_PENDING) {
+      stage["startMs"] = record.startMs;
+    }
+    if (record.status >= BOOT_STAGE_DONE) {
+      stage["endMs"] = record.endMs;
+      stage["note"] = record.note;
+    }
+  }
+  String json;
+  serializeJson(doc, json);
+  server.send(200, "application/json", json);
+}
+
+/**
+ * @brief Returns per task its priority, stack use and execution times (last, average,
+ *        worst case, overruns of its budget), how full the queues between them got,
+ *        and per job its jitter and deadline misses.
+ */
+void handleTasksCommand() {
+  DynamicJsonDocument doc(3584);
+  JsonArray tasks = doc.createNestedArray("tasks");
+  for (int i = 0; i < TASK_COUNT; i++) {
+    TaskStats stats = taskMonitor.stats((MonitoredTask)i);
+    if (stats.name == nullptr) {
+      continue; // Not started
+    }
+    JsonObject task = tasks.createNestedObject();
+    task["name"] = stats.name;
+    task["priority"] = stats.priority;
+    task["stackBytes"] = stats.stackBytes;
+    task["stackFreeBytes"] = stats.stackFreeBytes;
+    task["cycles"] = stats.cycles;
+    task["lastUs"] = stats.lastUs;
+    task["avgUs"] = stats.cycles > 0 ? (uint32_t)(stats.totalUs / stats.cycles) : 0;
+    task["wcetUs"] = stats.maxUs;
+    task["budgetUs"] = stats.budgetUs;
+    task["overruns"] = stats.overruns;
+  }
+  JsonObject queues = doc.createNestedObject("queues");
+  queues["samplePeriodMs"] = ACQUISITION_PERIOD_MS;
+  queues["sampleLength"] = SAMPLE_QUEUE_LENGTH;
+  queues["sampleWaiting"] = sampleQueue != nullptr ? uxQueueMessagesWaiting(sampleQueue) : 0;
+  queues["sampleOverruns"] = sampleOverruns;
+  queues["persistLength"] = PERSIST_QUEUE_LENGTH;
+  queues["persistWaiting"] = persistQueue != nullptr ? uxQueueMessagesWaiting(persistQueue) : 0;
+  queues["persistPeak"] = persistQueuePeak;
+  queues["persistOverflows"] = persistOverflows;
+  queues["persistOverflowLength"] = PERSIST_OVERFLOW_LENGTH;
+  queues["persistDropped"] = persistDropped;
+  LogStats log = logger.stats();
+  queues["logBufferBytes"] = log.bufferBytes;
+  queues["logUsedBytes"] = log.usedBytes;
+  queues["logPeakBytes"] = log.peakBytes;
+  queues["logLines"] = log.lines;
+  queues["logDropped"] = log.dropped;
+  if (touchInput.started()) {
+    TouchInputStats touch = touchInput.stats();
+    queues["touchInterrupts"] = touch.interrupts;
+    queues["touchReads"] = touch.reads;
+    queues["touchEvents"] = touch.events;
+    queues["touchBounces"] = touch.bounces;
+    queues["touchDropped"] = touch.dropped;
+  }
+  JsonArray jobs = doc.createNestedArray("jobs");
+  for (size_t i = 0; i < JobClock::count(); i++) {
+    JobStats stats = JobClock::at(i)->stats();
+    JsonObject job = jobs.createNestedObject();
+    job["name"] = stats.name;
+    job["periodUs"] = stats.periodUs;
+    job["runs"] = stats.runs;
+    job["misses"] = stats.misses;
+    job["avgJitterUs"] = stats.runs > 0 ? (uint32_t)(stats.totalJitterUs / stats.runs) : 0;
+    job["maxJitterUs"] = stats.maxJitterUs;
+    job["lastRunUs"] = stats.lastRunUs;
+    job["maxRunUs"] = stats.maxRunUs;
+  }
+  String json;
+  serializeJson(doc, json);
+  server.send(200, "application/json", json);
 }
 
+/**
+ * @brief Stage profiler control and results for one WebSocket client.
+ * @param action "on", "off", "reset" or "get"; every action replies with the current profile.
+ */
+void handleProfileCommand(uint8_t client, const String& action) {
+  if (action == "on") {
+    stageProfiler.setEnabled(true);
+  } else if (action == "off") {
+    stageProfiler.setEnabled(false);
+  } else if (action == "reset") {
+    stageProfiler.reset();
+  }
+
+  DynamicJsonDocument doc(768 + PROFILE_STAGE_COUNT * (192 + PROFILE_BUCKETS * 12));
+  JsonObject profile = doc.createNestedObject("profile");
+  profile["enabled"] = stageProfiler.enabled();
+  profile["windowMs"] = stageProfiler.windowMs();
+  profile["cpuMhz"] = stageProfiler.cpuMhz();
+  profile["overheadCycles"] = stageProfiler.overheadCycles();
+  profile["overheadPercent"] = stageProfiler.overheadPercent();
+  JsonArray stages = profile.createNestedArray("stages");
+  for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+    StageProfile stats = stageProfiler.stage((ProfileStage)i);
+    JsonObject stage = stages.createNestedObject();
+    stage["name"] = StageProfiler::stageName((ProfileStage)i);
+    stage["count"] = stats.count;
+    stage["avgUs"] = stats.count > 0 ? stageProfiler.cyclesToUs(stats.totalCycles / stats.count) : 0;
+    stage["p50Us"] = stageProfiler.percentileUs(stats, 50);
+    stage["p99Us"] = stageProfiler.percentileUs(stats, 99);
+    stage["maxUs"] = stageProfiler.cyclesToUs(stats.maxCycles);
+    // Bucket n counts runs of 2^n to 2^(n+1)-1 cycles; trailing empty buckets are left out
+    int last = PROFILE_BUCKETS - 1;
+    while (last >= 0 && stats.buckets[last] == 0) {
+      last--;
+    }
+    JsonArray histogram = stage.createNestedArray("histogram");
+    for (int bucket = 0; bucket <= last; bucket++) {
+      histogram.add(stats.buckets[bucket]);
+    }
+  }
+
+  String json;
+  serializeJson(doc, json);
+  webSocket.sendTXT(client, json);
+}
+
+/**
+ * @brief Reads commands typed on the serial console, one per line:
+ *        "profile [on|off|reset]", "tasks", "jobs" and "log [level <name>|file on|file off]".
+ *        Called from loop(), never blocks.
+ */
+void handleSerialConsole() {
+  static char line[32];
+  static size_t length = 0;
+  while (Serial.available() > 0) {
+    char c = (char)Serial.read();
+    if (c != '\n' && c != '\r') {
+      if (length < sizeof(line) - 1) {
+        line[length++] = c;
+      }
+      continue;
+    }
+    if (length == 0) {
+      continue;
+    }
+    line[length] = '\0';
+    length = 0;
+
+    if (strcmp(line, "profile on") == 0) {
+      stageProfiler.setEnabled(true);
+    } else if (strcmp(line, "profile off") == 0) {
+      stageProfiler.setEnabled(false);
+    } else if (strcmp(line, "profile reset") == 0) {
+      stageProfiler.reset();
+      Serial.println("Stage profiler reset");
+    } else if (strcmp(line, "profile") == 0) {
+      stageProfiler.log();
+    } else if (strcmp(line, "tasks") == 0) {
+      taskMonitor.logSummary();
+    } else if (strcmp(line, "jobs") == 0) {
+      JobClock::logAll();
+    } else if (strcmp(line, "log") == 0) {
+      LogStats log = logger.stats();
+      Serial.printf("Log level %s (compiled up to %s), file %s: %lu lines, %lu dropped, %lu cut, buffer %lu/%lu bytes (peak %lu)\n",
+                    Logger::levelName(logger.level()), Logger::levelName(LOG_LEVEL), logger.fileOutput() ? "on" : "off",
+                    (unsigned long)log.lines, (unsigned long)log.dropped, (unsigned long)log.cut, (unsigned long)log.usedBytes,
+                    (unsigned long)log.bufferBytes, (unsigned long)log.peakBytes);
+    } else if (strncmp(line, "log level ", 10) == 0) {
+      uint8_t level;
+      if (Logger::parseLevel(line + 10, level)) {
+        logger.setLevel(level);
+        Serial.printf("Log level %s\n", Logger::levelName(logger.level()));
+      } else {
+        Serial.println("Log levels: none, error, warn, info, debug, trace");
+      }
+    } else if (strcmp(line, "log file on") == 0) {
+      logger.setFileOutput(true);
+    } else if (strcmp(line, "log file off") == 0) {
+      logger.setFileOutput(false);
+    } else {
+      Serial.printf("Unknown command '%s' (profile [on|off|reset], tasks, jobs, log)\n", line);
+    }
+  }
+}
 
 void handleAutoMeasure() {
-  Serial.println("handleAutoMeasure() called."); // Debug print
+  LOG_DEBUG("handleAutoMeasure() called.");
   handleMeasureCommand(); // Call the existing measure command handler
 }
 
 void handleFactoryResetCommand() {
-  Serial.println("Command: Factory Reset initiated!");
+  LOG_INFO("Command: Factory Reset initiated!");
   // Clear all saved data
+  configTable.clear();
   SPIFFS.format(); // This will erase all files on SPIFFS
-  Serial.println("SPIFFS formatted. Restarting device.");
+  LOG_INFO("SPIFFS formatted. Restarting device.");
+  logger.flush();
   ESP.restart(); // Restart the device to apply changes
 }
 
 void handleUpdateFirmwareCommand(String type, String filename, size_t size) {
-  Serial.printf("Command: Update %s with file %s, size %d\n", type.c_str(), filename.c_str(), size);
+  LOG_INFO("Command: Update %s with file %s, size %d", type.c_str(), filename.c_str(), (int)size);
   if (isUpdating) {
-    Serial.println("Update already in progress.");
+    LOG_WARN("Update already in progress.");
     return;
   }
   updateType = type;
@@ -1949,19 +3017,19 @@ void handleUpdateFirmwareCommand(String type, String filename, size_t size) {
   } else if (type == "filesystem") {
     updateStarted = Update.begin(size, U_SPIFFS);
   } else {
-    Serial.println("Unknown update type.");
+    LOG_WARN("Unknown update type.");
     isUpdating = false;
     return;
   }
 
   if (!updateStarted) {
-    Serial.println("Update.begin() failed.");
+    LOG_ERROR("Update.begin() failed.");
     Update.printError(Serial);
     isUpdating = false;
     return;
   }
 
-  Serial.printf("Update started for %s. Waiting for binary data...\n", type.c_str());
+  LOG_INFO("Update started for %s. Waiting for binary data...", type.c_str());
   // Send status to client
   DynamicJsonDocument statusDoc(128);
   statusDoc["updateStatus"] = "started";
@@ -1971,7 +3039,7 @@ void handleUpdateFirmwareCommand(String type, String filename, size_t size) {
 }
 
 void handleImportConfigsCommand(JsonArray configs) {
-  Serial.printf("Command: Import %d configurations\n", configs.size());
+  LOG_INFO("Command: Import %d configurations", (int)configs.size());
   configCount = 0; // Replace existing configs with imported ones
   for (JsonObject config_in : configs) {
     if (configCount >= MAX_CONFIGS) break;
@@ -1984,46 +3052,91 @@ void handleImportConfigsCommand(JsonArray configs) {
     powderConfigs[configCount].potMinAdc = config_in["potMinAdc"] | 0.0;
     powderConfigs[configCount].grainsPerMmFactor = config_in["grainsPerMmFactor"] | 0.0;
     powderConfigs[configCount].isCalibrated = config_in["isCalibrated"] | false;
+    // Imported configs are new identities, never aliases of existing versions
+    powderConfigs[configCount].id = CONFIG_ID_NONE;
+    powderConfigs[configCount].version = 0;
+    configTable.publish(powderConfigs[configCount]);
 
     configCount++;
   }
   saveSettings();
-  Serial.printf("Imported %d configurations successfully.\n", configCount);
+  LOG_INFO("Imported %d configurations successfully.", configCount);
   sendCurrentStateToClients();
 }
 
+/**
+ * @brief Streams every shot of a logged session as CSV to the current HTTP client.
+ *        Records are read from measurementStore by seeking to the session's
+ *        first sequence number, in small batches, so RAM use is independent of
+ *        the session length.
+ * @param sessionIndex Index into sessionLogs (0 = oldest).
+ */
 void handleExportSessionDetailsCommand(int sessionIndex) {
-  Serial.printf("Command: Export session details for index %d\n", sessionIndex);
-  
-  if (sessionIndex < 0 || sessionIndex >= sessionLogCount) {
-    Serial.println("Error: Invalid session index");
+  LOG_INFO("Command: Export session details for index %d", sessionIndex);
+
+  // Copy the session's range; the state lock is only taken again per chunk
+  SessionLog log;
+  bool found = false;
+  {
+    StateLock lock;
+    if (sessionIndex >= 0 && sessionIndex < (int)sessionLogs.size()) {
+      log = sessionLogs[sessionIndex];
+      found = true;
+    }
+  }
+  if (!found) {
+    LOG_ERROR("Error: Invalid session index");
+    server.send(404, "text/plain", "Session not found");
     return;
   }
+  uint32_t first = log.measurementStartIndex;
+  uint32_t last = first + log.measurementCount; // Exclusive
+
+  // Unknown length: send chunked so the CSV never has to be built in RAM
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.sendHeader("Content-Disposition", "attachment; filename=\"powdersense_session_" + String(log.startTime) + ".csv\"");
+  server.send(200, "text/csv", "");
+  server.sendContent("Sequence,Timestamp,Weight(grains),Config Name,Caliber,Bullet Weight,Powder Name,Target Grain\n");
+
+  waitForPersistence(last, 1000); // The last shots may still be queued for flash
+  if (first < measurementStore.oldestSequence()) {
+    LOG_WARN("Session %d partially overwritten in measurement store, exporting remaining shots.", sessionIndex);
+  }
+
+  const size_t EXPORT_BATCH_SIZE = 32;
+  StoredMeasurement batch[EXPORT_BATCH_SIZE];
+  uint32_t next = first;
+  size_t exported = 0;
+  while (next < last) {
+    size_t wanted = min((size_t)(last - next), EXPORT_BATCH_SIZE);
+    size_t got = measurementStore.read(next, batch, wanted);
+    if (got == 0) break;
+
+    String chunk;
+    {
+      StateLock lock; // For the config table, not held while the chunk is sent
+      for (size_t i = 0; i < got && batch[i].sequence < last; i++) {
+        chunk += String(batch[i].sequence) + "," + String(batch[i].timestamp) + "," + String(batch[i].weight, 3);
+        const PowderConfig* config = configTable.find(batch[i].configId, batch[i].configVersion);
+        if (config) {
+          chunk += "," + String(config->name);
+          chunk += "," + String(config->caliber);
+          chunk += "," + String(config->bulletWeight);
+          chunk += "," + String(config->powderName);
+          chunk += "," + String(config->targetGrain, 3);
+        } else {
+          chunk += ",,,,,";
+        }
+        chunk += "\n";
+        exported++;
+      }
+    }
+    server.sendContent(chunk);
+    next = batch[got - 1].sequence + 1;
+  }
+  server.sendContent(""); // Terminate chunked response
 
-  SessionLog& log = sessionLogs[sessionIndex];
-  
-  // Create a detailed CSV export for this session
-  String csv = "PowderSense Session Export\n";
-  csv += "Session Date: " + String(ctime(&log.startTime));
-  csv += "Total Bullets: " + String(log.bulletCount) + "\n";
-  csv += "Total Weight: " + String(log.totalWeight, 3) + " grains\n";
-  csv += "Average Weight: " + String(log.totalWeight / log.bulletCount, 3) + " grains\n\n";
-  
-  csv += "Note: Per-bullet measurements are stored in the Recent Measurements table during the session.\n";
-  csv += "To export detailed per-bullet data, use the 'Export Data' button during or immediately after a session.\n\n";
-  
-  csv += "Session Summary\n";
-  csv += "Metric,Value\n";
-  csv += "Total Bullets," + String(log.bulletCount) + "\n";
-  csv += "Total Weight (gr)," + String(log.totalWeight, 3) + "\n";
-  csv += "Average Weight (gr)," + String(log.totalWeight / log.bulletCount, 3) + "\n";
-  csv += "Start Time," + String(log.startTime) + "\n";
-  csv += "End Time," + String(log.endTime) + "\n";
-  csv += "Duration (seconds)," + String(log.endTime - log.startTime) + "\n";
-  
-  // Send as HTTP response (this would be called via HTTP endpoint)
-  // For now, just log it
-  Serial.println("Session export CSV generated (length: " + String(csv.length()) + " bytes)");
+  LOG_INFO("Streamed %d measurements for session %d.", (int)exported, sessionIndex);
 }
 
 // --- Calibration Wizard Functions ---
@@ -2032,13 +3145,13 @@ void handleExportSessionDetailsCommand(int sessionIndex) {
 
 void startCalibrationWizard() {
   if (currentConfigIndex == -1) {
-    Serial.println("Error: Cannot start calibration. No configuration selected.");
+    LOG_ERROR("Error: Cannot start calibration. No configuration selected.");
     // The UI should prevent this, but as a safeguard:
     return;
   }
   currentCalibrationState = CALIBRATE_ZERO_STEP;
   tempKnownGrainsDepth = 0.0; // Reset this to 0.0 when starting calibration
-  Serial.printf("Calibration Wizard started for config: '%s'\n", powderConfigs[currentConfigIndex].name);
+  LOG_INFO("Calibration Wizard started for config: '%s'", powderConfigs[currentConfigIndex].name);
   alarmActive = false; // Ensure alarm is not active during calibration
   sendCurrentStateToClients();
 }
@@ -2053,9 +3166,10 @@ void setCalibrationZeroPoint() {
   }
   float averagedAdc = sumAdc / count;
   powderConfigs[currentConfigIndex].potMinAdc = averagedAdc;
+  configTable.publish(powderConfigs[currentConfigIndex]); // New calibration = new version
 
   currentCalibrationState = CALIBRATE_KNOWN_GRAINS_STEP; // Move to next step
-  Serial.printf("Zero point set to ADC: %.0f for config '%s'.\n", averagedAdc, powderConfigs[currentConfigIndex].name);
+  LOG_INFO("Zero point set to ADC: %.0f for config '%s'.", averagedAdc, powderConfigs[currentConfigIndex].name);
   alarmActive = false; // Ensure alarm is not active during calibration
   sendCurrentStateToClients();
 }
@@ -2075,7 +3189,8 @@ void setCalibrationKnownGrains(float knownWeight) {
     if (adcDifference > 0.01 && knownWeight > 0.0) { // Avoid division by zero or near-zero values
       config.grainsPerMmFactor = knownWeight / adcDifference;
       config.isCalibrated = true; // Mark this configuration as calibrated
-      Serial.printf("Calculated Grains/ADC_Diff Factor for '%s': %.4f (Known Weight: %.2f gr, ADC Diff: %.2f)\n", config.name, config.grainsPerMmFactor, knownWeight, adcDifference);
+      configTable.publish(config); // New calibration = new version
+      LOG_INFO("Calculated Grains/ADC_Diff Factor for '%s': %.4f (Known Weight: %.2f gr, ADC Diff: %.2f)", config.name, config.grainsPerMmFactor, knownWeight, adcDifference);
     
       saveSettings(); // Save all settings, including the new calibration data
 
@@ -2086,33 +3201,26 @@ void setCalibrationKnownGrains(float knownWeight) {
 
       // Reset session statistics to prevent calibration sample from being counted
       sessionMeasurementCount = 0;
-      minWeight = 0.0;
-      maxWeight = 0.0;
-      sumWeight = 0.0;
+      rollupStore.resetSession();
       // Clear measurement history
-      for (int i = 0; i < MAX_MEASUREMENTS_HISTORY; i++) {
-        measurementHistory[i].timestamp = 0;
-        measurementHistory[i].weight = 0.0;
-        measurementHistory[i].configWasSet = false;
-        memset(&measurementHistory[i].config, 0, sizeof(PowderConfig));
-      }
-      currentSessionStartTime = time(nullptr);
-      Serial.println("Calibration complete. Session statistics reset to prevent calibration sample from being counted.");
+      measurementHistory.clear();
+      currentSessionStartTime = timeSync.now();
+      LOG_INFO("Calibration complete. Session statistics reset to prevent calibration sample from being counted.");
 
       currentCalibrationState = CALIBRATE_NONE;
       alarmActive = false; // Calibration finished, reset alarm
     } else {
-      Serial.println("Error: Cannot calibrate Grains/ADC_Diff factor. ADC difference or known weight is zero/too small.");
+      LOG_ERROR("Error: Cannot calibrate Grains/ADC_Diff factor. ADC difference or known weight is zero/too small.");
     }
   } else {
-    Serial.println("Error: Not in Known Grains calibration state.");
+    LOG_ERROR("Error: Not in Known Grains calibration state.");
   }
   sendCurrentStateToClients();
 }
 
 void cancelCalibration() {
   currentCalibrationState = CALIBRATE_NONE;
-  Serial.println("Calibration cancelled.");
+  LOG_INFO("Calibration cancelled.");
   alarmActive = false; // Calibration cancelled, reset alarm
   sendCurrentStateToClients();
 }
@@ -2126,249 +3234,517 @@ void cancelCalibration() {
 
 
 /**
- * @brief Draws the main measurement screen on the display.
- * @param weight Current powder weight.
- * @param alarmActive True if alarm is active.
- * @param lowThreshold Low alarm threshold.
- * @param highThreshold High alarm threshold.
+ * @brief Updates the main measurement screen in the sprite.
+ * @param snapshot State published by the engine for this frame.
+ * @return Areas of the sprite that changed and need to be pushed.
  */
-void drawMeasurementScreen(float weight, bool alarmActive, float lowThreshold, float highThreshold) {
-  // Rotation is set in setupDisplay()
+const DirtyRegion& drawMeasurementScreen(const DisplaySnapshot& snapshot) {
+  char ipStr[16];
+  IPAddress ip(snapshot.ip);
+  snprintf(ipStr, sizeof(ipStr), "%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+
+  MeasurementScreenInputs inputs;
+  inputs.weight = snapshot.weight;
+  inputs.configName = snapshot.hasConfig ? snapshot.configName : nullptr;
+  inputs.targetGrain = snapshot.targetGrain;
+  inputs.alarmActive = snapshot.alarmActive;
+  inputs.alarmEnabled = snapshot.alarmEnabled;
+  inputs.lowThreshold = snapshot.lowThreshold;
+  inputs.highThreshold = snapshot.highThreshold;
+  inputs.ip = ipStr;
+  inputs.offline = snapshot.offline;
+  inputs.queuedShots = snapshot.queuedShots;
+
+  return measurementScreen.render(inputs);
+}
 
-  // --- Weight Display (Large) ---
-  display.setTextSize(3);
-  display.setTextColor(TFT_WHITE); // Set text color
-  char weightStr[15];
-  snprintf(weightStr, sizeof(weightStr), "%.3f grain", weight); // 3 decimal places for precision
-  
-  // Clear area for weight string (clear the whole line to avoid artifacts)
-  display.fillRect(0, 5, display.width(), display.fontHeight() * 3, TFT_BLACK); // Clear enough for 3 lines of text size 3
-  uint16_t w = display.textWidth(weightStr);
-  display.setCursor((display.width() - w) / 2, 5); // Center horizontally
-  display.print(weightStr);
-
-  // --- Caliber and Powder Info ---
-  display.setTextSize(2);
-  display.setTextColor(TFT_CYAN);
-
-  // Clear and draw config name
-  display.fillRect(0, 45, display.width(), display.fontHeight() * 2, TFT_BLACK); // Clear enough for 2 lines of text size 2
-  display.setCursor(5, 45);
-  if (currentConfigIndex != -1) {
-    display.print(powderConfigs[currentConfigIndex].name);
+/**
+ * @brief Adds this frame's column to the scrolling trace on the panel.
+ * @param snapshot State published by the engine for this frame.
+ */
+void drawTraceScreen(const DisplaySnapshot& snapshot) {
+  TraceViewInputs inputs;
+  inputs.weight = snapshot.weight;
+  inputs.minWeight = snapshot.traceMin;
+  inputs.maxWeight = snapshot.traceMax;
+  inputs.samples = snapshot.traceSamples;
+  inputs.shotCount = snapshot.shotCount;
+  inputs.targetGrain = snapshot.targetGrain;
+  inputs.alarmActive = snapshot.alarmActive;
+  inputs.alarmEnabled = snapshot.alarmEnabled;
+  inputs.lowThreshold = snapshot.lowThreshold;
+  inputs.highThreshold = snapshot.highThreshold;
+
+  traceView.render(inputs);
+}
+
+/**
+ * @brief Publishes the state the display task needs for its next frame.
+ *        Called by the engine after every sample.
+ * @param currentAdc The ADC reading the current weight was calculated from.
+ */
+void publishDisplaySnapshot(float currentAdc) {
+  // Determine the desired screen state
+  if (wifiLink.inApMode()) {
+    currentScreenState = SCREEN_AP_MODE;
+  } else if (currentCalibrationState != CALIBRATE_NONE) {
+    currentScreenState = SCREEN_CALIBRATION;
+  } else if (displayView == DISPLAY_VIEW_TRACE) {
+    currentScreenState = SCREEN_TRACE;
   } else {
-    display.print("No Config");
+    currentScreenState = SCREEN_MEASUREMENT;
+  }
+
+  DisplaySnapshot snapshot;
+  snapshot.screen = currentScreenState;
+  snapshot.weight = currentPowderWeight;
+  snapshot.adc = currentAdc;
+  snapshot.alarmActive = alarmActive;
+  snapshot.alarmEnabled = alarmSettings.enabled;
+  snapshot.lowThreshold = alarmSettings.lowThreshold;
+  snapshot.highThreshold = alarmSettings.highThreshold;
+  snapshot.hasConfig = (currentConfigIndex != -1);
+  if (snapshot.hasConfig) {
+    strlcpy(snapshot.configName, powderConfigs[currentConfigIndex].name, sizeof(snapshot.configName));
+    snapshot.targetGrain = powderConfigs[currentConfigIndex].targetGrain;
+  } else {
+    snapshot.configName[0] = '\0';
+    snapshot.targetGrain = 0.0;
+  }
+  snapshot.calibrationState = currentCalibrationState;
+  snapshot.ip = (uint32_t)WiFi.localIP();
+  snapshot.offline = !networkOnline;
+  snapshot.queuedShots = networkOnline ? 0 : nextShotSequence - offlineFromSequence;
+  snapshot.shotCount = measurementCount;
+
+  // Anything the operator would want to see right away brings the display back to full rate
+  uint32_t now = millis();
+  if (snapshot.screen != displaySnapshot.screen || snapshot.alarmActive != displaySnapshot.alarmActive) {
+    displayPower.wake(now);
+  }
+  bool wakeDisplay = displayPower.update(now, snapshot.weight, isStable);
+  snapshot.powerMode = displayPower.mode();
+  snapshot.frameIntervalMs = displayPower.frameIntervalMs();
+  snapshot.brightness = displayPower.brightness();
+
+  portENTER_CRITICAL(&displaySnapshotMux);
+  // Widen the envelope the display task has not consumed yet
+  if (displaySnapshot.traceSamples == 0) {
+    snapshot.traceMin = snapshot.weight;
+    snapshot.traceMax = snapshot.weight;
+    snapshot.traceSamples = 1;
+  } else {
+    snapshot.traceMin = min(displaySnapshot.traceMin, snapshot.weight);
+    snapshot.traceMax = max(displaySnapshot.traceMax, snapshot.weight);
+    snapshot.traceSamples = displaySnapshot.traceSamples + 1;
   }
+  displaySnapshot = snapshot;
+  portEXIT_CRITICAL(&displaySnapshotMux);
 
-  // Clear and draw target grain
-  display.fillRect(0, 70, display.width(), display.fontHeight() * 2, TFT_BLACK); // Clear enough for 2 lines of text size 2
-  display.setCursor(5, 70);
-  if (currentConfigIndex != -1) {
-    display.printf("T: %.3f gr", powderConfigs[currentConfigIndex].targetGrain);
-  } else {
-    display.print("T: ---");
+  if (wakeDisplay && displayTaskHandle != nullptr) {
+    xTaskNotifyGive(displayTaskHandle); // Cut the display task's slow-mode wait short
   }
+}
 
-  // --- Alarm Status (Bigger and Center) ---
-  display.setTextSize(3); // Increased font size for ALARM/OK
-  char alarmStatusStr[15]; // Increased size for "Powdersense"
-  if (currentConfigIndex == -1) {
-    display.setTextColor(TFT_WHITE);
-    strcpy(alarmStatusStr, "Powdersense");
-  } else if (weight < lowThreshold) {
-    display.setTextColor(TFT_BLUE);
-    strcpy(alarmStatusStr, "LOW");
-  } else if (weight > highThreshold) {
-    display.setTextColor(TFT_RED);
-    strcpy(alarmStatusStr, "HIGH");
-  } else {
-    display.setTextColor(TFT_GREEN);
-    strcpy(alarmStatusStr, "PERFECT");
+/**
+ * @brief Starts the display task. Called by serviceBoot() once the display and the settings are ready.
+ */
+void startDisplayTask() {
+  if (displayTaskHandle != nullptr) {
+    return;
   }
+  if (xTaskCreate(displayTask, "display", DISPLAY_TASK_STACK_SIZE, nullptr, DISPLAY_TASK_PRIORITY, &displayTaskHandle) != pdPASS) {
+    LOG_ERROR("Failed to start display task!");
+    displayTaskHandle = nullptr;
+    return;
+  }
+  taskMonitor.attach(TASK_DISPLAY, "display", displayTaskHandle, DISPLAY_TASK_STACK_SIZE, DISPLAY_BUDGET_US);
+  LOG_INFO("Display task started (%lu ms frame interval, %lu ms when settled)", DISPLAY_UPDATE_INTERVAL_MS, DISPLAY_SETTLED_INTERVAL_MS);
+}
 
-  // Calculate position for center (moved up one line)
-  w = display.textWidth(alarmStatusStr);
-  uint16_t h = display.fontHeight();
-  int alarmX = (display.width() - w) / 2; // Center horizontally
-  int alarmY = display.height() - h - 25; // Moved up one line (was -5, now -25)
-  
-  // Clear area for alarm status
-  display.fillRect(0, display.height() - h - 30, display.width(), h + 10, TFT_BLACK); // Clear area for alarm status
-  display.setCursor(alarmX, alarmY);
-  display.print(alarmStatusStr);
-
-  // --- IP Address (Small at Bottom) ---
-  display.setTextSize(1); // Small font for IP
-  display.setTextColor(TFT_WHITE);
-  String ipStr = WiFi.localIP().toString();
-  uint16_t ipW = display.textWidth(ipStr);
-  int ipX = (display.width() - ipW) / 2; // Center horizontally
-  int ipY = display.height() - 10; // 10 pixels from bottom
-  
-  // Clear area for IP address
-  display.fillRect(0, display.height() - 15, display.width(), 15, TFT_BLACK);
-  display.setCursor(ipX, ipY);
-  display.print(ipStr);
-
-  // --- Vertical Bar Graph (Scale) ---
-  // This part of the screen layout needs to be re-evaluated if the bar is always on the right.
-  // If the screen is rotated, the "right" side changes.
-  // For now, I'll assume the bar is always on the "physical" right side of the display,
-  // which means its coordinates might need to be fixed relative to the native resolution,
-  // or the drawing logic needs to be more complex to adapt to rotation.
-  // Given the current setup, the bar will move with the rotation.
-  // If the bar is always supposed to be on the right of the *physical* display,
-  // regardless of rotation, then its coordinates need to be fixed to the native resolution
-  // and then transformed by LovyanGFX's internal rotation matrix.
-  // For simplicity, I'll keep it relative to display.width() for now, meaning it moves with rotation.
-
-  int barX = display.width() - 50; // X position of the bar (right side of the *logical* screen)
-  int barY = 5;                // Y position of the top of the bar
-  int barWidth = 40;           // Width of the bar
-  int barHeight = display.height() - 10; // Height of the bar (almost full screen height)
-
-  // Clear the entire bar area before redrawing to prevent artifacts
-  display.fillRect(barX, barY, barWidth, barHeight, TFT_BLACK);
-  
-  // Draw bar background outline
-  display.drawRect(barX, barY, barWidth, barHeight, TFT_WHITE);
+/**
+ * @brief Display task: renders one frame per slot of the interval displayPower picks.
+ *
+ * Frames start on a fixed grid. A frame that overruns its slot is counted as
+ * missed and the grid restarts from now instead of bunching catch-up frames
+ * back to back. The engine notifies the task when the display has to wake up,
+ * which ends a slow-mode wait early and restarts the grid. While the
+ * backlight is off nothing is rendered.
+ */
+void displayTask(void* parameter) {
+  TickType_t lastWake = xTaskGetTickCount();
+  ScreenState shownScreen = SCREEN_MEASUREMENT;
+  bool firstFrame = true;
+  uint8_t shownBrightness = 255; // Set by setupDisplay()
+  DisplaySnapshot snapshot;
+  int64_t releaseUs = esp_timer_get_time(); // When this frame's slot started, for renderJob
+
+  for (;;) {
+    uint32_t start = micros();
+    int64_t startUs = esp_timer_get_time();
+
+    portENTER_CRITICAL(&displaySnapshotMux);
+    snapshot = displaySnapshot;
+    displaySnapshot.traceSamples = 0; // Next trace column starts a new envelope
+    portEXIT_CRITICAL(&displaySnapshotMux);
+
+    if (pendingDisplayBenchmarkFrames > 0) {
+      traceView.end(); // The benchmark pushes the canvas, which needs the panel unscrolled
+      displayBenchmarkResult = displayPipeline.runBenchmark(pendingDisplayBenchmarkFrames); // Pushes the current canvas, panel stays in sync
+      pendingDisplayBenchmarkFrames = 0;
+      displayBenchmarkReady = true;
+    }
+
+    if (pendingDisplayClock > 0) {
+      displayClock.setFixed(pendingDisplayClock, applyDisplayClock);
+      pendingDisplayClock = 0;
+    }
+    if (pendingDisplayClockSweep) {
+      traceView.end(); // The sweep draws over the whole panel
+      displayClock.sweep(gfx, canvas, displayPipeline, applyDisplayClock);
+      pendingDisplayClockSweep = false;
+      displayClockSweepReady = true;
+      measurementScreen.invalidate(); // Panel and canvas were cleared
+    }
+
+    if (firstFrame) {
+      measurementScreen.invalidate();
+      shownScreen = snapshot.screen;
+      firstFrame = false;
+    }
+
+    if (snapshot.powerMode != DISPLAY_POWER_BLANK) {
+      uint32_t stageStart = stageProfiler.start();
+      renderDisplayFrame(snapshot, shownScreen);
+      stageProfiler.stop(PROFILE_RENDER, stageStart);
+
+      // Stream the frame out, sleeping between bands so other tasks run during DMA
+      stageStart = stageProfiler.start();
+      while (displayPipeline.busy()) {
+        displayPipeline.service();
+        if (displayPipeline.busy()) {
+          vTaskDelay(1);
+        }
+      }
+      stageProfiler.stop(PROFILE_PUSH, stageStart);
 
-  // Calculate maxDisplayWeight dynamically based on thresholds
-  // Ensure the range covers from 0 up to at least the high threshold, plus some buffer
-  float minVal = 0.0; // Always start from 0 for the bar
-  float maxVal = highThreshold * 1.2; // High threshold + 20% buffer
-  if (maxVal < 10.0) maxVal = 10.0; // Ensure a minimum scale for very small thresholds
+      uint32_t frameUs = micros() - start;
+      displayTaskStats.frames++;
+      displayTaskStats.lastFrameUs = frameUs;
+      if (frameUs > displayTaskStats.maxFrameUs) {
+        displayTaskStats.maxFrameUs = frameUs;
+      }
+      taskMonitor.record(TASK_DISPLAY, frameUs);
+      renderJob.setPeriodMs(snapshot.frameIntervalMs);
+      renderJob.account(releaseUs, startUs, esp_timer_get_time());
+    }
 
-  int fillHeight = map(weight, minVal, maxVal, 0, barHeight);
-  fillHeight = constrain(fillHeight, 0, barHeight); // Ensure it stays within bounds
+    // After rendering, so waking from blank shows the new frame rather than the stale one
+    if (snapshot.brightness != shownBrightness) {
+      gfx.setBrightness(snapshot.brightness);
+      shownBrightness = snapshot.brightness;
+    }
 
-  // Draw filled portion of the bar
-  uint16_t barColor = TFT_GREEN;
-  if (alarmActive) {
-    barColor = TFT_RED;
-  } else if (alarmSettings.enabled && (weight < lowThreshold || weight > highThreshold)) {
-    barColor = (weight < lowThreshold) ? TFT_BLUE : TFT_RED; // ✅ IMPROVED - Blue for too low, Red for too high
+    const TickType_t period = pdMS_TO_TICKS(snapshot.frameIntervalMs);
+    TickType_t now = xTaskGetTickCount();
+    if (now - lastWake >= period) {
+      displayTaskStats.missedFrames += (now - lastWake) / period;
+      lastWake = now;
+    }
+    // Sleep until the next slot, unless the engine wakes the display first
+    releaseUs = esp_timer_get_time() + (int64_t)(lastWake + period - now) * portTICK_PERIOD_MS * 1000;
+    if (ulTaskNotifyTake(pdTRUE, lastWake + period - now) > 0) {
+      lastWake = xTaskGetTickCount();
+      releaseUs = esp_timer_get_time();
+    } else {
+      lastWake += period;
+    }
   }
-  display.fillRect(barX + 1, barY + barHeight - fillHeight + 1, barWidth - 2, fillHeight - 2, barColor);
+}
 
-  // Draw alarm thresholds on the bar if enabled
-  if (alarmSettings.enabled) {
-    // Low threshold line
-    int lowY = map(lowThreshold, minVal, maxVal, 0, barHeight);
-    lowY = barY + barHeight - lowY; // Invert Y for drawing from top
-    display.drawFastHLine(barX, lowY, barWidth, TFT_BLUE); // Blue line for low threshold
+/**
+ * @brief Draws one frame of whichever screen the snapshot asks for and starts pushing it.
+ * @param shownScreen Screen currently on the panel, updated on a switch.
+ */
+void renderDisplayFrame(const DisplaySnapshot& snapshot, ScreenState& shownScreen) {
+  if (snapshot.screen != shownScreen) {
+    LOG_DEBUG("ScreenState changed from %d to %d. Redrawing screen.", shownScreen, snapshot.screen);
+    if (shownScreen == SCREEN_TRACE) {
+      traceView.end(); // Leave hardware scroll before the canvas is pushed again
+    }
+    shownScreen = snapshot.screen;
+    measurementScreen.invalidate(); // Sprite and panel no longer match its retained state
+    traceView.invalidate();
+  }
 
-    // High threshold line
-    int highY = map(highThreshold, minVal, maxVal, 0, barHeight);
-    highY = barY + barHeight - highY; // Invert Y for drawing from top
-    display.drawFastHLine(barX, highY, barWidth, TFT_BLUE); // Blue line for high threshold
+  if (snapshot.screen == SCREEN_MEASUREMENT) {
+    // Only the widgets that changed are redrawn in the sprite and pushed
+    pushDirtyRegion(drawMeasurementScreen(snapshot));
+    return;
+  }
+  if (snapshot.screen == SCREEN_TRACE) {
+    // One new column per frame; the panel scrolls the rest
+    drawTraceScreen(snapshot);
+    return;
+  }
 
-  // --- Touch Buttons ---
+  // Draw to off-screen sprite buffer (no flicker!)
+  canvas.fillScreen(UI_BLACK);
+  if (snapshot.screen == SCREEN_CALIBRATION) {
+    drawCalibrationScreen(canvas, snapshot.calibrationState, snapshot.adc, snapshot.weight);
+  } else if (snapshot.screen == SCREEN_AP_MODE) {
+    drawAPModeScreen(canvas);
   }
+
+  // Push complete frame to display in one smooth operation (eliminates flicker!)
+  DirtyRegion frame;
+  frame.add(0, 0, canvas.width(), canvas.height());
+  pushDirtyRegion(frame);
 }
 
 /**
- * @brief Draws the calibration screen on the display.
- * @param state Current calibration state.
- * @param currentAdc Current ADC reading.
- * @param currentWeight Current weight in grains.
+ * @brief Adds the display task's frame counters to a state document.
  */
-void drawCalibrationScreen(CalibrationState state, float currentAdc, float currentWeight) { // Changed to currentWeight
-  // Rotation is set in setupDisplay()
-  display.setTextColor(TFT_WHITE); // Set text color
+void displayStatsToJson(JsonObject out) {
+  out["frames"] = displayTaskStats.frames;
+  out["missedFrames"] = displayTaskStats.missedFrames;
+  out["frameMs"] = displayTaskStats.lastFrameUs / 1000.0;
+  out["maxFrameMs"] = displayTaskStats.maxFrameUs / 1000.0;
+  out["spiClock"] = displayClock.frequency();
+
+  const DisplayPowerSettings& power = displayPower.settings();
+  out["mode"] = DisplayPowerPolicy::modeName(displayPower.mode());
+  out["dimAfterS"] = power.dimAfterMs / 1000;
+  out["blankAfterS"] = power.blankAfterMs / 1000;
+  out["dimBrightness"] = power.dimBrightness;
+  JsonObject modeSeconds = out.createNestedObject("secondsInMode");
+  uint32_t now = millis();
+  for (int mode = 0; mode < DISPLAY_POWER_MODE_COUNT; mode++) {
+    modeSeconds[DisplayPowerPolicy::modeName((DisplayPowerMode)mode)] = (uint32_t)(displayPower.timeInModeMs((DisplayPowerMode)mode, now) / 1000);
+  }
+}
 
-  // Clear the entire screen to avoid artifacts from previous states
-  display.fillScreen(TFT_BLACK);
+/**
+ * @brief Adds the Wi-Fi link state, connection uptime and reconnect counters to a state document.
+ */
+void wifiStatsToJson(JsonObject out) {
+  uint32_t now = millis();
+  WifiLinkStats stats = wifiLink.stats();
+  out["state"] = WifiLink::stateName(wifiLink.state());
+  out["apActive"] = wifiLink.apActive();
+  out["uptimeS"] = wifiLink.uptimeMs(now) / 1000;
+  out["connectedS"] = (uint32_t)(wifiLink.connectedTotalMs(now) / 1000);
+  out["longestUptimeS"] = stats.longestUptimeMs / 1000;
+  out["attempts"] = stats.attempts;
+  out["reconnects"] = stats.reconnects;
+  out["disconnects"] = stats.disconnects;
+  out["apFallbacks"] = stats.apFallbacks;
+  out["lastDisconnectReason"] = stats.lastDisconnectReason;
+  out["backoffMs"] = wifiLink.backoffMs();
+  out["firstConnectMs"] = stats.firstConnectMs;
+  out["fastAttempts"] = stats.fastAttempts;
+  out["fastConnects"] = stats.fastConnects;
+  out["staticIp"] = wifiLink.staticIp();
+  out["firstClientMs"] = firstWebSocketClientMs;
+}
 
-  display.setCursor(5, 5);
-  display.setTextSize(1); // Smallest size for title
-  display.println("--- CALIBRATION WIZARD ---"); 
+/**
+ * @brief Starts pushing the given areas of the sprite to the panel.
+ *        Returns immediately; the transfer continues via displayPipeline.service().
+ */
+void pushDirtyRegion(const DirtyRegion& region) {
+  displayPipeline.submit(region);
+}
 
-  display.setTextSize(2); // Larger for step title
-  display.setCursor(5, 30);
-  if (state == CALIBRATE_ZERO_STEP) {
-    display.println("Step 1/2: Set Zero"); 
-    
-    display.setTextSize(1); // Smaller for instructions
-    display.setCursor(5, 60);
-    display.println("Place probe at 0mm");
-    display.setCursor(5, 75); // New line for clarity
-    display.println("(empty container).");
-    
-    display.setCursor(5, 100); // Clear and draw Current ADC
-    display.printf("ADC: %.0f", currentAdc); 
-    
-    display.setCursor(5, 120);
-    display.println("Confirm on Web UI."); 
-  } else if (state == CALIBRATE_KNOWN_GRAINS_STEP) { // This is now Step 2
-    display.println("Step 2/2: Known Grains"); 
-    
-    display.setTextSize(1); // Smaller for instructions
-    display.setCursor(5, 60);
-    display.println("Insert probe into");
-    display.setCursor(5, 75); // New line for clarity
-    display.println("container w/ powder.");
-    
-    display.setCursor(5, 100); // Clear and draw Current Weight
-    display.printf("Weight: %.3f gr", currentWeight); 
-    
-    display.setCursor(5, 120);
-    display.println("Enter weight on Web UI."); 
+/**
+ * @brief Called by the display pipeline whenever a frame has been sent.
+ */
+void onDisplayFrameComplete(const DisplayFrameStats& stats) {
+  if (stats.frameUs > DISPLAY_UPDATE_INTERVAL_MS * 1000) {
+    LOG_WARN("Slow display frame: %lu us for %lu bytes in %lu bands",
+                  (unsigned long)stats.frameUs, (unsigned long)stats.bytes, (unsigned long)stats.bands);
   }
-  
-  // Common instruction for cancelling
-  display.setTextSize(1);
-  display.setCursor(5, display.height() - 15); // Position at bottom
+}
+
+/**
+ * @brief Asks the display task to measure blocking vs. DMA frame pushes.
+ *        The result is sent to clients by sendDisplayBenchmarkResult() once done.
+ * @param frames Number of full frames to push in each mode.
+ */
+void handleDisplayBenchmarkCommand(int frames) {
+  pendingDisplayBenchmarkFrames = constrain(frames, 1, 200);
+}
 
-  // --- Touch Buttons ---
-  // NOTE: These buttons are currently unused as calibration is driven by the Web UI.
-  // They are left here for potential future use on the device screen.
-  // drawButton(zeroBtn);
-  // drawButton(spanBtn);
-  // drawButton(backBtn);
-  display.println("Cancel via Web UI."); 
+/**
+ * @brief Switches the measuring view between the readout and the scrolling trace.
+ * @param view "readout" or "trace".
+ */
+void handleSetDisplayViewCommand(const String& view) {
+  if (view == "trace") {
+    displayView = DISPLAY_VIEW_TRACE;
+  } else if (view == "readout") {
+    displayView = DISPLAY_VIEW_READOUT;
+  } else {
+    LOG_WARN("Unknown display view: %s", view.c_str());
+    return;
+  }
+  LOG_INFO("Command: Display view set to %s", view.c_str());
+  saveSettings();
+}
+
+/**
+ * @brief Changes one of the display idle settings and saves it.
+ * @param key displayDimAfterS or displayBlankAfterS (seconds, 0 = never), or displayDimBrightness (0-255).
+ */
+void handleSetDisplayPowerCommand(const String& key, long value) {
+  if (value < 0) {
+    LOG_WARN("Invalid value for %s", key.c_str());
+    return;
+  }
+  DisplayPowerSettings power = displayPower.settings();
+  if (key == "displayDimAfterS") {
+    power.dimAfterMs = value * 1000UL;
+  } else if (key == "displayBlankAfterS") {
+    power.blankAfterMs = value * 1000UL;
+  } else {
+    power.dimBrightness = constrain(value, 0L, 255L);
+  }
+  displayPower.configure(power);
+  displayPower.wake(millis()); // Show the effect from a fresh idle period
+  LOG_INFO("Command: %s set to %ld", key.c_str(), value);
+  saveSettings();
 }
 
 /**
- * @brief Draws the AP mode screen on the display.
+ * @brief Asks the display task to sweep the SPI clock and keep the fastest stable one.
+ *        The result is sent to clients by sendDisplayClockSweepResult() once done.
  */
-void drawAPModeScreen() {
-  // Rotation is set in setupDisplay()
-  display.setTextColor(TFT_WHITE); // Set text color
+void handleDisplayClockSweepCommand() {
+  LOG_INFO("Command: Display clock sweep requested");
+  pendingDisplayClockSweep = true;
+}
 
-  display.fillScreen(TFT_BLACK); // Clear screen completely
+/**
+ * @brief Fixes the display SPI clock instead of using the tuned one.
+ * @param frequency Clock in Hz (1-80 MHz), or 0 to sweep and tune again.
+ */
+void handleSetDisplayClockCommand(long frequency) {
+  if (frequency == 0) {
+    handleDisplayClockSweepCommand();
+    return;
+  }
+  if (frequency < 1000000L || frequency > 80000000L) {
+    LOG_WARN("Invalid display SPI clock: %ld Hz", frequency);
+    return;
+  }
+  LOG_INFO("Command: Display SPI clock set to %ld Hz", frequency);
+  pendingDisplayClock = frequency;
+}
 
-  display.setCursor(5, 5);
-  display.setTextSize(1);
-  display.println("--- AP MODE ACTIVE ---"); 
-  display.setTextSize(2);
-  display.setCursor(5, 30);
-  display.println("SSID: PowderSense"); 
-  display.setCursor(5, 60);
-  display.println("IP: 192.168.4.1"); 
-  display.setTextSize(1);
-  display.setCursor(5, 90);
-  display.println("Connect to this network"); 
-  display.setCursor(5, 105);
-  display.println("to configure Wi-Fi."); 
+/**
+ * @brief Sets the POSIX time zone used for local time and saves it.
+ * @param timeZone TZ string, e.g. "CET-1CEST,M3.5.0,M10.5.0/3" or "EST5EDT,M3.2.0,M11.1.0".
+ */
+void handleSetTimeZoneCommand(const String& timeZone) {
+  if (!timeSync.setTimeZone(timeZone.c_str())) {
+    LOG_WARN("Invalid time zone: %s", timeZone.c_str());
+    return;
+  }
+  LOG_INFO("Command: Time zone set to %s", timeSync.timeZone());
+  saveSettings();
+}
+
+/**
+ * @brief Switches the panel to a new SPI clock. Only called from the display task.
+ */
+void applyDisplayClock(uint32_t frequency) {
+  gfx.setWriteClock(frequency);
+  displayPipeline.setSpiFrequency(frequency);
+}
+
+/**
+ * @brief Reports the last SPI clock sweep to all WebSocket clients.
+ */
+void sendDisplayClockSweepResult() {
+  const DisplayClockSweepResult& result = displayClock.lastSweep();
+  DynamicJsonDocument doc(2048);
+  JsonObject sweep = doc.createNestedObject("displayClockSweep");
+  sweep["selected"] = result.selected;
+  sweep["fastestStable"] = result.fastestStable;
+  sweep["durationMs"] = result.durationMs;
+  JsonArray clocks = sweep.createNestedArray("clocks");
+  for (uint8_t i = 0; i < result.count; i++) {
+    const DisplayClockMeasurement& m = result.clocks[i];
+    JsonObject clock = clocks.createNestedObject();
+    clock["frequency"] = m.frequency;
+    clock["fillMpixelsPerS"] = m.fillMpixelsPerS;
+    clock["frameMs"] = m.frameMs;
+    clock["jitter"] = m.jitter;
+    clock["textCharsPerS"] = m.textCharsPerS;
+    clock["wireEfficiency"] = m.wireEfficiency;
+    clock["stable"] = m.stable;
+  }
+  String json;
+  serializeJson(doc, json);
+  webSocket.broadcastTXT(json);
+}
+
+const char* displayViewName(DisplayView view) {
+  return view == DISPLAY_VIEW_TRACE ? "trace" : "readout";
+}
+
+/**
+ * @brief Reports the last display benchmark to all WebSocket clients.
+ */
+void sendDisplayBenchmarkResult() {
+  const DisplayBenchmarkResult& result = displayBenchmarkResult;
+  DynamicJsonDocument doc(512);
+  JsonObject benchmark = doc.createNestedObject("displayBenchmark");
+  benchmark["frames"] = result.frames;
+  benchmark["pixelsPerFrame"] = result.pixelsPerFrame;
+  benchmark["spiFrequency"] = displayClock.frequency();
+  benchmark["blockingFrameMs"] = result.blockingFrameMs;
+  benchmark["asyncFrameMs"] = result.asyncFrameMs;
+  benchmark["cpuIdlePercent"] = result.cpuIdlePercent;
+  benchmark["busUtilization"] = result.busUtilization;
+  String json;
+  serializeJson(doc, json);
+  webSocket.broadcastTXT(json);
 }
 
 // --- Touch Handling Functions ---
+/**
+ * @brief Handles the taps and long presses queued by the touch task. Never waits.
+ *        A tap presses a button on the main screen; a long press switches between readout and trace.
+ */
 void handleTouch() {
-  uint16_t touchX, touchY;
-  if (gfx.getTouch(&touchX, &touchY)) { // Note: This may need touch controller setup
-    Serial.printf("Touch detected: X=%d, Y=%d\n", touchX, touchY);
+  TouchEvent event;
+  while (touchInput.poll(event)) {
+    displayPower.wake(millis()); // The next published snapshot brings the display back to full rate
+
+    if (event.type == TOUCH_EVENT_LONG_PRESS) {
+      LOG_DEBUG("Long press at X=%d, Y=%d", event.x, event.y);
+      if (currentScreenState == SCREEN_MEASUREMENT || currentScreenState == SCREEN_TRACE) {
+        handleSetDisplayViewCommand(displayView == DISPLAY_VIEW_TRACE ? "readout" : "trace");
+        stateBroadcastPending = true;
+      }
+      continue;
+    }
 
+    LOG_DEBUG("Tap at X=%d, Y=%d (%lu ms)", event.x, event.y, (unsigned long)event.durationMs);
     switch (currentScreenState) {
       case SCREEN_MEASUREMENT:
-        handleMainTouch(touchX, touchY);
+        handleMainTouch(event.x, event.y);
         break;
       case SCREEN_CALIBRATION:
         // Touch handling disabled for calibration screen as it is Web UI driven
         break;
+      case SCREEN_TRACE:
+        // The trace has no buttons
+        break;
+      default:
+        break;
     }
-
-    delay(200); // Debounce
   }
 }
 
@@ -2379,9 +3755,9 @@ bool isButtonPressed(TouchButton &btn, int touchX, int touchY) {
 }
 
 void drawButton(TouchButton &btn, bool pressed) {
-  uint16_t bgColor = pressed ? TFT_DARKGREY : TFT_BLACK;
-  uint16_t borderColor = btn.enabled ? btn.color : TFT_DARKGREY;
-  uint16_t textColor = btn.enabled ? TFT_WHITE : TFT_DARKGREY;
+  uint16_t bgColor = pressed ? UI_DARKGREY : UI_BLACK;
+  uint16_t borderColor = btn.enabled ? btn.color : UI_DARKGREY;
+  uint16_t textColor = btn.enabled ? UI_WHITE : UI_DARKGREY;
   
   // Draw button background
   display.fillRect(btn.x, btn.y, btn.width, btn.height, bgColor);
@@ -2402,15 +3778,15 @@ void drawButton(TouchButton &btn, bool pressed) {
 
 void handleMainTouch(int x, int y) {
   if (isButtonPressed(calibrateBtn, x, y)) {
-    Serial.println("✅ Calibrate button pressed");
+    LOG_DEBUG("✅ Calibrate button pressed");
     currentScreenState = SCREEN_CALIBRATION;
   } else if (isButtonPressed(profileBtn, x, y)) {
-    Serial.println("✅ Profile button pressed");
+    LOG_DEBUG("✅ Profile button pressed");
     // Cycle through profiles or open profile selection
     currentConfigIndex = (currentConfigIndex + 1) % MAX_CONFIGS;
-    Serial.printf("Switched to profile %d\n", currentConfigIndex);
+    LOG_DEBUG("Switched to profile %d", currentConfigIndex);
   } else if (isButtonPressed(settingsBtn, x, y)) {
-    Serial.println("✅ Settings button pressed");
+    LOG_DEBUG("✅ Settings button pressed");
     // Could add settings screen later
   }
 }
@@ -0,0 +1,335 @@
+#include <Arduino.h>
+#include "measurement_screen.h"
+#include "digit_glyphs.h"
+
+// Layout, unchanged from the original immediate-mode drawing code except for
+// the weight readout, which is composed from pre-rendered digit glyphs
+#define WEIGHT_Y 5
+#define WEIGHT_INT_CELLS 3   // Digits before the decimal point (or '-' and two digits)
+#define WEIGHT_DEC_CELLS 3
+#define WEIGHT_CELLS (WEIGHT_INT_CELLS + WEIGHT_DEC_CELLS)
+#define WEIGHT_UNIT "grain"
+#define WEIGHT_UNIT_GAP 6
+#define WEIGHT_UNIT_Y (WEIGHT_Y + 11) // Size 2 text sitting on the digits' baseline
+#define CONFIG_NAME_Y 45
+#define TARGET_Y 70
+#define BAR_MARGIN_RIGHT 50
+#define BAR_WIDTH 40
+#define BAR_Y 5
+
+MeasurementScreen::MeasurementScreen(LGFX_Sprite& canvas)
+  : _canvas(canvas), _valid(false) {
+  memset(&_model, 0, sizeof(_model));
+  _clip = { 0, 0, 0, 0 };
+}
+
+const DirtyRegion& MeasurementScreen::render(const MeasurementScreenInputs& inputs) {
+  Model next;
+  buildModel(inputs, next);
+  _dirty.clear();
+
+  if (!_valid) {
+    _model = next;
+    _valid = true;
+    DirtyRect screen = { 0, 0, (int16_t)_canvas.width(), (int16_t)_canvas.height() };
+    repaint(screen);
+    _dirty.add(screen);
+    return _dirty;
+  }
+
+  // Only the digit cells that changed are redrawn
+  for (int cell = 0; cell < WEIGHT_CELLS; cell++) {
+    if (next.weightCells[cell] != _model.weightCells[cell]) {
+      _dirty.add(weightCellRect(cell));
+    }
+  }
+  if (strcmp(next.configName, _model.configName) != 0) {
+    _dirty.add(widgetRect(WIDGET_CONFIG_NAME));
+  }
+  if (strcmp(next.target, _model.target) != 0) {
+    _dirty.add(widgetRect(WIDGET_TARGET));
+  }
+  if (strcmp(next.status, _model.status) != 0 || next.statusColor != _model.statusColor) {
+    _dirty.add(widgetRect(WIDGET_STATUS));
+  }
+  if (strcmp(next.ip, _model.ip) != 0 || next.ipColor != _model.ipColor) {
+    _dirty.add(widgetRect(WIDGET_IP));
+  }
+
+  DirtyRect bar = barRect();
+  if (next.barColor != _model.barColor || next.thresholds != _model.thresholds ||
+      next.lowY != _model.lowY || next.highY != _model.highY) {
+    _dirty.add(bar);
+  } else if (next.barFillTop != _model.barFillTop) {
+    // Only the rows between the old and new fill level change
+    int top = min(next.barFillTop, _model.barFillTop) - 1;
+    int bottom = max(next.barFillTop, _model.barFillTop) + 1;
+    DirtyRect strip = { bar.x, (int16_t)top, bar.w, (int16_t)(bottom - top) };
+    _dirty.add(strip.intersected(bar));
+  }
+
+  _model = next;
+  for (size_t i = 0; i < _dirty.size(); i++) {
+    repaint(_dirty[i]);
+  }
+  return _dirty;
+}
+
+void MeasurementScreen::buildModel(const MeasurementScreenInputs& inputs, Model& model) const {
+  memset(&model, 0, sizeof(model));
+
+  // Integer milligrains instead of snprintf("%.3f"): one float multiply per frame
+  float weight = isnan(inputs.weight) ? 0.0f : inputs.weight;
+  int32_t milligrains = lroundf(weight * 1000.0f);
+  milligrains = constrain(milligrains, (int32_t)-99999, (int32_t)999999);
+  bool negative = milligrains < 0;
+  uint32_t value = negative ? -milligrains : milligrains;
+  for (int cell = WEIGHT_CELLS - 1; cell >= WEIGHT_INT_CELLS; cell--) {
+    model.weightCells[cell] = '0' + value % 10;
+    value /= 10;
+  }
+  int cell = WEIGHT_INT_CELLS - 1;
+  do {
+    model.weightCells[cell--] = '0' + value % 10;
+    value /= 10;
+  } while (value > 0 && cell >= 0);
+  if (negative && cell >= 0) {
+    model.weightCells[cell--] = '-';
+  }
+  while (cell >= 0) {
+    model.weightCells[cell--] = ' ';
+  }
+
+  if (inputs.configName != nullptr) {
+    strncpy(model.configName, inputs.configName, sizeof(model.configName) - 1);
+    snprintf(model.target, sizeof(model.target), "T: %.3f gr", inputs.targetGrain);
+  } else {
+    strcpy(model.configName, "No Config");
+    strcpy(model.target, "T: ---");
+  }
+
+  if (inputs.configName == nullptr) {
+    strcpy(model.status, "Powdersense");
+    model.statusColor = UI_WHITE;
+  } else if (inputs.weight < inputs.lowThreshold) {
+    strcpy(model.status, "LOW");
+    model.statusColor = UI_BLUE;
+  } else if (inputs.weight > inputs.highThreshold) {
+    strcpy(model.status, "HIGH");
+    model.statusColor = UI_RED;
+  } else {
+    strcpy(model.status, "PERFECT");
+    model.statusColor = UI_GREEN;
+  }
+
+  if (inputs.offline) {
+    // Shots keep being recorded; clients fetch them by sequence once back online
+    if (inputs.queuedShots > 0) {
+      snprintf(model.ip, sizeof(model.ip), "OFFLINE +%lu", (unsigned long)inputs.queuedShots);
+    } else {
+      strcpy(model.ip, "OFFLINE");
+    }
+    model.ipColor = UI_ORANGE;
+  } else {
+    strncpy(model.ip, inputs.ip != nullptr ? inputs.ip : "", sizeof(model.ip) - 1);
+    model.ipColor = UI_WHITE;
+  }
+
+  // --- Vertical bar graph ---
+  DirtyRect bar = barRect();
+  int barHeight = bar.h;
+
+  // Scale from 0 up to the high threshold plus a 20% buffer
+  float minVal = 0.0;
+  float maxVal = inputs.highThreshold * 1.2;
+  if (maxVal < 10.0) maxVal = 10.0; // Ensure a minimum scale for very small thresholds
+
+  int fillHeight = map(inputs.weight, minVal, maxVal, 0, barHeight);
+  fillHeight = constrain(fillHeight, 0, barHeight);
+  // The fill is inset by one pixel; heights below 3 draw nothing
+  model.barFillTop = fillHeight > 2 ? bar.y + barHeight - fillHeight + 1 : bar.y + barHeight - 1;
+
+  model.barColor = UI_GREEN;
+  if (inputs.alarmActive) {
+    model.barColor = UI_RED;
+  } else if (inputs.alarmEnabled && (inputs.weight < inputs.lowThreshold || inputs.weight > inputs.highThreshold)) {
+    model.barColor = (inputs.weight < inputs.lowThreshold) ? UI_BLUE : UI_RED; // Blue for too low, red for too high
+  }
+
+  model.thresholds = inputs.alarmEnabled;
+  if (model.thresholds) {
+    model.lowY = bar.y + barHeight - map(inputs.lowThreshold, minVal, maxVal, 0, barHeight);
+    model.highY = bar.y + barHeight - map(inputs.highThreshold, minVal, maxVal, 0, barHeight);
+  }
+}
+
+DirtyRect MeasurementScreen::barRect() const {
+  return { (int16_t)(_canvas.width() - BAR_MARGIN_RIGHT), BAR_Y, BAR_WIDTH, (int16_t)(_canvas.height() - 10) };
+}
+
+DirtyRect MeasurementScreen::widgetRect(MeasurementWidget widget) const {
+  int16_t width = _canvas.width();
+  int16_t height = _canvas.height();
+  // Built-in font is 8 pixels high per text size step
+  switch (widget) {
+    case WIDGET_WEIGHT:      return { 0, WEIGHT_Y, width, DIGIT_GLYPH_HEIGHT };
+    case WIDGET_CONFIG_NAME: return { 0, CONFIG_NAME_Y, width, TARGET_Y - CONFIG_NAME_Y }; // Room for a wrapped line
+    case WIDGET_TARGET:      return { 0, TARGET_Y, width, 8 * 2 * 2 };
+    case WIDGET_STATUS:      return { 0, (int16_t)(height - 8 * 3 - 30), width, 8 * 3 + 10 };
+    case WIDGET_IP:          return { 0, (int16_t)(height - 15), width, 15 };
+    case WIDGET_BAR:         return barRect();
+    default:                 return { 0, 0, 0, 0 };
+  }
+}
+
+int MeasurementScreen::weightCellX(int cell) const {
+  // The readout is centered as a whole; cells start on even columns so glyph
+  // rows line up with the canvas bytes and blit with memcpy
+  int unitWidth = strlen(WEIGHT_UNIT) * 6 * 2;
+  int total = WEIGHT_CELLS * DIGIT_GLYPH_WIDTH + DOT_GLYPH_WIDTH + WEIGHT_UNIT_GAP + unitWidth;
+  int x = ((_canvas.width() - total) / 2) & ~1;
+  x += cell * DIGIT_GLYPH_WIDTH;
+  if (cell >= WEIGHT_INT_CELLS) {
+    x += DOT_GLYPH_WIDTH; // cell == WEIGHT_CELLS gives the start of the unit gap
+  }
+  return x;
+}
+
+DirtyRect MeasurementScreen::weightCellRect(int cell) const {
+  return { (int16_t)weightCellX(cell), WEIGHT_Y, DIGIT_GLYPH_WIDTH, DIGIT_GLYPH_HEIGHT };
+}
+
+void MeasurementScreen::drawWeight() {
+  for (int cell = 0; cell < WEIGHT_CELLS; cell++) {
+    char c = _model.weightCells[cell];
+    if (c >= '0' && c <= '9') {
+      blitGlyph(DIGIT_GLYPHS[c - '0'], DIGIT_GLYPH_WIDTH, weightCellX(cell), WEIGHT_Y);
+    } else if (c == '-') {
+      blitGlyph(DIGIT_GLYPHS[DIGIT_GLYPH_MINUS], DIGIT_GLYPH_WIDTH, weightCellX(cell), WEIGHT_Y);
+    }
+  }
+  blitGlyph(DOT_GLYPH, DOT_GLYPH_WIDTH, weightCellX(WEIGHT_INT_CELLS) - DOT_GLYPH_WIDTH, WEIGHT_Y);
+
+  _canvas.setTextSize(2);
+  _canvas.setTextColor(UI_WHITE);
+  _canvas.setCursor(weightCellX(WEIGHT_CELLS) + WEIGHT_UNIT_GAP, WEIGHT_UNIT_Y);
+  _canvas.print(WEIGHT_UNIT);
+}
+
+void MeasurementScreen::blitGlyph(const uint8_t* glyph, int glyphWidth, int x, int y) {
+  int left = max(x, (int)_clip.x);
+  int right = min(x + glyphWidth, (int)_clip.right());
+  int top = max(y, (int)_clip.y);
+  int bottom = min(y + DIGIT_GLYPH_HEIGHT, (int)_clip.bottom());
+  if (left >= right || top >= bottom) {
+    return;
+  }
+
+  if (_canvas.getColorDepth() != lgfx::palette_4bit) {
+    // Glyphs are stored in the 4-bit canvas layout; draw them pixel by pixel otherwise
+    for (int row = top; row < bottom; row++) {
+      for (int col = left; col < right; col++) {
+        uint8_t pair = glyph[(row - y) * (glyphWidth >> 1) + ((col - x) >> 1)];
+        _canvas.drawPixel(col, row, ((col - x) & 1) ? (pair & 0x0F) : (pair >> 4));
+      }
+    }
+    return;
+  }
+
+  // x is even, so glyph and canvas nibbles share the same parity and whole
+  // bytes can be copied; only a clipped odd edge needs nibble handling
+  uint8_t* canvas = (uint8_t*)_canvas.getBuffer();
+  int strideBytes = (_canvas.width() + 1) >> 1;
+  for (int row = top; row < bottom; row++) {
+    const uint8_t* src = glyph + (row - y) * (glyphWidth >> 1);
+    uint8_t* dst = canvas + row * strideBytes;
+    int col = left;
+    if (col & 1) {
+      uint8_t* out = dst + (col >> 1);
+      *out = (*out & 0xF0) | (src[(col - x) >> 1] & 0x0F);
+      col++;
+    }
+    int bytes = (right - col) >> 1;
+    memcpy(dst + (col >> 1), src + ((col - x) >> 1), bytes);
+    col += bytes * 2;
+    if (col < right) {
+      uint8_t* out = dst + (col >> 1);
+      *out = (*out & 0x0F) | (src[(col - x) >> 1] & 0xF0);
+    }
+  }
+}
+
+void MeasurementScreen::repaint(const DirtyRect& area) {
+  _canvas.fillRect(area.x, area.y, area.w, area.h, UI_BLACK);
+
+  // Widgets overlap (text rows span the full width, the bar sits on top), so
+  // every widget touching the area is redrawn in z-order, clipped to the area
+  for (int i = 0; i < WIDGET_COUNT; i++) {
+    MeasurementWidget widget = (MeasurementWidget)i;
+    DirtyRect clip = widgetRect(widget).intersected(area);
+    if (clip.area() == 0) {
+      continue;
+    }
+    _clip = clip;
+    _canvas.setClipRect(clip.x, clip.y, clip.w, clip.h);
+    drawWidget(widget);
+  }
+  _canvas.clearClipRect();
+}
+
+void MeasurementScreen::drawCenteredText(const char* text, int y) {
+  int w = _canvas.textWidth(text);
+  _canvas.setCursor((_canvas.width() - w) / 2, y);
+  _canvas.print(text);
+}
+
+void MeasurementScreen::drawWidget(MeasurementWidget widget) {
+  switch (widget) {
+    case WIDGET_WEIGHT:
+      drawWeight();
+      break;
+
+    case WIDGET_CONFIG_NAME:
+      _canvas.setTextSize(2);
+      _canvas.setTextColor(UI_CYAN);
+      _canvas.setCursor(5, CONFIG_NAME_Y);
+      _canvas.print(_model.configName);
+      break;
+
+    case WIDGET_TARGET:
+      _canvas.setTextSize(2);
+      _canvas.setTextColor(UI_CYAN);
+      _canvas.setCursor(5, TARGET_Y);
+      _canvas.print(_model.target);
+      break;
+
+    case WIDGET_STATUS:
+      _canvas.setTextSize(3);
+      _canvas.setTextColor(_model.statusColor);
+      drawCenteredText(_model.status, _canvas.height() - _canvas.fontHeight() - 25);
+      break;
+
+    case WIDGET_IP:
+      _canvas.setTextSize(1);
+      _canvas.setTextColor(_model.ipColor);
+      drawCenteredText(_model.ip, _canvas.height() - 10);
+      break;
+
+    case WIDGET_BAR: {
+      DirtyRect bar = barRect();
+      _canvas.drawRect(bar.x, bar.y, bar.w, bar.h, UI_WHITE);
+      int fillBottom = bar.y + bar.h - 1; // Exclusive, keeps the outline's bottom row
+      if (_model.barFillTop < fillBottom) {
+        _canvas.fillRect(bar.x + 1, _model.barFillTop, bar.w - 2, fillBottom - _model.barFillTop, _model.barColor);
+      }
+      if (_model.thresholds) {
+        _canvas.drawFastHLine(bar.x, _model.lowY, bar.w, UI_BLUE);  // Low threshold
+        _canvas.drawFastHLine(bar.x, _model.highY, bar.w, UI_BLUE); // High threshold
+      }
+      break;
+    }
+
+    default:
+      break;
+  }
+}
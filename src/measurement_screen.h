@@ -0,0 +1,98 @@
+#ifndef MEASUREMENT_SCREEN_H
+#define MEASUREMENT_SCREEN_H
+
+#define LGFX_USE_V1
+#include <LovyanGFX.hpp>
+#include "dirty_region.h"
+#include "ui_palette.h"
+
+// ========================================
+// MEASUREMENT SCREEN (RETAINED MODE)
+// ========================================
+// The measurement screen is a fixed set of widgets. The last drawn state of
+// every widget is kept, and each frame only the widgets whose content changed
+// are repainted in the sprite. The areas that changed are returned as a
+// DirtyRegion so the caller pushes just those pixels to the panel instead of
+// the whole frame.
+
+// Everything the screen shows, as supplied by the caller each frame
+struct MeasurementScreenInputs {
+  float weight;
+  const char* configName; // nullptr if no config is selected
+  float targetGrain;
+  bool alarmActive;
+  bool alarmEnabled;
+  float lowThreshold;
+  float highThreshold;
+  const char* ip;
+  bool offline;         // No network: the footer shows OFFLINE instead of the address
+  uint32_t queuedShots; // Shots recorded since the network went down
+};
+
+enum MeasurementWidget {
+  WIDGET_WEIGHT,
+  WIDGET_CONFIG_NAME,
+  WIDGET_TARGET,
+  WIDGET_STATUS,
+  WIDGET_IP,
+  WIDGET_BAR, // Bar outline, fill and threshold lines; drawn last, on top
+  WIDGET_COUNT
+};
+
+/**
+ * @brief Retained-mode renderer for the main measurement screen.
+ */
+class MeasurementScreen
+{
+public:
+  explicit MeasurementScreen(LGFX_Sprite& canvas);
+
+  /**
+   * @brief Forces the next render() to repaint and report the whole screen,
+   *        e.g. after another screen has drawn into the sprite or panel.
+   */
+  void invalidate() { _valid = false; }
+
+  /**
+   * @brief Repaints the widgets that changed since the last call.
+   * @return The areas of the sprite that differ from what was last returned.
+   *         Empty if nothing changed. Valid until the next call.
+   */
+  const DirtyRegion& render(const MeasurementScreenInputs& inputs);
+
+private:
+  // Formatted content of every widget, compared field by field between frames
+  struct Model {
+    char weightCells[8]; // Right-aligned digits around a fixed decimal point, e.g. " 24123"
+    char configName[32];
+    char target[20];
+    char status[16];
+    uint8_t statusColor; // UiColor
+    char ip[20];         // Address, or the offline notice
+    uint8_t ipColor;     // UiColor
+    int barFillTop;    // First row of the bar fill (bar bottom if empty)
+    uint8_t barColor;  // UiColor
+    bool thresholds;   // Threshold lines visible
+    int lowY;
+    int highY;
+  };
+
+  void buildModel(const MeasurementScreenInputs& inputs, Model& model) const;
+  DirtyRect widgetRect(MeasurementWidget widget) const;
+  DirtyRect barRect() const;
+  int weightCellX(int cell) const;
+  DirtyRect weightCellRect(int cell) const;
+  void drawWeight();
+  void blitGlyph(const uint8_t* glyph, int glyphWidth, int x, int y);
+  void repaint(const DirtyRect& area);
+  void drawWidget(MeasurementWidget widget);
+  void drawCenteredText(const char* text, int y);
+
+  LGFX_Sprite& _canvas;
+  Model _model;
+  DirtyRegion _dirty;
+  DirtyRect _clip; // Area the widget being drawn is clipped to
+  bool _valid;
+};
+
+#endif // MEASUREMENT_SCREEN_H
@@ -0,0 +1,663 @@
+#include <Arduino.h>
+#include <SPIFFS.h>
+#include "measurement_store.h"
+#include "time_sync.h"
+#include "logger.h"
+
+// ========================================
+// BLOCK FORMAT
+// ========================================
+// Each slot holds one HistoryBlockHeader followed by three columns:
+//  - timestamps: delta-of-delta, zigzag varint (first timestamp is in the header)
+//  - weights:    milligrains, delta to previous shot, zigzag varint
+//  - configs:    run-length encoded as varint triples {run length, id, version}
+// Shots inside a block have consecutive sequence numbers starting at
+// header.firstSequence, so no sequence column is needed.
+//
+// A slot is written with magic = 0 first and the magic is set by a second
+// write, so a block torn by power loss is treated as empty and its shots are
+// recovered from the journal instead.
+
+#define MEASUREMENT_STORE_FILE "/history.bin"
+#define MEASUREMENT_JOURNAL_FILE "/history.jnl" // Raw records of the open block
+#define MEASUREMENT_FIXUP_FILE "/history.fix"   // TimestampFixup table
+#define LEGACY_STORE_FILE "/measurements.bin"   // Uncompressed format, no longer used
+#define HISTORY_BLOCK_MAGIC 0x31425350UL        // "PSB1"
+#define SLOT_EMPTY 0xFFFFFFFFUL
+#define OPEN_BLOCK_SLOT -2
+#define NO_CACHED_SLOT -1
+
+// Worst-case encoded sizes used to decide when to seal a block
+#define VARINT_MAX_BYTES 5
+#define RECORD_MAX_BYTES (2 * VARINT_MAX_BYTES) // Timestamp + weight
+#define RUN_MAX_BYTES (3 * VARINT_MAX_BYTES)
+
+MeasurementStore measurementStore;
+
+// --- Varint / zigzag helpers ---
+
+static inline uint32_t zigzagEncode(int32_t value) {
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static inline int32_t zigzagDecode(uint32_t value) {
+  return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+static size_t putVarint(uint8_t* out, uint32_t value) {
+  size_t n = 0;
+  while (value >= 0x80) {
+    out[n++] = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  out[n++] = (uint8_t)value;
+  return n;
+}
+
+static bool getVarint(const uint8_t*& cursor, const uint8_t* end, uint32_t& value) {
+  value = 0;
+  for (int shift = 0; shift < 35 && cursor < end; shift += 7) {
+    uint8_t byte = *cursor++;
+    value |= (uint32_t)(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static inline int32_t quantizeWeight(float weight) {
+  return (int32_t)lroundf(weight * 1000.0f);
+}
+
+/**
+ * @brief Sequential decoder over one block image.
+ */
+class HistoryBlockDecoder
+{
+public:
+  explicit HistoryBlockDecoder(const uint8_t* image) : _index(0), _runLeft(0), _configId(0), _configVersion(0) {
+    memcpy(&_header, image, sizeof(_header));
+    size_t total = sizeof(_header) + _header.timestampBytes + _header.weightBytes + _header.configBytes;
+    if (_header.magic != HISTORY_BLOCK_MAGIC || total > HISTORY_BLOCK_BYTES) {
+      _header.count = 0; // Corrupt block, decode nothing
+    }
+    _timestamp = image + sizeof(_header);
+    _timestampEnd = _timestamp + _header.timestampBytes;
+    _weight = _timestampEnd;
+    _weightEnd = _weight + _header.weightBytes;
+    _config = _weightEnd;
+    _configEnd = _config + _header.configBytes;
+    _prevTimestamp = _header.firstTimestamp;
+    _prevDelta = 0;
+    _prevWeight = 0;
+  }
+
+  const HistoryBlockHeader& header() const { return _header; }
+
+  bool next(StoredMeasurement& out) {
+    if (_index >= _header.count) {
+      return false;
+    }
+
+    uint32_t raw;
+    if (_index > 0) {
+      if (!getVarint(_timestamp, _timestampEnd, raw)) return false;
+      // Wrapping uint32 arithmetic mirrors the encoder, so clock jumps round-trip
+      _prevDelta = _prevDelta + (uint32_t)zigzagDecode(raw);
+      _prevTimestamp = _prevTimestamp + _prevDelta;
+    }
+    if (!getVarint(_weight, _weightEnd, raw)) return false;
+    _prevWeight += zigzagDecode(raw);
+
+    if (_runLeft == 0) {
+      uint32_t id, version;
+      if (!getVarint(_config, _configEnd, raw) || !getVarint(_config, _configEnd, id) ||
+          !getVarint(_config, _configEnd, version)) {
+        return false;
+      }
+      _runLeft = raw;
+      _configId = (uint16_t)id;
+      _configVersion = (uint16_t)version;
+    }
+    _runLeft--;
+
+    out.sequence = _header.firstSequence + _index;
+    out.timestamp = _prevTimestamp;
+    out.weight = _prevWeight / 1000.0f;
+    out.configId = _configId;
+    out.configVersion = _configVersion;
+    _index++;
+    return true;
+  }
+
+private:
+  HistoryBlockHeader _header;
+  const uint8_t* _timestamp;
+  const uint8_t* _timestampEnd;
+  const uint8_t* _weight;
+  const uint8_t* _weightEnd;
+  const uint8_t* _config;
+  const uint8_t* _configEnd;
+  uint32_t _index;
+  uint32_t _prevTimestamp;
+  uint32_t _prevDelta;
+  int32_t _prevWeight;
+  uint32_t _runLeft;
+  uint16_t _configId;
+  uint16_t _configVersion;
+};
+
+// Holds the store mutex for one public call. Before begin() there is no mutex
+// and nothing else running, so the guard does nothing.
+class StoreLock
+{
+public:
+  explicit StoreLock(SemaphoreHandle_t mutex) : _mutex(mutex) {
+    if (_mutex != nullptr) xSemaphoreTake(_mutex, portMAX_DELAY);
+  }
+  ~StoreLock() {
+    if (_mutex != nullptr) xSemaphoreGive(_mutex);
+  }
+
+private:
+  SemaphoreHandle_t _mutex;
+};
+
+// --- MeasurementStore ---
+
+MeasurementStore::MeasurementStore()
+  : _blockCount(0), _oldestSlot(0), _nextSequence(0), _cachedSlot(NO_CACHED_SLOT), _fixupCount(0), _mutex(nullptr) {
+  for (size_t i = 0; i < MEASUREMENT_STORE_BLOCKS; i++) {
+    _slotFirstSequence[i] = SLOT_EMPTY;
+  }
+  resetOpenBlock(0);
+}
+
+void MeasurementStore::begin() {
+  if (_mutex == nullptr) {
+    _mutex = xSemaphoreCreateMutex();
+  }
+  if (SPIFFS.exists(LEGACY_STORE_FILE)) {
+    SPIFFS.remove(LEGACY_STORE_FILE);
+    LOG_INFO("Removed legacy uncompressed measurement store.");
+  }
+
+  for (size_t i = 0; i < MEASUREMENT_STORE_BLOCKS; i++) {
+    _slotFirstSequence[i] = SLOT_EMPTY;
+  }
+  _blockCount = 0;
+  _oldestSlot = 0;
+  _nextSequence = 0;
+  _cachedSlot = NO_CACHED_SLOT;
+
+  // Rebuild the block index from the slot headers
+  unsigned long scanStart = millis();
+  if (SPIFFS.exists(MEASUREMENT_STORE_FILE)) {
+    File file = SPIFFS.open(MEASUREMENT_STORE_FILE, "r");
+    if (file) {
+      size_t slots = file.size() / HISTORY_BLOCK_BYTES;
+      if (slots > MEASUREMENT_STORE_BLOCKS) slots = MEASUREMENT_STORE_BLOCKS;
+
+      int newestSlot = -1;
+      HistoryBlockHeader header;
+      HistoryBlockHeader newest = {};
+      for (size_t slot = 0; slot < slots; slot++) {
+        if (!readHeader(file, slot, header) || header.magic != HISTORY_BLOCK_MAGIC) continue;
+        _slotFirstSequence[slot] = header.firstSequence;
+        if (newestSlot < 0 || header.firstSequence > newest.firstSequence) {
+          newestSlot = slot;
+          newest = header;
+        }
+      }
+      file.close();
+
+      if (newestSlot >= 0) {
+        // Oldest block is the first valid slot after the newest one (wrapping)
+        for (size_t k = 1; k <= MEASUREMENT_STORE_BLOCKS; k++) {
+          size_t slot = (newestSlot + k) % MEASUREMENT_STORE_BLOCKS;
+          if (_slotFirstSequence[slot] != SLOT_EMPTY) {
+            _oldestSlot = slot;
+            break;
+          }
+        }
+        _blockCount = (newestSlot - _oldestSlot + MEASUREMENT_STORE_BLOCKS) % MEASUREMENT_STORE_BLOCKS + 1;
+        _nextSequence = newest.firstSequence + newest.count;
+      }
+    }
+  }
+  resetOpenBlock(_nextSequence);
+
+  // Replay shots that were recorded after the last sealed block
+  size_t replayed = 0;
+  if (SPIFFS.exists(MEASUREMENT_JOURNAL_FILE)) {
+    File journal = SPIFFS.open(MEASUREMENT_JOURNAL_FILE, "r");
+    if (journal) {
+      StoredMeasurement record;
+      while (journal.read((uint8_t*)&record, sizeof(record)) == sizeof(record)) {
+        if (record.sequence != _nextSequence) continue; // Already sealed into a block
+        appendToOpenBlock(record);
+        _nextSequence++;
+        replayed++;
+      }
+      journal.close();
+    }
+  }
+
+  loadFixups();
+
+  LOG_INFO("Measurement store loaded in %lu ms: %d blocks (%d bytes), %d journaled shots, %d time fixups, next sequence %lu.",
+                millis() - scanStart, (int)_blockCount, (int)bytesUsed(), (int)replayed, (int)_fixupCount, (unsigned long)_nextSequence);
+}
+
+uint32_t MeasurementStore::append(time_t timestamp, float weight, uint16_t configId, uint16_t configVersion) {
+  StoreLock lock(_mutex);
+  StoredMeasurement record;
+  record.sequence = _nextSequence;
+  record.timestamp = (uint32_t)timestamp;
+  record.weight = weight;
+  record.configId = configId;
+  record.configVersion = configVersion;
+
+  // Seal first so the journal only ever holds shots of the current open block
+  if (openBlockFull()) {
+    sealOpenBlock();
+    if (openBlockFull()) {
+      // Flash write keeps failing; never let the open block overflow its buffers
+      LOG_WARN("Measurement store full or failing, discarding open block");
+      SPIFFS.remove(MEASUREMENT_JOURNAL_FILE);
+      resetOpenBlock(_nextSequence);
+    }
+  }
+
+  File journal = SPIFFS.open(MEASUREMENT_JOURNAL_FILE, "a");
+  if (journal) {
+    journal.write((const uint8_t*)&record, sizeof(record));
+    journal.close();
+  } else {
+    LOG_ERROR("Failed to open measurement journal for writing");
+  }
+
+  appendToOpenBlock(record);
+  _nextSequence++;
+  return record.sequence;
+}
+
+size_t MeasurementStore::read(uint32_t first, StoredMeasurement* out, size_t maxCount) {
+  StoreLock lock(_mutex);
+  if (first < oldestSequence()) {
+    first = oldestSequence();
+  }
+
+  size_t count = 0;
+  while (count < maxCount && first < _nextSequence) {
+    bool loaded;
+    if (first >= _open.firstSequence) {
+      loaded = loadOpenBlock();
+    } else {
+      int slot = findSlot(first);
+      loaded = slot >= 0 && loadSlot(slot);
+    }
+    if (!loaded) break;
+
+    HistoryBlockDecoder decoder(_blockImage);
+    StoredMeasurement record;
+    size_t before = count;
+    while (count < maxCount && decoder.next(record)) {
+      if (record.sequence < first) continue; // Skip to the requested position
+      applyFixups(record);
+      out[count++] = record;
+    }
+    if (count == before) break; // Nothing usable in this block
+    first = out[count - 1].sequence + 1;
+  }
+  return count;
+}
+
+void MeasurementStore::aggregate(uint32_t fromTime, uint32_t toTime, HistoryAggregate& out) {
+  StoreLock lock(_mutex);
+  out.count = 0;
+  out.sumWeight = 0;
+  out.minWeight = INT32_MAX;
+  out.maxWeight = INT32_MIN;
+  out.blocksFromHeader = 0;
+  out.blocksDecoded = 0;
+  out.blocksSkipped = 0;
+
+  // Visits one block: header only when possible, full decode when it straddles the range.
+  // Header timestamps of blocks with back-dated shots are stale, so those are always decoded.
+  auto visit = [&](const HistoryBlockHeader& header, int slot) {
+    bool fixed = header.count > 0 && TimeSync::provisional(header.minTimestamp) &&
+                 hasFixup(header.firstSequence, header.firstSequence + header.count);
+    if (header.count == 0 || (!fixed && (header.maxTimestamp < fromTime || header.minTimestamp > toTime))) {
+      out.blocksSkipped++;
+      return;
+    }
+    if (!fixed && header.minTimestamp >= fromTime && header.maxTimestamp <= toTime) {
+      out.count += header.count;
+      out.sumWeight += header.sumWeight;
+      if (header.minWeight < out.minWeight) out.minWeight = header.minWeight;
+      if (header.maxWeight > out.maxWeight) out.maxWeight = header.maxWeight;
+      out.blocksFromHeader++;
+      return;
+    }
+    bool loaded = (slot == OPEN_BLOCK_SLOT) ? loadOpenBlock() : loadSlot(slot);
+    if (!loaded) return;
+    out.blocksDecoded++;
+    HistoryBlockDecoder decoder(_blockImage);
+    StoredMeasurement record;
+    while (decoder.next(record)) {
+      applyFixups(record);
+      if (record.timestamp < fromTime || record.timestamp > toTime) continue;
+      int32_t weight = quantizeWeight(record.weight);
+      out.count++;
+      out.sumWeight += weight;
+      if (weight < out.minWeight) out.minWeight = weight;
+      if (weight > out.maxWeight) out.maxWeight = weight;
+    }
+  };
+
+  if (_blockCount > 0) {
+    File file = SPIFFS.open(MEASUREMENT_STORE_FILE, "r");
+    if (file) {
+      HistoryBlockHeader header;
+      for (size_t i = 0; i < _blockCount; i++) {
+        size_t slot = slotAt(i);
+        if (readHeader(file, slot, header)) {
+          visit(header, slot);
+        }
+      }
+      file.close();
+    }
+  }
+  visit(_open, OPEN_BLOCK_SLOT);
+
+  if (out.count == 0) {
+    out.minWeight = 0;
+    out.maxWeight = 0;
+  }
+}
+
+bool MeasurementStore::fixTimestamps(uint32_t first, uint32_t end, uint32_t offset) {
+  StoreLock lock(_mutex);
+  if (first >= end) {
+    return true;
+  }
+  if (_fixupCount == MEASUREMENT_STORE_MAX_FIXUPS) {
+    // Oldest range is the first to be overwritten anyway
+    memmove(_fixups, _fixups + 1, (MEASUREMENT_STORE_MAX_FIXUPS - 1) * sizeof(TimestampFixup));
+    _fixupCount--;
+    LOG_WARN("Measurement store: fixup table full, dropped the oldest range");
+  }
+  _fixups[_fixupCount].firstSequence = first;
+  _fixups[_fixupCount].endSequence = end;
+  _fixups[_fixupCount].offset = offset;
+  _fixupCount++;
+  _cachedSlot = NO_CACHED_SLOT;
+  LOG_INFO("Measurement store: shots %lu..%lu back-dated by %lu s", (unsigned long)first,
+                (unsigned long)(end - 1), (unsigned long)offset);
+  return saveFixups();
+}
+
+void MeasurementStore::loadFixups() {
+  _fixupCount = 0;
+  if (!SPIFFS.exists(MEASUREMENT_FIXUP_FILE)) {
+    return;
+  }
+  File file = SPIFFS.open(MEASUREMENT_FIXUP_FILE, "r");
+  if (!file) {
+    return;
+  }
+  TimestampFixup fixup;
+  size_t dropped = 0;
+  while (_fixupCount < MEASUREMENT_STORE_MAX_FIXUPS &&
+         file.read((uint8_t*)&fixup, sizeof(fixup)) == sizeof(fixup)) {
+    if (fixup.endSequence <= oldestSequence()) {
+      dropped++; // Its shots have been overwritten
+      continue;
+    }
+    _fixups[_fixupCount++] = fixup;
+  }
+  file.close();
+  if (dropped > 0) {
+    saveFixups();
+  }
+}
+
+bool MeasurementStore::saveFixups() {
+  if (_fixupCount == 0) {
+    if (SPIFFS.exists(MEASUREMENT_FIXUP_FILE)) {
+      SPIFFS.remove(MEASUREMENT_FIXUP_FILE);
+    }
+    return true;
+  }
+  File file = SPIFFS.open(MEASUREMENT_FIXUP_FILE, "w");
+  if (!file) {
+    LOG_ERROR("Failed to open measurement fixup table for writing");
+    return false;
+  }
+  size_t bytes = _fixupCount * sizeof(TimestampFixup);
+  bool ok = file.write((const uint8_t*)_fixups, bytes) == bytes;
+  file.close();
+  return ok;
+}
+
+void MeasurementStore::applyFixups(StoredMeasurement& record) const {
+  if (!TimeSync::provisional(record.timestamp)) {
+    return;
+  }
+  for (size_t i = 0; i < _fixupCount; i++) {
+    if (record.sequence >= _fixups[i].firstSequence && record.sequence < _fixups[i].endSequence) {
+      record.timestamp += _fixups[i].offset;
+      return;
+    }
+  }
+}
+
+bool MeasurementStore::hasFixup(uint32_t first, uint32_t end) const {
+  for (size_t i = 0; i < _fixupCount; i++) {
+    if (_fixups[i].firstSequence < end && first < _fixups[i].endSequence) {
+      return true;
+    }
+  }
+  return false;
+}
+
+uint32_t MeasurementStore::oldestSequence() const {
+  return (_blockCount > 0) ? _slotFirstSequence[_oldestSlot] : _open.firstSequence;
+}
+
+bool MeasurementStore::openBlockFull() const {
+  if (_open.count == 0) {
+    return false;
+  }
+  size_t used = sizeof(HistoryBlockHeader) + _open.timestampBytes + _open.weightBytes + _open.configBytes;
+  // Next shot may close the pending run and open a new one
+  return _open.count >= HISTORY_BLOCK_MAX_RECORDS ||
+         used + RECORD_MAX_BYTES + 2 * RUN_MAX_BYTES > HISTORY_BLOCK_BYTES;
+}
+
+void MeasurementStore::resetOpenBlock(uint32_t firstSequence) {
+  memset(&_open, 0, sizeof(_open));
+  _open.magic = HISTORY_BLOCK_MAGIC;
+  _open.firstSequence = firstSequence;
+  _prevTimestamp = 0;
+  _prevTimestampDelta = 0;
+  _prevWeight = 0;
+  _runConfigId = 0;
+  _runConfigVersion = 0;
+  _runLength = 0;
+  if (_cachedSlot == OPEN_BLOCK_SLOT) {
+    _cachedSlot = NO_CACHED_SLOT;
+  }
+}
+
+void MeasurementStore::appendToOpenBlock(const StoredMeasurement& record) {
+  int32_t weight = quantizeWeight(record.weight);
+
+  if (_open.count == 0) {
+    _open.firstTimestamp = record.timestamp;
+    _open.minTimestamp = record.timestamp;
+    _open.maxTimestamp = record.timestamp;
+    _open.minWeight = weight;
+    _open.maxWeight = weight;
+  } else {
+    uint32_t delta = record.timestamp - _prevTimestamp;
+    uint32_t deltaOfDelta = delta - (uint32_t)_prevTimestampDelta;
+    _open.timestampBytes += putVarint(_timestampColumn + _open.timestampBytes, zigzagEncode((int32_t)deltaOfDelta));
+    _prevTimestampDelta = (int32_t)delta;
+    if (record.timestamp < _open.minTimestamp) _open.minTimestamp = record.timestamp;
+    if (record.timestamp > _open.maxTimestamp) _open.maxTimestamp = record.timestamp;
+    if (weight < _open.minWeight) _open.minWeight = weight;
+    if (weight > _open.maxWeight) _open.maxWeight = weight;
+  }
+  _prevTimestamp = record.timestamp;
+
+  _open.weightBytes += putVarint(_weightColumn + _open.weightBytes, zigzagEncode(weight - _prevWeight));
+  _prevWeight = weight;
+
+  if (_runLength > 0 && record.configId == _runConfigId && record.configVersion == _runConfigVersion) {
+    _runLength++;
+  } else {
+    if (_runLength > 0) {
+      _open.configBytes += putVarint(_configColumn + _open.configBytes, _runLength);
+      _open.configBytes += putVarint(_configColumn + _open.configBytes, _runConfigId);
+      _open.configBytes += putVarint(_configColumn + _open.configBytes, _runConfigVersion);
+    }
+    _runConfigId = record.configId;
+    _runConfigVersion = record.configVersion;
+    _runLength = 1;
+  }
+
+  _open.sumWeight += weight;
+  _open.count++;
+
+  if (_cachedSlot == OPEN_BLOCK_SLOT) {
+    _cachedSlot = NO_CACHED_SLOT;
+  }
+}
+
+size_t MeasurementStore::serializeOpenBlock(uint8_t* image) {
+  HistoryBlockHeader header = _open;
+  uint8_t* cursor = image + sizeof(HistoryBlockHeader);
+
+  memcpy(cursor, _timestampColumn, header.timestampBytes);
+  cursor += header.timestampBytes;
+  memcpy(cursor, _weightColumn, header.weightBytes);
+  cursor += header.weightBytes;
+  memcpy(cursor, _configColumn, header.configBytes);
+  cursor += header.configBytes;
+
+  // Close the pending run in the image only; the open block keeps extending it
+  if (_runLength > 0) {
+    size_t runBytes = putVarint(cursor, _runLength);
+    runBytes += putVarint(cursor + runBytes, _runConfigId);
+    runBytes += putVarint(cursor + runBytes, _runConfigVersion);
+    cursor += runBytes;
+    header.configBytes += runBytes;
+  }
+
+  memcpy(image, &header, sizeof(header));
+  size_t used = cursor - image;
+  memset(cursor, 0xFF, HISTORY_BLOCK_BYTES - used);
+  return used;
+}
+
+void MeasurementStore::sealOpenBlock() {
+  if (_open.count == 0) {
+    return;
+  }
+
+  size_t used = serializeOpenBlock(_blockImage);
+  _cachedSlot = NO_CACHED_SLOT;
+
+  size_t slot = (_oldestSlot + _blockCount) % MEASUREMENT_STORE_BLOCKS;
+  bool overwritesOldest = (_blockCount == MEASUREMENT_STORE_BLOCKS);
+
+  File file = SPIFFS.exists(MEASUREMENT_STORE_FILE) ? SPIFFS.open(MEASUREMENT_STORE_FILE, "r+")
+                                                    : SPIFFS.open(MEASUREMENT_STORE_FILE, "w");
+  if (!file) {
+    LOG_ERROR("Failed to open measurement store for writing, keeping block open");
+    return;
+  }
+
+  // Two-phase write: block body with a zero magic, then the magic itself
+  uint32_t magic = HISTORY_BLOCK_MAGIC;
+  uint32_t noMagic = 0;
+  memcpy(_blockImage, &noMagic, sizeof(noMagic));
+  file.seek(slot * HISTORY_BLOCK_BYTES);
+  bool ok = file.write(_blockImage, HISTORY_BLOCK_BYTES) == HISTORY_BLOCK_BYTES;
+  if (ok) {
+    file.flush();
+    file.seek(slot * HISTORY_BLOCK_BYTES);
+    ok = file.write((const uint8_t*)&magic, sizeof(magic)) == sizeof(magic);
+  }
+  file.close();
+  if (!ok) {
+    LOG_ERROR("Failed to write measurement block, keeping block open");
+    return;
+  }
+
+  if (overwritesOldest) {
+    _oldestSlot = (_oldestSlot + 1) % MEASUREMENT_STORE_BLOCKS;
+  } else {
+    _blockCount++;
+  }
+  _slotFirstSequence[slot] = _open.firstSequence;
+  LOG_DEBUG("Sealed measurement block %d: %d shots in %d bytes.", (int)slot, (int)_open.count, (int)used);
+
+  SPIFFS.remove(MEASUREMENT_JOURNAL_FILE);
+  resetOpenBlock(_nextSequence);
+}
+
+bool MeasurementStore::loadOpenBlock() {
+  if (_cachedSlot != OPEN_BLOCK_SLOT) {
+    serializeOpenBlock(_blockImage);
+    _cachedSlot = OPEN_BLOCK_SLOT;
+  }
+  return true;
+}
+
+bool MeasurementStore::loadSlot(size_t slot) {
+  if (_cachedSlot == (int)slot) {
+    return true;
+  }
+  File file = SPIFFS.open(MEASUREMENT_STORE_FILE, "r");
+  if (!file) {
+    return false;
+  }
+  bool ok = file.seek(slot * HISTORY_BLOCK_BYTES) &&
+            file.read(_blockImage, HISTORY_BLOCK_BYTES) == HISTORY_BLOCK_BYTES;
+  file.close();
+  _cachedSlot = ok ? (int)slot : NO_CACHED_SLOT;
+  return ok;
+}
+
+int MeasurementStore::findSlot(uint32_t sequence) const {
+  if (_blockCount == 0 || sequence < _slotFirstSequence[_oldestSlot]) {
+    return -1;
+  }
+  // Binary search for the newest block whose first sequence is <= sequence
+  size_t lo = 0;
+  size_t hi = _blockCount - 1;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo + 1) / 2;
+    if (_slotFirstSequence[slotAt(mid)] <= sequence) {
+      lo = mid;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  return slotAt(lo);
+}
+
+size_t MeasurementStore::slotAt(size_t logicalIndex) const {
+  return (_oldestSlot + logicalIndex) % MEASUREMENT_STORE_BLOCKS;
+}
+
+bool MeasurementStore::readHeader(fs::File& file, size_t slot, HistoryBlockHeader& header) {
+  if (!file.seek(slot * HISTORY_BLOCK_BYTES)) {
+    return false;
+  }
+  return file.read((uint8_t*)&header, sizeof(header)) == sizeof(header);
+}
@@ -0,0 +1,183 @@
+#ifndef MEASUREMENT_STORE_H
+#define MEASUREMENT_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+#include <FS.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+// ========================================
+// PERSISTENT MEASUREMENT STORE
+// ========================================
+// Every recorded shot gets a monotonically increasing sequence number and is
+// written to SPIFFS. Session logs reference their shots as a
+// {first sequence, count} range, so any past session can be exported by
+// seeking straight to its records instead of rescanning RAM by timestamp.
+//
+// On flash the history is kept as a ring of fixed-size, block-compressed
+// columnar blocks (see measurement_store.cpp for the encoding). The block that
+// is still filling up lives in RAM and is protected by a small journal of raw
+// records until it is sealed.
+//
+// The persistence task appends while the network task reads, so append(),
+// read(), aggregate() and fixTimestamps() each hold an internal mutex. Callers
+// that also hold the state lock must take that one first.
+
+// Decoded record as handed to callers
+struct StoredMeasurement {
+  uint32_t sequence;
+  uint32_t timestamp;
+  float weight;           // Quantized to 0.001 gr on flash
+  uint16_t configId;      // CONFIG_ID_NONE if no config was active
+  uint16_t configVersion;
+};
+
+// Offset added to the provisional timestamps of a range of shots that were
+// stamped before the clock was synced. Applied when records are read, so sealed
+// blocks never have to be rewritten.
+struct TimestampFixup {
+  uint32_t firstSequence;
+  uint32_t endSequence; // Exclusive
+  uint32_t offset;      // Wall time at the boot the shots were taken in
+};
+
+// Fixups kept at a time; one is added per boot that recorded shots before sync
+#define MEASUREMENT_STORE_MAX_FIXUPS 16
+
+// Size of one block slot on flash. Also bounds the RAM used by the open block.
+#ifndef HISTORY_BLOCK_BYTES
+  #define HISTORY_BLOCK_BYTES 1024
+#endif
+
+// Number of block slots. 512 x 1 KB = 512 KB of the 0xF0000 SPIFFS partition,
+// which holds roughly 100k+ shots at ~3-5 bytes per shot.
+#ifndef MEASUREMENT_STORE_BLOCKS
+  #define MEASUREMENT_STORE_BLOCKS 512
+#endif
+
+// Upper bound on shots per block, even if they would still fit
+#define HISTORY_BLOCK_MAX_RECORDS 512
+
+// Block header, stored uncompressed at the start of every slot. The min/max/sum
+// fields allow aggregate queries over whole blocks without decoding them.
+struct HistoryBlockHeader {
+  uint32_t magic;
+  uint32_t firstSequence;
+  uint32_t firstTimestamp; // Seed for the timestamp column
+  uint32_t minTimestamp;
+  uint32_t maxTimestamp;
+  int32_t minWeight;      // Milligrains (0.001 gr)
+  int32_t maxWeight;      // Milligrains
+  int64_t sumWeight;      // Milligrains
+  uint16_t count;
+  uint16_t timestampBytes; // Length of the delta-of-delta timestamp column
+  uint16_t weightBytes;    // Length of the delta/zigzag weight column
+  uint16_t configBytes;    // Length of the run-length config column
+};
+
+// Result of an aggregate query over a time range
+struct HistoryAggregate {
+  uint32_t count;
+  int64_t sumWeight;  // Milligrains
+  int32_t minWeight;  // Milligrains
+  int32_t maxWeight;  // Milligrains
+  uint16_t blocksFromHeader; // Blocks answered from their header alone
+  uint16_t blocksDecoded;    // Blocks that straddled the range and had to be decoded
+  uint16_t blocksSkipped;    // Blocks outside the range
+};
+
+/**
+ * @brief Ring of compressed history blocks on SPIFFS plus an open block in RAM.
+ */
+class MeasurementStore
+{
+public:
+  MeasurementStore();
+
+  /**
+   * @brief Rebuilds the block index and replays the journal. Call after SPIFFS is mounted.
+   */
+  void begin();
+
+  /**
+   * @brief Appends one measurement.
+   * @return The sequence number assigned to it.
+   */
+  uint32_t append(time_t timestamp, float weight, uint16_t configId, uint16_t configVersion);
+
+  /**
+   * @brief Reads up to maxCount records starting at sequence first.
+   *        Sequences that have been overwritten are skipped.
+   * @return Number of records written to out.
+   */
+  size_t read(uint32_t first, StoredMeasurement* out, size_t maxCount);
+
+  /**
+   * @brief Aggregates all shots with fromTime <= timestamp <= toTime.
+   *        Blocks entirely inside the range are answered from their header,
+   *        blocks entirely outside are skipped without reading their data.
+   */
+  void aggregate(uint32_t fromTime, uint32_t toTime, HistoryAggregate& out);
+
+  /**
+   * @brief Back-dates shots first <= sequence < end that carry a provisional
+   *        (seconds since boot) timestamp by adding offset to it. Persisted.
+   * @return False if the fixup could not be saved.
+   */
+  bool fixTimestamps(uint32_t first, uint32_t end, uint32_t offset);
+
+  uint32_t nextSequence() const { return _nextSequence; }
+  uint32_t oldestSequence() const;
+  size_t size() const { return _nextSequence - oldestSequence(); }
+  size_t blockCount() const { return _blockCount; }
+  size_t bytesUsed() const { return _blockCount * HISTORY_BLOCK_BYTES; }
+
+private:
+  bool openBlockFull() const;
+  void appendToOpenBlock(const StoredMeasurement& record);
+  void resetOpenBlock(uint32_t firstSequence);
+  size_t serializeOpenBlock(uint8_t* image);
+  void sealOpenBlock();
+  bool loadOpenBlock();
+  bool loadSlot(size_t slot);
+  int findSlot(uint32_t sequence) const;
+  size_t slotAt(size_t logicalIndex) const;
+  bool readHeader(fs::File& file, size_t slot, HistoryBlockHeader& header);
+  void loadFixups();
+  bool saveFixups();
+  void applyFixups(StoredMeasurement& record) const;
+  bool hasFixup(uint32_t first, uint32_t end) const;
+
+  // Block index: first sequence of every slot, UINT32_MAX if the slot is empty
+  uint32_t _slotFirstSequence[MEASUREMENT_STORE_BLOCKS];
+  size_t _blockCount;  // Sealed blocks on flash
+  size_t _oldestSlot;  // Slot of the oldest sealed block
+  uint32_t _nextSequence;
+
+  // Open block, encoded incrementally column by column
+  HistoryBlockHeader _open;
+  uint8_t _timestampColumn[HISTORY_BLOCK_BYTES];
+  uint8_t _weightColumn[HISTORY_BLOCK_BYTES];
+  uint8_t _configColumn[HISTORY_BLOCK_BYTES];
+  uint32_t _prevTimestamp;
+  int32_t _prevTimestampDelta;
+  int32_t _prevWeight;
+  uint16_t _runConfigId;
+  uint16_t _runConfigVersion;
+  uint32_t _runLength;
+
+  // Read cache holding one decoded-from slot image (or the serialized open block)
+  uint8_t _blockImage[HISTORY_BLOCK_BYTES];
+  int _cachedSlot;
+
+  TimestampFixup _fixups[MEASUREMENT_STORE_MAX_FIXUPS];
+  size_t _fixupCount;
+
+  SemaphoreHandle_t _mutex; // Created in begin()
+};
+
+extern MeasurementStore measurementStore;
+
+#endif // MEASUREMENT_STORE_H
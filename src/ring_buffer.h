@@ -0,0 +1,97 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <stddef.h>
+
+// ========================================
+// FIXED-CAPACITY RING BUFFER
+// ========================================
+// Statically sized circular buffer used for measurement history and session logs.
+// push() and clear() are O(1): when the buffer is full the oldest entry is
+// overwritten instead of shifting the whole array down by one.
+// Logical index 0 is always the oldest element, size() - 1 the newest.
+
+template <typename T, size_t Capacity>
+class RingBuffer
+{
+  static_assert(Capacity > 0, "RingBuffer capacity must be greater than zero");
+
+public:
+  // Forward iterator over the logical (oldest -> newest) order
+  template <typename Buffer, typename Ref>
+  class Iterator
+  {
+  public:
+    Iterator(Buffer* buffer, size_t index) : _buffer(buffer), _index(index) {}
+    Ref operator*() const { return (*_buffer)[_index]; }
+    Iterator& operator++() { _index++; return *this; }
+    bool operator!=(const Iterator& other) const { return _index != other._index || _buffer != other._buffer; }
+    bool operator==(const Iterator& other) const { return !(*this != other); }
+
+  private:
+    Buffer* _buffer;
+    size_t _index;
+  };
+
+  typedef Iterator<RingBuffer, T&> iterator;
+  typedef Iterator<const RingBuffer, const T&> const_iterator;
+
+  RingBuffer() : _head(0), _count(0) {}
+
+  /**
+   * @brief Appends an element, overwriting the oldest one when full.
+   * @return Reference to the stored element.
+   */
+  T& push(const T& item) {
+    size_t slot = (_head + _count) % Capacity;
+    if (_count < Capacity) {
+      _count++;
+    } else {
+      _head = (_head + 1) % Capacity; // Drop the oldest entry
+    }
+    _items[slot] = item;
+    return _items[slot];
+  }
+
+  /**
+   * @brief Removes the oldest element. The buffer must not be empty.
+   */
+  void pop() {
+    _head = (_head + 1) % Capacity;
+    _count--;
+  }
+
+  /**
+   * @brief Forgets all elements. Storage is not touched, only the indices are reset.
+   */
+  void clear() {
+    _head = 0;
+    _count = 0;
+  }
+
+  size_t size() const { return _count; }
+  bool empty() const { return _count == 0; }
+  bool full() const { return _count == Capacity; }
+  static constexpr size_t capacity() { return Capacity; }
+
+  // Logical access: 0 = oldest, size() - 1 = newest. No bounds checking.
+  T& operator[](size_t index) { return _items[(_head + index) % Capacity]; }
+  const T& operator[](size_t index) const { return _items[(_head + index) % Capacity]; }
+
+  T& front() { return (*this)[0]; }
+  const T& front() const { return (*this)[0]; }
+  T& back() { return (*this)[_count - 1]; }
+  const T& back() const { return (*this)[_count - 1]; }
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, _count); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, _count); }
+
+private:
+  T _items[Capacity];
+  size_t _head;  // Physical index of the oldest element
+  size_t _count; // Number of valid elements
+};
+
+#endif // RING_BUFFER_H
@@ -0,0 +1,102 @@
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include "rle_image.h"
+#include "logger.h"
+
+namespace {
+
+// Expands an RLE stream a number of pixels at a time
+class RleReader
+{
+public:
+  explicit RleReader(const RleImage& image)
+    : _data(image.data), _end(image.data + image.words), _remaining(0), _run(false), _color(0) {}
+
+  // Returns false if the stream ends before count pixels
+  bool read(uint16_t* out, uint32_t count) {
+    while (count > 0) {
+      if (_remaining == 0) {
+        if (_data >= _end) {
+          return false;
+        }
+        uint16_t control = *_data++;
+        _run = control & RLE_IMAGE_RUN;
+        _remaining = control & ~RLE_IMAGE_RUN;
+        if (_run) {
+          if (_data >= _end) {
+            return false;
+          }
+          _color = *_data++;
+        } else if (_data + _remaining > _end) {
+          return false;
+        }
+      }
+      uint32_t n = min(count, _remaining);
+      if (_run) {
+        for (uint32_t i = 0; i < n; i++) {
+          out[i] = _color;
+        }
+      } else {
+        memcpy(out, _data, n * sizeof(uint16_t));
+        _data += n;
+      }
+      out += n;
+      count -= n;
+      _remaining -= n;
+    }
+    return true;
+  }
+
+private:
+  const uint16_t* _data;
+  const uint16_t* _end;
+  uint32_t _remaining;
+  bool _run;
+  uint16_t _color;
+};
+
+} // namespace
+
+bool drawRleImage(lgfx::LGFX_Device& panel, const RleImage& image, int32_t x, int32_t y) {
+  RleReader reader(image);
+  uint32_t bandPixels = (uint32_t)image.width * RLE_IMAGE_BAND_ROWS;
+  uint16_t* bands[2];
+  bands[0] = (uint16_t*)heap_caps_malloc(bandPixels * sizeof(uint16_t), MALLOC_CAP_DMA);
+  bands[1] = (uint16_t*)heap_caps_malloc(bandPixels * sizeof(uint16_t), MALLOC_CAP_DMA);
+  bool ok = true;
+
+  panel.startWrite();
+  if (bands[0] != nullptr && bands[1] != nullptr) {
+    // Expand the next band while the previous one is on the wire
+    int current = 0;
+    for (int32_t row = 0; row < image.height && ok; row += RLE_IMAGE_BAND_ROWS) {
+      int32_t rows = min((int32_t)RLE_IMAGE_BAND_ROWS, image.height - row);
+      ok = reader.read(bands[current], rows * image.width);
+      panel.waitDMA(); // The band expanded last time round is free again once this returns
+      if (ok) {
+        panel.pushImageDMA(x, y + row, image.width, rows, (const lgfx::swap565_t*)bands[current]);
+      }
+      current ^= 1;
+    }
+    panel.waitDMA();
+  } else {
+    // No DMA memory: expand and send one row at a time
+    LOG_WARN("RLE image: no DMA buffers, drawing row by row.");
+    uint16_t* line = (uint16_t*)malloc(image.width * sizeof(uint16_t));
+    for (int32_t row = 0; line != nullptr && row < image.height && ok; row++) {
+      ok = reader.read(line, image.width);
+      if (ok) {
+        panel.pushImage(x, y + row, image.width, 1, (const lgfx::swap565_t*)line);
+      }
+    }
+    free(line);
+  }
+  panel.endWrite();
+
+  free(bands[0]);
+  free(bands[1]);
+  if (!ok) {
+    LOG_ERROR("RLE image: data ended early, image is corrupt.");
+  }
+  return ok;
+}
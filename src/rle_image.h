@@ -0,0 +1,35 @@
+#ifndef RLE_IMAGE_H
+#define RLE_IMAGE_H
+
+#define LGFX_USE_V1
+#include <LovyanGFX.hpp>
+
+// ========================================
+// RUN-LENGTH ENCODED FLASH IMAGES
+// ========================================
+// Static artwork is converted at build time (scripts/generate_image_assets.py)
+// into RGB565 runs in panel byte order and compiled into flash. Drawing only
+// expands the runs into two small DMA buffers, one filling while the other
+// is sent, so nothing is read from SPIFFS or inflated at boot.
+
+#define RLE_IMAGE_RUN 0x8000 // Control word flag: one colour repeated, else literal colours follow
+
+// Rows expanded per DMA transfer
+#ifndef RLE_IMAGE_BAND_ROWS
+  #define RLE_IMAGE_BAND_ROWS 16
+#endif
+
+struct RleImage {
+  uint16_t width;
+  uint16_t height;
+  const uint16_t* data; // Control words and colours, see RLE_IMAGE_RUN
+  uint32_t words;
+};
+
+/**
+ * @brief Streams an RLE image to the panel at (x, y). Blocks until it has been sent.
+ * @return False if the image data is corrupt.
+ */
+bool drawRleImage(lgfx::LGFX_Device& panel, const RleImage& image, int32_t x, int32_t y);
+
+#endif // RLE_IMAGE_H
@@ -0,0 +1,273 @@
+#include <Arduino.h>
+#include <FS.h>
+#include <SPIFFS.h>
+#include "rollups.h"
+#include "measurement_store.h"
+#include "time_sync.h"
+#include "logger.h"
+
+#define ROLLUPS_FILE "/rollups.bin"
+#define ROLLUPS_MAGIC 0x31525350UL // "PSR1"
+#define ROLLUP_SAVE_INTERVAL 25     // Shots between saves; the rest is replayed on boot
+#define SECONDS_PER_DAY 86400UL
+
+RollupStore rollupStore;
+
+struct RollupFileHeader {
+  uint32_t magic;
+  uint32_t throughSequence;
+  uint16_t configCount;
+  uint16_t dayCount;
+};
+
+// --- Rollup ---
+
+void Rollup::add(int32_t weightMg, bool hasTarget, int32_t targetMg) {
+  if (count == 0 || weightMg < min) min = weightMg;
+  if (count == 0 || weightMg > max) max = weightMg;
+  count++;
+  sum += weightMg;
+  sumSquares += (int64_t)weightMg * weightMg;
+
+  if (hasTarget) {
+    int32_t deviation = weightMg - targetMg;
+    if (deviation >= -ROLLUP_IN_BAND_TOLERANCE_MG && deviation <= ROLLUP_IN_BAND_TOLERANCE_MG) {
+      inBandCount++;
+    }
+    int32_t bucket = (deviation + (ROLLUP_HISTOGRAM_BUCKETS / 2) * ROLLUP_BUCKET_WIDTH_MG);
+    bucket = (bucket < 0) ? 0 : bucket / ROLLUP_BUCKET_WIDTH_MG;
+    if (bucket >= ROLLUP_HISTOGRAM_BUCKETS) bucket = ROLLUP_HISTOGRAM_BUCKETS - 1;
+    if (histogram[bucket] < UINT16_MAX) histogram[bucket]++;
+  }
+}
+
+float Rollup::mean() const {
+  return (count > 0) ? (float)((double)sum / count / 1000.0) : 0.0;
+}
+
+float Rollup::standardDeviation() const {
+  if (count <= 1) {
+    return 0.0;
+  }
+  double n = count;
+  double variance = ((double)sumSquares - ((double)sum * (double)sum) / n) / (n - 1);
+  if (variance < 0.0) variance = 0.0; // Rounding guard
+  return (float)(sqrt(variance) / 1000.0);
+}
+
+float Rollup::extremeSpread() const {
+  return (count > 0) ? (max - min) / 1000.0f : 0.0;
+}
+
+float Rollup::inBandPercent() const {
+  return (count > 0) ? 100.0f * inBandCount / count : 0.0;
+}
+
+// --- RollupStore ---
+
+void RollupStore::begin() {
+  _configCount = 0;
+  _days.clear();
+  _throughSequence = 0;
+  _unsavedShots = 0;
+  _saveRequested = false;
+
+  File file = SPIFFS.open(ROLLUPS_FILE, "r");
+  if (file) {
+    RollupFileHeader header;
+    if (file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) && header.magic == ROLLUPS_MAGIC) {
+      _throughSequence = header.throughSequence;
+      for (uint16_t i = 0; i < header.configCount && _configCount < ROLLUP_CONFIGS; i++) {
+        if (file.read((uint8_t*)&_configs[_configCount], sizeof(ConfigRollup)) != sizeof(ConfigRollup)) break;
+        _configCount++;
+      }
+      DayRollup day;
+      for (uint16_t i = 0; i < header.dayCount; i++) {
+        if (file.read((uint8_t*)&day, sizeof(day)) != sizeof(day)) break;
+        _days.push(day);
+      }
+    } else {
+      LOG_WARN("Rollup file invalid, rebuilding from measurement store.");
+    }
+    file.close();
+  }
+
+  // Catch up on shots recorded since the last save (or everything still stored)
+  if (_throughSequence < measurementStore.oldestSequence()) {
+    _throughSequence = measurementStore.oldestSequence();
+  }
+  const size_t REPLAY_BATCH_SIZE = 32;
+  StoredMeasurement batch[REPLAY_BATCH_SIZE];
+  size_t replayed = 0;
+  while (_throughSequence < measurementStore.nextSequence()) {
+    size_t got = measurementStore.read(_throughSequence, batch, REPLAY_BATCH_SIZE);
+    if (got == 0) break;
+    for (size_t i = 0; i < got; i++) {
+      int32_t weightMg = (int32_t)lroundf(batch[i].weight * 1000.0f);
+      apply(batch[i].timestamp, weightMg, configTable.find(batch[i].configId, batch[i].configVersion), batch[i].configId);
+      replayed++;
+    }
+    _throughSequence = batch[got - 1].sequence + 1;
+  }
+
+  LOG_INFO("Rollups loaded: %d configs, %d days, %d shots replayed.", (int)_configCount, (int)_days.size(), (int)replayed);
+  if (replayed > 0) {
+    save();
+  }
+}
+
+void RollupStore::record(uint32_t sequence, uint32_t timestamp, float weight, const PowderConfig* config) {
+  int32_t weightMg = (int32_t)lroundf(weight * 1000.0f);
+  bool hasTarget = (config != nullptr);
+  int32_t targetMg = hasTarget ? (int32_t)lroundf(config->targetGrain * 1000.0f) : 0;
+
+  _session.add(weightMg, hasTarget, targetMg);
+  apply(timestamp, weightMg, config, hasTarget ? config->id : CONFIG_ID_NONE);
+  _throughSequence = sequence + 1;
+  _unsavedShots++;
+}
+
+bool RollupStore::saveDue() const {
+  return _saveRequested || _unsavedShots >= ROLLUP_SAVE_INTERVAL;
+}
+
+size_t RollupStore::backfillDays(uint32_t first, uint32_t end) {
+  // Later shots are still to be replayed in full, which covers their day too
+  if (end > _throughSequence) {
+    end = _throughSequence;
+  }
+  const size_t BACKFILL_BATCH_SIZE = 32;
+  StoredMeasurement batch[BACKFILL_BATCH_SIZE];
+  size_t assigned = 0;
+  while (first < end) {
+    size_t got = measurementStore.read(first, batch, BACKFILL_BATCH_SIZE);
+    if (got == 0) break;
+    for (size_t i = 0; i < got && batch[i].sequence < end; i++) {
+      if (TimeSync::provisional(batch[i].timestamp)) continue; // No fixup covers it
+      const PowderConfig* config = configTable.find(batch[i].configId, batch[i].configVersion);
+      bool hasTarget = (config != nullptr);
+      int32_t targetMg = hasTarget ? (int32_t)lroundf(config->targetGrain * 1000.0f) : 0;
+      applyDay(batch[i].timestamp, (int32_t)lroundf(batch[i].weight * 1000.0f), hasTarget, targetMg);
+      assigned++;
+    }
+    first = batch[got - 1].sequence + 1;
+  }
+  if (assigned > 0) {
+    _saveRequested = true;
+  }
+  return assigned;
+}
+
+void RollupStore::resetSession() {
+  memset(&_session, 0, sizeof(_session));
+}
+
+const Rollup* RollupStore::forConfig(uint16_t configId) const {
+  for (size_t i = 0; i < _configCount; i++) {
+    if (_configs[i].configId == configId) {
+      return &_configs[i].stats;
+    }
+  }
+  return nullptr;
+}
+
+void RollupStore::snapshot(RollupSnapshot& snapshot) {
+  free(snapshot._data);
+  snapshot._length = sizeof(RollupFileHeader) + _configCount * sizeof(ConfigRollup) + _days.size() * sizeof(DayRollup);
+  snapshot._data = (uint8_t*)malloc(snapshot._length);
+  if (snapshot._data == nullptr) {
+    LOG_ERROR("Out of memory for rollup snapshot (%d bytes)", (int)snapshot._length);
+    snapshot._length = 0;
+    return;
+  }
+  RollupFileHeader header;
+  header.magic = ROLLUPS_MAGIC;
+  header.throughSequence = _throughSequence;
+  header.configCount = _configCount;
+  header.dayCount = _days.size();
+  uint8_t* out = snapshot._data;
+  memcpy(out, &header, sizeof(header));
+  out += sizeof(header);
+  memcpy(out, _configs, _configCount * sizeof(ConfigRollup));
+  out += _configCount * sizeof(ConfigRollup);
+  for (const DayRollup& day : _days) {
+    memcpy(out, &day, sizeof(day));
+    out += sizeof(day);
+  }
+  _unsavedShots = 0;
+  _saveRequested = false;
+}
+
+void RollupStore::save() {
+  RollupSnapshot copy;
+  snapshot(copy);
+  copy.write();
+}
+
+void RollupSnapshot::write() const {
+  if (_data == nullptr) {
+    return;
+  }
+  File file = SPIFFS.open(ROLLUPS_FILE, "w");
+  if (!file) {
+    LOG_ERROR("Failed to open rollup file for writing");
+    return;
+  }
+  file.write(_data, _length);
+  file.close();
+}
+
+void RollupStore::apply(uint32_t timestamp, int32_t weightMg, const PowderConfig* config, uint16_t configId) {
+  bool hasTarget = (config != nullptr);
+  int32_t targetMg = hasTarget ? (int32_t)lroundf(config->targetGrain * 1000.0f) : 0;
+
+  // Per config (all versions of a config share one rollup)
+  if (configId != CONFIG_ID_NONE) {
+    ConfigRollup* entry = nullptr;
+    for (size_t i = 0; i < _configCount; i++) {
+      if (_configs[i].configId == configId) {
+        entry = &_configs[i];
+        break;
+      }
+    }
+    if (!entry) {
+      if (_configCount < ROLLUP_CONFIGS) {
+        entry = &_configs[_configCount++];
+      } else {
+        // Evict the least recently used config
+        entry = &_configs[0];
+        for (size_t i = 1; i < _configCount; i++) {
+          if (_configs[i].lastTimestamp < entry->lastTimestamp) entry = &_configs[i];
+        }
+      }
+      memset(entry, 0, sizeof(*entry));
+      entry->configId = configId;
+    }
+    entry->lastTimestamp = timestamp;
+    entry->stats.add(weightMg, hasTarget, targetMg);
+  }
+
+  applyDay(timestamp, weightMg, hasTarget, targetMg);
+}
+
+void RollupStore::applyDay(uint32_t timestamp, int32_t weightMg, bool hasTarget, int32_t targetMg) {
+  // Provisional timestamps are not assigned to a day until they are back-dated
+  if (TimeSync::provisional(timestamp)) {
+    return;
+  }
+  uint32_t day = timestamp / SECONDS_PER_DAY;
+  if (_days.empty() || _days.back().day < day) {
+    DayRollup fresh;
+    memset(&fresh, 0, sizeof(fresh));
+    fresh.day = day;
+    _days.push(fresh); // Drops the oldest day when full
+  }
+  // Shots are recorded in time order, so they almost always land on the newest day.
+  // A back-dated shot whose day is not among the kept ones is left out.
+  for (size_t i = _days.size(); i > 0; i--) {
+    if (_days[i - 1].day == day) {
+      _days[i - 1].stats.add(weightMg, hasTarget, targetMg);
+      break;
+    }
+  }
+}
@@ -0,0 +1,169 @@
+#ifndef ROLLUPS_H
+#define ROLLUPS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "ring_buffer.h"
+#include "config_table.h"
+
+// ========================================
+// INCREMENTAL ROLLUPS
+// ========================================
+// Summary statistics maintained as each shot is recorded, so session lists and
+// long-range reports never have to rescan raw measurements. Weights are kept
+// in milligrains (0.001 gr) as integers so sums stay exact.
+
+#define ROLLUP_HISTOGRAM_BUCKETS 16
+#define ROLLUP_BUCKET_WIDTH_MG 20          // 0.02 gr per bucket, +/-0.16 gr around target
+#define ROLLUP_IN_BAND_TOLERANCE_MG 100    // Same +/-0.10 gr band selectConfig uses for alarms
+
+// Days of per-day rollups kept (UTC days)
+#ifndef ROLLUP_DAYS
+  #define ROLLUP_DAYS 60
+#endif
+
+// Configs tracked; the least recently used one is evicted when full
+#ifndef ROLLUP_CONFIGS
+  #define ROLLUP_CONFIGS 32
+#endif
+
+struct Rollup {
+  uint32_t count;
+  uint32_t inBandCount;        // Shots within +/-ROLLUP_IN_BAND_TOLERANCE_MG of their target
+  int64_t sum;                 // Milligrains
+  int64_t sumSquares;          // Milligrains squared
+  int32_t min;                 // Milligrains
+  int32_t max;                 // Milligrains
+  uint16_t histogram[ROLLUP_HISTOGRAM_BUCKETS]; // Deviation from target, outer buckets are open-ended
+
+  void add(int32_t weightMg, bool hasTarget, int32_t targetMg);
+  float mean() const;              // Grains
+  float standardDeviation() const; // Grains, sample (N-1)
+  float extremeSpread() const;     // Grains
+  float inBandPercent() const;
+};
+
+struct ConfigRollup {
+  uint16_t configId;
+  uint32_t lastTimestamp; // For LRU eviction
+  Rollup stats;
+};
+
+struct DayRollup {
+  uint32_t day; // Days since 1970-01-01 (UTC)
+  Rollup stats;
+};
+
+/**
+ * @brief Copy of the rollup file contents. Taken with the state lock held and
+ *        written to SPIFFS after it is released, so a slow flash write does not
+ *        hold up the engine task.
+ */
+class RollupSnapshot
+{
+public:
+  RollupSnapshot() : _data(nullptr), _length(0) {}
+  ~RollupSnapshot() { free(_data); }
+  RollupSnapshot(const RollupSnapshot&) = delete;
+  RollupSnapshot& operator=(const RollupSnapshot&) = delete;
+
+  bool empty() const { return _data == nullptr; }
+
+  /**
+   * @brief Writes the copy to SPIFFS. Does not need the state lock.
+   */
+  void write() const;
+
+private:
+  friend class RollupStore;
+  uint8_t* _data;
+  size_t _length;
+};
+
+/**
+ * @brief Owns the current-session, per-config and per-day rollups.
+ *
+ * Config and day rollups are persisted to SPIFFS together with the sequence
+ * number of the last shot they include. On boot any shots recorded after that
+ * are replayed from measurementStore, so saving does not have to happen on
+ * every shot.
+ */
+class RollupStore
+{
+public:
+  RollupStore() : _configCount(0), _throughSequence(0), _unsavedShots(0), _saveRequested(false) { resetSession(); }
+
+  /**
+   * @brief Loads persisted rollups and catches up from measurementStore.
+   *        Call after configTable and measurementStore have been started.
+   */
+  void begin();
+
+  /**
+   * @brief Adds one recorded shot to the session, config and day rollups. Does not
+   *        write to flash; the persistence task writes a snapshot() once saveDue().
+   * @param config The active config, or nullptr if none was selected.
+   */
+  void record(uint32_t sequence, uint32_t timestamp, float weight, const PowderConfig* config);
+
+  /**
+   * @brief True once enough shots have been recorded since the last save, or a
+   *        save was requested.
+   */
+  bool saveDue() const;
+
+  /**
+   * @brief Has the next snapshot() happen regardless of the shot count, e.g. at a
+   *        session boundary.
+   */
+  void requestSave() { _saveRequested = true; }
+
+  void resetSession();
+  const Rollup& session() const { return _session; }
+
+  const Rollup* forConfig(uint16_t configId) const;
+  size_t configCount() const { return _configCount; }
+  const ConfigRollup& configAt(size_t index) const { return _configs[index]; }
+
+  size_t dayCount() const { return _days.size(); }
+  const DayRollup& dayAt(size_t index) const { return _days[index]; } // 0 = oldest
+
+  /**
+   * @brief Adds shots first <= sequence < end to the day rollups. For shots that were
+   *        recorded with a provisional timestamp and back-dated once the clock synced;
+   *        their session and config rollups are already up to date. The range must
+   *        hold only such shots, a shot stamped with wall time already has its day.
+   *        Requests a save if any were, it is not written here.
+   * @return Number of shots assigned to a day.
+   */
+  size_t backfillDays(uint32_t first, uint32_t end);
+
+  /**
+   * @brief Copies config and day rollups into snapshot and counts them as saved.
+   *        Leaves the snapshot empty, and the save due, if out of memory.
+   */
+  void snapshot(RollupSnapshot& snapshot);
+
+  /**
+   * @brief Writes config and day rollups to SPIFFS right away. For boot, before
+   *        the tasks that share the rollups are running.
+   */
+  void save();
+
+private:
+  void apply(uint32_t timestamp, int32_t weightMg, const PowderConfig* config, uint16_t configId);
+  void applyDay(uint32_t timestamp, int32_t weightMg, bool hasTarget, int32_t targetMg);
+
+  Rollup _session;
+  ConfigRollup _configs[ROLLUP_CONFIGS];
+  size_t _configCount;
+  RingBuffer<DayRollup, ROLLUP_DAYS> _days;
+  uint32_t _throughSequence; // Next sequence not yet included
+  uint16_t _unsavedShots;
+  bool _saveRequested;
+};
+
+extern RollupStore rollupStore;
+
+#endif // ROLLUPS_H
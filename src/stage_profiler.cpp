@@ -0,0 +1,147 @@
+#include <Arduino.h>
+#include <esp_timer.h>
+#include "stage_profiler.h"
+
+StageProfiler stageProfiler;
+
+StageProfiler::StageProfiler()
+  : _resetPending(0), _enabled(false), _cpuMhz(160), _overheadCycles(0), _windowStartUs(0) {
+  memset(_stages, 0, sizeof(_stages));
+}
+
+void StageProfiler::setEnabled(bool enabled) {
+  if (enabled == _enabled) {
+    return;
+  }
+  if (enabled) {
+    _cpuMhz = getCpuFrequencyMhz();
+    // Cost of one start()/stop() pair, timed on a profile nobody reads
+    const uint32_t ROUNDS = 64;
+    StageProfile scratch;
+    memset(&scratch, 0, sizeof(scratch));
+    uint32_t begin = ESP.getCycleCount();
+    for (uint32_t i = 0; i < ROUNDS; i++) {
+      uint32_t start = ESP.getCycleCount();
+      add(scratch, ESP.getCycleCount() - start);
+    }
+    _overheadCycles = (ESP.getCycleCount() - begin) / ROUNDS;
+    reset();
+  }
+  _enabled = enabled;
+  Serial.printf("Stage profiler %s (%lu cycles per sample at %lu MHz)\n", enabled ? "on" : "off",
+                (unsigned long)_overheadCycles, (unsigned long)_cpuMhz);
+}
+
+void StageProfiler::reset() {
+  __atomic_store_n(&_resetPending, (1UL << PROFILE_STAGE_COUNT) - 1, __ATOMIC_RELAXED);
+  _windowStartUs = esp_timer_get_time();
+}
+
+void StageProfiler::record(ProfileStage stage, uint32_t cycles) {
+  if (stage >= PROFILE_STAGE_COUNT) {
+    return;
+  }
+  uint32_t bit = 1UL << stage;
+  if (__atomic_load_n(&_resetPending, __ATOMIC_RELAXED) & bit) {
+    memset(&_stages[stage], 0, sizeof(StageProfile));
+    __atomic_fetch_and(&_resetPending, ~bit, __ATOMIC_RELAXED);
+  }
+  add(_stages[stage], cycles);
+}
+
+void StageProfiler::add(StageProfile& profile, uint32_t cycles) {
+  profile.count++;
+  profile.totalCycles += cycles;
+  if (cycles > profile.maxCycles) {
+    profile.maxCycles = cycles;
+  }
+  uint32_t bucket = 31 - __builtin_clz(cycles | 1);
+  if (bucket >= PROFILE_BUCKETS) {
+    bucket = PROFILE_BUCKETS - 1;
+  }
+  profile.buckets[bucket]++;
+}
+
+StageProfile StageProfiler::stage(ProfileStage stage) const {
+  StageProfile profile;
+  memset(&profile, 0, sizeof(profile));
+  if (stage < PROFILE_STAGE_COUNT && !(__atomic_load_n(&_resetPending, __ATOMIC_RELAXED) & (1UL << stage))) {
+    profile = _stages[stage];
+  }
+  return profile;
+}
+
+uint32_t StageProfiler::percentileUs(const StageProfile& profile, uint8_t percent) const {
+  if (profile.count == 0) {
+    return 0;
+  }
+  uint32_t wanted = (uint32_t)(((uint64_t)profile.count * percent + 99) / 100);
+  uint32_t seen = 0;
+  for (size_t bucket = 0; bucket < PROFILE_BUCKETS - 1; bucket++) {
+    seen += profile.buckets[bucket];
+    if (seen >= wanted) {
+      uint64_t upperCycles = 2ULL << bucket;
+      return cyclesToUs(min(upperCycles, (uint64_t)profile.maxCycles));
+    }
+  }
+  return cyclesToUs(profile.maxCycles);
+}
+
+float StageProfiler::overheadPercent() const {
+  uint64_t windowUs = esp_timer_get_time() - _windowStartUs;
+  if (!_enabled || windowUs == 0) {
+    return 0.0f;
+  }
+  uint64_t samples = 0;
+  for (size_t i = 0; i < PROFILE_STAGE_COUNT; i++) {
+    samples += stage((ProfileStage)i).count;
+  }
+  return 100.0f * (float)(samples * _overheadCycles) / ((float)windowUs * _cpuMhz);
+}
+
+uint32_t StageProfiler::windowMs() const {
+  return (uint32_t)((esp_timer_get_time() - _windowStartUs) / 1000);
+}
+
+void StageProfiler::log() const {
+  if (!_enabled) {
+    Serial.println("Stage profiler is off ('profile on' starts it)");
+    return;
+  }
+  Serial.printf("Stage profile over %lu ms, %.3f%% profiler overhead:\n", (unsigned long)windowMs(), overheadPercent());
+  for (size_t i = 0; i < PROFILE_STAGE_COUNT; i++) {
+    StageProfile profile = stage((ProfileStage)i);
+    if (profile.count == 0) {
+      Serial.printf("  %-15s no runs\n", stageName((ProfileStage)i));
+      continue;
+    }
+    Serial.printf("  %-15s %7lu runs  avg %6lu us  p50 <%6lu us  p99 <%6lu us  max %6lu us\n", stageName((ProfileStage)i),
+                  (unsigned long)profile.count, (unsigned long)cyclesToUs(profile.totalCycles / profile.count),
+                  (unsigned long)percentileUs(profile, 50), (unsigned long)percentileUs(profile, 99),
+                  (unsigned long)cyclesToUs(profile.maxCycles));
+    // Histogram, one "<upper edge:runs" pair per non-empty bucket
+    Serial.print("                 ");
+    for (size_t bucket = 0; bucket < PROFILE_BUCKETS; bucket++) {
+      if (profile.buckets[bucket] > 0) {
+        Serial.printf(" <%.1fus:%lu", (float)(2ULL << bucket) / _cpuMhz, (unsigned long)profile.buckets[bucket]);
+      }
+    }
+    Serial.println();
+  }
+}
+
+const char* StageProfiler::stageName(ProfileStage stage) {
+  switch (stage) {
+    case PROFILE_HTTP: return "http";
+    case PROFILE_DNS: return "dns";
+    case PROFILE_WEBSOCKET: return "websocket";
+    case PROFILE_TOUCH: return "touch";
+    case PROFILE_ADC_READ: return "adcRead";
+    case PROFILE_AUTO_MEASURE: return "autoMeasure";
+    case PROFILE_RENDER: return "render";
+    case PROFILE_PUSH: return "push";
+    case PROFILE_LEDS: return "leds";
+    case PROFILE_STATE_BROADCAST: return "stateBroadcast";
+    default: return "?";
+  }
+}
@@ -0,0 +1,146 @@
+#ifndef STAGE_PROFILER_H
+#define STAGE_PROFILER_H
+
+#include <Arduino.h>
+
+// ========================================
+// PER-STAGE PROFILER
+// ========================================
+// Times the individual stages of the tasks' work loops with the CPU cycle
+// counter and keeps a log2 histogram per stage: bucket n counts the runs that
+// took 2^n to 2^(n+1)-1 cycles. Together with count, total and maximum that
+// shows both where the time goes and how spread out it is.
+//
+// Each stage is only ever timed from one task, so recording needs no lock:
+// the writer owns its counters. A reset from another task is only requested
+// and carried out by the writer on its next record. Readers may see a stage
+// half-way through an update, which is fine for statistics.
+//
+// Stages may nest (a state broadcast can run inside webSocket.loop()); each
+// one counts its own time including what it calls.
+//
+// Off at boot. When off, start() and stop() cost a flag test each.
+
+enum ProfileStage : uint8_t {
+  PROFILE_HTTP,            // server.handleClient()
+  PROFILE_DNS,             // dnsServer.processNextRequest()
+  PROFILE_WEBSOCKET,       // webSocket.loop(), including the commands it runs
+  PROFILE_TOUCH,           // handleTouch()
+  PROFILE_ADC_READ,        // readRawDepthADC(), acquisition task
+  PROFILE_AUTO_MEASURE,    // updateAutoMeasure(), engine task
+  PROFILE_RENDER,          // Drawing a frame into the canvas and starting its push
+  PROFILE_PUSH,            // Waiting for the rest of the frame to go out by DMA
+  PROFILE_LEDS,            // updateLEDs()
+  PROFILE_STATE_BROADCAST, // sendCurrentStateToClients()
+  PROFILE_STAGE_COUNT
+};
+
+// 2^27 cycles is about 0.8 s at 160 MHz; anything longer lands in the last bucket
+#define PROFILE_BUCKETS 28
+
+struct StageProfile {
+  uint32_t count;
+  uint32_t maxCycles;
+  uint64_t totalCycles;
+  uint32_t buckets[PROFILE_BUCKETS];
+};
+
+/**
+ * @brief Cycle-counter timing and log2 histograms for the stages above.
+ */
+class StageProfiler
+{
+public:
+  StageProfiler();
+
+  /**
+   * @brief Turns profiling on or off. Turning it on measures the profiler's own cost first.
+   */
+  void setEnabled(bool enabled);
+  bool enabled() const { return _enabled; }
+
+  /**
+   * @brief Start of a stage. Pass the result to stop().
+   * @return The cycle counter, or 0 while profiling is off.
+   */
+  uint32_t start() const { return _enabled ? ESP.getCycleCount() : 0; }
+
+  /**
+   * @brief End of a stage that started at startCycles. Call from the task that owns the stage.
+   */
+  void stop(ProfileStage stage, uint32_t startCycles) {
+    if (startCycles != 0 && _enabled) {
+      record(stage, ESP.getCycleCount() - startCycles);
+    }
+  }
+
+  /**
+   * @brief Clears all stages. Each one is cleared by its own task on its next run.
+   */
+  void reset();
+
+  /**
+   * @brief Copy of one stage's counters.
+   */
+  StageProfile stage(ProfileStage stage) const;
+
+  /**
+   * @brief Smallest duration (us) that at least percent of the runs stayed below, to
+   *        histogram resolution: the upper edge of the bucket the percentile falls in.
+   */
+  uint32_t percentileUs(const StageProfile& profile, uint8_t percent) const;
+
+  uint32_t cyclesToUs(uint64_t cycles) const { return (uint32_t)(cycles / _cpuMhz); }
+  uint32_t cpuMhz() const { return _cpuMhz; }
+
+  /**
+   * @brief Cycles one start()/stop() pair costs, measured when profiling was turned on.
+   */
+  uint32_t overheadCycles() const { return _overheadCycles; }
+
+  /**
+   * @brief Share of the CPU time since profiling was turned on spent in the profiler itself.
+   */
+  float overheadPercent() const;
+
+  /**
+   * @brief Time since profiling was last turned on or reset.
+   */
+  uint32_t windowMs() const;
+
+  /**
+   * @brief Prints one line per stage: runs, average, p50, p99 and worst case, then the histogram.
+   */
+  void log() const;
+
+  static const char* stageName(ProfileStage stage);
+
+private:
+  void record(ProfileStage stage, uint32_t cycles);
+  static void add(StageProfile& profile, uint32_t cycles);
+
+  StageProfile _stages[PROFILE_STAGE_COUNT];
+  uint32_t _resetPending; // One bit per stage, changed with __atomic builtins only
+  volatile bool _enabled;
+  uint32_t _cpuMhz;
+  uint32_t _overheadCycles;
+  int64_t _windowStartUs;
+};
+
+extern StageProfiler stageProfiler;
+
+/**
+ * @brief Times the enclosing scope as one stage.
+ */
+class ProfileScope
+{
+public:
+  explicit ProfileScope(ProfileStage stage) : _stage(stage), _start(stageProfiler.start()) {}
+  ~ProfileScope() { stageProfiler.stop(_stage, _start); }
+
+private:
+  ProfileStage _stage;
+  uint32_t _start;
+};
+
+#endif // STAGE_PROFILER_H
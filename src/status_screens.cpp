@@ -0,0 +1,79 @@
+#include <Arduino.h>
+#include "status_screens.h"
+
+void drawCalibrationScreen(LGFX_Sprite& canvas, CalibrationState state, float currentAdc, float currentWeight) {
+  // Rotation is set in setupDisplay()
+  canvas.setTextColor(UI_WHITE); // Set text color
+
+  // Clear the entire screen to avoid artifacts from previous states
+  canvas.fillScreen(UI_BLACK);
+
+  canvas.setCursor(5, 5);
+  canvas.setTextSize(1); // Smallest size for title
+  canvas.println("--- CALIBRATION WIZARD ---");
+
+  canvas.setTextSize(2); // Larger for step title
+  canvas.setCursor(5, 30);
+  if (state == CALIBRATE_ZERO_STEP) {
+    canvas.println("Step 1/2: Set Zero");
+
+    canvas.setTextSize(1); // Smaller for instructions
+    canvas.setCursor(5, 60);
+    canvas.println("Place probe at 0mm");
+    canvas.setCursor(5, 75); // New line for clarity
+    canvas.println("(empty container).");
+
+    canvas.setCursor(5, 100); // Clear and draw Current ADC
+    canvas.printf("ADC: %.0f", currentAdc);
+
+    canvas.setCursor(5, 120);
+    canvas.println("Confirm on Web UI.");
+  } else if (state == CALIBRATE_KNOWN_GRAINS_STEP) { // This is now Step 2
+    canvas.println("Step 2/2: Known Grains");
+
+    canvas.setTextSize(1); // Smaller for instructions
+    canvas.setCursor(5, 60);
+    canvas.println("Insert probe into");
+    canvas.setCursor(5, 75); // New line for clarity
+    canvas.println("container w/ powder.");
+
+    canvas.setCursor(5, 100); // Clear and draw Current Weight
+    canvas.printf("Weight: %.3f gr", currentWeight);
+
+    canvas.setCursor(5, 120);
+    canvas.println("Enter weight on Web UI.");
+  }
+
+  // Common instruction for cancelling
+  canvas.setTextSize(1);
+  canvas.setCursor(5, canvas.height() - 15); // Position at bottom
+
+  // --- Touch Buttons ---
+  // NOTE: These buttons are currently unused as calibration is driven by the Web UI.
+  // They are left here for potential future use on the device screen.
+  // drawButton(zeroBtn);
+  // drawButton(spanBtn);
+  // drawButton(backBtn);
+  canvas.println("Cancel via Web UI.");
+}
+
+void drawAPModeScreen(LGFX_Sprite& canvas) {
+  // Rotation is set in setupDisplay()
+  canvas.setTextColor(UI_WHITE); // Set text color
+
+  canvas.fillScreen(UI_BLACK); // Clear screen completely
+
+  canvas.setCursor(5, 5);
+  canvas.setTextSize(1);
+  canvas.println("--- AP MODE ACTIVE ---");
+  canvas.setTextSize(2);
+  canvas.setCursor(5, 30);
+  canvas.println("SSID: PowderSense");
+  canvas.setCursor(5, 60);
+  canvas.println("IP: 192.168.4.1");
+  canvas.setTextSize(1);
+  canvas.setCursor(5, 90);
+  canvas.println("Connect to this network");
+  canvas.setCursor(5, 105);
+  canvas.println("to configure Wi-Fi.");
+}
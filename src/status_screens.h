@@ -0,0 +1,37 @@
+#ifndef STATUS_SCREENS_H
+#define STATUS_SCREENS_H
+
+#define LGFX_USE_V1
+#include <LovyanGFX.hpp>
+#include "ui_palette.h"
+
+// ========================================
+// CALIBRATION AND AP MODE SCREENS
+// ========================================
+// Static text screens, redrawn in full into the canvas whenever they are
+// shown. They only depend on the canvas they are given, so the same code
+// runs on the device and in the host display emulator.
+
+// Calibration state machine
+enum CalibrationState {
+  CALIBRATE_NONE,
+  CALIBRATE_ZERO_STEP,      // Step 1: Set probe at 0mm
+  CALIBRATE_KNOWN_GRAINS_STEP // Step 2: Set probe at known grains
+};
+
+/**
+ * @brief Draws the calibration screen on the display.
+ * @param canvas Sprite to draw into.
+ * @param state Current calibration state.
+ * @param currentAdc Current ADC reading.
+ * @param currentWeight Current weight in grains.
+ */
+void drawCalibrationScreen(LGFX_Sprite& canvas, CalibrationState state, float currentAdc, float currentWeight);
+
+/**
+ * @brief Draws the AP mode screen on the display.
+ * @param canvas Sprite to draw into.
+ */
+void drawAPModeScreen(LGFX_Sprite& canvas);
+
+#endif // STATUS_SCREENS_H
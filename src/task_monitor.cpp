@@ -0,0 +1,87 @@
+#include <Arduino.h>
+#include "task_monitor.h"
+
+TaskMonitor taskMonitor;
+
+TaskMonitor::TaskMonitor() {
+  memset(_tasks, 0, sizeof(_tasks));
+  for (size_t i = 0; i < TASK_COUNT; i++) {
+    _handles[i] = nullptr;
+  }
+  _mux = portMUX_INITIALIZER_UNLOCKED;
+}
+
+void TaskMonitor::attach(MonitoredTask task, const char* name, TaskHandle_t handle, uint32_t stackBytes, uint32_t budgetUs) {
+  if (task >= TASK_COUNT) {
+    return;
+  }
+  if (handle == nullptr) {
+    handle = xTaskGetCurrentTaskHandle();
+  }
+  UBaseType_t priority = uxTaskPriorityGet(handle);
+  portENTER_CRITICAL(&_mux);
+  _handles[task] = handle;
+  _tasks[task].name = name;
+  _tasks[task].priority = priority;
+  _tasks[task].stackBytes = stackBytes;
+  _tasks[task].budgetUs = budgetUs;
+  portEXIT_CRITICAL(&_mux);
+}
+
+void TaskMonitor::record(MonitoredTask task, uint32_t elapsedUs) {
+  if (task >= TASK_COUNT) {
+    return;
+  }
+  portENTER_CRITICAL(&_mux);
+  TaskStats& stats = _tasks[task];
+  stats.cycles++;
+  stats.lastUs = elapsedUs;
+  stats.totalUs += elapsedUs;
+  if (elapsedUs > stats.maxUs) {
+    stats.maxUs = elapsedUs;
+  }
+  if (stats.budgetUs > 0 && elapsedUs > stats.budgetUs) {
+    stats.overruns++;
+  }
+  portEXIT_CRITICAL(&_mux);
+}
+
+TaskStats TaskMonitor::stats(MonitoredTask task) const {
+  TaskStats result;
+  memset(&result, 0, sizeof(result));
+  if (task >= TASK_COUNT) {
+    return result;
+  }
+  portENTER_CRITICAL(&_mux);
+  result = _tasks[task];
+  TaskHandle_t handle = _handles[task];
+  portEXIT_CRITICAL(&_mux);
+  if (handle != nullptr) {
+    result.stackFreeBytes = uxTaskGetStackHighWaterMark(handle); // Bytes on ESP-IDF
+  }
+  return result;
+}
+
+void TaskMonitor::resetPeaks() {
+  portENTER_CRITICAL(&_mux);
+  for (size_t i = 0; i < TASK_COUNT; i++) {
+    _tasks[i].maxUs = 0;
+    _tasks[i].overruns = 0;
+  }
+  portEXIT_CRITICAL(&_mux);
+}
+
+void TaskMonitor::logSummary() const {
+  Serial.println("Tasks:");
+  for (size_t i = 0; i < TASK_COUNT; i++) {
+    TaskStats task = stats((MonitoredTask)i);
+    if (task.name == nullptr) {
+      continue; // Not started
+    }
+    uint32_t averageUs = task.cycles > 0 ? (uint32_t)(task.totalUs / task.cycles) : 0;
+    Serial.printf("  %-12s prio %u  wcet %6lu us  avg %6lu us  budget %6lu us  %lu overruns  stack %lu/%lu bytes free\n",
+                  task.name, (unsigned)task.priority, (unsigned long)task.maxUs, (unsigned long)averageUs,
+                  (unsigned long)task.budgetUs, (unsigned long)task.overruns,
+                  (unsigned long)task.stackFreeBytes, (unsigned long)task.stackBytes);
+  }
+}
@@ -0,0 +1,86 @@
+#ifndef TASK_MONITOR_H
+#define TASK_MONITOR_H
+
+#include <Arduino.h>
+
+// ========================================
+// TASK BUDGETS AND EXECUTION TIMES
+// ========================================
+// The firmware runs as a handful of FreeRTOS tasks with fixed priorities:
+//
+//   acquisition  samples the sensor on a fixed period      (highest)
+//   engine       averaging, weight, auto-measure, LEDs
+//   display      renders frames from the shared snapshot
+//   network      Arduino loop(): HTTP, WebSocket, touch, boot stages
+//   persistence  measurement log, rollups and settings to SPIFFS (lowest)
+//
+// Every task reports how long each of its cycles took. The monitor keeps the
+// last and the worst case (WCET), counts cycles that went over the task's
+// budget and reads the stack high-water mark when asked, so the stack sizes
+// can be trimmed against real numbers.
+
+enum MonitoredTask : uint8_t {
+  TASK_ACQUISITION,
+  TASK_ENGINE,
+  TASK_DISPLAY,
+  TASK_NETWORK,
+  TASK_PERSISTENCE,
+  TASK_COUNT
+};
+
+struct TaskStats {
+  const char* name;
+  UBaseType_t priority;
+  uint32_t stackBytes;     // Stack the task was created with
+  uint32_t stackFreeBytes; // Least free stack seen so far (high-water mark)
+  uint32_t budgetUs;       // Expected worst case per cycle, 0 = none
+  uint32_t cycles;
+  uint32_t lastUs;
+  uint32_t maxUs;          // Worst case since boot or the last resetPeaks()
+  uint64_t totalUs;
+  uint32_t overruns;       // Cycles that took longer than the budget
+};
+
+/**
+ * @brief Per-task execution time and stack statistics. Safe to use from several tasks.
+ */
+class TaskMonitor
+{
+public:
+  TaskMonitor();
+
+  /**
+   * @brief Registers a started task. Call once per task, after xTaskCreate().
+   * @param handle The task, or nullptr for the calling task.
+   */
+  void attach(MonitoredTask task, const char* name, TaskHandle_t handle, uint32_t stackBytes, uint32_t budgetUs);
+
+  /**
+   * @brief Records one cycle of a task. Call from the task itself.
+   */
+  void record(MonitoredTask task, uint32_t elapsedUs);
+
+  /**
+   * @brief Snapshot of one task, with a fresh stack high-water mark.
+   */
+  TaskStats stats(MonitoredTask task) const;
+
+  /**
+   * @brief Clears worst cases and overrun counts, e.g. after boot has settled.
+   */
+  void resetPeaks();
+
+  /**
+   * @brief Prints one line per task with its WCET, average and stack headroom.
+   */
+  void logSummary() const;
+
+private:
+  TaskStats _tasks[TASK_COUNT];
+  TaskHandle_t _handles[TASK_COUNT];
+  mutable portMUX_TYPE _mux;
+};
+
+extern TaskMonitor taskMonitor;
+
+#endif // TASK_MONITOR_H
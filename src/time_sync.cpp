@@ -0,0 +1,96 @@
+#include <Arduino.h>
+#include <esp_sntp.h>
+#include <sys/time.h>
+#include "time_sync.h"
+#include "logger.h"
+
+TimeSync* TimeSync::_instance = nullptr;
+
+TimeSync::TimeSync()
+  : _offsetUs(0), _synced(false), _firstSyncPending(false), _syncCount(0), _lastSyncMs(0), _onFirstSync(nullptr) {
+  strlcpy(_timeZone, TIME_ZONE_DEFAULT, sizeof(_timeZone));
+  _mux = portMUX_INITIALIZER_UNLOCKED;
+}
+
+void TimeSync::begin(const char* timeZone) {
+  _instance = this;
+  if (!setTimeZone(timeZone)) {
+    strlcpy(_timeZone, TIME_ZONE_DEFAULT, sizeof(_timeZone));
+  }
+
+  // A software reset keeps the RTC running, so the clock may already be right
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  if (tv.tv_sec >= (time_t)MIN_VALID_EPOCH) {
+    adopt((int64_t)tv.tv_sec * 1000000LL + tv.tv_usec);
+    LOG_INFO("Time: clock kept across reset, using it until SNTP answers");
+  }
+
+  sntp_set_time_sync_notification_cb(onSntpSync);
+  configTzTime(_timeZone, TIME_SNTP_SERVER_1, TIME_SNTP_SERVER_2);
+}
+
+bool TimeSync::setTimeZone(const char* timeZone) {
+  if (timeZone == nullptr || timeZone[0] == '\0' || strlen(timeZone) > TIME_ZONE_MAX_LENGTH) {
+    return false;
+  }
+  strlcpy(_timeZone, timeZone, sizeof(_timeZone));
+  setenv("TZ", _timeZone, 1);
+  tzset();
+  return true;
+}
+
+void TimeSync::onSntpSync(struct timeval* tv) {
+  // Runs in the lwIP task: record the offset, leave the rest to service()
+  if (_instance != nullptr && tv != nullptr) {
+    _instance->adopt((int64_t)tv->tv_sec * 1000000LL + tv->tv_usec);
+  }
+}
+
+void TimeSync::adopt(int64_t wallUs) {
+  int64_t offset = wallUs - esp_timer_get_time();
+  portENTER_CRITICAL(&_mux);
+  _offsetUs = offset;
+  bool first = !_synced;
+  _synced = true;
+  if (first) {
+    _firstSyncPending = true;
+  }
+  portEXIT_CRITICAL(&_mux);
+  _syncCount++;
+  _lastSyncMs = millis();
+}
+
+void TimeSync::service() {
+  if (!_firstSyncPending) {
+    return;
+  }
+  _firstSyncPending = false;
+
+  uint32_t epoch = bootEpoch();
+  time_t now = time(nullptr);
+  struct tm local;
+  localtime_r(&now, &local);
+  char timeStr[30];
+  strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", &local);
+  LOG_INFO("Time: synced, %s (%s), boot was at epoch %lu", timeStr, _timeZone, (unsigned long)epoch);
+
+  if (_onFirstSync != nullptr) {
+    _onFirstSync(epoch);
+  }
+}
+
+uint32_t TimeSync::stamp(int64_t monotonicUs) const {
+  portENTER_CRITICAL(&_mux);
+  bool synced = _synced;
+  int64_t offset = _offsetUs;
+  portEXIT_CRITICAL(&_mux);
+  return (uint32_t)((monotonicUs + (synced ? offset : 0)) / 1000000LL);
+}
+
+uint32_t TimeSync::bootEpoch() const {
+  portENTER_CRITICAL(&_mux);
+  uint32_t epoch = _synced ? (uint32_t)(_offsetUs / 1000000LL) : 0;
+  portEXIT_CRITICAL(&_mux);
+  return epoch;
+}
@@ -0,0 +1,99 @@
+#ifndef TIME_SYNC_H
+#define TIME_SYNC_H
+
+#include <Arduino.h>
+#include <esp_timer.h>
+
+// ========================================
+// WALL CLOCK FROM SNTP, MONOTONIC STAMPS
+// ========================================
+// Shots are stamped from the monotonic esp_timer clock and converted to wall
+// time with an offset that SNTP provides. SNTP runs in the background and
+// reports each sync through a callback; nothing waits for it.
+//
+// Until the first sync the offset is unknown. A stamp taken then is
+// provisional: the number of seconds since boot, which is always below
+// MIN_VALID_EPOCH. Once the first sync arrives, the wall time at boot is
+// known. The first-sync callback (run from loop() by service()) adds it to
+// every provisional stamp of this boot, so records taken before the sync
+// end up with the right time.
+
+// Anything earlier is a provisional stamp (seconds since some boot), not wall time
+#define MIN_VALID_EPOCH 1600000000UL
+
+// POSIX TZ string used until the settings provide one; only affects local time shown by the device
+#define TIME_ZONE_DEFAULT "CET-1CEST,M3.5.0,M10.5.0/3"
+#define TIME_ZONE_MAX_LENGTH 48
+
+#define TIME_SNTP_SERVER_1 "pool.ntp.org"
+#define TIME_SNTP_SERVER_2 "time.nist.gov"
+
+/**
+ * @brief Called once, from loop(), when the wall clock first becomes valid.
+ * @param bootEpoch Wall time of the esp_timer zero; add it to provisional stamps.
+ */
+typedef void (*TimeSyncCallback)(uint32_t bootEpoch);
+
+/**
+ * @brief Non-blocking SNTP client and converter from monotonic stamps to wall time.
+ */
+class TimeSync
+{
+public:
+  TimeSync();
+
+  /**
+   * @brief Starts SNTP and returns at once. Call after the network stack is up (WiFi.mode()).
+   *        If the RTC still holds a valid time from before a software reset, it is used right away.
+   */
+  void begin(const char* timeZone);
+
+  /**
+   * @brief Sets the POSIX TZ string, e.g. "CET-1CEST,M3.5.0,M10.5.0/3".
+   * @return False if it is empty or too long.
+   */
+  bool setTimeZone(const char* timeZone);
+  const char* timeZone() const { return _timeZone; }
+
+  void onFirstSync(TimeSyncCallback callback) { _onFirstSync = callback; }
+
+  /**
+   * @brief Runs the first-sync callback once the sync has arrived. Call from loop().
+   */
+  void service();
+
+  bool synced() const { return _synced; }
+
+  /**
+   * @brief Timestamp for a monotonic time: epoch seconds once synced, seconds since boot before.
+   */
+  uint32_t stamp(int64_t monotonicUs) const;
+  uint32_t now() const { return stamp(esp_timer_get_time()); }
+
+  static bool provisional(uint32_t timestamp) { return timestamp < MIN_VALID_EPOCH; }
+
+  /**
+   * @brief Wall time (epoch seconds) at esp_timer zero, 0 until synced.
+   */
+  uint32_t bootEpoch() const;
+
+  uint32_t syncCount() const { return _syncCount; }
+  uint32_t lastSyncMs() const { return _lastSyncMs; } // millis() of the last sync, 0 = none
+
+private:
+  static void onSntpSync(struct timeval* tv);
+  void adopt(int64_t wallUs);
+
+  static TimeSync* _instance;
+
+  char _timeZone[TIME_ZONE_MAX_LENGTH + 1];
+  int64_t _offsetUs; // Wall time minus esp_timer time
+  volatile bool _synced;
+  volatile bool _firstSyncPending;
+  volatile uint32_t _syncCount;
+  volatile uint32_t _lastSyncMs;
+  TimeSyncCallback _onFirstSync;
+  mutable portMUX_TYPE _mux;
+};
+
+#endif // TIME_SYNC_H
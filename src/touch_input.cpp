@@ -0,0 +1,166 @@
+#include <Arduino.h>
+#include "touch_input.h"
+#include "axs5106l_device.h"
+#include "logger.h"
+
+TouchInput touchInput;
+TouchInput* TouchInput::_instance = nullptr;
+
+TouchInput::TouchInput()
+  : _wire(nullptr), _busMutex(nullptr), _rotation(0), _panelWidth(0), _panelHeight(0), _resetPin(-1), _interruptPin(-1), _events(nullptr), _task(nullptr),
+    _down(false), _ignored(false), _longPressSent(false), _downX(0), _downY(0), _downMs(0), _releasedMs(0),
+    _hasReleased(false), _interrupts(0) {
+  memset(&_stats, 0, sizeof(_stats));
+  _mux = portMUX_INITIALIZER_UNLOCKED;
+}
+
+void TouchInput::setOrientation(uint8_t rotation, uint16_t panelWidth, uint16_t panelHeight) {
+  _rotation = rotation & 7;
+  _panelWidth = panelWidth;
+  _panelHeight = panelHeight;
+}
+
+bool TouchInput::begin(TwoWire* wire, SemaphoreHandle_t busMutex, int resetPin, int interruptPin) {
+  if (_task != nullptr) {
+    return true;
+  }
+  _wire = wire;
+  _busMutex = busMutex;
+  _resetPin = resetPin;
+  _interruptPin = interruptPin;
+  _instance = this;
+  _events = xQueueCreate(TOUCH_EVENT_QUEUE_LENGTH, sizeof(TouchEvent));
+  if (_events == nullptr) {
+    LOG_ERROR("Failed to create the touch event queue.");
+    return false;
+  }
+  if (xTaskCreate(taskEntry, "touch", TOUCH_TASK_STACK_SIZE, this, TOUCH_TASK_PRIORITY, &_task) != pdPASS) {
+    _task = nullptr;
+    LOG_ERROR("Failed to start the touch task.");
+    return false;
+  }
+  return true;
+}
+
+bool TouchInput::poll(TouchEvent& event) {
+  return _events != nullptr && xQueueReceive(_events, &event, 0) == pdTRUE;
+}
+
+TouchInputStats TouchInput::stats() const {
+  portENTER_CRITICAL(&_mux);
+  TouchInputStats result = _stats;
+  portEXIT_CRITICAL(&_mux);
+  result.interrupts = _interrupts;
+  return result;
+}
+
+void IRAM_ATTR TouchInput::onInterrupt() {
+  TouchInput* self = _instance;
+  if (self == nullptr || self->_task == nullptr) {
+    return;
+  }
+  self->_interrupts++;
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(self->_task, &woken);
+  if (woken) {
+    portYIELD_FROM_ISR();
+  }
+}
+
+void TouchInput::taskEntry(void* parameter) {
+  static_cast<TouchInput*>(parameter)->run();
+}
+
+void TouchInput::run() {
+  // The controller reset takes half a second; it happens here so setup() goes on meanwhile.
+  // Wire does not keep a register read (address write, requestFrom, readBytes) in one piece,
+  // so the driver holds the bus mutex around each one against the ADS1115 reads.
+  touch_set_bus_mutex(_busMutex);
+  touch_init(_wire, _resetPin, _interruptPin);
+  pinMode(_interruptPin, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(_interruptPin), onInterrupt, FALLING);
+  LOG_INFO("Touch controller ready (INT on GPIO%d)", _interruptPin);
+
+  for (;;) {
+    // Idle: sleep until the controller has a report. Held: also wake to time the long press and catch the release.
+    ulTaskNotifyTake(pdTRUE, _down ? pdMS_TO_TICKS(TOUCH_HOLD_POLL_MS) : portMAX_DELAY);
+
+    touch_data_t data;
+    bool pressed = get_touch_data(&data);
+    uint32_t now = millis();
+    portENTER_CRITICAL(&_mux);
+    _stats.reads++;
+    portEXIT_CRITICAL(&_mux);
+
+    if (pressed && !_down) {
+      _down = true;
+      _longPressSent = false;
+      toScreen(data.coords[0].x, data.coords[0].y, _downX, _downY);
+      _downMs = now;
+      // Contact chatter right after a release is the same press, not a new one
+      _ignored = _hasReleased && now - _releasedMs < TOUCH_DEBOUNCE_MS;
+      if (_ignored) {
+        countBounce();
+      }
+    } else if (pressed) {
+      if (!_ignored && !_longPressSent && now - _downMs >= TOUCH_LONG_PRESS_MS) {
+        _longPressSent = true;
+        post(TOUCH_EVENT_LONG_PRESS, now);
+      }
+    } else if (_down) {
+      _down = false;
+      _hasReleased = true;
+      _releasedMs = now;
+      if (!_ignored && !_longPressSent) {
+        if (now - _downMs >= TOUCH_MIN_PRESS_MS) {
+          post(TOUCH_EVENT_TAP, now);
+        } else {
+          countBounce();
+        }
+      }
+    }
+  }
+}
+
+void TouchInput::post(TouchEventType type, uint32_t nowMs) {
+  TouchEvent event = {type, _downX, _downY, _downMs, nowMs - _downMs};
+  bool queued = xQueueSend(_events, &event, 0) == pdTRUE;
+  portENTER_CRITICAL(&_mux);
+  if (queued) {
+    _stats.events++;
+  } else {
+    _stats.dropped++;
+  }
+  portEXIT_CRITICAL(&_mux);
+}
+
+/**
+ * @brief Native panel coordinates to screen coordinates, as LGFXBase::convertRawXY() does it.
+ */
+void TouchInput::toScreen(uint16_t rawX, uint16_t rawY, uint16_t& x, uint16_t& y) const {
+  int32_t tx = rawX;
+  int32_t ty = rawY;
+  if (_panelWidth > 0 && _panelHeight > 0) {
+    tx = constrain(tx, 0, _panelWidth - 1);
+    ty = constrain(ty, 0, _panelHeight - 1);
+    if ((1u << _rotation) & 0b10010110) { // Rotations 1, 2, 4 and 7 mirror the native y axis
+      ty = _panelHeight - 1 - ty;
+    }
+    if (_rotation & 2) {
+      tx = _panelWidth - 1 - tx;
+    }
+    if (_rotation & 1) {
+      int32_t swap = tx;
+      tx = ty;
+      ty = swap;
+    }
+  }
+  x = (uint16_t)tx;
+  y = (uint16_t)ty;
+}
+
+void TouchInput::countBounce() {
+  portENTER_CRITICAL(&_mux);
+  _stats.bounces++;
+  portEXIT_CRITICAL(&_mux);
+}
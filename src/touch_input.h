@@ -0,0 +1,136 @@
+#ifndef TOUCH_INPUT_H
+#define TOUCH_INPUT_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// ========================================
+// INTERRUPT-DRIVEN TOUCH INPUT
+// ========================================
+// The AXS5106L pulls its INT line low whenever it has a new touch report. The
+// pin interrupt only wakes a reader task; that task reads the report over
+// I2C, follows the finger and turns each press into one event:
+//
+//   tap         released within TOUCH_LONG_PRESS_MS
+//   long press  still held after TOUCH_LONG_PRESS_MS, sent while held
+//
+// Debouncing is by time, not by waiting: a press that lasts less than
+// TOUCH_MIN_PRESS_MS, or starts within TOUCH_DEBOUNCE_MS of the previous
+// release, is ignored. Events go to a bounded queue that the UI drains with
+// poll(), which never blocks. If the UI falls behind, new events are dropped
+// and counted.
+//
+// While a finger is down the reader also wakes every TOUCH_HOLD_POLL_MS, so a
+// long press is seen without a new report and a release is noticed even if
+// the controller sends no interrupt for it.
+//
+// The controller reports in the panel's native orientation; events carry
+// screen coordinates for the rotation set with setOrientation(), mapped the
+// same way LovyanGFX maps its own touch drivers. The bus is shared with the
+// ADS1115, so every transaction holds the bus mutex passed to begin().
+
+#ifndef TOUCH_DEBOUNCE_MS
+  #define TOUCH_DEBOUNCE_MS 150
+#endif
+#ifndef TOUCH_MIN_PRESS_MS
+  #define TOUCH_MIN_PRESS_MS 30
+#endif
+#ifndef TOUCH_LONG_PRESS_MS
+  #define TOUCH_LONG_PRESS_MS 800
+#endif
+#define TOUCH_HOLD_POLL_MS 40
+#define TOUCH_EVENT_QUEUE_LENGTH 8
+#define TOUCH_TASK_STACK_SIZE 3072
+#define TOUCH_TASK_PRIORITY 3 // Above the network task that consumes the events
+
+enum TouchEventType : uint8_t {
+  TOUCH_EVENT_TAP,
+  TOUCH_EVENT_LONG_PRESS
+};
+
+struct TouchEvent {
+  TouchEventType type;
+  uint16_t x;          // Where the press started, screen coordinates
+  uint16_t y;
+  uint32_t pressedMs;  // millis() when the finger went down
+  uint32_t durationMs; // How long it was held (up to the event)
+};
+
+struct TouchInputStats {
+  uint32_t interrupts;
+  uint32_t reads;
+  uint32_t events;
+  uint32_t bounces;   // Presses ignored by the debounce
+  uint32_t dropped;   // Events lost because the queue was full
+};
+
+/**
+ * @brief AXS5106L reader task fed by the INT line, with a tap/long-press event queue.
+ */
+class TouchInput
+{
+public:
+  TouchInput();
+
+  /**
+   * @brief Maps reports from the panel's native orientation to the screen's.
+   * @param rotation LovyanGFX rotation 0-7, as passed to setRotation().
+   * @param panelWidth Native panel width, before rotation.
+   * @param panelHeight Native panel height, before rotation.
+   */
+  void setOrientation(uint8_t rotation, uint16_t panelWidth, uint16_t panelHeight);
+
+  /**
+   * @brief Starts the reader task, which resets and probes the controller itself,
+   *        so setup() does not wait for it. The I2C bus must already be started.
+   * @param busMutex Held for each I2C transaction, as by every other user of the bus.
+   * @return False if the queue or the task could not be created.
+   */
+  bool begin(TwoWire* wire, SemaphoreHandle_t busMutex, int resetPin, int interruptPin);
+
+  /**
+   * @brief Takes the next event, if there is one. Never blocks.
+   */
+  bool poll(TouchEvent& event);
+
+  TouchInputStats stats() const;
+  bool started() const { return _task != nullptr; }
+
+private:
+  static void onInterrupt();
+  static void taskEntry(void* parameter);
+  void run();
+  void post(TouchEventType type, uint32_t nowMs);
+  void countBounce();
+  void toScreen(uint16_t rawX, uint16_t rawY, uint16_t& x, uint16_t& y) const;
+
+  static TouchInput* _instance;
+
+  TwoWire* _wire;
+  SemaphoreHandle_t _busMutex;
+  uint8_t _rotation;
+  uint16_t _panelWidth;
+  uint16_t _panelHeight;
+  int _resetPin;
+  int _interruptPin;
+  QueueHandle_t _events;
+  TaskHandle_t _task;
+
+  // Reader task state
+  bool _down;
+  bool _ignored;        // This press started inside the debounce window
+  bool _longPressSent;
+  uint16_t _downX;
+  uint16_t _downY;
+  uint32_t _downMs;
+  uint32_t _releasedMs;
+  bool _hasReleased;
+
+  volatile uint32_t _interrupts;
+  TouchInputStats _stats;
+  mutable portMUX_TYPE _mux;
+};
+
+extern TouchInput touchInput;
+
+#endif // TOUCH_INPUT_H
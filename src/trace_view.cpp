@@ -0,0 +1,278 @@
+#include <Arduino.h>
+#include "trace_view.h"
+#include "logger.h"
+
+// ST7789 commands not wrapped by LovyanGFX
+#define ST7789_NORON   0x13 // Normal display mode, also leaves scroll mode
+#define ST7789_VSCRDEF 0x33 // Vertical scrolling definition: top fixed, scroll, bottom fixed rows
+#define ST7789_VSCRSADD 0x37 // Vertical scrolling start address
+
+#define TRACE_PLOT_MARGIN 2    // Rows kept clear above and below the plot
+#define TRACE_GRID_DIVISIONS 4 // Horizontal grid lines split the range into this many bands
+#define TRACE_MARKER_HEIGHT 8  // Tick at the top of a column where a shot was recorded
+#define TRACE_WEIGHT_Y 60
+#define TRACE_UNIT_Y (TRACE_WEIGHT_Y + 20)
+#define TRACE_TARGET_Y (TRACE_WEIGHT_Y + 36)
+
+// RGB565 colours of the plot columns
+#define TRACE_GRID_COLOR 0x2945   // Dim grey
+#define TRACE_MARKER_COLOR 0x4208 // Grey, full-height line behind a shot
+#define TRACE_TARGET_COLOR TFT_CYAN
+#define TRACE_THRESHOLD_COLOR TFT_BLUE // Same as the threshold lines on the measurement bar
+
+// Column pixels are pushed as-is, so they are stored byte-swapped like the panel expects
+static inline uint16_t panelOrder(uint16_t color) {
+  return (uint16_t)((color >> 8) | (color << 8));
+}
+
+TraceView::TraceView(lgfx::LGFX_Device& panel)
+  : _panel(panel), _valid(false), _scrolling(false), _reversed(false), _plotWidth(0), _plotHeight(0),
+    _scrollTop(0), _head(0), _pixels(nullptr), _lastMin(0), _lastMax(0), _lastShotCount(0), _columns(0),
+    _weightAlarm(false) {
+  memset(&_scale, 0, sizeof(_scale));
+  _weightText[0] = '\0';
+  _targetText[0] = '\0';
+}
+
+void TraceView::render(const TraceViewInputs& inputs) {
+  Scale next;
+  buildScale(inputs, next);
+  if (!_valid || !sameScale(next, _scale)) {
+    // A new range would misplace every column already on the panel, so start over
+    _scale = next;
+    _lastMin = inputs.weight;
+    _lastMax = inputs.weight;
+    _lastShotCount = inputs.shotCount;
+    restart();
+  }
+  if (_pixels == nullptr) {
+    return;
+  }
+
+  _panel.startWrite();
+  drawColumn(inputs);
+  drawReadout(inputs);
+  _panel.endWrite();
+}
+
+void TraceView::end() {
+  if (_scrolling) {
+    uint16_t rows = _panel.width();
+    _panel.startWrite();
+    setScrollArea(0, rows, 0);
+    setScrollStart(0);
+    _panel.writeCommand(ST7789_NORON);
+    _panel.endWrite();
+    _scrolling = false;
+  }
+  _valid = false;
+}
+
+void TraceView::buildScale(const TraceViewInputs& inputs, Scale& scale) const {
+  memset(&scale, 0, sizeof(scale));
+  scale.target = inputs.targetGrain > 0 ? inputs.targetGrain : NAN;
+  scale.thresholds = inputs.alarmEnabled && inputs.lowThreshold < inputs.highThreshold;
+  if (scale.thresholds) {
+    // Like the web chart, zoom in on the threshold band when alarms are set,
+    // with half a band of room either side to watch the weight settle into it
+    scale.lowThreshold = inputs.lowThreshold;
+    scale.highThreshold = inputs.highThreshold;
+    float margin = (inputs.highThreshold - inputs.lowThreshold) / 2.0f;
+    scale.low = inputs.lowThreshold - margin;
+    scale.high = inputs.highThreshold + margin;
+  } else if (inputs.targetGrain > 0) {
+    scale.low = 0.0f;
+    scale.high = inputs.targetGrain * 1.25f;
+  } else {
+    scale.low = 0.0f;
+    scale.high = TRACE_DEFAULT_FULL_SCALE;
+  }
+}
+
+bool TraceView::sameScale(const Scale& a, const Scale& b) const {
+  bool sameTarget = (isnan(a.target) && isnan(b.target)) || a.target == b.target;
+  return sameTarget && a.low == b.low && a.high == b.high && a.thresholds == b.thresholds &&
+         a.lowThreshold == b.lowThreshold && a.highThreshold == b.highThreshold;
+}
+
+void TraceView::restart() {
+  end();
+  _valid = true;
+
+  int width = _panel.width();
+  _plotWidth = width - TRACE_READOUT_WIDTH;
+  _plotHeight = _panel.height();
+  if (_pixels == nullptr) {
+    _pixels = (uint16_t*)malloc(_plotHeight * sizeof(uint16_t));
+    if (_pixels == nullptr) {
+      LOG_ERROR("Trace view: failed to allocate column buffer.");
+      return;
+    }
+  }
+  _head = 0;
+  _weightText[0] = '\0';
+  _targetText[0] = '\0';
+
+  // Odd rotations are landscape, where panel rows run along x. Rotations 3 and 7
+  // address them from the right edge.
+  uint8_t rotation = _panel.getRotation();
+  bool landscape = rotation & 1;
+  _reversed = landscape && (rotation & 3) == 3;
+
+  _panel.startWrite();
+  _panel.fillScreen(TFT_BLACK);
+  for (int x = 0; x < _plotWidth; x++) {
+    fillBackground(_pixels, false);
+    _panel.pushImage(x, 0, 1, _plotHeight, (const lgfx::swap565_t*)_pixels);
+  }
+
+  if (landscape) {
+    uint16_t rows = width;
+    _scrollTop = _reversed ? rows - _plotWidth : 0;
+    setScrollArea(_scrollTop, _plotWidth, rows - _scrollTop - _plotWidth);
+    setScrollStart(_scrollTop);
+    _scrolling = true;
+  } else {
+    // Scrolling would move the y axis; the plot sweeps across instead
+    LOG_WARN("Trace view: portrait rotation, plotting without hardware scroll.");
+  }
+
+  _panel.drawFastVLine(_plotWidth, 0, _plotHeight, TFT_DARKGREY);
+  drawScaleLabels();
+  _panel.endWrite();
+}
+
+int TraceView::weightToY(float weight) const {
+  float t = (weight - _scale.low) / (_scale.high - _scale.low);
+  t = constrain(t, 0.0f, 1.0f);
+  int rows = _plotHeight - 1 - 2 * TRACE_PLOT_MARGIN;
+  return TRACE_PLOT_MARGIN + (int)lroundf((1.0f - t) * rows);
+}
+
+void TraceView::fillBackground(uint16_t* pixels, bool marker) const {
+  uint16_t background = panelOrder(marker ? TRACE_MARKER_COLOR : TFT_BLACK);
+  for (int y = 0; y < _plotHeight; y++) {
+    pixels[y] = background;
+  }
+  for (int i = 1; i < TRACE_GRID_DIVISIONS; i++) {
+    float weight = _scale.low + (_scale.high - _scale.low) * i / TRACE_GRID_DIVISIONS;
+    pixels[weightToY(weight)] = panelOrder(TRACE_GRID_COLOR);
+  }
+  if (_scale.thresholds) {
+    pixels[weightToY(_scale.lowThreshold)] = panelOrder(TRACE_THRESHOLD_COLOR);
+    pixels[weightToY(_scale.highThreshold)] = panelOrder(TRACE_THRESHOLD_COLOR);
+  }
+  if (!isnan(_scale.target)) {
+    pixels[weightToY(_scale.target)] = panelOrder(TRACE_TARGET_COLOR);
+  }
+  if (marker) {
+    for (int y = 0; y < TRACE_MARKER_HEIGHT; y++) {
+      pixels[y] = panelOrder(TFT_WHITE);
+    }
+  }
+}
+
+void TraceView::drawColumn(const TraceViewInputs& inputs) {
+  if (inputs.samples > 0) {
+    _lastMin = inputs.minWeight;
+    _lastMax = inputs.maxWeight;
+  }
+  bool marker = inputs.shotCount != _lastShotCount;
+  _lastShotCount = inputs.shotCount;
+
+  fillBackground(_pixels, marker);
+  // Everything sampled since the previous column, as a vertical min-max line
+  int top = weightToY(_lastMax);
+  int bottom = weightToY(_lastMin);
+  uint16_t color = panelOrder(inputs.alarmActive ? TFT_RED : TFT_GREEN);
+  for (int y = top; y <= bottom; y++) {
+    _pixels[y] = color;
+  }
+
+  // The newest column always ends up at the right edge of the plot. Without
+  // reversal the write row climbs and the start address follows one behind;
+  // reversed, the write row descends and becomes the start address.
+  uint16_t row;
+  if (_reversed) {
+    row = _scrollTop + (_plotWidth - _head) % _plotWidth;
+  } else {
+    row = _scrollTop + _head;
+  }
+  int x = _reversed ? _panel.width() - 1 - row : row;
+  _panel.pushImage(x, 0, 1, _plotHeight, (const lgfx::swap565_t*)_pixels);
+
+  _head = (_head + 1) % _plotWidth;
+  _columns++;
+  if (_scrolling) {
+    setScrollStart(_reversed ? row : _scrollTop + _head);
+  }
+}
+
+void TraceView::setScrollArea(uint16_t top, uint16_t height, uint16_t bottom) {
+  _panel.writeCommand(ST7789_VSCRDEF);
+  _panel.writeData16(top);
+  _panel.writeData16(height);
+  _panel.writeData16(bottom);
+}
+
+void TraceView::setScrollStart(uint16_t row) {
+  _panel.writeCommand(ST7789_VSCRSADD);
+  _panel.writeData16(row);
+}
+
+void TraceView::drawReadout(const TraceViewInputs& inputs) {
+  int x = _plotWidth + 2;
+  int width = TRACE_READOUT_WIDTH - 2;
+
+  // Size 2 text is 12 px per character; keep the readout to five characters
+  char text[12];
+  if (inputs.weight > -10.0f && inputs.weight < 100.0f) {
+    snprintf(text, sizeof(text), "%.2f", inputs.weight);
+  } else if (inputs.weight > -100.0f && inputs.weight < 1000.0f) {
+    snprintf(text, sizeof(text), "%.1f", inputs.weight);
+  } else {
+    snprintf(text, sizeof(text), "%.0f", inputs.weight);
+  }
+  if (strcmp(text, _weightText) != 0 || inputs.alarmActive != _weightAlarm) {
+    strlcpy(_weightText, text, sizeof(_weightText));
+    _weightAlarm = inputs.alarmActive;
+    _panel.fillRect(x, TRACE_WEIGHT_Y, width, 16, TFT_BLACK);
+    _panel.setTextSize(2);
+    _panel.setTextColor(inputs.alarmActive ? TFT_RED : TFT_WHITE);
+    _panel.setCursor(x, TRACE_WEIGHT_Y);
+    _panel.print(text);
+    _panel.setTextSize(1);
+    _panel.setTextColor(TFT_WHITE);
+    _panel.setCursor(x, TRACE_UNIT_Y);
+    _panel.print("grain");
+  }
+
+  if (inputs.targetGrain > 0) {
+    snprintf(text, sizeof(text), "T %.2f", inputs.targetGrain);
+  } else {
+    text[0] = '\0';
+  }
+  if (strcmp(text, _targetText) != 0) {
+    strlcpy(_targetText, text, sizeof(_targetText));
+    _panel.fillRect(x, TRACE_TARGET_Y, width, 8, TFT_BLACK);
+    _panel.setTextSize(1);
+    _panel.setTextColor(TRACE_TARGET_COLOR);
+    _panel.setCursor(x, TRACE_TARGET_Y);
+    _panel.print(text);
+  }
+}
+
+void TraceView::drawScaleLabels() {
+  int x = _plotWidth + 2;
+  char text[12];
+  _panel.setTextSize(1);
+  _panel.setTextColor(TFT_DARKGREY);
+
+  snprintf(text, sizeof(text), "%.1f", _scale.high);
+  _panel.setCursor(x, TRACE_PLOT_MARGIN);
+  _panel.print(text);
+
+  snprintf(text, sizeof(text), "%.1f", _scale.low);
+  _panel.setCursor(x, _plotHeight - TRACE_PLOT_MARGIN - 8);
+  _panel.print(text);
+}
@@ -0,0 +1,109 @@
+#ifndef TRACE_VIEW_H
+#define TRACE_VIEW_H
+
+#define LGFX_USE_V1
+#include <LovyanGFX.hpp>
+
+// ========================================
+// SCROLLING LIVE TRACE (HARDWARE SCROLL)
+// ========================================
+// Plots the filtered weight over time, one column per display frame, using
+// the ST7789's vertical scrolling (VSCRDEF 0x33 / VSCRSADD 0x37). The panel
+// scrolls its own frame memory, so each frame writes a single new column and
+// moves the scroll start address instead of redrawing the plot.
+//
+// Hardware scrolling moves whole panel rows, which is the 320 px axis. In the
+// landscape rotations those rows are the screen's x axis, so the plot scrolls
+// sideways. A fixed strip on the right holds the readout and is left out of
+// the scroll area.
+//
+// The trace draws straight to the panel, not into the canvas sprite. Call
+// end() before anything else is pushed to the panel again.
+
+// Width of the fixed readout strip to the right of the plot
+#define TRACE_READOUT_WIDTH 64
+
+// Plot range when neither alarm thresholds nor a target are set (grains)
+#define TRACE_DEFAULT_FULL_SCALE 100.0f
+
+// Everything the trace shows, as supplied by the caller each frame
+struct TraceViewInputs {
+  float weight;          // Latest filtered weight, for the readout
+  float minWeight;       // Envelope of the samples since the previous column
+  float maxWeight;
+  uint16_t samples;      // Samples in the envelope; 0 repeats the previous column
+  uint32_t shotCount;    // Recorded shots since boot; a change draws a marker
+  float targetGrain;     // 0 if no config is selected
+  bool alarmActive;
+  bool alarmEnabled;
+  float lowThreshold;
+  float highThreshold;
+};
+
+/**
+ * @brief Live weight trace that scrolls in panel hardware.
+ */
+class TraceView
+{
+public:
+  explicit TraceView(lgfx::LGFX_Device& panel);
+
+  /**
+   * @brief Forces the next render() to clear the panel and restart the trace.
+   */
+  void invalidate() { _valid = false; }
+
+  /**
+   * @brief Adds one column for this frame and updates the readout.
+   *        Restarts the trace when the plot range changes.
+   */
+  void render(const TraceViewInputs& inputs);
+
+  /**
+   * @brief Leaves hardware scroll mode so the panel maps 1:1 to the canvas again.
+   */
+  void end();
+
+  uint32_t columns() const { return _columns; }
+
+private:
+  struct Scale {
+    float low;
+    float high;
+    float target;        // NAN if no target line
+    bool thresholds;     // Threshold lines visible
+    float lowThreshold;
+    float highThreshold;
+  };
+
+  void buildScale(const TraceViewInputs& inputs, Scale& scale) const;
+  bool sameScale(const Scale& a, const Scale& b) const;
+  void restart();
+  int weightToY(float weight) const;
+  void fillBackground(uint16_t* pixels, bool marker) const;
+  void drawColumn(const TraceViewInputs& inputs);
+  void setScrollArea(uint16_t top, uint16_t height, uint16_t bottom);
+  void setScrollStart(uint16_t row);
+  void drawReadout(const TraceViewInputs& inputs);
+  void drawScaleLabels();
+
+  lgfx::LGFX_Device& _panel;
+  Scale _scale;
+  bool _valid;
+  bool _scrolling;       // Scroll area defined on the panel
+  bool _reversed;        // Panel rows run right to left in this rotation
+  int16_t _plotWidth;
+  int16_t _plotHeight;
+  uint16_t _scrollTop;   // First panel row of the scroll area
+  uint16_t _head;        // Columns written modulo the plot width
+  uint16_t* _pixels;     // One column, panel byte order
+  float _lastMin;        // Envelope of the previous column, repeated if no samples arrive
+  float _lastMax;
+  uint32_t _lastShotCount;
+  uint32_t _columns;     // Columns drawn since boot
+  char _weightText[12];  // Retained readout text
+  bool _weightAlarm;     // Readout drawn in the alarm colour
+  char _targetText[12];
+};
+
+#endif // TRACE_VIEW_H
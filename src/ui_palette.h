@@ -0,0 +1,61 @@
+#ifndef UI_PALETTE_H
+#define UI_PALETTE_H
+
+#define LGFX_USE_V1
+#include <LovyanGFX.hpp>
+
+// ========================================
+// INDEXED UI PALETTE
+// ========================================
+// The canvas sprite is a 4-bit palette sprite: 320x172 at 4 bpp is ~27 KB
+// instead of ~110 KB at 16 bpp. Everything drawn into the canvas must use
+// these palette indices, not TFT_* RGB565 values. Drawing straight to the
+// panel (gfx) still takes RGB565. The display pipeline expands indices back
+// to RGB565 while copying pixels into its DMA bands.
+
+enum UiColor : uint8_t {
+  UI_BLACK = 0, // Index 0 so a freshly created sprite is black
+  UI_WHITE,
+  UI_CYAN,
+  UI_GREEN,
+  UI_BLUE,
+  UI_RED,
+  UI_ORANGE,
+  UI_DARKGREY,
+  UI_COLOR_COUNT
+};
+
+// Indices 8..14 are a black-to-white ramp for anti-aliased edges of the
+// pre-rendered weight digits (coverage levels 1..7 of 8, see digit_glyphs.h)
+#define UI_AA_RAMP_FIRST 8
+#define UI_AA_RAMP_LEVELS 7
+
+#define UI_CANVAS_COLOR_DEPTH lgfx::palette_4bit
+
+/**
+ * @brief Loads the UI colours into the palette of an indexed sprite.
+ *        Call after createSprite().
+ */
+inline void applyUiPalette(LGFX_Sprite& sprite) {
+  // RGB888 equivalents of the TFT_* colours the screens were designed with
+  static const uint32_t colors[UI_COLOR_COUNT] = {
+    0x000000, // UI_BLACK
+    0xFFFFFF, // UI_WHITE
+    0x00FFFF, // UI_CYAN
+    0x00FF00, // UI_GREEN
+    0x0000FF, // UI_BLUE
+    0xFF0000, // UI_RED
+    0xFFB400, // UI_ORANGE
+    0x7B7D7B, // UI_DARKGREY
+  };
+  sprite.createPalette();
+  for (size_t i = 0; i < UI_COLOR_COUNT; i++) {
+    sprite.setPaletteColor(i, colors[i]);
+  }
+  for (uint32_t level = 1; level <= UI_AA_RAMP_LEVELS; level++) {
+    uint32_t grey = level * 255 / (UI_AA_RAMP_LEVELS + 1);
+    sprite.setPaletteColor(UI_AA_RAMP_FIRST + level - 1, (grey << 16) | (grey << 8) | grey);
+  }
+}
+
+#endif // UI_PALETTE_H
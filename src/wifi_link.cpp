@@ -0,0 +1,346 @@
+#include <Arduino.h>
+#include <Preferences.h>
+#include "wifi_link.h"
+#include "logger.h"
+
+WifiLink* WifiLink::_instance = nullptr;
+
+// Time left until a deadline, 0 if it has passed
+static uint32_t remainingMs(uint32_t deadlineMs, uint32_t nowMs) {
+  int32_t left = (int32_t)(deadlineMs - nowMs);
+  return left > 0 ? (uint32_t)left : 0;
+}
+
+WifiLink::WifiLink()
+  : _task(nullptr), _state(WIFI_LINK_OFF), _apActive(false), _backoffMs(WIFI_BACKOFF_INITIAL_MS),
+    _attemptStartMs(0), _retryAtMs(0), _downSinceMs(0), _channel(0), _joinedChannel(0),
+    _fastAttempt(false), _rescanPending(false), _cacheDirty(false) {
+  _ssid[0] = '\0';
+  _password[0] = '\0';
+  memset(_bssid, 0, sizeof(_bssid));
+  memset(_joinedBssid, 0, sizeof(_joinedBssid));
+  memset(&_stats, 0, sizeof(_stats));
+  _mux = portMUX_INITIALIZER_UNLOCKED;
+}
+
+void WifiLink::begin(const char* ssid, const char* password) {
+  _instance = this;
+  strlcpy(_ssid, ssid, sizeof(_ssid));
+  strlcpy(_password, password, sizeof(_password));
+
+  if (_ssid[0] == '\0') {
+    _state = WIFI_LINK_OFF;
+    startAccessPoint();
+    return;
+  }
+
+  WiFi.setAutoReconnect(false); // Retries are made here, with backoff
+  WiFi.onEvent(onEvent);
+  WiFi.mode(WIFI_STA);
+  if (staticIp()) {
+    WiFi.config(_staticIp, _gateway, _subnet, _dns); // No DHCP exchange on any attempt
+  }
+
+  bool fast = loadAccessPoint();
+  uint32_t now = millis();
+  portENTER_CRITICAL(&_mux);
+  _state = WIFI_LINK_CONNECTING;
+  _attemptStartMs = now;
+  _downSinceMs = now;
+  _stats.attempts++;
+  _fastAttempt = fast;
+  if (fast) {
+    _stats.fastAttempts++;
+  }
+  portEXIT_CRITICAL(&_mux);
+  if (fast) {
+    LOG_INFO("WiFi: joining %02X:%02X:%02X:%02X:%02X:%02X on channel %u without a scan%s", _bssid[0], _bssid[1],
+                  _bssid[2], _bssid[3], _bssid[4], _bssid[5], _channel, staticIp() ? ", static IP" : "");
+    WiFi.begin(_ssid, _password, _channel, _bssid, true);
+  } else {
+    WiFi.begin(_ssid, _password);
+  }
+
+  if (xTaskCreate(task, "wifiLink", WIFI_LINK_TASK_STACK_SIZE, this, WIFI_LINK_TASK_PRIORITY, &_task) != pdPASS) {
+    LOG_ERROR("WiFi: failed to start link task, no reconnects or AP fallback!");
+    _task = nullptr;
+  }
+}
+
+void WifiLink::setStaticIp(IPAddress ip, IPAddress gateway, IPAddress subnet, IPAddress dns) {
+  _staticIp = ip;
+  _gateway = gateway;
+  _subnet = subnet;
+  _dns = dns;
+}
+
+void WifiLink::onEvent(arduino_event_id_t event, arduino_event_info_t info) {
+  if (_instance != nullptr) {
+    _instance->handleEvent(event, info);
+  }
+}
+
+void WifiLink::handleEvent(arduino_event_id_t event, const arduino_event_info_t& info) {
+  uint32_t now = millis();
+  switch (event) {
+    case ARDUINO_EVENT_WIFI_STA_CONNECTED:
+      // Remember where we got in; saved to NVS once there is an address too
+      portENTER_CRITICAL(&_mux);
+      memcpy(_joinedBssid, info.wifi_sta_connected.bssid, sizeof(_joinedBssid));
+      _joinedChannel = info.wifi_sta_connected.channel;
+      portEXIT_CRITICAL(&_mux);
+      break;
+
+    case ARDUINO_EVENT_WIFI_STA_GOT_IP: {
+      portENTER_CRITICAL(&_mux);
+      _state = WIFI_LINK_CONNECTED;
+      _stats.connects++;
+      if (_fastAttempt) {
+        _stats.fastConnects++;
+        _fastAttempt = false;
+      }
+      if (_joinedChannel != 0 && (_joinedChannel != _channel || memcmp(_joinedBssid, _bssid, sizeof(_bssid)) != 0)) {
+        _cacheDirty = true;
+      }
+      if (_stats.connects > 1) {
+        _stats.reconnects++;
+      }
+      if (_stats.firstConnectMs == 0) {
+        _stats.firstConnectMs = now;
+      }
+      _stats.connectedSinceMs = now;
+      uint32_t downMs = now - _downSinceMs;
+      _backoffMs = WIFI_BACKOFF_INITIAL_MS;
+      portEXIT_CRITICAL(&_mux);
+      LOG_INFO("WiFi: connected, IP %s, after %lu ms without a connection",
+                    IPAddress(info.got_ip.ip_info.ip.addr).toString().c_str(), (unsigned long)downMs);
+      wake(); // The access point may have to go, and the cache may need saving
+      break;
+    }
+
+    case ARDUINO_EVENT_WIFI_STA_DISCONNECTED: {
+      uint8_t reason = info.wifi_sta_disconnected.reason;
+      WifiLinkState state = _state;
+      // ASSOC_LEAVE is our own WiFi.reconnect() ending the previous attempt
+      if (state == WIFI_LINK_OFF || state == WIFI_LINK_BACKOFF ||
+          (state == WIFI_LINK_CONNECTING && reason == WIFI_REASON_ASSOC_LEAVE)) {
+        break;
+      }
+      linkDown(now, reason);
+      LOG_WARN("WiFi: %s (reason %u), next attempt in %lu ms",
+                    state == WIFI_LINK_CONNECTED ? "connection lost" : "attempt failed", reason,
+                    (unsigned long)remainingMs(_retryAtMs, now));
+      wake();
+      break;
+    }
+
+    case ARDUINO_EVENT_WIFI_STA_LOST_IP:
+      if (_state == WIFI_LINK_CONNECTED) {
+        linkDown(now, 0);
+        LOG_WARN("WiFi: address lost, reconnecting");
+        wake();
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+void WifiLink::linkDown(uint32_t nowMs, uint8_t reason) {
+  portENTER_CRITICAL(&_mux);
+  if (_fastAttempt) {
+    // The cached access point is gone or moved: scan right away, no backoff
+    _fastAttempt = false;
+    _rescanPending = true;
+    _stats.lastDisconnectReason = reason;
+    _state = WIFI_LINK_BACKOFF;
+    _retryAtMs = nowMs;
+    portEXIT_CRITICAL(&_mux);
+    return;
+  }
+  if (_state == WIFI_LINK_CONNECTED) {
+    uint32_t uptime = nowMs - _stats.connectedSinceMs;
+    _stats.connectedTotalMs += uptime;
+    _stats.longestUptimeMs = max(_stats.longestUptimeMs, uptime);
+    _stats.disconnects++;
+    _downSinceMs = nowMs;
+  }
+  _stats.lastDisconnectReason = reason;
+  _state = WIFI_LINK_BACKOFF;
+  _retryAtMs = nowMs + _backoffMs;
+  _backoffMs = min((uint32_t)(_backoffMs * 2), (uint32_t)WIFI_BACKOFF_MAX_MS);
+  portEXIT_CRITICAL(&_mux);
+}
+
+void WifiLink::task(void* parameter) {
+  WifiLink* link = (WifiLink*)parameter;
+  for (;;) {
+    uint32_t waitMs = link->step(millis());
+    // Sleeps until the next deadline; driver events cut the wait short
+    ulTaskNotifyTake(pdTRUE, waitMs == UINT32_MAX ? portMAX_DELAY : pdMS_TO_TICKS(waitMs) + 1);
+  }
+}
+
+uint32_t WifiLink::step(uint32_t nowMs) {
+  portENTER_CRITICAL(&_mux);
+  WifiLinkState state = _state;
+  bool attemptTimedOut = state == WIFI_LINK_CONNECTING && nowMs - _attemptStartMs >= attemptTimeoutMs();
+  bool fallbackDue = !_apActive && state != WIFI_LINK_CONNECTED && nowMs - _downSinceMs >= WIFI_AP_FALLBACK_MS;
+  bool apNotNeeded = _apActive && state == WIFI_LINK_CONNECTED;
+  portEXIT_CRITICAL(&_mux);
+
+  if (attemptTimedOut) {
+    linkDown(nowMs, 0);
+    LOG_WARN("WiFi: attempt timed out, next attempt in %lu ms", (unsigned long)remainingMs(_retryAtMs, nowMs));
+  }
+  if (fallbackDue) {
+    startAccessPoint();
+    portENTER_CRITICAL(&_mux);
+    _stats.apFallbacks++;
+    portEXIT_CRITICAL(&_mux);
+  }
+  if (apNotNeeded) {
+    stopAccessPoint();
+  }
+  if (_cacheDirty) {
+    _cacheDirty = false;
+    saveAccessPoint();
+  }
+
+  portENTER_CRITICAL(&_mux);
+  bool attemptDue = _state == WIFI_LINK_BACKOFF && remainingMs(_retryAtMs, nowMs) == 0;
+  if (attemptDue) {
+    _state = WIFI_LINK_CONNECTING;
+    _attemptStartMs = nowMs;
+    _stats.attempts++;
+  }
+  bool rescan = attemptDue && _rescanPending;
+  if (rescan) {
+    _rescanPending = false;
+  }
+  portEXIT_CRITICAL(&_mux);
+  if (rescan) {
+    LOG_WARN("WiFi: cached access point did not answer, scanning");
+    forgetAccessPoint();
+    _channel = 0;
+    WiFi.begin(_ssid, _password); // Clears the BSSID and channel from the station config
+  } else if (attemptDue) {
+    WiFi.reconnect();
+  }
+
+  // Next deadline: end of the attempt or of the backoff, and the fallback
+  uint32_t waitMs = UINT32_MAX;
+  portENTER_CRITICAL(&_mux);
+  if (_state == WIFI_LINK_CONNECTING) {
+    waitMs = remainingMs(_attemptStartMs + attemptTimeoutMs(), nowMs);
+  } else if (_state == WIFI_LINK_BACKOFF) {
+    waitMs = remainingMs(_retryAtMs, nowMs);
+  }
+  if (!_apActive && _state != WIFI_LINK_CONNECTED) {
+    waitMs = min(waitMs, remainingMs(_downSinceMs + WIFI_AP_FALLBACK_MS, nowMs));
+  }
+  portEXIT_CRITICAL(&_mux);
+  return waitMs;
+}
+
+void WifiLink::startAccessPoint() {
+  // With credentials the station keeps trying alongside the access point
+  WiFi.mode(_state == WIFI_LINK_OFF ? WIFI_AP : WIFI_AP_STA);
+  WiFi.softAP(WIFI_AP_SSID, ""); // No password for easy setup
+  IPAddress apIP(192, 168, 4, 1);
+  WiFi.softAPConfig(apIP, apIP, IPAddress(255, 255, 255, 0));
+  _apActive = true;
+  LOG_INFO("WiFi: access point \"%s\" up at %s", WIFI_AP_SSID, apIP.toString().c_str());
+}
+
+void WifiLink::stopAccessPoint() {
+  WiFi.softAPdisconnect(true); // Back to station only
+  _apActive = false;
+  LOG_INFO("WiFi: access point down, station connected");
+}
+
+bool WifiLink::loadAccessPoint() {
+  Preferences prefs;
+  if (!prefs.begin(WIFI_LINK_NVS_NAMESPACE, true)) {
+    return false;
+  }
+  bool found = prefs.isKey("apBssid") && prefs.getBytes("apBssid", _bssid, sizeof(_bssid)) == sizeof(_bssid);
+  _channel = found ? prefs.getUChar("apChannel", 0) : 0;
+  prefs.end();
+  return _channel != 0;
+}
+
+void WifiLink::saveAccessPoint() {
+  portENTER_CRITICAL(&_mux);
+  memcpy(_bssid, _joinedBssid, sizeof(_bssid));
+  _channel = _joinedChannel;
+  portEXIT_CRITICAL(&_mux);
+
+  Preferences prefs;
+  if (!prefs.begin(WIFI_LINK_NVS_NAMESPACE, false)) {
+    LOG_ERROR("WiFi: failed to open NVS, access point not cached");
+    return;
+  }
+  prefs.putBytes("apBssid", _bssid, sizeof(_bssid));
+  prefs.putUChar("apChannel", _channel);
+  prefs.end();
+  LOG_INFO("WiFi: cached access point %02X:%02X:%02X:%02X:%02X:%02X, channel %u", _bssid[0], _bssid[1],
+                _bssid[2], _bssid[3], _bssid[4], _bssid[5], _channel);
+}
+
+void WifiLink::forgetAccessPoint() {
+  Preferences prefs;
+  if (prefs.begin(WIFI_LINK_NVS_NAMESPACE, false)) {
+    if (prefs.isKey("apBssid")) {
+      prefs.remove("apBssid");
+      prefs.remove("apChannel");
+    }
+    prefs.end();
+  }
+}
+
+void WifiLink::wake() {
+  if (_task != nullptr) {
+    xTaskNotifyGive(_task);
+  }
+}
+
+WifiLinkStats WifiLink::stats() const {
+  portENTER_CRITICAL(&_mux);
+  WifiLinkStats copy = _stats;
+  portEXIT_CRITICAL(&_mux);
+  return copy;
+}
+
+uint32_t WifiLink::uptimeMs(uint32_t nowMs) const {
+  portENTER_CRITICAL(&_mux);
+  uint32_t uptime = _state == WIFI_LINK_CONNECTED ? nowMs - _stats.connectedSinceMs : 0;
+  portEXIT_CRITICAL(&_mux);
+  return uptime;
+}
+
+uint64_t WifiLink::connectedTotalMs(uint32_t nowMs) const {
+  portENTER_CRITICAL(&_mux);
+  uint64_t total = _stats.connectedTotalMs;
+  if (_state == WIFI_LINK_CONNECTED) {
+    total += nowMs - _stats.connectedSinceMs;
+  }
+  portEXIT_CRITICAL(&_mux);
+  return total;
+}
+
+const char* WifiLink::stateName(WifiLinkState state) {
+  switch (state) {
+    case WIFI_LINK_OFF:
+      return "off";
+    case WIFI_LINK_CONNECTING:
+      return "connecting";
+    case WIFI_LINK_CONNECTED:
+      return "connected";
+    case WIFI_LINK_BACKOFF:
+      return "backoff";
+    default:
+      return "unknown";
+  }
+}
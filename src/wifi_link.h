@@ -0,0 +1,173 @@
+#ifndef WIFI_LINK_H
+#define WIFI_LINK_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+// ========================================
+// EVENT-DRIVEN WI-FI STATION WITH AP FALLBACK
+// ========================================
+// Nothing here polls or waits. Driver events (got IP, disconnected) update
+// the link state. A small task sleeps until the next deadline or event, and
+// then makes the one Wi-Fi call that is due:
+//   - retry after a failed attempt, with the wait doubling every time
+//     (1 s, 2 s, 4 s ... capped at one minute)
+//   - bring up the "PowderSense" access point once the station has been
+//     down for a while, so the device can still be reached and set up
+//   - take the access point down again as soon as the station is back
+// The station keeps retrying while the access point is up. Callers only
+// read the state, so measuring and drawing never wait for the network.
+//
+// The BSSID and channel of the last access point that gave an address are
+// kept in NVS. The first attempt after boot goes straight to them instead of
+// scanning every channel; if that fails, the cache is dropped and the next
+// attempt does a full scan at once. With a static IP configuration the DHCP
+// exchange is skipped as well. A dynamic lease is not reused without DHCP,
+// since the router may have handed the address to someone else.
+
+// First wait after a failed attempt, doubled up to WIFI_BACKOFF_MAX_MS
+#ifndef WIFI_BACKOFF_INITIAL_MS
+  #define WIFI_BACKOFF_INITIAL_MS 1000
+#endif
+#ifndef WIFI_BACKOFF_MAX_MS
+  #define WIFI_BACKOFF_MAX_MS 60000
+#endif
+
+// An attempt without a result after this long counts as failed
+#ifndef WIFI_ATTEMPT_TIMEOUT_MS
+  #define WIFI_ATTEMPT_TIMEOUT_MS 10000
+#endif
+
+// Time without a station connection before the access point comes up
+#ifndef WIFI_AP_FALLBACK_MS
+  #define WIFI_AP_FALLBACK_MS 15000
+#endif
+
+// Direct association to the cached access point normally takes well under a second
+#ifndef WIFI_FAST_ATTEMPT_TIMEOUT_MS
+  #define WIFI_FAST_ATTEMPT_TIMEOUT_MS 4000
+#endif
+
+// Last good access point is kept next to the credentials
+#define WIFI_LINK_NVS_NAMESPACE "wifi-creds"
+
+#define WIFI_AP_SSID "PowderSense"
+#define WIFI_LINK_TASK_STACK_SIZE 4096
+#define WIFI_LINK_TASK_PRIORITY 1
+
+enum WifiLinkState : uint8_t {
+  WIFI_LINK_OFF,        // No credentials, access point only
+  WIFI_LINK_CONNECTING, // Attempt in progress
+  WIFI_LINK_CONNECTED,  // Station has an address
+  WIFI_LINK_BACKOFF     // Waiting before the next attempt
+};
+
+struct WifiLinkStats {
+  uint32_t attempts;          // Connection attempts started
+  uint32_t connects;          // Times an address was obtained
+  uint32_t reconnects;        // connects after the first one
+  uint32_t disconnects;       // Established connections that dropped
+  uint32_t apFallbacks;       // Times the access point came up
+  uint32_t fastAttempts;      // Attempts straight to the cached BSSID and channel
+  uint32_t fastConnects;      // Of which got an address
+  uint8_t lastDisconnectReason; // wifi_err_reason_t of the last failure or drop
+  uint32_t firstConnectMs;    // millis() of the first address, 0 = not yet
+  uint32_t connectedSinceMs;  // millis() the current connection started
+  uint64_t connectedTotalMs;  // Closed connections only; see WifiLink::connectedTotalMs()
+  uint32_t longestUptimeMs;   // Longest closed connection
+};
+
+/**
+ * @brief Keeps the station connected, with exponential backoff and access point fallback.
+ */
+class WifiLink
+{
+public:
+  WifiLink();
+
+  /**
+   * @brief Uses a fixed address instead of DHCP. Call before begin(); a zero ip means DHCP.
+   */
+  void setStaticIp(IPAddress ip, IPAddress gateway, IPAddress subnet, IPAddress dns);
+  bool staticIp() const { return (uint32_t)_staticIp != 0; }
+
+  /**
+   * @brief Drops the cached access point, e.g. when the credentials change.
+   */
+  static void forgetAccessPoint();
+
+  /**
+   * @brief Starts the link task and the first attempt. Returns at once.
+   * @param ssid Network to join; empty means no credentials, access point only.
+   */
+  void begin(const char* ssid, const char* password);
+
+  WifiLinkState state() const { return _state; }
+  bool connected() const { return _state == WIFI_LINK_CONNECTED; }
+  bool apActive() const { return _apActive; }
+
+  /**
+   * @brief True while the device can only be reached through its access point,
+   *        i.e. it should serve the Wi-Fi setup page.
+   */
+  bool inApMode() const { return _apActive && _state != WIFI_LINK_CONNECTED; }
+
+  WifiLinkStats stats() const;
+
+  /**
+   * @brief Length of the current connection, 0 while disconnected.
+   */
+  uint32_t uptimeMs(uint32_t nowMs) const;
+
+  /**
+   * @brief Time connected since boot, including the current connection.
+   */
+  uint64_t connectedTotalMs(uint32_t nowMs) const;
+
+  /**
+   * @brief Wait before the next attempt after a failure.
+   */
+  uint32_t backoffMs() const { return _backoffMs; }
+
+  static const char* stateName(WifiLinkState state);
+
+private:
+  static void onEvent(arduino_event_id_t event, arduino_event_info_t info);
+  static void task(void* parameter);
+  void handleEvent(arduino_event_id_t event, const arduino_event_info_t& info);
+  void linkDown(uint32_t nowMs, uint8_t reason);
+  uint32_t step(uint32_t nowMs);
+  void startAccessPoint();
+  void stopAccessPoint();
+  void wake();
+  uint32_t attemptTimeoutMs() const { return _fastAttempt ? WIFI_FAST_ATTEMPT_TIMEOUT_MS : WIFI_ATTEMPT_TIMEOUT_MS; }
+  bool loadAccessPoint();
+  void saveAccessPoint();
+
+  static WifiLink* _instance;
+
+  char _ssid[33];
+  char _password[65];
+  TaskHandle_t _task;
+  volatile WifiLinkState _state;
+  volatile bool _apActive;
+  volatile uint32_t _backoffMs;
+  uint32_t _attemptStartMs;
+  uint32_t _retryAtMs;
+  uint32_t _downSinceMs;
+  IPAddress _staticIp;
+  IPAddress _gateway;
+  IPAddress _subnet;
+  IPAddress _dns;
+  uint8_t _bssid[6];        // Cached access point, valid if _channel != 0
+  uint8_t _channel;
+  uint8_t _joinedBssid[6];  // Access point of the current connection
+  uint8_t _joinedChannel;
+  volatile bool _fastAttempt;  // Current attempt targets the cached access point
+  volatile bool _rescanPending; // Next attempt must drop the BSSID and scan
+  volatile bool _cacheDirty;    // Joined access point differs from the cache
+  WifiLinkStats _stats;
+  mutable portMUX_TYPE _mux;
+};
+
+#endif // WIFI_LINK_H
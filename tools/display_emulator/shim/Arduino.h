@@ -0,0 +1,68 @@
+#ifndef EMULATOR_ARDUINO_H
+#define EMULATOR_ARDUINO_H
+
+// ========================================
+// ARDUINO CORE SUBSET FOR THE HOST EMULATOR
+// ========================================
+// Just what the display modules in src/ use: Serial logging, the clock,
+// and the usual helper macros. Serial output goes to stderr so it does not
+// mix with the emulator's report on stdout.
+
+#include <math.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#define PROGMEM
+#define IRAM_ATTR
+
+using std::max;
+using std::min;
+
+template <class T, class L, class H>
+inline T constrain(T value, L low, H high) {
+  return value < low ? low : (value > high ? high : value);
+}
+
+// Same integer arithmetic as the ESP32 core
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  long run = inMax - inMin;
+  if (run == 0) {
+    return -1;
+  }
+  return (x - inMin) * (outMax - outMin) / run + outMin;
+}
+
+// glibc only gained strlcpy in 2.38
+inline size_t emulatorStrlcpy(char* dst, const char* src, size_t size) {
+  size_t length = strlen(src);
+  if (size > 0) {
+    size_t n = length < size - 1 ? length : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return length;
+}
+#define strlcpy emulatorStrlcpy
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+class HardwareSerial
+{
+public:
+  void begin(unsigned long) {}
+  size_t printf(const char* format, ...);
+  size_t print(const char* text) { return fputs(text, stderr) >= 0 ? strlen(text) : 0; }
+  size_t println(const char* text) { return print(text) + print("\n"); }
+  size_t println() { return print("\n"); }
+};
+
+extern HardwareSerial Serial;
+
+#endif // EMULATOR_ARDUINO_H
@@ -0,0 +1,261 @@
+#ifndef EMULATOR_LOVYANGFX_HPP
+#define EMULATOR_LOVYANGFX_HPP
+
+// ========================================
+// LOVYANGFX SUBSET ON AN IN-MEMORY FRAMEBUFFER
+// ========================================
+// Host stand-in for the parts of LovyanGFX the display modules use. Sprites
+// keep their pixels in the same layout as on the device (4-bit palette or
+// byte-swapped RGB565), so code that writes into getBuffer() directly still
+// works. LGFX_Device emulates the ST7789: its frame memory, the rotation
+// mapping, hardware scrolling, and the bytes each operation would put on the
+// SPI bus.
+//
+// Only the built-in 6x8 font (Font0) is drawn. Pixels match the device for
+// the drawing calls implemented here; anything else does not exist, so an
+// unsupported call fails to compile rather than silently drawing nothing.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+static constexpr int TFT_BLACK = 0x0000;
+static constexpr int TFT_NAVY = 0x000F;
+static constexpr int TFT_BLUE = 0x001F;
+static constexpr int TFT_DARKGREY = 0x7BEF;
+static constexpr int TFT_LIGHTGREY = 0xD69A;
+static constexpr int TFT_GREEN = 0x07E0;
+static constexpr int TFT_CYAN = 0x07FF;
+static constexpr int TFT_RED = 0xF800;
+static constexpr int TFT_MAGENTA = 0xF81F;
+static constexpr int TFT_ORANGE = 0xFDA0;
+static constexpr int TFT_YELLOW = 0xFFE0;
+static constexpr int TFT_WHITE = 0xFFFF;
+
+namespace lgfx {
+inline namespace v1 {
+
+enum color_depth_t : uint16_t {
+  bit_mask = 0x00FF,
+  has_palette = 0x0800,
+  palette_1bit = 1 | has_palette,
+  palette_2bit = 2 | has_palette,
+  palette_4bit = 4 | has_palette,
+  palette_8bit = 8 | has_palette,
+  rgb565_2Byte = 16,
+};
+
+struct swap565_t { uint16_t raw; };
+struct bgr888_t { uint8_t b, g, r; };
+
+inline uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+  return (uint16_t)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+}
+
+inline uint16_t swap565(uint8_t r, uint8_t g, uint8_t b) {
+  uint16_t color = color565(r, g, b);
+  return (uint16_t)((color >> 8) | (color << 8));
+}
+
+// What one or more operations would have sent to the panel
+struct PanelTraffic {
+  uint32_t windows;  // Address windows set (CASET + RASET + RAMWR)
+  uint32_t pixels;   // Pixels written to frame memory
+  uint32_t commands; // Other command bytes (writeCommand)
+  uint32_t bytes;    // Everything on the wire: commands, window arguments and pixel data
+};
+
+/**
+ * @brief Drawing surface shared by the emulated panel and sprites.
+ */
+class LovyanGFX
+{
+public:
+  virtual ~LovyanGFX() {}
+
+  int32_t width() const { return _width; }
+  int32_t height() const { return _height; }
+
+  void startWrite() {}
+  void endWrite() {}
+
+  void fillScreen(uint32_t color) { fillRect(0, 0, _width, _height, color); }
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) { fillRect(x, y, w, 1, color); }
+  void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) { fillRect(x, y, 1, h, color); }
+  void drawPixel(int32_t x, int32_t y, uint32_t color) { fillRect(x, y, 1, 1, color); }
+
+  void setClipRect(int32_t x, int32_t y, int32_t w, int32_t h);
+  void clearClipRect() { setClipRect(0, 0, _width, _height); }
+
+  // Text, built-in 6x8 font scaled by the text size
+  void setTextSize(float size) { _textSize = size < 1 ? 1 : (int)size; }
+  void setTextColor(uint32_t color) { _textColor = color; _textBackground = color; }
+  void setTextColor(uint32_t color, uint32_t background) { _textColor = color; _textBackground = background; }
+  void setTextWrap(bool wrap) { _textWrap = wrap; }
+  void setCursor(int32_t x, int32_t y) { _cursorX = x; _cursorY = y; }
+  int32_t getCursorX() const { return _cursorX; }
+  int32_t getCursorY() const { return _cursorY; }
+  int32_t textWidth(const char* text) const;
+  int32_t fontHeight() const { return 8 * _textSize; }
+
+  size_t write(uint8_t c);
+  size_t print(const char* text);
+  size_t print(char c) { return write(c); }
+  size_t print(int value);
+  size_t print(double value, int digits = 2);
+  size_t println(const char* text) { return print(text) + write('\n'); }
+  size_t println() { return write('\n'); }
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+protected:
+  LovyanGFX() : _width(0), _height(0) { resetState(); }
+
+  void resetState();
+  void setSize(int32_t width, int32_t height);
+
+  /**
+   * @brief Fills an area already clipped to the surface and the clip rectangle.
+   */
+  virtual void fillClipped(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) = 0;
+
+  /**
+   * @brief Writes RGB565 pixels (native byte order) into an area, clipped.
+   */
+  virtual void writeImage565(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* pixels, bool swapped) = 0;
+
+  bool clip(int32_t& x, int32_t& y, int32_t& w, int32_t& h) const;
+
+  int32_t _width;
+  int32_t _height;
+  int32_t _clipX, _clipY, _clipW, _clipH;
+
+private:
+  void drawChar(uint8_t c);
+
+  int32_t _cursorX, _cursorY;
+  int _textSize;
+  uint32_t _textColor;
+  uint32_t _textBackground;
+  bool _textWrap;
+
+  friend class LGFX_Sprite;
+};
+
+/**
+ * @brief Emulated ST7789 panel: frame memory, rotation, hardware scroll and SPI traffic.
+ */
+class LGFX_Device : public LovyanGFX
+{
+public:
+  /**
+   * @param memoryWidth, memoryHeight Panel frame memory in its native portrait orientation.
+   */
+  LGFX_Device(int32_t memoryWidth, int32_t memoryHeight);
+
+  void setRotation(uint8_t rotation);
+  uint8_t getRotation() const { return _rotation; }
+  void setBrightness(uint8_t brightness) { _brightness = brightness; }
+  uint8_t getBrightness() const { return _brightness; }
+
+  void writeCommand(uint32_t command);
+  void writeData(uint32_t data);
+  void writeData16(uint32_t data);
+
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const swap565_t* pixels) {
+    writeImage565(x, y, w, h, (const uint16_t*)pixels, true);
+  }
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* pixels) {
+    writeImage565(x, y, w, h, pixels, false);
+  }
+  // Transfers complete immediately on the host
+  void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, const swap565_t* pixels) { pushImage(x, y, w, h, pixels); }
+  bool dmaBusy() const { return false; }
+  void waitDMA() {}
+
+  // --- Emulator only ---
+
+  /**
+   * @brief RGB565 colour currently shown at a screen position, after rotation and scrolling.
+   */
+  uint16_t shownPixel(int32_t x, int32_t y) const;
+
+  bool scrolling() const { return _scrollMode; }
+  const PanelTraffic& traffic() const { return _traffic; }
+  void resetTraffic();
+
+protected:
+  void fillClipped(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) override;
+  void writeImage565(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* pixels, bool swapped) override;
+
+private:
+  void memoryPosition(int32_t x, int32_t y, int32_t& row, int32_t& column) const;
+  void countWindow(uint32_t pixels);
+
+  int32_t _memoryWidth;   // Columns, 172 on this board
+  int32_t _memoryHeight;  // Rows, the hardware scroll axis
+  std::vector<uint16_t> _memory;
+  uint8_t _rotation;
+  uint8_t _brightness;
+
+  uint32_t _command;      // Last command, its arguments follow in _arguments
+  uint16_t _arguments[4];
+  int _argumentCount;
+  bool _scrollMode;
+  int32_t _fixedTop, _scrollHeight, _scrollStart;
+
+  PanelTraffic _traffic;
+};
+
+/**
+ * @brief Off-screen sprite, 4-bit palette or 16-bit RGB565 like on the device.
+ */
+class LGFX_Sprite : public LovyanGFX
+{
+public:
+  LGFX_Sprite() : _depth(rgb565_2Byte) {}
+  explicit LGFX_Sprite(LovyanGFX*) : _depth(rgb565_2Byte) {}
+
+  void setColorDepth(color_depth_t depth) { _depth = depth; }
+  color_depth_t getColorDepth() const { return _depth; }
+  void* createSprite(int32_t width, int32_t height);
+  void deleteSprite();
+
+  bool createPalette();
+  void setPaletteColor(size_t index, uint32_t rgb888);
+  const bgr888_t* getPalette() const { return _palette.empty() ? nullptr : _palette.data(); }
+  uint32_t getPaletteCount() const { return _palette.size(); }
+
+  void* getBuffer() { return _buffer.empty() ? nullptr : _buffer.data(); }
+  void fillSprite(uint32_t color) { fillScreen(color); }
+
+  /**
+   * @brief Copies the sprite to a surface at (x, y), honouring the target's clip rectangle.
+   */
+  void pushSprite(LovyanGFX* target, int32_t x, int32_t y);
+
+  /**
+   * @brief RGB565 value of a pixel, palette indices expanded.
+   */
+  uint16_t readPixel565(int32_t x, int32_t y) const;
+
+protected:
+  void fillClipped(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) override;
+  void writeImage565(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* pixels, bool swapped) override;
+
+private:
+  void setPixel(int32_t x, int32_t y, uint32_t value);
+  int32_t strideBytes() const;
+
+  color_depth_t _depth;
+  std::vector<uint8_t> _buffer;
+  std::vector<bgr888_t> _palette;
+};
+
+} // namespace v1
+} // namespace lgfx
+
+using lgfx::LGFX_Sprite;
+
+#endif // EMULATOR_LOVYANGFX_HPP
@@ -0,0 +1,16 @@
+#ifndef EMULATOR_ESP_HEAP_CAPS_H
+#define EMULATOR_ESP_HEAP_CAPS_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// The host has no DMA-capable region; any heap memory will do
+#define MALLOC_CAP_DMA (1 << 3)
+#define MALLOC_CAP_8BIT (1 << 2)
+
+inline void* heap_caps_malloc(size_t size, uint32_t caps) {
+  (void)caps;
+  return malloc(size);
+}
+
+#endif // EMULATOR_ESP_HEAP_CAPS_H
@@ -0,0 +1,418 @@
+// ========================================
+// HOST DISPLAY EMULATOR
+// ========================================
+// Runs the firmware's screen code from src/ against an emulated ST7789 on
+// the PC. Every scene feeds a fixed sequence of inputs through the same
+// calls the display task makes, then
+//   - reports the pixels and SPI bytes each frame would push,
+//   - writes a PNG of what the panel shows at the end (--out), and
+//   - compares that against a golden image (--golden, --update to accept).
+// The exit code is non-zero if any scene differs from its golden image.
+
+#include <Arduino.h>
+#include <sys/stat.h>
+#include <string>
+#include "board_config.h"
+#include "display_pipeline.h"
+#include "image_assets.h"
+#include "measurement_screen.h"
+#include "png_io.h"
+#include "rle_image.h"
+#include "status_screens.h"
+#include "trace_view.h"
+#include "ui_palette.h"
+
+#define DEFAULT_GOLDEN_DIR "tools/display_emulator/golden"
+#define DEFAULT_SPI_FREQUENCY 10000000 // DISPLAY_SPI_FREQ_WRITE in main.cpp
+#define EMULATOR_IP "192.168.1.50"
+
+// Panel, canvas and screens of one scene, set up like setupDisplay() does
+struct SceneContext {
+  lgfx::LGFX_Device panel;
+  LGFX_Sprite canvas;
+  MeasurementScreen measurementScreen;
+  TraceView traceView;
+
+  uint32_t frames;
+  lgfx::PanelTraffic first;  // First frame, usually a full redraw
+  lgfx::PanelTraffic later;  // Sum of all frames after the first
+
+  explicit SceneContext(uint8_t rotation)
+    : panel(DISPLAY_WIDTH, DISPLAY_HEIGHT), canvas(&panel), measurementScreen(canvas), traceView(panel),
+      frames(0), first(), later() {
+    panel.setRotation(rotation);
+    panel.fillScreen(TFT_BLACK);
+    canvas.setColorDepth(UI_CANVAS_COLOR_DEPTH);
+    canvas.createSprite(panel.width(), panel.height());
+    applyUiPalette(canvas);
+    canvas.fillSprite(UI_BLACK);
+    displayPipeline.begin(panel, canvas, DEFAULT_SPI_FREQUENCY);
+    panel.resetTraffic();
+  }
+
+  /**
+   * @brief Pushes a canvas region through the display pipeline, as pushDirtyRegion() does.
+   */
+  void push(const DirtyRegion& region) {
+    displayPipeline.submit(region);
+    displayPipeline.flush();
+  }
+
+  void pushFullCanvas() {
+    DirtyRegion frame;
+    frame.add(0, 0, canvas.width(), canvas.height());
+    push(frame);
+  }
+
+  /**
+   * @brief Closes a frame: books the panel traffic since the previous call.
+   */
+  void endFrame() {
+    const lgfx::PanelTraffic& traffic = panel.traffic();
+    if (frames == 0) {
+      first = traffic;
+    } else {
+      later.windows += traffic.windows;
+      later.pixels += traffic.pixels;
+      later.commands += traffic.commands;
+      later.bytes += traffic.bytes;
+    }
+    frames++;
+    panel.resetTraffic();
+  }
+};
+
+struct Scene {
+  const char* name;
+  const char* description;
+  void (*run)(SceneContext& context);
+};
+
+// ========================================
+// SCENES
+// ========================================
+
+static MeasurementScreenInputs measurementInputs(float weight, bool alarmActive) {
+  MeasurementScreenInputs inputs;
+  inputs.weight = weight;
+  inputs.configName = "Varget 223 Rem";
+  inputs.targetGrain = 24.0f;
+  inputs.alarmActive = alarmActive;
+  inputs.alarmEnabled = true;
+  inputs.lowThreshold = 23.8f;
+  inputs.highThreshold = 24.2f;
+  inputs.ip = EMULATOR_IP;
+  inputs.offline = false;
+  inputs.queuedShots = 0;
+  return inputs;
+}
+
+static void runSplash(SceneContext& context) {
+  const RleImage& image = SPLASH_IMAGE;
+  drawRleImage(context.panel, image, (context.panel.width() - image.width) / 2, (context.panel.height() - image.height) / 2);
+  context.endFrame();
+}
+
+static void runMeasurementNoConfig(SceneContext& context) {
+  MeasurementScreenInputs inputs = measurementInputs(0.0f, false);
+  inputs.configName = nullptr;
+  inputs.targetGrain = 0.0f;
+  inputs.alarmEnabled = false;
+  context.push(context.measurementScreen.render(inputs));
+  context.endFrame();
+}
+
+static void runMeasurementLow(SceneContext& context) {
+  context.push(context.measurementScreen.render(measurementInputs(22.314f, false)));
+  context.endFrame();
+}
+
+static void runMeasurementPerfect(SceneContext& context) {
+  context.push(context.measurementScreen.render(measurementInputs(24.052f, false)));
+  context.endFrame();
+}
+
+static void runMeasurementHighAlarm(SceneContext& context) {
+  context.push(context.measurementScreen.render(measurementInputs(25.408f, true)));
+  context.endFrame();
+}
+
+static void runMeasurementSettling(SceneContext& context) {
+  // A charge trickling up to the target: after the first full frame only
+  // the changed digits and the bar edge should go out
+  for (int i = 0; i <= 40; i++) {
+    float weight = 23.0f + 1.05f * (1.0f - expf(-i / 8.0f));
+    context.push(context.measurementScreen.render(measurementInputs(weight, false)));
+    context.endFrame();
+  }
+}
+
+static void runMeasurementSteady(SceneContext& context) {
+  // Unchanged reading: frames after the first should push nothing
+  for (int i = 0; i < 10; i++) {
+    context.push(context.measurementScreen.render(measurementInputs(24.052f, false)));
+    context.endFrame();
+  }
+}
+
+static void runMeasurementOffline(SceneContext& context) {
+  // Network drops with a reading on screen, then shots are taken offline:
+  // only the footer should go out after the first frame
+  MeasurementScreenInputs inputs = measurementInputs(24.052f, false);
+  context.push(context.measurementScreen.render(inputs));
+  context.endFrame();
+  inputs.offline = true;
+  for (uint32_t shots = 0; shots <= 3; shots++) {
+    inputs.queuedShots = shots;
+    context.push(context.measurementScreen.render(inputs));
+    context.endFrame();
+  }
+}
+
+static void runCalibrationZero(SceneContext& context) {
+  context.canvas.fillScreen(UI_BLACK);
+  drawCalibrationScreen(context.canvas, CALIBRATE_ZERO_STEP, 1873.0f, 0.0f);
+  context.pushFullCanvas();
+  context.endFrame();
+}
+
+static void runCalibrationKnownGrains(SceneContext& context) {
+  context.canvas.fillScreen(UI_BLACK);
+  drawCalibrationScreen(context.canvas, CALIBRATE_KNOWN_GRAINS_STEP, 9120.0f, 24.123f);
+  context.pushFullCanvas();
+  context.endFrame();
+}
+
+static void runAPMode(SceneContext& context) {
+  context.canvas.fillScreen(UI_BLACK);
+  drawAPModeScreen(context.canvas);
+  context.pushFullCanvas();
+  context.endFrame();
+}
+
+static void runTrace(SceneContext& context) {
+  // Three charges thrown one after another, each settling around the target,
+  // with a shot recorded once each has settled. Longer than the plot is wide,
+  // so the hardware scroll wraps around.
+  TraceViewInputs inputs;
+  memset(&inputs, 0, sizeof(inputs));
+  inputs.targetGrain = 24.0f;
+  inputs.alarmEnabled = true;
+  inputs.lowThreshold = 23.8f;
+  inputs.highThreshold = 24.2f;
+
+  const int chargeFrames = 150;
+  for (int frame = 0; frame < 3 * chargeFrames; frame++) {
+    int t = frame % chargeFrames;
+    float settled = 23.9f + 0.1f * (frame / chargeFrames);
+    float weight = t < 100 ? settled * (1.0f - expf(-t / 15.0f)) : settled;
+    inputs.weight = weight;
+    inputs.minWeight = weight - 0.02f;
+    inputs.maxWeight = weight + 0.02f;
+    inputs.samples = 3;
+    if (t == 120) {
+      inputs.shotCount++;
+    }
+    inputs.alarmActive = t >= 100 && (weight < inputs.lowThreshold || weight > inputs.highThreshold);
+    context.traceView.render(inputs);
+    context.endFrame();
+  }
+}
+
+static const Scene SCENES[] = {
+  { "splash", "Boot splash streamed from the RLE asset", runSplash },
+  { "measurement_no_config", "Measurement screen before a config is selected", runMeasurementNoConfig },
+  { "measurement_low", "Below the low threshold", runMeasurementLow },
+  { "measurement_perfect", "Inside the threshold band", runMeasurementPerfect },
+  { "measurement_high_alarm", "Above the high threshold with the alarm active", runMeasurementHighAlarm },
+  { "measurement_settling", "41 frames of a reading settling on the target", runMeasurementSettling },
+  { "measurement_steady", "10 frames of an unchanged reading", runMeasurementSteady },
+  { "measurement_offline", "Network lost, three shots recorded offline", runMeasurementOffline },
+  { "calibration_zero", "Calibration wizard, step 1", runCalibrationZero },
+  { "calibration_known_grains", "Calibration wizard, step 2", runCalibrationKnownGrains },
+  { "ap_mode", "Access point mode screen", runAPMode },
+  { "trace", "450 frames of the scrolling trace", runTrace },
+};
+static const size_t SCENE_COUNT = sizeof(SCENES) / sizeof(SCENES[0]);
+
+// ========================================
+// SNAPSHOTS AND GOLDEN IMAGES
+// ========================================
+
+static Rgb565Image capture(const lgfx::LGFX_Device& panel) {
+  Rgb565Image image;
+  image.width = panel.width();
+  image.height = panel.height();
+  image.pixels.resize(image.width * image.height);
+  for (int32_t y = 0; y < image.height; y++) {
+    for (int32_t x = 0; x < image.width; x++) {
+      image.pixels[y * image.width + x] = panel.shownPixel(x, y);
+    }
+  }
+  return image;
+}
+
+/**
+ * @brief Counts differing pixels and paints a diff image: differences red, the rest dimmed.
+ */
+static uint32_t compareImages(const Rgb565Image& actual, const Rgb565Image& golden, Rgb565Image& diff) {
+  diff = actual;
+  if (actual.width != golden.width || actual.height != golden.height) {
+    return actual.width * actual.height;
+  }
+  uint32_t differing = 0;
+  for (size_t i = 0; i < actual.pixels.size(); i++) {
+    if (actual.pixels[i] != golden.pixels[i]) {
+      diff.pixels[i] = TFT_RED;
+      differing++;
+    } else {
+      diff.pixels[i] = (actual.pixels[i] >> 2) & 0x39E7; // Each channel at a quarter
+    }
+  }
+  return differing;
+}
+
+static std::string joinPath(const char* dir, const char* name, const char* suffix) {
+  return std::string(dir) + "/" + name + suffix;
+}
+
+// ========================================
+// COMMAND LINE
+// ========================================
+
+struct Options {
+  const char* scene;      // nullptr = all
+  const char* outDir;     // nullptr = no snapshots
+  const char* goldenDir;
+  bool update;
+  uint8_t rotation;
+  uint32_t spiFrequency;
+};
+
+static void printUsage(const char* program) {
+  printf("Usage: %s [options]\n"
+         "  --list            List the scenes and exit\n"
+         "  --scene NAME      Run one scene only\n"
+         "  --out DIR         Write <scene>.png (and <scene>.diff.png on a mismatch) to DIR\n"
+         "  --golden DIR      Golden images to compare against (default %s)\n"
+         "  --update          Replace the golden images with this run's output\n"
+         "  --rotation N      Panel rotation, 0-7 (default %d, as on the board)\n"
+         "  --spi-mhz N       SPI clock for wire time estimates (default %d)\n",
+         program, DEFAULT_GOLDEN_DIR, DISPLAY_ROTATION, DEFAULT_SPI_FREQUENCY / 1000000);
+}
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+  options.scene = nullptr;
+  options.outDir = nullptr;
+  options.goldenDir = DEFAULT_GOLDEN_DIR;
+  options.update = false;
+  options.rotation = DISPLAY_ROTATION;
+  options.spiFrequency = DEFAULT_SPI_FREQUENCY;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--list") {
+      for (size_t s = 0; s < SCENE_COUNT; s++) {
+        printf("%-26s %s\n", SCENES[s].name, SCENES[s].description);
+      }
+      exit(0);
+    } else if (arg == "--scene" && hasValue) {
+      options.scene = argv[++i];
+    } else if (arg == "--out" && hasValue) {
+      options.outDir = argv[++i];
+    } else if (arg == "--golden" && hasValue) {
+      options.goldenDir = argv[++i];
+    } else if (arg == "--update") {
+      options.update = true;
+    } else if (arg == "--rotation" && hasValue) {
+      options.rotation = atoi(argv[++i]) & 7;
+    } else if (arg == "--spi-mhz" && hasValue) {
+      options.spiFrequency = atoi(argv[++i]) * 1000000;
+    } else {
+      printUsage(argv[0]);
+      return false;
+    }
+  }
+  return options.spiFrequency > 0;
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    return 2;
+  }
+  if (options.outDir != nullptr) {
+    mkdir(options.outDir, 0755);
+  }
+
+  bool landscape = options.rotation & 1;
+  printf("Screen %dx%d, rotation %d, SPI %lu MHz\n\n", landscape ? DISPLAY_HEIGHT : DISPLAY_WIDTH,
+         landscape ? DISPLAY_WIDTH : DISPLAY_HEIGHT, options.rotation, (unsigned long)(options.spiFrequency / 1000000));
+  printf("%-26s %6s | %-24s | %-33s | %s\n", "", "", "first frame", "later frames, average", "");
+  printf("%-26s %6s | %8s %8s %6s | %8s %8s %6s %8s | %s\n", "scene", "frames", "pixels", "bytes", "ms",
+         "pixels", "bytes", "ms", "windows", "golden");
+
+  int failures = 0;
+  bool found = false;
+  for (size_t s = 0; s < SCENE_COUNT; s++) {
+    const Scene& scene = SCENES[s];
+    if (options.scene != nullptr && strcmp(options.scene, scene.name) != 0) {
+      continue;
+    }
+    found = true;
+
+    SceneContext context(options.rotation);
+    scene.run(context);
+    Rgb565Image shown = capture(context.panel);
+    context.traceView.end();
+
+    // Wire time at the configured clock, ignoring gaps between transfers
+    float msPerByte = 8000.0f / options.spiFrequency;
+    uint32_t laterFrames = context.frames > 1 ? context.frames - 1 : 1;
+    printf("%-26s %6lu | %8lu %8lu %6.1f | %8lu %8lu %6.2f %8.1f | ", scene.name, (unsigned long)context.frames,
+           (unsigned long)context.first.pixels, (unsigned long)context.first.bytes, context.first.bytes * msPerByte,
+           (unsigned long)(context.later.pixels / laterFrames), (unsigned long)(context.later.bytes / laterFrames),
+           context.later.bytes * msPerByte / laterFrames, (float)context.later.windows / laterFrames);
+
+    if (options.outDir != nullptr) {
+      writePng(joinPath(options.outDir, scene.name, ".png").c_str(), shown);
+    }
+
+    std::string goldenPath = joinPath(options.goldenDir, scene.name, ".png");
+    if (options.update) {
+      bool written = writePng(goldenPath.c_str(), shown);
+      printf("%s\n", written ? "updated" : "WRITE FAILED");
+      failures += written ? 0 : 1;
+      continue;
+    }
+
+    Rgb565Image golden;
+    if (!readPng(goldenPath.c_str(), golden)) {
+      printf("MISSING (run with --update)\n");
+      failures++;
+      continue;
+    }
+    Rgb565Image diff;
+    uint32_t differing = compareImages(shown, golden, diff);
+    if (differing == 0) {
+      printf("match\n");
+      continue;
+    }
+    printf("DIFFERS in %lu pixels\n", (unsigned long)differing);
+    failures++;
+    if (options.outDir != nullptr) {
+      writePng(joinPath(options.outDir, scene.name, ".diff.png").c_str(), diff);
+    }
+  }
+
+  if (!found) {
+    printf("Unknown scene: %s (see --list)\n", options.scene);
+    return 2;
+  }
+  if (failures > 0) {
+    printf("\n%d scene(s) failed\n", failures);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,390 @@
+#include <Arduino.h>
+#include <LovyanGFX.hpp>
+#include "../../../lib/Arduino_GFX/font/glcdfont.h" // Same classic 5x7 font as LovyanGFX's Font0
+
+// ST7789 commands the emulated panel interprets
+#define ST7789_NORON   0x13
+#define ST7789_VSCRDEF 0x33
+#define ST7789_VSCRSADD 0x37
+
+// CASET and RASET with four argument bytes each, then RAMWR
+#define WINDOW_OVERHEAD_BYTES 11
+
+namespace lgfx {
+inline namespace v1 {
+
+// ========================================
+// COMMON DRAWING SURFACE
+// ========================================
+
+void LovyanGFX::resetState() {
+  _cursorX = 0;
+  _cursorY = 0;
+  _textSize = 1;
+  _textColor = TFT_WHITE;
+  _textBackground = TFT_WHITE;
+  _textWrap = true;
+  clearClipRect();
+}
+
+void LovyanGFX::setSize(int32_t width, int32_t height) {
+  _width = width;
+  _height = height;
+  clearClipRect();
+}
+
+void LovyanGFX::setClipRect(int32_t x, int32_t y, int32_t w, int32_t h) {
+  int32_t left = max(x, (int32_t)0);
+  int32_t top = max(y, (int32_t)0);
+  int32_t right = min(x + w, _width);
+  int32_t bottom = min(y + h, _height);
+  _clipX = left;
+  _clipY = top;
+  _clipW = max(right - left, (int32_t)0);
+  _clipH = max(bottom - top, (int32_t)0);
+}
+
+bool LovyanGFX::clip(int32_t& x, int32_t& y, int32_t& w, int32_t& h) const {
+  int32_t left = max(x, _clipX);
+  int32_t top = max(y, _clipY);
+  int32_t right = min(x + w, _clipX + _clipW);
+  int32_t bottom = min(y + h, _clipY + _clipH);
+  if (right <= left || bottom <= top) {
+    return false;
+  }
+  x = left;
+  y = top;
+  w = right - left;
+  h = bottom - top;
+  return true;
+}
+
+void LovyanGFX::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  if (clip(x, y, w, h)) {
+    fillClipped(x, y, w, h, color);
+  }
+}
+
+void LovyanGFX::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  if (w <= 0 || h <= 0) {
+    return;
+  }
+  drawFastHLine(x, y, w, color);
+  drawFastHLine(x, y + h - 1, w, color);
+  drawFastVLine(x, y + 1, h - 2, color);
+  drawFastVLine(x + w - 1, y + 1, h - 2, color);
+}
+
+int32_t LovyanGFX::textWidth(const char* text) const {
+  return (int32_t)strlen(text) * 6 * _textSize;
+}
+
+void LovyanGFX::drawChar(uint8_t c) {
+  int32_t size = _textSize;
+  bool opaque = _textBackground != _textColor;
+  for (int column = 0; column < 6; column++) {
+    uint8_t bits = column < 5 ? font[c * 5 + column] : 0; // Sixth column is spacing
+    for (int row = 0; row < 8; row++) {
+      int32_t x = _cursorX + column * size;
+      int32_t y = _cursorY + row * size;
+      if (bits & (1 << row)) {
+        fillRect(x, y, size, size, _textColor);
+      } else if (opaque) {
+        fillRect(x, y, size, size, _textBackground);
+      }
+    }
+  }
+}
+
+size_t LovyanGFX::write(uint8_t c) {
+  if (c == '\n') {
+    _cursorX = 0;
+    _cursorY += fontHeight();
+    return 1;
+  }
+  if (c == '\r') {
+    return 1;
+  }
+  if (_textWrap && _cursorX + 6 * _textSize > _width) {
+    _cursorX = 0;
+    _cursorY += fontHeight();
+  }
+  drawChar(c);
+  _cursorX += 6 * _textSize;
+  return 1;
+}
+
+size_t LovyanGFX::print(const char* text) {
+  size_t n = 0;
+  while (*text) {
+    n += write((uint8_t)*text++);
+  }
+  return n;
+}
+
+size_t LovyanGFX::print(int value) {
+  char text[16];
+  snprintf(text, sizeof(text), "%d", value);
+  return print(text);
+}
+
+size_t LovyanGFX::print(double value, int digits) {
+  char text[32];
+  snprintf(text, sizeof(text), "%.*f", digits, value);
+  return print(text);
+}
+
+size_t LovyanGFX::printf(const char* format, ...) {
+  char text[256];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(text, sizeof(text), format, args);
+  va_end(args);
+  return print(text);
+}
+
+// ========================================
+// EMULATED ST7789 PANEL
+// ========================================
+
+LGFX_Device::LGFX_Device(int32_t memoryWidth, int32_t memoryHeight)
+  : _memoryWidth(memoryWidth), _memoryHeight(memoryHeight), _memory(memoryWidth * memoryHeight, 0),
+    _rotation(0), _brightness(255), _command(0), _argumentCount(0), _scrollMode(false),
+    _fixedTop(0), _scrollHeight(memoryHeight), _scrollStart(0) {
+  memset(_arguments, 0, sizeof(_arguments));
+  setSize(memoryWidth, memoryHeight);
+  resetTraffic();
+}
+
+void LGFX_Device::setRotation(uint8_t rotation) {
+  _rotation = rotation & 7;
+  if (_rotation & 1) {
+    setSize(_memoryHeight, _memoryWidth);
+  } else {
+    setSize(_memoryWidth, _memoryHeight);
+  }
+}
+
+void LGFX_Device::memoryPosition(int32_t x, int32_t y, int32_t& row, int32_t& column) const {
+  // Landscape rotations swap the axes, so screen x runs along the panel rows
+  // (the hardware scroll axis); rotations 2 and 3 address from the far end,
+  // and 4-7 mirror 0-3
+  switch (_rotation & 3) {
+    case 0: row = y; column = x; break;
+    case 1: row = x; column = _memoryWidth - 1 - y; break;
+    case 2: row = _memoryHeight - 1 - y; column = _memoryWidth - 1 - x; break;
+    default: row = _memoryHeight - 1 - x; column = y; break;
+  }
+  if (_rotation & 4) {
+    column = _memoryWidth - 1 - column;
+  }
+}
+
+uint16_t LGFX_Device::shownPixel(int32_t x, int32_t y) const {
+  int32_t row, column;
+  memoryPosition(x, y, row, column);
+  if (_scrollMode && _scrollHeight > 0 && row >= _fixedTop && row < _fixedTop + _scrollHeight) {
+    // The scroll area shows frame memory starting at the scroll start address, wrapping around
+    int32_t offset = (row - _fixedTop) + (_scrollStart - _fixedTop);
+    row = _fixedTop + ((offset % _scrollHeight) + _scrollHeight) % _scrollHeight;
+  }
+  return _memory[row * _memoryWidth + column];
+}
+
+void LGFX_Device::resetTraffic() {
+  memset(&_traffic, 0, sizeof(_traffic));
+}
+
+void LGFX_Device::countWindow(uint32_t pixels) {
+  _traffic.windows++;
+  _traffic.pixels += pixels;
+  _traffic.bytes += WINDOW_OVERHEAD_BYTES + pixels * 2;
+}
+
+void LGFX_Device::writeCommand(uint32_t command) {
+  _traffic.commands++;
+  _traffic.bytes++;
+  _command = command;
+  _argumentCount = 0;
+  if (command == ST7789_NORON) {
+    _scrollMode = false;
+  }
+}
+
+void LGFX_Device::writeData(uint32_t data) {
+  _traffic.bytes++;
+  (void)data;
+}
+
+void LGFX_Device::writeData16(uint32_t data) {
+  _traffic.bytes += 2;
+  if (_argumentCount < 4) {
+    _arguments[_argumentCount++] = (uint16_t)data;
+  }
+  if (_command == ST7789_VSCRDEF && _argumentCount == 3) {
+    _fixedTop = _arguments[0];
+    _scrollHeight = _arguments[1];
+    if (_arguments[0] + _arguments[1] + _arguments[2] != _memoryHeight) {
+      Serial.printf("Emulated panel: VSCRDEF areas add up to %d rows, panel has %d\n",
+                    _arguments[0] + _arguments[1] + _arguments[2], (int)_memoryHeight);
+    }
+  } else if (_command == ST7789_VSCRSADD && _argumentCount == 1) {
+    _scrollStart = _arguments[0];
+    _scrollMode = true;
+  }
+}
+
+void LGFX_Device::fillClipped(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  countWindow((uint32_t)w * h);
+  for (int32_t j = y; j < y + h; j++) {
+    for (int32_t i = x; i < x + w; i++) {
+      int32_t row, column;
+      memoryPosition(i, j, row, column);
+      _memory[row * _memoryWidth + column] = (uint16_t)color;
+    }
+  }
+}
+
+void LGFX_Device::writeImage565(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* pixels, bool swapped) {
+  int32_t left = x, top = y, width = w, height = h;
+  if (!clip(left, top, width, height)) {
+    return;
+  }
+  countWindow((uint32_t)width * height);
+  for (int32_t j = top; j < top + height; j++) {
+    for (int32_t i = left; i < left + width; i++) {
+      uint16_t color = pixels[(j - y) * w + (i - x)];
+      if (swapped) {
+        color = (uint16_t)((color >> 8) | (color << 8));
+      }
+      int32_t row, column;
+      memoryPosition(i, j, row, column);
+      _memory[row * _memoryWidth + column] = color;
+    }
+  }
+}
+
+// ========================================
+// SPRITES
+// ========================================
+
+int32_t LGFX_Sprite::strideBytes() const {
+  return _depth == palette_4bit ? (_width + 1) >> 1 : _width * 2;
+}
+
+void* LGFX_Sprite::createSprite(int32_t width, int32_t height) {
+  if ((_depth & bit_mask) != 4 && (_depth & bit_mask) != 16) {
+    Serial.printf("Emulated sprite: colour depth %d is not supported\n", _depth & bit_mask);
+    return nullptr;
+  }
+  setSize(width, height);
+  _buffer.assign(strideBytes() * height, 0);
+  return _buffer.data();
+}
+
+void LGFX_Sprite::deleteSprite() {
+  _buffer.clear();
+  _palette.clear();
+  setSize(0, 0);
+}
+
+bool LGFX_Sprite::createPalette() {
+  if (!(_depth & has_palette)) {
+    return false;
+  }
+  // Grey ramp until the caller sets its own colours
+  size_t entries = 1u << (_depth & bit_mask);
+  _palette.resize(entries);
+  for (size_t i = 0; i < entries; i++) {
+    uint8_t grey = (uint8_t)(i * 255 / (entries - 1));
+    _palette[i] = { grey, grey, grey };
+  }
+  return true;
+}
+
+void LGFX_Sprite::setPaletteColor(size_t index, uint32_t rgb888) {
+  if (index < _palette.size()) {
+    _palette[index] = { (uint8_t)rgb888, (uint8_t)(rgb888 >> 8), (uint8_t)(rgb888 >> 16) };
+  }
+}
+
+void LGFX_Sprite::setPixel(int32_t x, int32_t y, uint32_t value) {
+  uint8_t* row = _buffer.data() + y * strideBytes();
+  if (_depth == palette_4bit) {
+    uint8_t& pair = row[x >> 1];
+    pair = (x & 1) ? ((pair & 0xF0) | (value & 0x0F)) : ((pair & 0x0F) | ((value & 0x0F) << 4));
+  } else {
+    uint16_t raw = (uint16_t)value;
+    memcpy(row + x * 2, &raw, sizeof(raw));
+  }
+}
+
+void LGFX_Sprite::fillClipped(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  // Palette sprites take indices; 16-bit sprites store RGB565 in panel byte order
+  uint32_t value = _depth == palette_4bit ? (color & 0x0F) : (uint16_t)((color >> 8) | (color << 8));
+  for (int32_t j = y; j < y + h; j++) {
+    for (int32_t i = x; i < x + w; i++) {
+      setPixel(i, j, value);
+    }
+  }
+}
+
+void LGFX_Sprite::writeImage565(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* pixels, bool swapped) {
+  int32_t left = x, top = y, width = w, height = h;
+  if (!clip(left, top, width, height)) {
+    return;
+  }
+  for (int32_t j = top; j < top + height; j++) {
+    for (int32_t i = left; i < left + width; i++) {
+      uint16_t color = pixels[(j - y) * w + (i - x)];
+      if (swapped) {
+        color = (uint16_t)((color >> 8) | (color << 8));
+      }
+      if (_depth != palette_4bit) {
+        setPixel(i, j, (uint16_t)((color >> 8) | (color << 8)));
+        continue;
+      }
+      // Nearest palette entry
+      uint32_t best = 0;
+      uint32_t bestDistance = UINT32_MAX;
+      for (size_t k = 0; k < _palette.size(); k++) {
+        int32_t dr = (int32_t)((color >> 11) << 3) - _palette[k].r;
+        int32_t dg = (int32_t)(((color >> 5) & 0x3F) << 2) - _palette[k].g;
+        int32_t db = (int32_t)((color & 0x1F) << 3) - _palette[k].b;
+        uint32_t distance = dr * dr + dg * dg + db * db;
+        if (distance < bestDistance) {
+          bestDistance = distance;
+          best = k;
+        }
+      }
+      setPixel(i, j, best);
+    }
+  }
+}
+
+uint16_t LGFX_Sprite::readPixel565(int32_t x, int32_t y) const {
+  const uint8_t* row = _buffer.data() + y * strideBytes();
+  if (_depth == palette_4bit) {
+    uint8_t index = (x & 1) ? (row[x >> 1] & 0x0F) : (row[x >> 1] >> 4);
+    if (index >= _palette.size()) {
+      return 0;
+    }
+    return color565(_palette[index].r, _palette[index].g, _palette[index].b);
+  }
+  uint16_t raw;
+  memcpy(&raw, row + x * 2, sizeof(raw));
+  return (uint16_t)((raw >> 8) | (raw << 8));
+}
+
+void LGFX_Sprite::pushSprite(LovyanGFX* target, int32_t x, int32_t y) {
+  std::vector<uint16_t> pixels(_width * _height);
+  for (int32_t j = 0; j < _height; j++) {
+    for (int32_t i = 0; i < _width; i++) {
+      pixels[j * _width + i] = readPixel565(i, j);
+    }
+  }
+  target->writeImage565(x, y, _width, _height, pixels.data(), false);
+}
+
+} // namespace v1
+} // namespace lgfx
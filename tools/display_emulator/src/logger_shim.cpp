@@ -0,0 +1,20 @@
+#include <Arduino.h>
+#include "logger.h"
+
+// The display modules log through LOG_*(); on the host every line goes
+// straight to stderr like Serial, there is no ring or drain task to run
+
+Logger logger;
+
+Logger::Logger() : _level(LOG_LEVEL), _fileOutput(false) {
+}
+
+void Logger::write(uint8_t level, const char* format, ...) {
+  static const char LEVEL_LETTERS[] = "-EWIDT";
+  fprintf(stderr, "%c ", LEVEL_LETTERS[level <= LOG_LEVEL_TRACE ? level : 0]);
+  va_list args;
+  va_start(args, format);
+  vfprintf(stderr, format, args);
+  va_end(args);
+  fputc('\n', stderr);
+}
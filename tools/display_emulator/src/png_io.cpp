@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+#include "png_io.h"
+
+static const uint8_t PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+static void putBigEndian32(std::vector<uint8_t>& out, uint32_t value) {
+  out.push_back(value >> 24);
+  out.push_back(value >> 16);
+  out.push_back(value >> 8);
+  out.push_back(value);
+}
+
+static uint32_t getBigEndian32(const uint8_t* in) {
+  return ((uint32_t)in[0] << 24) | ((uint32_t)in[1] << 16) | ((uint32_t)in[2] << 8) | in[3];
+}
+
+static void putChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data) {
+  putBigEndian32(out, data.size());
+  size_t start = out.size();
+  out.insert(out.end(), type, type + 4);
+  out.insert(out.end(), data.begin(), data.end());
+  putBigEndian32(out, crc32(0, out.data() + start, out.size() - start));
+}
+
+bool writePng(const char* path, const Rgb565Image& image) {
+  // Every row starts with filter type 0 (none)
+  size_t rowBytes = 1 + image.width * 3;
+  std::vector<uint8_t> raw(rowBytes * image.height);
+  for (int32_t y = 0; y < image.height; y++) {
+    uint8_t* row = raw.data() + y * rowBytes;
+    row[0] = 0;
+    for (int32_t x = 0; x < image.width; x++) {
+      uint16_t color = image.pixels[y * image.width + x];
+      uint8_t r = color >> 11, g = (color >> 5) & 0x3F, b = color & 0x1F;
+      row[1 + x * 3] = (r << 3) | (r >> 2);
+      row[2 + x * 3] = (g << 2) | (g >> 4);
+      row[3 + x * 3] = (b << 3) | (b >> 2);
+    }
+  }
+
+  uLongf compressedSize = compressBound(raw.size());
+  std::vector<uint8_t> compressed(compressedSize);
+  if (compress2(compressed.data(), &compressedSize, raw.data(), raw.size(), Z_BEST_COMPRESSION) != Z_OK) {
+    return false;
+  }
+  compressed.resize(compressedSize);
+
+  std::vector<uint8_t> header;
+  putBigEndian32(header, image.width);
+  putBigEndian32(header, image.height);
+  header.push_back(8); // Bit depth
+  header.push_back(2); // Colour type: RGB
+  header.push_back(0); // Compression
+  header.push_back(0); // Filter method
+  header.push_back(0); // No interlace
+
+  std::vector<uint8_t> file(PNG_SIGNATURE, PNG_SIGNATURE + sizeof(PNG_SIGNATURE));
+  putChunk(file, "IHDR", header);
+  putChunk(file, "IDAT", compressed);
+  putChunk(file, "IEND", std::vector<uint8_t>());
+
+  FILE* out = fopen(path, "wb");
+  if (out == nullptr) {
+    return false;
+  }
+  bool ok = fwrite(file.data(), 1, file.size(), out) == file.size();
+  return fclose(out) == 0 && ok;
+}
+
+static uint8_t paeth(uint8_t a, uint8_t b, uint8_t c) {
+  int p = a + b - c;
+  int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+  if (pa <= pb && pa <= pc) {
+    return a;
+  }
+  return pb <= pc ? b : c;
+}
+
+bool readPng(const char* path, Rgb565Image& image) {
+  FILE* in = fopen(path, "rb");
+  if (in == nullptr) {
+    return false;
+  }
+  std::vector<uint8_t> file;
+  uint8_t buffer[4096];
+  size_t n;
+  while ((n = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+    file.insert(file.end(), buffer, buffer + n);
+  }
+  fclose(in);
+  if (file.size() < sizeof(PNG_SIGNATURE) || memcmp(file.data(), PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) != 0) {
+    return false;
+  }
+
+  int32_t width = 0, height = 0;
+  int channels = 0;
+  std::vector<uint8_t> compressed;
+  size_t offset = sizeof(PNG_SIGNATURE);
+  while (offset + 12 <= file.size()) {
+    uint32_t length = getBigEndian32(&file[offset]);
+    const uint8_t* type = &file[offset + 4];
+    const uint8_t* data = &file[offset + 8];
+    if (offset + 12 + length > file.size()) {
+      return false;
+    }
+    if (memcmp(type, "IHDR", 4) == 0 && length >= 13) {
+      width = getBigEndian32(data);
+      height = getBigEndian32(data + 4);
+      uint8_t depth = data[8], colorType = data[9], interlace = data[12];
+      if (depth != 8 || interlace != 0 || (colorType != 2 && colorType != 6)) {
+        return false;
+      }
+      channels = colorType == 6 ? 4 : 3;
+    } else if (memcmp(type, "IDAT", 4) == 0) {
+      compressed.insert(compressed.end(), data, data + length);
+    } else if (memcmp(type, "IEND", 4) == 0) {
+      break;
+    }
+    offset += 12 + length;
+  }
+  if (width <= 0 || height <= 0 || channels == 0) {
+    return false;
+  }
+
+  size_t rowBytes = 1 + (size_t)width * channels;
+  uLongf rawSize = rowBytes * height;
+  std::vector<uint8_t> raw(rawSize);
+  if (uncompress(raw.data(), &rawSize, compressed.data(), compressed.size()) != Z_OK || rawSize != raw.size()) {
+    return false;
+  }
+
+  // Undo the per-row filters in place
+  for (int32_t y = 0; y < height; y++) {
+    uint8_t* row = raw.data() + y * rowBytes + 1;
+    const uint8_t* previous = y > 0 ? row - rowBytes : nullptr;
+    uint8_t filter = row[-1];
+    for (size_t i = 0; i < rowBytes - 1; i++) {
+      uint8_t left = i >= (size_t)channels ? row[i - channels] : 0;
+      uint8_t up = previous ? previous[i] : 0;
+      uint8_t upLeft = previous && i >= (size_t)channels ? previous[i - channels] : 0;
+      switch (filter) {
+        case 0: break;
+        case 1: row[i] += left; break;
+        case 2: row[i] += up; break;
+        case 3: row[i] += (left + up) / 2; break;
+        case 4: row[i] += paeth(left, up, upLeft); break;
+        default: return false;
+      }
+    }
+  }
+
+  image.width = width;
+  image.height = height;
+  image.pixels.resize((size_t)width * height);
+  for (int32_t y = 0; y < height; y++) {
+    const uint8_t* row = raw.data() + y * rowBytes + 1;
+    for (int32_t x = 0; x < width; x++) {
+      const uint8_t* p = row + x * channels;
+      image.pixels[y * width + x] = (uint16_t)(((p[0] >> 3) << 11) | ((p[1] >> 2) << 5) | (p[2] >> 3));
+    }
+  }
+  return true;
+}
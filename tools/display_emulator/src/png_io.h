@@ -0,0 +1,32 @@
+#ifndef PNG_IO_H
+#define PNG_IO_H
+
+#include <stdint.h>
+#include <vector>
+
+// ========================================
+// PNG SNAPSHOTS
+// ========================================
+// Minimal PNG reader and writer on top of zlib, for emulator snapshots and
+// golden images. Pixels are RGB565; they are written as 8-bit RGB with the
+// low bits replicated, so a snapshot read back gives the same RGB565 values.
+
+struct Rgb565Image {
+  int32_t width;
+  int32_t height;
+  std::vector<uint16_t> pixels; // Row-major, native byte order
+};
+
+/**
+ * @brief Writes an image as an 8-bit RGB PNG.
+ * @return False if the file could not be written.
+ */
+bool writePng(const char* path, const Rgb565Image& image);
+
+/**
+ * @brief Reads an 8-bit RGB or RGBA, non-interlaced PNG and reduces it to RGB565.
+ * @return False if the file is missing, corrupt or in an unsupported format.
+ */
+bool readPng(const char* path, Rgb565Image& image);
+
+#endif // PNG_IO_H